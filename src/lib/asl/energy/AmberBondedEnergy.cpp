@@ -0,0 +1,616 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberBondedEnergy.hpp>
+#include <AmberTopology.hpp>
+#include <AmberRestart.hpp>
+#include <ErrorSystem.hpp>
+#include <SmallString.hpp>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+// terms are stored in flat arrays (atom indexes and parameters), each kind of
+// term is evaluated in a parallel loop, the energy of each term is stored
+// into a separate array (no reduction in the loop), forces are accumulated in
+// per-thread buffers and reduced afterwards, category and type totals are
+// summed from term energies
+
+// energy and forces of harmonic bond, returns energy, fi is force on atom i
+// (force on atom j is -fi)
+
+static inline double BondKernel(const double* p_i,const double* p_j,
+                                double k,double r0,double* p_fi)
+{
+    double dx = p_i[0] - p_j[0];
+    double dy = p_i[1] - p_j[1];
+    double dz = p_i[2] - p_j[2];
+    double r = sqrt(dx*dx + dy*dy + dz*dz);
+    double dr = r - r0;
+    double fs = 0.0;
+    if( r > 0.0 ) fs = -2.0*k*dr/r;
+    p_fi[0] = fs*dx;
+    p_fi[1] = fs*dy;
+    p_fi[2] = fs*dz;
+    return(k*dr*dr);
+}
+
+//------------------------------------------------------------------------------
+
+// energy and forces of harmonic angle i-j-k, returns energy,
+// fi and fk are forces on terminal atoms (force on atom j is -fi-fk)
+
+static inline double AngleKernel(const double* p_i,const double* p_j,const double* p_k,
+                                 double k,double t0,double* p_fi,double* p_fk)
+{
+    double ux = p_i[0] - p_j[0];
+    double uy = p_i[1] - p_j[1];
+    double uz = p_i[2] - p_j[2];
+    double vx = p_k[0] - p_j[0];
+    double vy = p_k[1] - p_j[1];
+    double vz = p_k[2] - p_j[2];
+    double u2 = ux*ux + uy*uy + uz*uz;
+    double v2 = vx*vx + vy*vy + vz*vz;
+    double uv = sqrt(u2*v2);
+    double cost = 0.0;
+    if( uv > 0.0 ) cost = (ux*vx + uy*vy + uz*vz)/uv;
+    if( cost > 1.0 ) cost = 1.0;
+    if( cost < -1.0 ) cost = -1.0;
+    double t = acos(cost);
+    double dt = t - t0;
+    double sint = sqrt(1.0 - cost*cost);
+
+    // F = -dE/dt * dt/dcos * dcos/dr = 2k*dt/sin * dcos/dr
+    double fs = 0.0;
+    if( (sint > 1.0e-8) && (uv > 0.0) ) fs = 2.0*k*dt/sint;
+    double a = (uv > 0.0) ? fs/uv : 0.0;
+    double bi = (u2 > 0.0) ? fs*cost/u2 : 0.0;
+    double bk = (v2 > 0.0) ? fs*cost/v2 : 0.0;
+    p_fi[0] = a*vx - bi*ux;
+    p_fi[1] = a*vy - bi*uy;
+    p_fi[2] = a*vz - bi*uz;
+    p_fk[0] = a*ux - bk*vx;
+    p_fk[1] = a*uy - bk*vy;
+    p_fk[2] = a*uz - bk*vz;
+    return(k*dt*dt);
+}
+
+//------------------------------------------------------------------------------
+
+// energy and forces of dihedral i-j-k-l, pk*(1+cos(pn*phi-phase)), returns
+// energy, f contains forces on atoms i,j,k,l (12 items)
+
+static inline double DihedralKernel(const double* p_i,const double* p_j,
+                                    const double* p_k,const double* p_l,
+                                    double pk,double pn,double phase,double* p_f)
+{
+    // r_ij, r_kj, r_kl
+    double ijx = p_i[0] - p_j[0];
+    double ijy = p_i[1] - p_j[1];
+    double ijz = p_i[2] - p_j[2];
+    double kjx = p_k[0] - p_j[0];
+    double kjy = p_k[1] - p_j[1];
+    double kjz = p_k[2] - p_j[2];
+    double klx = p_k[0] - p_l[0];
+    double kly = p_k[1] - p_l[1];
+    double klz = p_k[2] - p_l[2];
+
+    // m = r_ij x r_kj, n = r_kj x r_kl
+    double mx = ijy*kjz - ijz*kjy;
+    double my = ijz*kjx - ijx*kjz;
+    double mz = ijx*kjy - ijy*kjx;
+    double nx = kjy*klz - kjz*kly;
+    double ny = kjz*klx - kjx*klz;
+    double nz = kjx*kly - kjy*klx;
+
+    double m2 = mx*mx + my*my + mz*mz;
+    double n2 = nx*nx + ny*ny + nz*nz;
+    double kj2 = kjx*kjx + kjy*kjy + kjz*kjz;
+    double kj = sqrt(kj2);
+
+    // phi = atan2(|r_kj| r_ij.n, m.n)
+    double phi = atan2(kj*(ijx*nx + ijy*ny + ijz*nz),mx*nx + my*ny + mz*nz);
+    double arg = pn*phi - phase;
+    double energy = pk*(1.0 + cos(arg));
+
+    for(int c=0; c < 12; c++) p_f[c] = 0.0;
+    if( (m2 <= 0.0) || (n2 <= 0.0) || (kj2 <= 0.0) ) return(energy);
+
+    double dedphi = -pk*pn*sin(arg);
+
+    double fix = -dedphi*kj/m2*mx;
+    double fiy = -dedphi*kj/m2*my;
+    double fiz = -dedphi*kj/m2*mz;
+    double flx = dedphi*kj/n2*nx;
+    double fly = dedphi*kj/n2*ny;
+    double flz = dedphi*kj/n2*nz;
+
+    double p = (ijx*kjx + ijy*kjy + ijz*kjz)/kj2;
+    double q = (klx*kjx + kly*kjy + klz*kjz)/kj2;
+    double sx = p*fix - q*flx;
+    double sy = p*fiy - q*fly;
+    double sz = p*fiz - q*flz;
+
+    p_f[0]  = fix;
+    p_f[1]  = fiy;
+    p_f[2]  = fiz;
+    p_f[3]  = -(fix - sx);
+    p_f[4]  = -(fiy - sy);
+    p_f[5]  = -(fiz - sz);
+    p_f[6]  = -(flx + sx);
+    p_f[7]  = -(fly + sy);
+    p_f[8]  = -(flz + sz);
+    p_f[9]  = flx;
+    p_f[10] = fly;
+    p_f[11] = flz;
+
+    return(energy);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberBondedEnergy::CAmberBondedEnergy(void)
+{
+    Topology = NULL;
+    NumOfThreads = 1;
+    ForcesEnabled = false;
+    NumOfAtoms = 0;
+    NumOfBonds = 0;
+    NumOfBondsWithoutH = 0;
+    NumOfAngles = 0;
+    NumOfAnglesWithoutH = 0;
+    NumOfDihedrals = 0;
+    NumOfDihedralsWithoutH = 0;
+    NumOfBondTypes = 0;
+    NumOfAngleTypes = 0;
+    NumOfDihedralTypes = 0;
+    for(int i=0; i < AMBER_BONDED_NUM_OF_TERMS; i++) Energies[i] = 0.0;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberBondedEnergy::~CAmberBondedEnergy(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberBondedEnergy::SetTopology(CAmberTopology* p_topology)
+{
+    Topology = p_topology;
+    NumOfAtoms = 0;
+    NumOfBonds = 0;
+    NumOfBondsWithoutH = 0;
+    NumOfAngles = 0;
+    NumOfAnglesWithoutH = 0;
+    NumOfDihedrals = 0;
+    NumOfDihedralsWithoutH = 0;
+    NumOfBondTypes = 0;
+    NumOfAngleTypes = 0;
+    NumOfDihedralTypes = 0;
+
+    if( Topology == NULL ) return(true);
+
+    if( (Topology->GetLoadedParts() & AMBER_LOAD_BONDED) == 0 ) {
+        ES_ERROR("bonded terms must be loaded");
+        Topology = NULL;
+        return(false);
+    }
+
+    NumOfAtoms = Topology->AtomList.GetNumberOfAtoms();
+
+    // bonds
+    CAmberBondList* p_blist = &Topology->BondList;
+    NumOfBonds = p_blist->GetNumberOfBonds();
+    NumOfBondsWithoutH = p_blist->GetNumberOfBondsWithoutHydrogen();
+    NumOfBondTypes = p_blist->GetNumberOfBondTypes();
+    BondAtoms.resize(2*NumOfBonds);
+    BondTypes.resize(NumOfBonds);
+    BondK.resize(NumOfBonds);
+    BondR0.resize(NumOfBonds);
+    for(int i=0; i < NumOfBonds; i++) {
+        CAmberBond* p_bond = p_blist->GetBond(i);
+        BondAtoms[2*i+0] = p_bond->GetIB();
+        BondAtoms[2*i+1] = p_bond->GetJB();
+        BondTypes[i] = p_bond->GetICB();
+        CAmberBondType* p_type = p_blist->GetBondType(p_bond->GetICB());
+        if( p_type == NULL ) {
+            CSmallString error;
+            error << "illegal type of bond " << i+1;
+            ES_ERROR(error);
+            Topology = NULL;
+            return(false);
+        }
+        BondK[i] = p_type->GetRK();
+        BondR0[i] = p_type->GetREQ();
+    }
+
+    // angles
+    CAmberAngleList* p_alist = &Topology->AngleList;
+    NumOfAngles = p_alist->GetNumberOfAngles();
+    NumOfAnglesWithoutH = p_alist->GetNumberOfAnglesWithoutHydrogen();
+    NumOfAngleTypes = p_alist->GetNumberOfAngleTypes();
+    AngleAtoms.resize(3*NumOfAngles);
+    AngleTypes.resize(NumOfAngles);
+    AngleK.resize(NumOfAngles);
+    AngleT0.resize(NumOfAngles);
+    for(int i=0; i < NumOfAngles; i++) {
+        CAmberAngle* p_angle = p_alist->GetAngle(i);
+        AngleAtoms[3*i+0] = p_angle->GetIT();
+        AngleAtoms[3*i+1] = p_angle->GetJT();
+        AngleAtoms[3*i+2] = p_angle->GetKT();
+        AngleTypes[i] = p_angle->GetICT();
+        CAmberAngleType* p_type = p_alist->GetAngleType(p_angle->GetICT());
+        if( p_type == NULL ) {
+            CSmallString error;
+            error << "illegal type of angle " << i+1;
+            ES_ERROR(error);
+            Topology = NULL;
+            return(false);
+        }
+        AngleK[i] = p_type->GetTK();
+        AngleT0[i] = p_type->GetTEQ();
+    }
+
+    // dihedrals - each term of multi-term dihedral is stored separately
+    CAmberDihedralList* p_dlist = &Topology->DihedralList;
+    NumOfDihedrals = p_dlist->GetNumberOfDihedrals();
+    NumOfDihedralsWithoutH = p_dlist->GetNumberOfDihedralsWithoutHydrogen();
+    NumOfDihedralTypes = p_dlist->GetNumberOfDihedralTypes();
+    DihedralAtoms.resize(4*NumOfDihedrals);
+    DihedralTypes.resize(NumOfDihedrals);
+    DihedralImproper.resize(NumOfDihedrals);
+    DihedralPK.resize(NumOfDihedrals);
+    DihedralPN.resize(NumOfDihedrals);
+    DihedralPhase.resize(NumOfDihedrals);
+    for(int i=0; i < NumOfDihedrals; i++) {
+        CAmberDihedral* p_dih = p_dlist->GetDihedral(i);
+        DihedralAtoms[4*i+0] = p_dih->GetIP();
+        DihedralAtoms[4*i+1] = p_dih->GetJP();
+        DihedralAtoms[4*i+2] = p_dih->GetKP();
+        DihedralAtoms[4*i+3] = p_dih->GetLP();
+        DihedralTypes[i] = p_dih->GetICP();
+        DihedralImproper[i] = (p_dih->GetType() == 1) || (p_dih->GetType() == -2);
+        CAmberDihedralType* p_type = p_dlist->GetDihedralType(p_dih->GetICP());
+        if( p_type == NULL ) {
+            CSmallString error;
+            error << "illegal type of dihedral " << i+1;
+            ES_ERROR(error);
+            Topology = NULL;
+            return(false);
+        }
+        DihedralPK[i] = p_type->GetPK();
+        DihedralPN[i] = p_type->GetPN();
+        DihedralPhase[i] = p_type->GetPHASE();
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBondedEnergy::SetNumberOfThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfThreads = nthreads;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberBondedEnergy::GetNumberOfThreads(void)
+{
+    return(NumOfThreads);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBondedEnergy::SetForcesEnabled(bool set)
+{
+    ForcesEnabled = set;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberBondedEnergy::Calculate(CAmberRestart* p_rst)
+{
+    for(int i=0; i < AMBER_BONDED_NUM_OF_TERMS; i++) Energies[i] = 0.0;
+
+    if( Topology == NULL ) {
+        ES_ERROR("topology is not set");
+        return(false);
+    }
+
+    if( p_rst == NULL ) {
+        ES_ERROR("snapshot is NULL");
+        return(false);
+    }
+
+    if( p_rst->GetNumberOfAtoms() != NumOfAtoms ) {
+        ES_ERROR("number of atoms in snapshot and topology differs");
+        return(false);
+    }
+
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    const double* p_crd = p_rst->GetCoordinatesBuffer();
+
+    Forces.assign(ForcesEnabled ? 3*NumOfAtoms : 0,0.0);
+    ThreadForces.assign(ForcesEnabled ? nthreads*3*NumOfAtoms : 0,0.0);
+
+    CalculateBonds(p_crd,nthreads);
+    CalculateAngles(p_crd,nthreads);
+    CalculateDihedrals(p_crd,nthreads);
+
+    // reduce thread buffers
+    if( ForcesEnabled ) {
+        for(int t=0; t < nthreads; t++) {
+            for(int i=0; i < 3*NumOfAtoms; i++) Forces[i] += ThreadForces[t*3*NumOfAtoms+i];
+        }
+    }
+
+    // category totals
+    for(int i=0; i < NumOfBonds; i++) {
+        if( i < NumOfBondsWithoutH ) {
+            Energies[AMBER_BONDED_BOND] += BondEnergies[i];
+        } else {
+            Energies[AMBER_BONDED_BOND_H] += BondEnergies[i];
+        }
+    }
+    for(int i=0; i < NumOfAngles; i++) {
+        if( i < NumOfAnglesWithoutH ) {
+            Energies[AMBER_BONDED_ANGLE] += AngleEnergies[i];
+        } else {
+            Energies[AMBER_BONDED_ANGLE_H] += AngleEnergies[i];
+        }
+    }
+    for(int i=0; i < NumOfDihedrals; i++) {
+        bool h = i >= NumOfDihedralsWithoutH;
+        if( DihedralImproper[i] ) {
+            Energies[h ? AMBER_BONDED_IMPROPER_H : AMBER_BONDED_IMPROPER] += DihedralEnergies[i];
+        } else {
+            Energies[h ? AMBER_BONDED_DIHEDRAL_H : AMBER_BONDED_DIHEDRAL] += DihedralEnergies[i];
+        }
+    }
+
+    // type totals
+    BondTypeEnergies.assign(NumOfBondTypes,0.0);
+    for(int i=0; i < NumOfBonds; i++) BondTypeEnergies[BondTypes[i]] += BondEnergies[i];
+    AngleTypeEnergies.assign(NumOfAngleTypes,0.0);
+    for(int i=0; i < NumOfAngles; i++) AngleTypeEnergies[AngleTypes[i]] += AngleEnergies[i];
+    DihedralTypeEnergies.assign(NumOfDihedralTypes,0.0);
+    for(int i=0; i < NumOfDihedrals; i++) DihedralTypeEnergies[DihedralTypes[i]] += DihedralEnergies[i];
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBondedEnergy::CalculateBonds(const double* p_crd,int nthreads)
+{
+    BondEnergies.resize(NumOfBonds);
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads)
+#endif
+    for(int i=0; i < NumOfBonds; i++) {
+        int ai = BondAtoms[2*i+0];
+        int aj = BondAtoms[2*i+1];
+        double fi[3];
+        BondEnergies[i] = BondKernel(&p_crd[3*ai],&p_crd[3*aj],BondK[i],BondR0[i],fi);
+        if( ForcesEnabled ) {
+            int tid = 0;
+#ifdef _OPENMP
+            tid = omp_get_thread_num();
+#endif
+            double* p_f = &ThreadForces[tid*3*NumOfAtoms];
+            for(int c=0; c < 3; c++) {
+                p_f[3*ai+c] += fi[c];
+                p_f[3*aj+c] -= fi[c];
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBondedEnergy::CalculateAngles(const double* p_crd,int nthreads)
+{
+    AngleEnergies.resize(NumOfAngles);
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads)
+#endif
+    for(int i=0; i < NumOfAngles; i++) {
+        int ai = AngleAtoms[3*i+0];
+        int aj = AngleAtoms[3*i+1];
+        int ak = AngleAtoms[3*i+2];
+        double fi[3];
+        double fk[3];
+        AngleEnergies[i] = AngleKernel(&p_crd[3*ai],&p_crd[3*aj],&p_crd[3*ak],
+                                       AngleK[i],AngleT0[i],fi,fk);
+        if( ForcesEnabled ) {
+            int tid = 0;
+#ifdef _OPENMP
+            tid = omp_get_thread_num();
+#endif
+            double* p_f = &ThreadForces[tid*3*NumOfAtoms];
+            for(int c=0; c < 3; c++) {
+                p_f[3*ai+c] += fi[c];
+                p_f[3*aj+c] -= fi[c] + fk[c];
+                p_f[3*ak+c] += fk[c];
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBondedEnergy::CalculateDihedrals(const double* p_crd,int nthreads)
+{
+    DihedralEnergies.resize(NumOfDihedrals);
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads)
+#endif
+    for(int i=0; i < NumOfDihedrals; i++) {
+        const int* p_atoms = &DihedralAtoms[4*i];
+        double f[12];
+        DihedralEnergies[i] = DihedralKernel(&p_crd[3*p_atoms[0]],&p_crd[3*p_atoms[1]],
+                                             &p_crd[3*p_atoms[2]],&p_crd[3*p_atoms[3]],
+                                             DihedralPK[i],DihedralPN[i],DihedralPhase[i],f);
+        if( ForcesEnabled ) {
+            int tid = 0;
+#ifdef _OPENMP
+            tid = omp_get_thread_num();
+#endif
+            double* p_f = &ThreadForces[tid*3*NumOfAtoms];
+            for(int a=0; a < 4; a++) {
+                for(int c=0; c < 3; c++) {
+                    p_f[3*p_atoms[a]+c] += f[3*a+c];
+                }
+            }
+        }
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+double CAmberBondedEnergy::GetEnergy(EAmberBondedTerm term)
+{
+    if( (term < 0) || (term >= AMBER_BONDED_NUM_OF_TERMS) ) return(0.0);
+    return(Energies[term]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetBondEnergy(void)
+{
+    return(Energies[AMBER_BONDED_BOND_H] + Energies[AMBER_BONDED_BOND]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetAngleEnergy(void)
+{
+    return(Energies[AMBER_BONDED_ANGLE_H] + Energies[AMBER_BONDED_ANGLE]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetDihedralEnergy(void)
+{
+    return(Energies[AMBER_BONDED_DIHEDRAL_H] + Energies[AMBER_BONDED_DIHEDRAL]
+         + Energies[AMBER_BONDED_IMPROPER_H] + Energies[AMBER_BONDED_IMPROPER]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetTotalEnergy(void)
+{
+    return(GetBondEnergy() + GetAngleEnergy() + GetDihedralEnergy());
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetBondTermEnergy(int index)
+{
+    if( (index < 0) || (index >= (int)BondEnergies.size()) ) return(0.0);
+    return(BondEnergies[index]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetAngleTermEnergy(int index)
+{
+    if( (index < 0) || (index >= (int)AngleEnergies.size()) ) return(0.0);
+    return(AngleEnergies[index]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetDihedralTermEnergy(int index)
+{
+    if( (index < 0) || (index >= (int)DihedralEnergies.size()) ) return(0.0);
+    return(DihedralEnergies[index]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetBondTypeEnergy(int type)
+{
+    if( (type < 0) || (type >= (int)BondTypeEnergies.size()) ) return(0.0);
+    return(BondTypeEnergies[type]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetAngleTypeEnergy(int type)
+{
+    if( (type < 0) || (type >= (int)AngleTypeEnergies.size()) ) return(0.0);
+    return(AngleTypeEnergies[type]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberBondedEnergy::GetDihedralTypeEnergy(int type)
+{
+    if( (type < 0) || (type >= (int)DihedralTypeEnergies.size()) ) return(0.0);
+    return(DihedralTypeEnergies[type]);
+}
+
+//------------------------------------------------------------------------------
+
+const CPoint CAmberBondedEnergy::GetForce(int index)
+{
+    CPoint force;
+    if( (index < 0) || (3*index >= (int)Forces.size()) ) return(force);
+    force.x = Forces[3*index+0];
+    force.y = Forces[3*index+1];
+    force.z = Forces[3*index+2];
+    return(force);
+}
+
+//------------------------------------------------------------------------------
+
+const double* CAmberBondedEnergy::GetForces(void)
+{
+    if( Forces.size() == 0 ) return(NULL);
+    return(&Forces[0]);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
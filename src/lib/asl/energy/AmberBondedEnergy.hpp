@@ -0,0 +1,176 @@
+#ifndef AmberBondedEnergyH
+#define AmberBondedEnergyH
+/** \ingroup AmberEnergy*/
+/*! \file AmberBondedEnergy.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ASLMainHeader.hpp>
+#include <Point.hpp>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+class CAmberTopology;
+class CAmberRestart;
+
+//---------------------------------------------------------------------------
+
+/// categories of bonded terms
+
+enum EAmberBondedTerm {
+    AMBER_BONDED_BOND_H,        // bonds with hydrogen
+    AMBER_BONDED_BOND,          // bonds without hydrogen
+    AMBER_BONDED_ANGLE_H,       // angles with hydrogen
+    AMBER_BONDED_ANGLE,         // angles without hydrogen
+    AMBER_BONDED_DIHEDRAL_H,    // proper dihedrals with hydrogen
+    AMBER_BONDED_DIHEDRAL,      // proper dihedrals without hydrogen
+    AMBER_BONDED_IMPROPER_H,    // improper dihedrals with hydrogen
+    AMBER_BONDED_IMPROPER,      // improper dihedrals without hydrogen
+    AMBER_BONDED_NUM_OF_TERMS
+};
+
+//---------------------------------------------------------------------------
+
+/// bonded (bond, angle, dihedral) energies and forces
+
+class ASL_PACKAGE CAmberBondedEnergy {
+public:
+    CAmberBondedEnergy(void);
+    ~CAmberBondedEnergy(void);
+
+    /// set topology and prepare parameters
+    /*! parameters are copied from topology thus the method must be called
+        again if the topology is modified
+    */
+    bool SetTopology(CAmberTopology* p_topology);
+
+    /// set number of threads used in the calculation
+    void SetNumberOfThreads(int nthreads);
+
+    /// get number of threads used in the calculation
+    int GetNumberOfThreads(void);
+
+    /// enable calculation of forces
+    void SetForcesEnabled(bool set);
+
+    /// calculate energies of given snapshot
+    /*! molecules must not be broken by periodic imaging
+    */
+    bool Calculate(CAmberRestart* p_rst);
+
+// results ---------------------------------------------------------------------
+    /// get energy of given category of terms in kcal/mol
+    double GetEnergy(EAmberBondedTerm term);
+
+    /// get bond energy in kcal/mol
+    double GetBondEnergy(void);
+
+    /// get angle energy in kcal/mol
+    double GetAngleEnergy(void);
+
+    /// get dihedral energy (including impropers) in kcal/mol
+    double GetDihedralEnergy(void);
+
+    /// get total bonded energy in kcal/mol
+    double GetTotalEnergy(void);
+
+    /// get energy of bond, index is the same as in CAmberBondList::GetBond
+    double GetBondTermEnergy(int index);
+
+    /// get energy of angle, index is the same as in CAmberAngleList::GetAngle
+    double GetAngleTermEnergy(int index);
+
+    /// get energy of dihedral, index is the same as in CAmberDihedralList::GetDihedral
+    double GetDihedralTermEnergy(int index);
+
+    /// get energy of all bonds of given bond type
+    double GetBondTypeEnergy(int type);
+
+    /// get energy of all angles of given angle type
+    double GetAngleTypeEnergy(int type);
+
+    /// get energy of all dihedrals of given dihedral type
+    double GetDihedralTypeEnergy(int type);
+
+    /// get force acting on atom in kcal/mol/A
+    const CPoint GetForce(int index);
+
+    /// get forces - NATOM*3 items (x,y,z for each atom) in kcal/mol/A
+    const double* GetForces(void);
+
+// section of private data ----------------------------------------------------
+private:
+    CAmberTopology*         Topology;
+    int                     NumOfThreads;
+    bool                    ForcesEnabled;
+    int                     NumOfAtoms;
+
+    // bonds - without hydrogens first
+    int                     NumOfBonds;
+    int                     NumOfBondsWithoutH;
+    std::vector<int>        BondAtoms;          // 2 items per bond
+    std::vector<int>        BondTypes;
+    std::vector<double>     BondK;
+    std::vector<double>     BondR0;
+
+    // angles - without hydrogens first
+    int                     NumOfAngles;
+    int                     NumOfAnglesWithoutH;
+    std::vector<int>        AngleAtoms;         // 3 items per angle
+    std::vector<int>        AngleTypes;
+    std::vector<double>     AngleK;
+    std::vector<double>     AngleT0;
+
+    // dihedrals - without hydrogens first, each term is a separate item
+    int                     NumOfDihedrals;
+    int                     NumOfDihedralsWithoutH;
+    std::vector<int>        DihedralAtoms;      // 4 items per dihedral
+    std::vector<int>        DihedralTypes;
+    std::vector<int>        DihedralImproper;
+    std::vector<double>     DihedralPK;
+    std::vector<double>     DihedralPN;
+    std::vector<double>     DihedralPhase;
+
+    int                     NumOfBondTypes;
+    int                     NumOfAngleTypes;
+    int                     NumOfDihedralTypes;
+
+    // results
+    double                  Energies[AMBER_BONDED_NUM_OF_TERMS];
+    std::vector<double>     BondEnergies;
+    std::vector<double>     AngleEnergies;
+    std::vector<double>     DihedralEnergies;
+    std::vector<double>     BondTypeEnergies;
+    std::vector<double>     AngleTypeEnergies;
+    std::vector<double>     DihedralTypeEnergies;
+    std::vector<double>     Forces;
+
+    // thread buffers
+    std::vector<double>     ThreadForces;
+
+    void CalculateBonds(const double* p_crd,int nthreads);
+    void CalculateAngles(const double* p_crd,int nthreads);
+    void CalculateDihedrals(const double* p_crd,int nthreads);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
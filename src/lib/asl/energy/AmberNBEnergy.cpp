@@ -0,0 +1,645 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberNBEnergy.hpp>
+#include <AmberTopology.hpp>
+#include <AmberRestart.hpp>
+#include <ErrorSystem.hpp>
+#include <SmallString.hpp>
+#include <math.h>
+#include <float.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+// pairs i < j are evaluated for each atom i in three passes over j: minimum
+// image differences, pair energies, and forces/decomposition (only if requested),
+// the body of the energy loop is free of data dependent branches (cutoff and
+// exclusions are applied via multiplicative masks, 12-6 and 12-10 terms via
+// weights) so it can be vectorized, excluded partners of atom i are masked in
+// a per-thread array, forces and decomposed energies are accumulated in
+// per-thread buffers
+
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#define AMBER_NB_SIMD_LOOP  _Pragma("omp simd reduction(+:eel,evdw)")
+#else
+#define AMBER_NB_SIMD_LOOP
+#endif
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberNBEnergy::CAmberNBEnergy(void)
+{
+    Topology = NULL;
+    Cutoff = 0.0;
+    NumOfThreads = 1;
+    ForcesEnabled = false;
+    DecompositionEnabled = false;
+
+    NumOfAtoms = 0;
+    NumOfResidues = 0;
+    NumOfTypes = 0;
+    BoxMode = 0;
+
+    EEL = 0.0;
+    VDW = 0.0;
+    EEL14 = 0.0;
+    VDW14 = 0.0;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberNBEnergy::~CAmberNBEnergy(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberNBEnergy::SetTopology(CAmberTopology* p_topology)
+{
+    Topology = p_topology;
+    NumOfAtoms = 0;
+    NumOfResidues = 0;
+    NumOfTypes = 0;
+
+    if( Topology == NULL ) return(true);
+
+    if( (Topology->GetLoadedParts() & (AMBER_LOAD_ATOMS | AMBER_LOAD_NONBONDED))
+                                   != (AMBER_LOAD_ATOMS | AMBER_LOAD_NONBONDED) ) {
+        ES_ERROR("atoms and nonbonded parameters must be loaded");
+        Topology = NULL;
+        return(false);
+    }
+
+    NumOfAtoms = Topology->AtomList.GetNumberOfAtoms();
+    NumOfResidues = Topology->ResidueList.GetNumberOfResidues();
+    NumOfTypes = Topology->NonBondedList.GetNumberOfTypes();
+
+    // atom properties
+    Charges.resize(NumOfAtoms);
+    Types.resize(NumOfAtoms);
+    Residues.resize(NumOfAtoms);
+    if( NumOfAtoms > 0 ) {
+        const double* p_charges = Topology->AtomList.GetChargeArray();
+        const int*    p_types = Topology->AtomList.GetTypeIndexArray();
+        const int*    p_residues = Topology->AtomList.GetResidueIndexArray();
+        for(int i=0; i < NumOfAtoms; i++) {
+            Charges[i] = p_charges[i];
+            Types[i] = p_types[i];
+            Residues[i] = p_residues[i];
+            if( (Types[i] < 0) || (Types[i] >= NumOfTypes) ) {
+                CSmallString error;
+                error << "illegal atom type of atom " << i+1;
+                ES_ERROR(error);
+                Topology = NULL;
+                return(false);
+            }
+        }
+    }
+
+    // LJ parameters
+    Params.resize(NumOfTypes*NumOfTypes);
+    if( NumOfTypes > 0 ) {
+        const CAmberNBParams* p_params = Topology->NonBondedList.GetParamTable();
+        for(int i=0; i < NumOfTypes*NumOfTypes; i++) {
+            Params[i] = p_params[i];
+        }
+    }
+
+    // exclusions - only partners j > i
+    ExclusionOffsets.resize(NumOfAtoms+1);
+    ExclusionList.clear();
+    if( NumOfAtoms > 0 ) ExclusionOffsets[0] = 0;
+    for(int i=0; i < NumOfAtoms; i++) {
+        int         count;
+        const int*  p_list = Topology->GetExcludedAtoms(i,count);
+        for(int k=0; k < count; k++) {
+            if( p_list[k] > i ) ExclusionList.push_back(p_list[k]);
+        }
+        ExclusionOffsets[i+1] = ExclusionList.size();
+    }
+
+    // 1-4 pairs - only dihedrals with both terminal atoms (KP >= 0 and LP >= 0)
+    Pair14I.clear();
+    Pair14J.clear();
+    Pair14EELScale.clear();
+    Pair14VDWScale.clear();
+    CAmberDihedralList* p_dlist = &Topology->DihedralList;
+    int ndih = p_dlist->GetNumberOfDihedralsWithHydrogen() + p_dlist->GetNumberOfDihedralsWithoutHydrogen();
+    for(int i=0; i < ndih; i++) {
+        CAmberDihedral* p_dih;
+        if( i < p_dlist->GetNumberOfDihedralsWithHydrogen() ) {
+            p_dih = p_dlist->GetDihedralWithHydrogen(i);
+        } else {
+            p_dih = p_dlist->GetDihedralWithoutHydrogen(i-p_dlist->GetNumberOfDihedralsWithHydrogen());
+        }
+        if( p_dih->GetType() != 0 ) continue;
+        CAmberDihedralType* p_type = p_dlist->GetDihedralType(p_dih->GetICP());
+        if( p_type == NULL ) continue;
+        double scee = p_type->GetSCEE();
+        double scnb = p_type->GetSCNB();
+        Pair14I.push_back(p_dih->GetIP());
+        Pair14J.push_back(p_dih->GetLP());
+        Pair14EELScale.push_back(scee != 0.0 ? 1.0/scee : 0.0);
+        Pair14VDWScale.push_back(scnb != 0.0 ? 1.0/scnb : 0.0);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNBEnergy::SetCutoff(double cutoff)
+{
+    Cutoff = cutoff;
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetCutoff(void)
+{
+    return(Cutoff);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNBEnergy::SetNumberOfThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfThreads = nthreads;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberNBEnergy::GetNumberOfThreads(void)
+{
+    return(NumOfThreads);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNBEnergy::SetForcesEnabled(bool set)
+{
+    ForcesEnabled = set;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNBEnergy::SetDecompositionEnabled(bool set)
+{
+    DecompositionEnabled = set;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberNBEnergy::Calculate(CAmberRestart* p_rst)
+{
+    EEL = 0.0;
+    VDW = 0.0;
+    EEL14 = 0.0;
+    VDW14 = 0.0;
+
+    if( Topology == NULL ) {
+        ES_ERROR("topology is not set");
+        return(false);
+    }
+
+    if( PrepareSnapshot(p_rst) == false ) return(false);
+
+    Forces.assign(ForcesEnabled ? 3*NumOfAtoms : 0,0.0);
+    AtomEEL.assign(DecompositionEnabled ? NumOfAtoms : 0,0.0);
+    AtomVDW.assign(DecompositionEnabled ? NumOfAtoms : 0,0.0);
+
+    CalculatePairs();
+    Calculate14Pairs();
+
+    // residue decomposition
+    ResidueEEL.assign(DecompositionEnabled ? NumOfResidues : 0,0.0);
+    ResidueVDW.assign(DecompositionEnabled ? NumOfResidues : 0,0.0);
+    if( DecompositionEnabled ) {
+        for(int i=0; i < NumOfAtoms; i++) {
+            int ri = Residues[i];
+            if( ri < 0 ) continue;
+            ResidueEEL[ri] += AtomEEL[i];
+            ResidueVDW[ri] += AtomVDW[i];
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberNBEnergy::PrepareSnapshot(CAmberRestart* p_rst)
+{
+    if( p_rst == NULL ) {
+        ES_ERROR("snapshot is NULL");
+        return(false);
+    }
+
+    if( p_rst->GetNumberOfAtoms() != NumOfAtoms ) {
+        ES_ERROR("number of atoms in snapshot and topology differs");
+        return(false);
+    }
+
+    // coordinates - structure of arrays
+    X.resize(NumOfAtoms);
+    Y.resize(NumOfAtoms);
+    Z.resize(NumOfAtoms);
+    for(int i=0; i < NumOfAtoms; i++) {
+        const CPoint& pos = p_rst->GetPosition(i);
+        X[i] = pos.x;
+        Y[i] = pos.y;
+        Z[i] = pos.z;
+    }
+
+    // box
+    BoxMode = 0;
+    Box = Topology->BoxInfo;
+    if( (Box.GetType() != AMBER_BOX_NONE) && p_rst->IsBoxPresent() ) {
+        Box.SetBoxDimmensions(p_rst->GetBox());
+        Box.SetBoxAngles(p_rst->GetAngles());
+        Box.UpdateBoxMatrices();
+        CPoint angs = Box.GetBoxAngles();
+        if( (angs.x == 90.0) && (angs.y == 90.0) && (angs.z == 90.0) ) {
+            BoxMode = 1;
+        } else {
+            BoxMode = 2;
+        }
+        if( (Cutoff > 0.0) && (Cutoff > Box.GetLargestSphereRadius()) ) {
+            CSmallString error;
+            error << "cutoff (" << Cutoff << ") is larger than the radius of the largest sphere inscribed in the box ("
+                  << Box.GetLargestSphereRadius() << ")";
+            ES_ERROR(error);
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNBEnergy::ImageGeneral(double& dx,double& dy,double& dz)
+{
+    CPoint d(dx,dy,dz);
+    d = Box.ImageVector(d);
+    dx = d.x;
+    dy = d.y;
+    dz = d.z;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNBEnergy::CalculatePairs(void)
+{
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    ThreadMask.assign(nthreads*NumOfAtoms,1.0);
+    ThreadScratch.resize(nthreads*6*NumOfAtoms);
+    ThreadForces.assign(ForcesEnabled ? nthreads*3*NumOfAtoms : 0,0.0);
+    ThreadAtomEEL.assign(DecompositionEnabled ? nthreads*NumOfAtoms : 0,0.0);
+    ThreadAtomVDW.assign(DecompositionEnabled ? nthreads*NumOfAtoms : 0,0.0);
+
+    double cut2 = DBL_MAX;
+    if( Cutoff > 0.0 ) cut2 = Cutoff*Cutoff;
+
+    CPoint dimm = Box.GetBoxDimmensions();
+    double bx = dimm.x;
+    double by = dimm.y;
+    double bz = dimm.z;
+    double rbx = bx > 0.0 ? 1.0/bx : 0.0;
+    double rby = by > 0.0 ? 1.0/by : 0.0;
+    double rbz = bz > 0.0 ? 1.0/bz : 0.0;
+
+    const double*           p_x = X.size() > 0 ? &X[0] : NULL;
+    const double*           p_y = Y.size() > 0 ? &Y[0] : NULL;
+    const double*           p_z = Z.size() > 0 ? &Z[0] : NULL;
+    const double*           p_q = Charges.size() > 0 ? &Charges[0] : NULL;
+    const int*              p_t = Types.size() > 0 ? &Types[0] : NULL;
+    const CAmberNBParams*   p_params = Params.size() > 0 ? &Params[0] : NULL;
+
+    double  tot_eel = 0.0;
+    double  tot_vdw = 0.0;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic,16) num_threads(nthreads) reduction(+:tot_eel,tot_vdw)
+#endif
+    for(int i=0; i < NumOfAtoms; i++) {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        double* p_mask = &ThreadMask[tid*NumOfAtoms];
+        double* p_dx = &ThreadScratch[tid*6*NumOfAtoms];
+        double* p_dy = p_dx + NumOfAtoms;
+        double* p_dz = p_dy + NumOfAtoms;
+        double* p_fs = p_dz + NumOfAtoms;
+        double* p_pe = p_fs + NumOfAtoms;
+        double* p_pv = p_pe + NumOfAtoms;
+
+        double xi = p_x[i];
+        double yi = p_y[i];
+        double zi = p_z[i];
+        double qi = p_q[i];
+        const CAmberNBParams* p_row = &p_params[p_t[i]*NumOfTypes];
+
+        // minimum image differences
+        if( BoxMode == 2 ) {
+            for(int j=i+1; j < NumOfAtoms; j++) {
+                double dx = xi - p_x[j];
+                double dy = yi - p_y[j];
+                double dz = zi - p_z[j];
+                ImageGeneral(dx,dy,dz);
+                p_dx[j] = dx;
+                p_dy[j] = dy;
+                p_dz[j] = dz;
+            }
+        } else if( BoxMode == 1 ) {
+            for(int j=i+1; j < NumOfAtoms; j++) {
+                double dx = xi - p_x[j];
+                double dy = yi - p_y[j];
+                double dz = zi - p_z[j];
+                p_dx[j] = dx - bx*floor(dx*rbx + 0.5);
+                p_dy[j] = dy - by*floor(dy*rby + 0.5);
+                p_dz[j] = dz - bz*floor(dz*rbz + 0.5);
+            }
+        } else {
+            for(int j=i+1; j < NumOfAtoms; j++) {
+                p_dx[j] = xi - p_x[j];
+                p_dy[j] = yi - p_y[j];
+                p_dz[j] = zi - p_z[j];
+            }
+        }
+
+        // mask excluded partners
+        for(int k=ExclusionOffsets[i]; k < ExclusionOffsets[i+1]; k++) {
+            p_mask[ExclusionList[k]] = 0.0;
+        }
+
+        // pair energies
+        double eel = 0.0;
+        double evdw = 0.0;
+
+        AMBER_NB_SIMD_LOOP
+        for(int j=i+1; j < NumOfAtoms; j++) {
+            double r2 = p_dx[j]*p_dx[j] + p_dy[j]*p_dy[j] + p_dz[j]*p_dz[j];
+            double mask = p_mask[j]*(r2 < cut2 ? 1.0 : 0.0);
+            double r2inv = mask / (r2 + (1.0 - mask));   // no division by zero for masked pairs
+            double rinv = sqrt(r2inv);
+            double r6inv = r2inv*r2inv*r2inv;
+            double r10inv = r6inv*r2inv*r2inv;
+            double r12inv = r6inv*r6inv;
+
+            const CAmberNBParams* p_par = &p_row[p_t[j]];
+            double a = p_par->A;
+            double b = p_par->B;
+            double w6 = p_par->Type > 0 ? 1.0 : 0.0;
+            double w10 = p_par->Type < 0 ? 1.0 : 0.0;
+
+            double e_el = qi*p_q[j]*rinv;
+            double e_vdw = a*r12inv - b*(w6*r6inv + w10*r10inv);
+            p_fs[j] = (e_el + 12.0*a*r12inv - b*(6.0*w6*r6inv + 10.0*w10*r10inv))*r2inv;
+            p_pe[j] = e_el;
+            p_pv[j] = e_vdw;
+            eel += e_el;
+            evdw += e_vdw;
+        }
+
+        // restore mask
+        for(int k=ExclusionOffsets[i]; k < ExclusionOffsets[i+1]; k++) {
+            p_mask[ExclusionList[k]] = 1.0;
+        }
+
+        // forces
+        if( ForcesEnabled ) {
+            double* p_f = &ThreadForces[tid*3*NumOfAtoms];
+            double fxi = 0.0;
+            double fyi = 0.0;
+            double fzi = 0.0;
+            for(int j=i+1; j < NumOfAtoms; j++) {
+                double fx = p_fs[j]*p_dx[j];
+                double fy = p_fs[j]*p_dy[j];
+                double fz = p_fs[j]*p_dz[j];
+                fxi += fx;
+                fyi += fy;
+                fzi += fz;
+                p_f[3*j+0] -= fx;
+                p_f[3*j+1] -= fy;
+                p_f[3*j+2] -= fz;
+            }
+            p_f[3*i+0] += fxi;
+            p_f[3*i+1] += fyi;
+            p_f[3*i+2] += fzi;
+        }
+
+        // decomposition - pair energy is split equally
+        if( DecompositionEnabled ) {
+            double* p_aeel = &ThreadAtomEEL[tid*NumOfAtoms];
+            double* p_avdw = &ThreadAtomVDW[tid*NumOfAtoms];
+            for(int j=i+1; j < NumOfAtoms; j++) {
+                p_aeel[j] += 0.5*p_pe[j];
+                p_avdw[j] += 0.5*p_pv[j];
+            }
+            p_aeel[i] += 0.5*eel;
+            p_avdw[i] += 0.5*evdw;
+        }
+
+        tot_eel += eel;
+        tot_vdw += evdw;
+    }
+
+    EEL = tot_eel;
+    VDW = tot_vdw;
+
+    // reduce thread buffers
+    for(int t=0; t < nthreads; t++) {
+        if( ForcesEnabled ) {
+            for(int i=0; i < 3*NumOfAtoms; i++) Forces[i] += ThreadForces[t*3*NumOfAtoms+i];
+        }
+        if( DecompositionEnabled ) {
+            for(int i=0; i < NumOfAtoms; i++) {
+                AtomEEL[i] += ThreadAtomEEL[t*NumOfAtoms+i];
+                AtomVDW[i] += ThreadAtomVDW[t*NumOfAtoms+i];
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNBEnergy::Calculate14Pairs(void)
+{
+    CPoint dimm = Box.GetBoxDimmensions();
+
+    for(unsigned int k=0; k < Pair14I.size(); k++) {
+        int i = Pair14I[k];
+        int j = Pair14J[k];
+
+        double dx = X[i] - X[j];
+        double dy = Y[i] - Y[j];
+        double dz = Z[i] - Z[j];
+        if( BoxMode == 1 ) {
+            dx -= dimm.x*floor(dx/dimm.x + 0.5);
+            dy -= dimm.y*floor(dy/dimm.y + 0.5);
+            dz -= dimm.z*floor(dz/dimm.z + 0.5);
+        } else if( BoxMode == 2 ) {
+            ImageGeneral(dx,dy,dz);
+        }
+        double r2 = dx*dx + dy*dy + dz*dz;
+        if( r2 == 0.0 ) continue;
+        double r2inv = 1.0 / r2;
+        double rinv = sqrt(r2inv);
+        double r6inv = r2inv*r2inv*r2inv;
+        double r12inv = r6inv*r6inv;
+
+        // 1-4 pairs always interact via 12-6 potential
+        const CAmberNBParams* p_par = &Params[Types[i]*NumOfTypes+Types[j]];
+        double a = p_par->Type > 0 ? p_par->A : 0.0;
+        double b = p_par->Type > 0 ? p_par->B : 0.0;
+
+        double e_el = Charges[i]*Charges[j]*rinv*Pair14EELScale[k];
+        double e_vdw = (a*r12inv - b*r6inv)*Pair14VDWScale[k];
+        EEL14 += e_el;
+        VDW14 += e_vdw;
+
+        if( ForcesEnabled ) {
+            double fs = (e_el + (12.0*a*r12inv - 6.0*b*r6inv)*Pair14VDWScale[k])*r2inv;
+            Forces[3*i+0] += fs*dx;
+            Forces[3*i+1] += fs*dy;
+            Forces[3*i+2] += fs*dz;
+            Forces[3*j+0] -= fs*dx;
+            Forces[3*j+1] -= fs*dy;
+            Forces[3*j+2] -= fs*dz;
+        }
+        if( DecompositionEnabled ) {
+            AtomEEL[i] += 0.5*e_el;
+            AtomEEL[j] += 0.5*e_el;
+            AtomVDW[i] += 0.5*e_vdw;
+            AtomVDW[j] += 0.5*e_vdw;
+        }
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+double CAmberNBEnergy::GetEELEnergy(void)
+{
+    return(EEL);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetVDWEnergy(void)
+{
+    return(VDW);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetEEL14Energy(void)
+{
+    return(EEL14);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetVDW14Energy(void)
+{
+    return(VDW14);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetTotalEnergy(void)
+{
+    return(EEL + VDW + EEL14 + VDW14);
+}
+
+//------------------------------------------------------------------------------
+
+const CPoint CAmberNBEnergy::GetForce(int index)
+{
+    CPoint force;
+    if( (index < 0) || (3*index >= (int)Forces.size()) ) return(force);
+    force.x = Forces[3*index+0];
+    force.y = Forces[3*index+1];
+    force.z = Forces[3*index+2];
+    return(force);
+}
+
+//------------------------------------------------------------------------------
+
+const double* CAmberNBEnergy::GetForces(void)
+{
+    if( Forces.size() == 0 ) return(NULL);
+    return(&Forces[0]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetAtomEELEnergy(int index)
+{
+    if( (index < 0) || (index >= (int)AtomEEL.size()) ) return(0.0);
+    return(AtomEEL[index]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetAtomVDWEnergy(int index)
+{
+    if( (index < 0) || (index >= (int)AtomVDW.size()) ) return(0.0);
+    return(AtomVDW[index]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetResidueEELEnergy(int index)
+{
+    if( (index < 0) || (index >= (int)ResidueEEL.size()) ) return(0.0);
+    return(ResidueEEL[index]);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberNBEnergy::GetResidueVDWEnergy(int index)
+{
+    if( (index < 0) || (index >= (int)ResidueVDW.size()) ) return(0.0);
+    return(ResidueVDW[index]);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,170 @@
+#ifndef AmberNBEnergyH
+#define AmberNBEnergyH
+/** \ingroup AmberEnergy*/
+/*! \file AmberNBEnergy.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ASLMainHeader.hpp>
+#include <AmberBox.hpp>
+#include <AmberNonBondedList.hpp>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+class CAmberTopology;
+class CAmberRestart;
+
+//---------------------------------------------------------------------------
+
+/// nonbonded (LJ + Coulomb) energies and forces
+
+class ASL_PACKAGE CAmberNBEnergy {
+public:
+    CAmberNBEnergy(void);
+    ~CAmberNBEnergy(void);
+
+    /// set topology and prepare parameters
+    /*! parameters are copied from topology thus the method must be called
+        again if the topology is modified
+    */
+    bool SetTopology(CAmberTopology* p_topology);
+
+    /// set cutoff in A (zero or negative value means no cutoff)
+    /*! the cutoff is applied to all pairs except 1-4 pairs, interactions
+        are truncated without any smoothing, in periodic systems the cutoff
+        must not exceed the radius of the largest inscribed sphere of the box
+    */
+    void SetCutoff(double cutoff);
+
+    /// get cutoff
+    double GetCutoff(void);
+
+    /// set number of threads used in the calculation
+    void SetNumberOfThreads(int nthreads);
+
+    /// get number of threads used in the calculation
+    int GetNumberOfThreads(void);
+
+    /// enable calculation of forces
+    void SetForcesEnabled(bool set);
+
+    /// enable decomposition of energies into atoms and residues
+    void SetDecompositionEnabled(bool set);
+
+    /// calculate energies of given snapshot
+    /*! periodic boundary conditions (minimum image) are applied if the
+        topology contains a box and the box is present in the snapshot
+    */
+    bool Calculate(CAmberRestart* p_rst);
+
+// results ---------------------------------------------------------------------
+    /// get electrostatic energy (without 1-4 pairs) in kcal/mol
+    double GetEELEnergy(void);
+
+    /// get vdW energy (without 1-4 pairs) in kcal/mol
+    double GetVDWEnergy(void);
+
+    /// get scaled 1-4 electrostatic energy in kcal/mol
+    double GetEEL14Energy(void);
+
+    /// get scaled 1-4 vdW energy in kcal/mol
+    double GetVDW14Energy(void);
+
+    /// get total nonbonded energy in kcal/mol
+    double GetTotalEnergy(void);
+
+    /// get force acting on atom in kcal/mol/A
+    const CPoint GetForce(int index);
+
+    /// get forces - NATOM*3 items (x,y,z for each atom) in kcal/mol/A
+    const double* GetForces(void);
+
+    /// get electrostatic energy of atom (including 1-4 pairs)
+    /*! energy of a pair is split equally between both atoms
+    */
+    double GetAtomEELEnergy(int index);
+
+    /// get vdW energy of atom (including 1-4 pairs)
+    double GetAtomVDWEnergy(int index);
+
+    /// get electrostatic energy of residue (including 1-4 pairs)
+    double GetResidueEELEnergy(int index);
+
+    /// get vdW energy of residue (including 1-4 pairs)
+    double GetResidueVDWEnergy(int index);
+
+// section of private data ----------------------------------------------------
+private:
+    CAmberTopology*         Topology;
+    double                  Cutoff;
+    int                     NumOfThreads;
+    bool                    ForcesEnabled;
+    bool                    DecompositionEnabled;
+
+    // parameters
+    int                     NumOfAtoms;
+    int                     NumOfResidues;
+    int                     NumOfTypes;
+    std::vector<double>     Charges;
+    std::vector<int>        Types;
+    std::vector<int>        Residues;
+    std::vector<CAmberNBParams> Params;
+    std::vector<int>        ExclusionOffsets;
+    std::vector<int>        ExclusionList;      // partners j > i
+    std::vector<int>        Pair14I;
+    std::vector<int>        Pair14J;
+    std::vector<double>     Pair14EELScale;     // 1/SCEE
+    std::vector<double>     Pair14VDWScale;     // 1/SCNB
+
+    // snapshot
+    std::vector<double>     X;
+    std::vector<double>     Y;
+    std::vector<double>     Z;
+    CAmberBox               Box;
+    int                     BoxMode;            // 0 - none, 1 - orthogonal, 2 - general
+
+    // results
+    double                  EEL;
+    double                  VDW;
+    double                  EEL14;
+    double                  VDW14;
+    std::vector<double>     Forces;
+    std::vector<double>     AtomEEL;
+    std::vector<double>     AtomVDW;
+    std::vector<double>     ResidueEEL;
+    std::vector<double>     ResidueVDW;
+
+    // thread buffers
+    std::vector<double>     ThreadMask;
+    std::vector<double>     ThreadScratch;      // dx,dy,dz,fs,eel,evdw for each atom
+    std::vector<double>     ThreadForces;
+    std::vector<double>     ThreadAtomEEL;
+    std::vector<double>     ThreadAtomVDW;
+
+    bool PrepareSnapshot(CAmberRestart* p_rst);
+    void CalculatePairs(void);
+    void Calculate14Pairs(void);
+    void ImageGeneral(double& dx,double& dy,double& dz);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,552 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberCellList.hpp>
+#include <AmberRestart.hpp>
+#include <AmberBox.hpp>
+#include <ErrorSystem.hpp>
+#include <SmallString.hpp>
+#include <math.h>
+#include <float.h>
+#include <string.h>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+// periodic systems: positions are wrapped into the unit cell, which is divided
+// into NCells[0]*NCells[1]*NCells[2] cells along the cell vectors, the number
+// of cells along each vector is chosen so that the perpendicular width of cell
+// is not smaller than cutoff, thus all partners within cutoff are in the 27
+// neighbouring cells (with the periodic shift); for less than three cells
+// along a vector, the same cell is visited with different shifts, but only
+// one image of a pair can be within cutoff, which is not larger than the radius
+// of the largest inscribed sphere
+
+// non-periodic systems: the bounding box is divided into cubic cells with
+// the edge equal to cutoff
+
+#define AMBER_CELL_MAX_CELLS    16777216
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberCellList::CAmberCellList(void)
+{
+    NumOfThreads = 1;
+    Cutoff = 0.0;
+    NumOfAtoms = 0;
+    Periodic = false;
+    NCells[0] = NCells[1] = NCells[2] = 0;
+    NumOfCells = 0;
+    Origin[0] = Origin[1] = Origin[2] = 0.0;
+    CellSize = 0.0;
+    memset(UCELL,0,sizeof(UCELL));
+    memset(RECIP,0,sizeof(RECIP));
+}
+
+//------------------------------------------------------------------------------
+
+CAmberCellList::~CAmberCellList(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberCellList::SetNumberOfThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfThreads = nthreads;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberCellList::GetNumberOfThreads(void)
+{
+    return(NumOfThreads);
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberCellList::GetCutoff(void)
+{
+    return(Cutoff);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCellList::IsPeriodic(void)
+{
+    return(Periodic);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberCellList::GetNumberOfCells(void)
+{
+    return(NumOfCells);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberCellList::Build(CAmberRestart* p_rst,CAmberBox* p_box,double cutoff)
+{
+    NumOfAtoms = 0;
+    NumOfCells = 0;
+
+    if( p_rst == NULL ) {
+        ES_ERROR("snapshot is NULL");
+        return(false);
+    }
+    if( cutoff <= 0.0 ) {
+        ES_ERROR("cutoff must be positive");
+        return(false);
+    }
+
+    Cutoff = cutoff;
+    NumOfAtoms = p_rst->GetNumberOfAtoms();
+    Periodic = (p_box != NULL) && (p_box->GetType() != AMBER_BOX_NONE);
+
+    const double* p_crd = p_rst->GetCoordinatesBuffer();
+    Positions.resize(3*NumOfAtoms);
+
+    if( Periodic ) {
+        if( Cutoff > p_box->Radius ) {
+            CSmallString error;
+            error << "cutoff (" << Cutoff << ") is larger than the radius of the largest sphere inscribed in the box ("
+                  << p_box->Radius << ")";
+            ES_ERROR(error);
+            NumOfAtoms = 0;
+            return(false);
+        }
+        memcpy(UCELL,p_box->UCELL,sizeof(UCELL));
+        memcpy(RECIP,p_box->RECIP,sizeof(RECIP));
+
+        // number of cells - perpendicular width of unit cell is 1/|RECIP[a]|
+        for(int a=0; a < 3; a++) {
+            double rl = sqrt(RECIP[a][0]*RECIP[a][0] + RECIP[a][1]*RECIP[a][1] + RECIP[a][2]*RECIP[a][2]);
+            NCells[a] = (int)floor(1.0/(rl*Cutoff));
+            if( NCells[a] < 1 ) NCells[a] = 1;
+        }
+    } else {
+        double minc[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+        double maxc[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+        for(int i=0; i < NumOfAtoms; i++) {
+            for(int a=0; a < 3; a++) {
+                if( p_crd[3*i+a] < minc[a] ) minc[a] = p_crd[3*i+a];
+                if( p_crd[3*i+a] > maxc[a] ) maxc[a] = p_crd[3*i+a];
+            }
+        }
+        CellSize = Cutoff;
+        for(int a=0; a < 3; a++) {
+            if( NumOfAtoms == 0 ) minc[a] = maxc[a] = 0.0;
+            Origin[a] = minc[a];
+            NCells[a] = (int)floor((maxc[a] - minc[a])/CellSize) + 1;
+        }
+        // limit memory for sparse systems
+        while( (double)NCells[0]*NCells[1]*NCells[2] > AMBER_CELL_MAX_CELLS ) {
+            CellSize *= 2.0;
+            for(int a=0; a < 3; a++) NCells[a] = (int)floor((maxc[a] - minc[a])/CellSize) + 1;
+        }
+    }
+    NumOfCells = NCells[0]*NCells[1]*NCells[2];
+
+    // wrap positions and assign cells
+    AtomCells.resize(NumOfAtoms);
+
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel for num_threads(nthreads)
+#endif
+    for(int i=0; i < NumOfAtoms; i++) {
+        double* p_pos = &Positions[3*i];
+        p_pos[0] = p_crd[3*i+0];
+        p_pos[1] = p_crd[3*i+1];
+        p_pos[2] = p_crd[3*i+2];
+        int cell[3];
+        AtomCells[i] = GetCellIndex(p_pos,cell);
+    }
+
+    // counting sort of atoms by cells
+    CellOffsets.assign(NumOfCells+1,0);
+    for(int i=0; i < NumOfAtoms; i++) CellOffsets[AtomCells[i]+1]++;
+    for(int c=0; c < NumOfCells; c++) CellOffsets[c+1] += CellOffsets[c];
+    CellAtoms.resize(NumOfAtoms);
+    std::vector<int> fill(CellOffsets.begin(),CellOffsets.end()-1);
+    for(int i=0; i < NumOfAtoms; i++) CellAtoms[fill[AtomCells[i]]++] = i;
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberCellList::GetCellIndex(double* p_pos,int* p_cell)
+{
+    // p_pos is wrapped into the unit cell in periodic systems
+
+    if( Periodic ) {
+        double f[3];
+        for(int a=0; a < 3; a++) {
+            f[a] = RECIP[a][0]*p_pos[0] + RECIP[a][1]*p_pos[1] + RECIP[a][2]*p_pos[2];
+            f[a] -= floor(f[a]);
+            p_cell[a] = (int)(f[a]*NCells[a]);
+            if( p_cell[a] >= NCells[a] ) p_cell[a] = NCells[a] - 1;
+            if( p_cell[a] < 0 ) p_cell[a] = 0;
+        }
+        for(int a=0; a < 3; a++) {
+            p_pos[a] = UCELL[a][0]*f[0] + UCELL[a][1]*f[1] + UCELL[a][2]*f[2];
+        }
+    } else {
+        for(int a=0; a < 3; a++) {
+            p_cell[a] = (int)floor((p_pos[a] - Origin[a])/CellSize);
+            // points outside of bounding box are assigned to border cells
+            if( p_cell[a] >= NCells[a] ) p_cell[a] = NCells[a] - 1;
+            if( p_cell[a] < 0 ) p_cell[a] = 0;
+        }
+    }
+
+    return( (p_cell[0]*NCells[1] + p_cell[1])*NCells[2] + p_cell[2] );
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberCellList::GetNeighbourCells(const int* p_cell,int* p_cells,double* p_shifts)
+{
+    int count = 0;
+
+    for(int dx=-1; dx <= 1; dx++) {
+        for(int dy=-1; dy <= 1; dy++) {
+            for(int dz=-1; dz <= 1; dz++) {
+                int     c[3];
+                int     s[3];
+                bool    skip = false;
+                c[0] = p_cell[0] + dx;
+                c[1] = p_cell[1] + dy;
+                c[2] = p_cell[2] + dz;
+                for(int a=0; a < 3; a++) {
+                    s[a] = 0;
+                    if( c[a] < 0 ) {
+                        c[a] += NCells[a];
+                        s[a] = -1;
+                    }
+                    if( c[a] >= NCells[a] ) {
+                        c[a] -= NCells[a];
+                        s[a] = 1;
+                    }
+                    if( (Periodic == false) && (s[a] != 0) ) skip = true;
+                }
+                if( skip ) continue;
+                p_cells[count] = (c[0]*NCells[1] + c[1])*NCells[2] + c[2];
+                for(int a=0; a < 3; a++) {
+                    p_shifts[3*count+a] = UCELL[a][0]*s[0] + UCELL[a][1]*s[1] + UCELL[a][2]*s[2];
+                }
+                count++;
+            }
+        }
+    }
+
+    return(count);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCellList::CheckRadius(double r)
+{
+    if( NumOfCells == 0 ) {
+        ES_ERROR("cell list is not built");
+        return(false);
+    }
+    if( r > Cutoff ) {
+        CSmallString error;
+        error << "radius (" << r << ") is larger than cutoff of cell list (" << Cutoff << ")";
+        ES_ERROR(error);
+        return(false);
+    }
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberCellList::GetPairs(double r,std::vector<int>& ai,std::vector<int>& aj,
+                              std::vector<double>* p_dist,
+                              std::vector<CPoint>* p_diffs)
+{
+    ai.clear();
+    aj.clear();
+    if( p_dist != NULL ) p_dist->clear();
+    if( p_diffs != NULL ) p_diffs->clear();
+
+    if( CheckRadius(r) == false ) return(false);
+
+    double r2 = r*r;
+
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    std::vector< std::vector<int> >     tai(nthreads);
+    std::vector< std::vector<int> >     taj(nthreads);
+    std::vector< std::vector<double> >  tdist(nthreads);
+    std::vector< std::vector<CPoint> >  tdiffs(nthreads);
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+    for(int c=0; c < NumOfCells; c++) {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        if( CellOffsets[c] == CellOffsets[c+1] ) continue;
+
+        int cell[3];
+        cell[0] = c / (NCells[1]*NCells[2]);
+        cell[1] = (c / NCells[2]) % NCells[1];
+        cell[2] = c % NCells[2];
+
+        int     ncells[27];
+        double  shifts[27*3];
+        int     nn = GetNeighbourCells(cell,ncells,shifts);
+
+        for(int k=CellOffsets[c]; k < CellOffsets[c+1]; k++) {
+            int i = CellAtoms[k];
+            const double* p_i = &Positions[3*i];
+            for(int n=0; n < nn; n++) {
+                int d = ncells[n];
+                for(int l=CellOffsets[d]; l < CellOffsets[d+1]; l++) {
+                    int j = CellAtoms[l];
+                    if( j <= i ) continue;
+                    double dx = Positions[3*j+0] + shifts[3*n+0] - p_i[0];
+                    double dy = Positions[3*j+1] + shifts[3*n+1] - p_i[1];
+                    double dz = Positions[3*j+2] + shifts[3*n+2] - p_i[2];
+                    double d2 = dx*dx + dy*dy + dz*dz;
+                    if( d2 > r2 ) continue;
+                    tai[tid].push_back(i);
+                    taj[tid].push_back(j);
+                    if( p_dist != NULL ) tdist[tid].push_back(sqrt(d2));
+                    if( p_diffs != NULL ) tdiffs[tid].push_back(CPoint(dx,dy,dz));
+                }
+            }
+        }
+    }
+
+    // merge in thread order (static schedule keeps the order deterministic)
+    for(int t=0; t < nthreads; t++) {
+        ai.insert(ai.end(),tai[t].begin(),tai[t].end());
+        aj.insert(aj.end(),taj[t].begin(),taj[t].end());
+        if( p_dist != NULL ) p_dist->insert(p_dist->end(),tdist[t].begin(),tdist[t].end());
+        if( p_diffs != NULL ) p_diffs->insert(p_diffs->end(),tdiffs[t].begin(),tdiffs[t].end());
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCellList::GetNeighbours(int atom,double r,std::vector<int>& list)
+{
+    list.clear();
+
+    if( CheckRadius(r) == false ) return(false);
+    if( (atom < 0) || (atom >= NumOfAtoms) ) {
+        ES_ERROR("atom index out of range");
+        return(false);
+    }
+
+    CPoint pos(Positions[3*atom+0],Positions[3*atom+1],Positions[3*atom+2]);
+    if( GetAtomsAroundPoint(pos,r,list) == false ) return(false);
+
+    std::vector<int>::iterator it = std::lower_bound(list.begin(),list.end(),atom);
+    if( (it != list.end()) && (*it == atom) ) list.erase(it);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCellList::GetAtomsAroundPoint(const CPoint& pos,double r,std::vector<int>& list)
+{
+    list.clear();
+
+    if( CheckRadius(r) == false ) return(false);
+
+    double r2 = r*r;
+    double p[3];
+    p[0] = pos.x;
+    p[1] = pos.y;
+    p[2] = pos.z;
+
+    int cell[3];
+    GetCellIndex(p,cell);
+
+    int     ncells[27];
+    double  shifts[27*3];
+    int     nn = GetNeighbourCells(cell,ncells,shifts);
+
+    for(int n=0; n < nn; n++) {
+        int d = ncells[n];
+        for(int l=CellOffsets[d]; l < CellOffsets[d+1]; l++) {
+            int j = CellAtoms[l];
+            double dx = Positions[3*j+0] + shifts[3*n+0] - p[0];
+            double dy = Positions[3*j+1] + shifts[3*n+1] - p[1];
+            double dz = Positions[3*j+2] + shifts[3*n+2] - p[2];
+            if( dx*dx + dy*dy + dz*dz <= r2 ) list.push_back(j);
+        }
+    }
+
+    std::sort(list.begin(),list.end());
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCellList::GetAtomsAroundSet(const std::vector<int>& set,double r,std::vector<int>& list,
+                                       bool strict)
+{
+    list.clear();
+
+    if( CheckRadius(r) == false ) return(false);
+
+    double r2 = r*r;
+
+    std::vector<char> inset(NumOfAtoms,0);
+    for(unsigned int k=0; k < set.size(); k++) {
+        if( (set[k] < 0) || (set[k] >= NumOfAtoms) ) {
+            ES_ERROR("atom index out of range");
+            return(false);
+        }
+        inset[set[k]] = 1;
+    }
+
+    std::vector<char> selected(NumOfAtoms,0);
+
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+#endif
+
+    // each atom is tested independently - no write conflicts
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+    for(int c=0; c < NumOfCells; c++) {
+        if( CellOffsets[c] == CellOffsets[c+1] ) continue;
+
+        int cell[3];
+        cell[0] = c / (NCells[1]*NCells[2]);
+        cell[1] = (c / NCells[2]) % NCells[1];
+        cell[2] = c % NCells[2];
+
+        int     ncells[27];
+        double  shifts[27*3];
+        int     nn = GetNeighbourCells(cell,ncells,shifts);
+
+        for(int k=CellOffsets[c]; k < CellOffsets[c+1]; k++) {
+            int i = CellAtoms[k];
+            if( inset[i] ) {
+                selected[i] = 1;
+                continue;
+            }
+            const double* p_i = &Positions[3*i];
+            for(int n=0; (n < nn) && (selected[i] == 0); n++) {
+                int d = ncells[n];
+                for(int l=CellOffsets[d]; l < CellOffsets[d+1]; l++) {
+                    int j = CellAtoms[l];
+                    if( inset[j] == 0 ) continue;
+                    double dx = Positions[3*j+0] + shifts[3*n+0] - p_i[0];
+                    double dy = Positions[3*j+1] + shifts[3*n+1] - p_i[1];
+                    double dz = Positions[3*j+2] + shifts[3*n+2] - p_i[2];
+                    double d2 = dx*dx + dy*dy + dz*dz;
+                    if( (d2 < r2) || ((strict == false) && (d2 == r2)) ) {
+                        selected[i] = 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for(int i=0; i < NumOfAtoms; i++) {
+        if( selected[i] ) list.push_back(i);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+const CPoint CAmberCellList::GetDifference(int ai,int aj)
+{
+    CPoint d;
+    if( (ai < 0) || (ai >= NumOfAtoms) || (aj < 0) || (aj >= NumOfAtoms) ) return(d);
+
+    double v[3];
+    for(int a=0; a < 3; a++) v[a] = Positions[3*aj+a] - Positions[3*ai+a];
+
+    if( Periodic ) {
+        // nearest image - the wrapped vector is the minimum image if it is
+        // shorter than the radius of the largest inscribed sphere, otherwise
+        // neighbouring images are tested
+        double f[3];
+        for(int a=0; a < 3; a++) {
+            f[a] = RECIP[a][0]*v[0] + RECIP[a][1]*v[1] + RECIP[a][2]*v[2];
+            f[a] -= floor(f[a] + 0.5);
+        }
+        double best = DBL_MAX;
+        for(int sx=-1; sx <= 1; sx++) {
+            for(int sy=-1; sy <= 1; sy++) {
+                for(int sz=-1; sz <= 1; sz++) {
+                    double g[3] = { f[0]+sx, f[1]+sy, f[2]+sz };
+                    double c[3];
+                    for(int a=0; a < 3; a++) c[a] = UCELL[a][0]*g[0] + UCELL[a][1]*g[1] + UCELL[a][2]*g[2];
+                    double d2 = c[0]*c[0] + c[1]*c[1] + c[2]*c[2];
+                    if( d2 < best ) {
+                        best = d2;
+                        d.x = c[0];
+                        d.y = c[1];
+                        d.z = c[2];
+                    }
+                }
+            }
+        }
+    } else {
+        d.x = v[0];
+        d.y = v[1];
+        d.z = v[2];
+    }
+
+    return(d);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,121 @@
+#ifndef AmberCellListH
+#define AmberCellListH
+/** \ingroup AmberGeometry*/
+/*! \file AmberCellList.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ASLMainHeader.hpp>
+#include <Point.hpp>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+class CAmberRestart;
+class CAmberBox;
+
+//---------------------------------------------------------------------------
+
+/// linked-cell neighbour search
+
+class ASL_PACKAGE CAmberCellList {
+public:
+    CAmberCellList(void);
+    ~CAmberCellList(void);
+
+    /// build cell list for snapshot
+    /*! if p_box is NULL or its type is AMBER_BOX_NONE, the system is not
+        periodic, otherwise minimum image convention is applied via the box
+        matrices (UpdateBoxMatrices must be called in advance, any triclinic
+        box including the truncated octahedron is supported), cutoff is the
+        maximum radius of subsequent queries, in periodic systems it must not
+        exceed the radius of the largest sphere inscribed in the box
+    */
+    bool Build(CAmberRestart* p_rst,CAmberBox* p_box,double cutoff);
+
+    /// set number of threads used in queries
+    void SetNumberOfThreads(int nthreads);
+
+    /// get number of threads used in queries
+    int GetNumberOfThreads(void);
+
+    /// get cutoff
+    double GetCutoff(void);
+
+    /// is the system periodic?
+    bool IsPeriodic(void);
+
+    /// get number of cells
+    int GetNumberOfCells(void);
+
+    /// return all pairs ai < aj within radius r (r <= cutoff)
+    /*! p_dist (if not NULL) receives distances of the pairs,
+        p_diffs (if not NULL) receives minimum image vectors pos(aj)-pos(ai)
+    */
+    bool GetPairs(double r,std::vector<int>& ai,std::vector<int>& aj,
+                  std::vector<double>* p_dist=NULL,
+                  std::vector<CPoint>* p_diffs=NULL);
+
+    /// return sorted list of atoms within radius r of atom (atom is not included)
+    bool GetNeighbours(int atom,double r,std::vector<int>& list);
+
+    /// return sorted list of atoms within radius r of point
+    bool GetAtomsAroundPoint(const CPoint& pos,double r,std::vector<int>& list);
+
+    /// return sorted list of atoms within radius r of any atom from set
+    /*! set atoms are included as well, if strict is true, distance must be
+        smaller than r (otherwise smaller or equal)
+    */
+    bool GetAtomsAroundSet(const std::vector<int>& set,double r,std::vector<int>& list,
+                           bool strict=false);
+
+    /// return minimum image difference vector pos(aj)-pos(ai)
+    const CPoint GetDifference(int ai,int aj);
+
+// section of private data ----------------------------------------------------
+private:
+    int                     NumOfThreads;
+    double                  Cutoff;
+    int                     NumOfAtoms;
+    bool                    Periodic;
+    int                     NCells[3];
+    int                     NumOfCells;
+
+    // non-periodic grid
+    double                  Origin[3];
+    double                  CellSize;
+
+    // periodic cell
+    double                  UCELL[3][3];
+    double                  RECIP[3][3];
+
+    std::vector<double>     Positions;      // wrapped positions (x,y,z for each atom)
+    std::vector<int>        AtomCells;      // cell of each atom
+    std::vector<int>        CellOffsets;    // NumOfCells+1 items
+    std::vector<int>        CellAtoms;      // atoms sorted by cells
+
+    int  GetCellIndex(double* p_pos,int* p_cell);
+    int  GetNeighbourCells(const int* p_cell,int* p_cells,double* p_shifts);
+    bool CheckRadius(double r);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
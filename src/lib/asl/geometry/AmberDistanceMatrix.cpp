@@ -0,0 +1,396 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberDistanceMatrix.hpp>
+#include <AmberRestart.hpp>
+#include <AmberBox.hpp>
+#include <ErrorSystem.hpp>
+#include <math.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+// tile sizes - B tile (SoA coordinates) fits into L1/L2 cache
+#define AMBER_DM_TILE_A     32
+#define AMBER_DM_TILE_B     1024
+
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#define AMBER_DM_SIMD_LOOP  _Pragma("omp simd")
+#else
+#define AMBER_DM_SIMD_LOOP
+#endif
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberDistanceMatrix::CAmberDistanceMatrix(void)
+{
+    NumOfThreads = 1;
+    BoxMode = 0;
+    memset(UCELL,0,sizeof(UCELL));
+    Lengths[0] = Lengths[1] = Lengths[2] = 0.0;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberDistanceMatrix::~CAmberDistanceMatrix(void)
+{
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberDistanceMatrix::SetNumberOfThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfThreads = nthreads;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberDistanceMatrix::GetNumberOfThreads(void)
+{
+    return(NumOfThreads);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberDistanceMatrix::Prepare(CAmberRestart* p_rst,CAmberBox* p_box,
+                                   const std::vector<int>& seta,const std::vector<int>& setb)
+{
+    if( p_rst == NULL ) {
+        ES_ERROR("snapshot is NULL");
+        return(false);
+    }
+
+    int natoms = p_rst->GetNumberOfAtoms();
+    for(unsigned int i=0; i < seta.size(); i++) {
+        if( (seta[i] < 0) || (seta[i] >= natoms) ) {
+            ES_ERROR("atom index in set A out of range");
+            return(false);
+        }
+    }
+    for(unsigned int i=0; i < setb.size(); i++) {
+        if( (setb[i] < 0) || (setb[i] >= natoms) ) {
+            ES_ERROR("atom index in set B out of range");
+            return(false);
+        }
+    }
+
+    BoxMode = 0;
+    double recip[3][3];
+    memset(recip,0,sizeof(recip));
+    if( (p_box != NULL) && (p_box->GetType() == AMBER_BOX_STANDARD) ) {
+        BoxMode = 1;
+        for(int a=0; a < 3; a++) Lengths[a] = p_box->UCELL[a][a];
+    }
+    if( (p_box != NULL) && (p_box->GetType() == AMBER_BOX_OCTAHEDRAL) ) {
+        BoxMode = 2;
+        memcpy(UCELL,p_box->UCELL,sizeof(UCELL));
+        memcpy(recip,p_box->RECIP,sizeof(recip));
+    }
+
+    // gather coordinates, fractional ones for general box
+    const double* p_crd = p_rst->GetCoordinatesBuffer();
+    int na = seta.size();
+    int nb = setb.size();
+    AX.resize(na);
+    AY.resize(na);
+    AZ.resize(na);
+    BX.resize(nb);
+    BY.resize(nb);
+    BZ.resize(nb);
+
+    for(int s=0; s < 2; s++) {
+        const std::vector<int>& set = s == 0 ? seta : setb;
+        std::vector<double>&    x = s == 0 ? AX : BX;
+        std::vector<double>&    y = s == 0 ? AY : BY;
+        std::vector<double>&    z = s == 0 ? AZ : BZ;
+        for(unsigned int i=0; i < set.size(); i++) {
+            const double* p_pos = p_crd + 3*set[i];
+            if( BoxMode == 2 ) {
+                x[i] = recip[0][0]*p_pos[0] + recip[0][1]*p_pos[1] + recip[0][2]*p_pos[2];
+                y[i] = recip[1][0]*p_pos[0] + recip[1][1]*p_pos[1] + recip[1][2]*p_pos[2];
+                z[i] = recip[2][0]*p_pos[0] + recip[2][1]*p_pos[1] + recip[2][2]*p_pos[2];
+            } else {
+                x[i] = p_pos[0];
+                y[i] = p_pos[1];
+                z[i] = p_pos[2];
+            }
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberDistanceMatrix::CalculateRow(int i,int jstart,int jend,double* p_row)
+{
+    const double* p_bx = &BX[0];
+    const double* p_by = &BY[0];
+    const double* p_bz = &BZ[0];
+    double        ax = AX[i];
+    double        ay = AY[i];
+    double        az = AZ[i];
+
+    switch(BoxMode) {
+    default:
+    case 0: {
+        AMBER_DM_SIMD_LOOP
+        for(int j=jstart; j < jend; j++) {
+            double dx = p_bx[j] - ax;
+            double dy = p_by[j] - ay;
+            double dz = p_bz[j] - az;
+            p_row[j-jstart] = sqrt(dx*dx + dy*dy + dz*dz);
+        }
+    }
+    break;
+
+    case 1: {
+        double lx = Lengths[0], ly = Lengths[1], lz = Lengths[2];
+        double rx = 1.0/lx, ry = 1.0/ly, rz = 1.0/lz;
+        AMBER_DM_SIMD_LOOP
+        for(int j=jstart; j < jend; j++) {
+            double dx = p_bx[j] - ax;
+            double dy = p_by[j] - ay;
+            double dz = p_bz[j] - az;
+            dx -= lx*floor(dx*rx + 0.5);
+            dy -= ly*floor(dy*ry + 0.5);
+            dz -= lz*floor(dz*rz + 0.5);
+            p_row[j-jstart] = sqrt(dx*dx + dy*dy + dz*dz);
+        }
+    }
+    break;
+
+    case 2: {
+        double u00 = UCELL[0][0], u01 = UCELL[0][1], u02 = UCELL[0][2];
+        double u10 = UCELL[1][0], u11 = UCELL[1][1], u12 = UCELL[1][2];
+        double u20 = UCELL[2][0], u21 = UCELL[2][1], u22 = UCELL[2][2];
+        double cx[AMBER_DM_TILE_B];
+        double cy[AMBER_DM_TILE_B];
+        double cz[AMBER_DM_TILE_B];
+        int    n = jend - jstart;
+
+        // fractional difference is reduced into the parallelepiped centred
+        // at origin, the shortest image is then among it and its 26 neighbours
+        AMBER_DM_SIMD_LOOP
+        for(int j=0; j < n; j++) {
+            double gx = p_bx[jstart+j] - ax;
+            double gy = p_by[jstart+j] - ay;
+            double gz = p_bz[jstart+j] - az;
+            gx -= floor(gx + 0.5);
+            gy -= floor(gy + 0.5);
+            gz -= floor(gz + 0.5);
+            cx[j] = gx*u00 + gy*u01 + gz*u02;
+            cy[j] = gx*u10 + gy*u11 + gz*u12;
+            cz[j] = gx*u20 + gy*u21 + gz*u22;
+            p_row[j] = cx[j]*cx[j] + cy[j]*cy[j] + cz[j]*cz[j];
+        }
+
+        // one pass over the tile for each neighbouring image
+        for(int lx=-1; lx <= 1; lx++) {
+            for(int ly=-1; ly <= 1; ly++) {
+                for(int lz=-1; lz <= 1; lz++) {
+                    if( (lx == 0) && (ly == 0) && (lz == 0) ) continue;
+                    double sx = lx*u00 + ly*u01 + lz*u02;
+                    double sy = lx*u10 + ly*u11 + lz*u12;
+                    double sz = lx*u20 + ly*u21 + lz*u22;
+                    AMBER_DM_SIMD_LOOP
+                    for(int j=0; j < n; j++) {
+                        double px = cx[j] + sx;
+                        double py = cy[j] + sy;
+                        double pz = cz[j] + sz;
+                        double ds = px*px + py*py + pz*pz;
+                        p_row[j] = ds < p_row[j] ? ds : p_row[j];
+                    }
+                }
+            }
+        }
+
+        AMBER_DM_SIMD_LOOP
+        for(int j=0; j < n; j++) {
+            p_row[j] = sqrt(p_row[j]);
+        }
+    }
+    break;
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberDistanceMatrix::CalculateMatrix(CAmberRestart* p_rst,CAmberBox* p_box,
+                                           const std::vector<int>& seta,const std::vector<int>& setb,
+                                           double* p_matrix)
+{
+    if( Prepare(p_rst,p_box,seta,setb) == false ) return(false);
+    if( p_matrix == NULL ) {
+        ES_ERROR("matrix is NULL");
+        return(false);
+    }
+
+    int na = seta.size();
+    int nb = setb.size();
+    int nta = (na + AMBER_DM_TILE_A - 1) / AMBER_DM_TILE_A;
+    int ntb = (nb + AMBER_DM_TILE_B - 1) / AMBER_DM_TILE_B;
+
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+    for(int t=0; t < nta*ntb; t++) {
+        int ta = t / ntb;
+        int tb = t % ntb;
+        int iend = (ta+1)*AMBER_DM_TILE_A < na ? (ta+1)*AMBER_DM_TILE_A : na;
+        int jstart = tb*AMBER_DM_TILE_B;
+        int jend = jstart + AMBER_DM_TILE_B < nb ? jstart + AMBER_DM_TILE_B : nb;
+        for(int i=ta*AMBER_DM_TILE_A; i < iend; i++) {
+            CalculateRow(i,jstart,jend,p_matrix + (size_t)i*nb + jstart);
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberDistanceMatrix::CalculateMatrix(CAmberRestart* p_rst,CAmberBox* p_box,
+                                           const std::vector<int>& seta,const std::vector<int>& setb,
+                                           float* p_matrix)
+{
+    if( Prepare(p_rst,p_box,seta,setb) == false ) return(false);
+    if( p_matrix == NULL ) {
+        ES_ERROR("matrix is NULL");
+        return(false);
+    }
+
+    int na = seta.size();
+    int nb = setb.size();
+    int nta = (na + AMBER_DM_TILE_A - 1) / AMBER_DM_TILE_A;
+    int ntb = (nb + AMBER_DM_TILE_B - 1) / AMBER_DM_TILE_B;
+
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel num_threads(nthreads)
+#endif
+    {
+        double row[AMBER_DM_TILE_B];
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for(int t=0; t < nta*ntb; t++) {
+            int ta = t / ntb;
+            int tb = t % ntb;
+            int iend = (ta+1)*AMBER_DM_TILE_A < na ? (ta+1)*AMBER_DM_TILE_A : na;
+            int jstart = tb*AMBER_DM_TILE_B;
+            int jend = jstart + AMBER_DM_TILE_B < nb ? jstart + AMBER_DM_TILE_B : nb;
+            for(int i=ta*AMBER_DM_TILE_A; i < iend; i++) {
+                CalculateRow(i,jstart,jend,row);
+                float* p_out = p_matrix + (size_t)i*nb + jstart;
+                for(int j=0; j < jend-jstart; j++) p_out[j] = row[j];
+            }
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberDistanceMatrix::CalculateContacts(CAmberRestart* p_rst,CAmberBox* p_box,
+                                             const std::vector<int>& seta,const std::vector<int>& setb,
+                                             double threshold,std::vector<int>& ia,std::vector<int>& ib,
+                                             std::vector<float>* p_dist,bool skip_same)
+{
+    ia.clear();
+    ib.clear();
+    if( p_dist != NULL ) p_dist->clear();
+
+    if( Prepare(p_rst,p_box,seta,setb) == false ) return(false);
+
+    int na = seta.size();
+    int nb = setb.size();
+    int nta = (na + AMBER_DM_TILE_A - 1) / AMBER_DM_TILE_A;
+    int ntb = (nb + AMBER_DM_TILE_B - 1) / AMBER_DM_TILE_B;
+
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    std::vector< std::vector<int> >     tia(nthreads);
+    std::vector< std::vector<int> >     tib(nthreads);
+    std::vector< std::vector<float> >   tdist(nthreads);
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(nthreads)
+#endif
+    {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        double row[AMBER_DM_TILE_B];
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for(int t=0; t < nta*ntb; t++) {
+            int ta = t / ntb;
+            int tb = t % ntb;
+            int iend = (ta+1)*AMBER_DM_TILE_A < na ? (ta+1)*AMBER_DM_TILE_A : na;
+            int jstart = tb*AMBER_DM_TILE_B;
+            int jend = jstart + AMBER_DM_TILE_B < nb ? jstart + AMBER_DM_TILE_B : nb;
+            for(int i=ta*AMBER_DM_TILE_A; i < iend; i++) {
+                CalculateRow(i,jstart,jend,row);
+                for(int j=jstart; j < jend; j++) {
+                    if( row[j-jstart] > threshold ) continue;
+                    if( skip_same && (seta[i] == setb[j]) ) continue;
+                    tia[tid].push_back(i);
+                    tib[tid].push_back(j);
+                    if( p_dist != NULL ) tdist[tid].push_back(row[j-jstart]);
+                }
+            }
+        }
+    }
+
+    // static schedule - threads own consecutive tiles
+    for(int t=0; t < nthreads; t++) {
+        ia.insert(ia.end(),tia[t].begin(),tia[t].end());
+        ib.insert(ib.end(),tib[t].begin(),tib[t].end());
+        if( p_dist != NULL ) p_dist->insert(p_dist->end(),tdist[t].begin(),tdist[t].end());
+    }
+
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,98 @@
+#ifndef AmberDistanceMatrixH
+#define AmberDistanceMatrixH
+/** \ingroup AmberGeometry*/
+/*! \file AmberDistanceMatrix.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+#include <ASLMainHeader.hpp>
+#include <stddef.h>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+class CAmberRestart;
+class CAmberBox;
+
+//---------------------------------------------------------------------------
+
+/// tiled minimum image distance matrix
+
+/*! distances are calculated between atoms of set A and set B (full matrix is
+    obtained if both sets contain all atoms), sets are blocked into tiles that
+    fit into cache, tiles are distributed over threads and the inner loop is
+    vectorized, if p_box is NULL or its type is AMBER_BOX_NONE, the system
+    is not periodic, otherwise minimum image convention is applied
+    (UpdateBoxMatrices must be called in advance)
+*/
+
+class ASL_PACKAGE CAmberDistanceMatrix {
+public:
+    CAmberDistanceMatrix(void);
+    ~CAmberDistanceMatrix(void);
+
+    /// set number of threads
+    void SetNumberOfThreads(int nthreads);
+
+    /// get number of threads
+    int GetNumberOfThreads(void);
+
+    /// calculate dense matrix
+    /*! p_matrix must have seta.size()*setb.size() items, it is stored by rows
+        (distance between seta[i] and setb[j] is at p_matrix[i*setb.size()+j])
+    */
+    bool CalculateMatrix(CAmberRestart* p_rst,CAmberBox* p_box,
+                         const std::vector<int>& seta,const std::vector<int>& setb,
+                         double* p_matrix);
+
+    /// calculate dense matrix in single precision
+    bool CalculateMatrix(CAmberRestart* p_rst,CAmberBox* p_box,
+                         const std::vector<int>& seta,const std::vector<int>& setb,
+                         float* p_matrix);
+
+    /// calculate sparse contacts
+    /*! pairs with distance not larger than threshold are returned as indexes
+        into seta (ia) and setb (ib), pairs are ordered by tiles, p_dist
+        (if not NULL) receives distances, if skip_same is true, pairs formed
+        by the same atom are not returned
+    */
+    bool CalculateContacts(CAmberRestart* p_rst,CAmberBox* p_box,
+                           const std::vector<int>& seta,const std::vector<int>& setb,
+                           double threshold,std::vector<int>& ia,std::vector<int>& ib,
+                           std::vector<float>* p_dist=NULL,bool skip_same=true);
+
+// section of private data ----------------------------------------------------
+private:
+    int                     NumOfThreads;
+    int                     BoxMode;        // 0 - none, 1 - orthorhombic, 2 - general
+    double                  UCELL[3][3];
+    double                  Lengths[3];
+
+    // coordinates of sets (SoA), fractional for general box
+    std::vector<double>     AX,AY,AZ;
+    std::vector<double>     BX,BY,BZ;
+
+    bool Prepare(CAmberRestart* p_rst,CAmberBox* p_box,
+                 const std::vector<int>& seta,const std::vector<int>& setb);
+    void CalculateRow(int i,int jstart,int jend,double* p_row);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,452 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberImaging.hpp>
+#include <AmberTopology.hpp>
+#include <AmberRestart.hpp>
+#include <AmberMaskAtoms.hpp>
+#include <ErrorSystem.hpp>
+#include <SmallString.hpp>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberImaging::CAmberImaging(void)
+{
+    Topology = NULL;
+    NumOfThreads = 1;
+    OriginMode = false;
+    NumOfAtoms = 0;
+    NumOfMolecules = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberImaging::~CAmberImaging(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberImaging::SetTopology(CAmberTopology* p_top)
+{
+    Topology = p_top;
+    NumOfAtoms = 0;
+    NumOfMolecules = 0;
+    MolOffsets.clear();
+    MolAtoms.clear();
+    Parents.clear();
+    Masses.clear();
+    MolMasses.clear();
+    CentreAtoms.clear();
+    RefComs.clear();
+
+    if( Topology == NULL ) return(true);
+
+    if( (Topology->GetLoadedParts() & (AMBER_LOAD_ATOMS | AMBER_LOAD_BONDED | AMBER_LOAD_BOX))
+                                   != (AMBER_LOAD_ATOMS | AMBER_LOAD_BONDED | AMBER_LOAD_BOX) ) {
+        ES_ERROR("atoms, bonded terms and box must be loaded");
+        Topology = NULL;
+        return(false);
+    }
+
+    Box = Topology->BoxInfo;
+    NumOfAtoms = Topology->AtomList.GetNumberOfAtoms();
+    if( NumOfAtoms == 0 ) return(true);
+
+    if( Topology->GetNumberOfMolecules() == 0 ) {
+        if( Topology->InitMoleculeIndexes() == false ) {
+            ES_ERROR("unable to init molecule indexes");
+            Topology = NULL;
+            return(false);
+        }
+    }
+    NumOfMolecules = Topology->GetNumberOfMolecules();
+
+    // masses
+    const double* p_masses = Topology->AtomList.GetMassArray();
+    Masses.assign(p_masses,p_masses+NumOfAtoms);
+
+    // molecule of each atom - molecules are numbered by their first atoms
+    std::vector<int>    first_atoms(NumOfMolecules);
+    for(int m=0; m < NumOfMolecules; m++) {
+        first_atoms[m] = Topology->GetMoleculeFirstAtom(m);
+    }
+    MolOffsets.assign(NumOfMolecules+1,0);
+    for(int m=0; m < NumOfMolecules; m++) {
+        MolOffsets[m+1] = MolOffsets[m] + Topology->GetMoleculeNumberOfAtoms(m);
+    }
+
+    // bond walk (breadth-first) from the first atom of each molecule,
+    // atoms of the same molecule unreachable by bonds (see InitMoleculeIndexes)
+    // start a new walk with the first atom of molecule as a parent
+    MolAtoms.resize(NumOfAtoms);
+    Parents.assign(NumOfAtoms,-1);
+    std::vector<int>    fill(MolOffsets.begin(),MolOffsets.end()-1);
+    std::vector<char>   visited(NumOfAtoms,0);
+    const int*          p_molidx = Topology->AtomList.GetMoleculeIndexArray();
+    std::vector<int>    mol_by_index;   // MoleculeIndex -> molecule
+
+    for(int m=0; m < NumOfMolecules; m++) {
+        int idx = p_molidx[first_atoms[m]];
+        if( idx >= (int)mol_by_index.size() ) mol_by_index.resize(idx+1,-1);
+        mol_by_index[idx] = m;
+    }
+
+    for(int i=0; i < NumOfAtoms; i++) {
+        if( visited[i] ) continue;
+        int m = mol_by_index[p_molidx[i]];
+        int first = first_atoms[m];
+        if( i != first ) Parents[i] = first;
+
+        int start = fill[m];
+        MolAtoms[fill[m]++] = i;
+        visited[i] = 1;
+
+        for(int k=start; k < fill[m]; k++) {
+            int ai = MolAtoms[k];
+            int count = 0;
+            const int* p_neighs = Topology->GetNeighbourAtoms(ai,count);
+            for(int n=0; n < count; n++) {
+                int aj = p_neighs[n];
+                if( visited[aj] ) continue;
+                visited[aj] = 1;
+                Parents[aj] = ai;
+                MolAtoms[fill[m]++] = aj;
+            }
+        }
+    }
+
+    // molecule masses
+    MolMasses.assign(NumOfMolecules,0.0);
+    for(int m=0; m < NumOfMolecules; m++) {
+        for(int k=MolOffsets[m]; k < MolOffsets[m+1]; k++) {
+            MolMasses[m] += Masses[MolAtoms[k]];
+        }
+    }
+
+    Diffs.resize(3*NumOfAtoms);
+    Coms.resize(3*NumOfMolecules);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberImaging::SetNumberOfThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfThreads = nthreads;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberImaging::GetNumberOfThreads(void)
+{
+    return(NumOfThreads);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberImaging::SetCentreMask(CAmberMaskAtoms* p_mask)
+{
+    CentreAtoms.clear();
+    if( p_mask == NULL ) return(true);
+
+    if( p_mask->GetNumberOfTopologyAtoms() != NumOfAtoms ) {
+        ES_ERROR("mask and topology do not match");
+        return(false);
+    }
+    for(int i=0; i < NumOfAtoms; i++) {
+        if( p_mask->IsAtomSelected(i) ) CentreAtoms.push_back(i);
+    }
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberImaging::SetOriginMode(bool origin)
+{
+    OriginMode = origin;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberImaging::GetNumberOfMolecules(void)
+{
+    return(NumOfMolecules);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberImaging::ResetUnwrap(void)
+{
+    RefComs.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberImaging::PrepareBox(CAmberRestart* p_rst)
+{
+    if( Topology == NULL ) {
+        ES_ERROR("topology is not set");
+        return(false);
+    }
+    if( p_rst == NULL ) {
+        ES_ERROR("snapshot is NULL");
+        return(false);
+    }
+    if( p_rst->GetNumberOfAtoms() != NumOfAtoms ) {
+        ES_ERROR("snapshot and topology do not match");
+        return(false);
+    }
+    if( Box.GetType() == AMBER_BOX_NONE ) {
+        ES_ERROR("system is not periodic");
+        return(false);
+    }
+
+    // box can change during NPT simulations
+    if( p_rst->IsBoxPresent() ) {
+        Box.SetBoxDimmensions(p_rst->GetBox());
+        Box.SetBoxAngles(p_rst->GetAngles());
+    }
+    Box.UpdateBoxMatrices();
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberImaging::MakeMoleculesWhole(CAmberRestart* p_rst)
+{
+    if( PrepareBox(p_rst) == false ) return(false);
+
+    double* p_crd = p_rst->GetCoordinatesBuffer();
+
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    // bond vectors (to parents) are independent - image them in bulk
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads)
+#endif
+    for(int i=0; i < NumOfAtoms; i++) {
+        int p = Parents[i];
+        if( p < 0 ) {
+            Diffs[3*i+0] = Diffs[3*i+1] = Diffs[3*i+2] = 0.0;
+        } else {
+            Diffs[3*i+0] = p_crd[3*i+0] - p_crd[3*p+0];
+            Diffs[3*i+1] = p_crd[3*i+1] - p_crd[3*p+1];
+            Diffs[3*i+2] = p_crd[3*i+2] - p_crd[3*p+2];
+        }
+    }
+
+    Box.ImageVectors(&Diffs[0],NumOfAtoms,nthreads);
+
+    // rebuild molecules along the bond walk, parents precede children
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic,16) num_threads(nthreads)
+#endif
+    for(int m=0; m < NumOfMolecules; m++) {
+        for(int k=MolOffsets[m]; k < MolOffsets[m+1]; k++) {
+            int i = MolAtoms[k];
+            int p = Parents[i];
+            if( p < 0 ) continue;
+            p_crd[3*i+0] = p_crd[3*p+0] + Diffs[3*i+0];
+            p_crd[3*i+1] = p_crd[3*p+1] + Diffs[3*i+1];
+            p_crd[3*i+2] = p_crd[3*p+2] + Diffs[3*i+2];
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberImaging::CalculateComs(const double* p_crd)
+{
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel for schedule(dynamic,16) num_threads(nthreads)
+#endif
+    for(int m=0; m < NumOfMolecules; m++) {
+        double x = 0.0, y = 0.0, z = 0.0, w = 0.0;
+        bool   geo = MolMasses[m] <= 0.0;   // geometric centre for massless molecules
+        for(int k=MolOffsets[m]; k < MolOffsets[m+1]; k++) {
+            int i = MolAtoms[k];
+            double mass = geo ? 1.0 : Masses[i];
+            x += mass*p_crd[3*i+0];
+            y += mass*p_crd[3*i+1];
+            z += mass*p_crd[3*i+2];
+            w += mass;
+        }
+        if( w > 0.0 ) {
+            x /= w;
+            y /= w;
+            z /= w;
+        }
+        Coms[3*m+0] = x;
+        Coms[3*m+1] = y;
+        Coms[3*m+2] = z;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberImaging::MoveMolecules(double* p_crd,const double* p_new_coms)
+{
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel for schedule(dynamic,16) num_threads(nthreads)
+#endif
+    for(int m=0; m < NumOfMolecules; m++) {
+        double dx = p_new_coms[3*m+0] - Coms[3*m+0];
+        double dy = p_new_coms[3*m+1] - Coms[3*m+1];
+        double dz = p_new_coms[3*m+2] - Coms[3*m+2];
+        if( (dx == 0.0) && (dy == 0.0) && (dz == 0.0) ) continue;
+        for(int k=MolOffsets[m]; k < MolOffsets[m+1]; k++) {
+            int i = MolAtoms[k];
+            p_crd[3*i+0] += dx;
+            p_crd[3*i+1] += dy;
+            p_crd[3*i+2] += dz;
+        }
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberImaging::Autoimage(CAmberRestart* p_rst)
+{
+    if( MakeMoleculesWhole(p_rst) == false ) return(false);
+
+    double* p_crd = p_rst->GetCoordinatesBuffer();
+
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    // centre - atoms of centre mask are imaged to the first one as they
+    // can belong to different molecules
+    int ncentre = CentreAtoms.size();
+    if( ncentre > 0 ) {
+        std::vector<double> cdiffs(3*ncentre);
+        int first = CentreAtoms[0];
+        for(int k=0; k < ncentre; k++) {
+            int i = CentreAtoms[k];
+            cdiffs[3*k+0] = p_crd[3*i+0] - p_crd[3*first+0];
+            cdiffs[3*k+1] = p_crd[3*i+1] - p_crd[3*first+1];
+            cdiffs[3*k+2] = p_crd[3*i+2] - p_crd[3*first+2];
+        }
+        Box.ImageVectors(&cdiffs[0],ncentre,1);
+
+        double x = 0.0, y = 0.0, z = 0.0, w = 0.0;
+        for(int k=0; k < ncentre; k++) {
+            double mass = Masses[CentreAtoms[k]];
+            x += mass*cdiffs[3*k+0];
+            y += mass*cdiffs[3*k+1];
+            z += mass*cdiffs[3*k+2];
+            w += mass;
+        }
+        if( w <= 0.0 ) {
+            ES_ERROR("centre mask has zero mass");
+            return(false);
+        }
+
+        CPoint target(0.0,0.0,0.0);
+        if( OriginMode == false ) target = Box.GetBoxCenter();
+        double dx = target.x - (p_crd[3*first+0] + x/w);
+        double dy = target.y - (p_crd[3*first+1] + y/w);
+        double dz = target.z - (p_crd[3*first+2] + z/w);
+
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(nthreads)
+#endif
+        for(int i=0; i < NumOfAtoms; i++) {
+            p_crd[3*i+0] += dx;
+            p_crd[3*i+1] += dy;
+            p_crd[3*i+2] += dz;
+        }
+    }
+
+    // image molecules by their centres of mass
+    CalculateComs(p_crd);
+    std::vector<double> icoms(Coms);
+    Box.ImagePoints(&icoms[0],NumOfMolecules,OriginMode,true,nthreads);
+    MoveMolecules(p_crd,&icoms[0]);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberImaging::Unwrap(CAmberRestart* p_rst)
+{
+    if( MakeMoleculesWhole(p_rst) == false ) return(false);
+
+    double* p_crd = p_rst->GetCoordinatesBuffer();
+
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    CalculateComs(p_crd);
+
+    // the first snapshot is the reference
+    if( (int)RefComs.size() != 3*NumOfMolecules ) {
+        RefComs = Coms;
+        return(true);
+    }
+
+    // displacements of centres of mass are imaged to the shortest ones
+    std::vector<double> ncoms(3*NumOfMolecules);
+    for(int k=0; k < 3*NumOfMolecules; k++) ncoms[k] = Coms[k] - RefComs[k];
+    Box.ImageVectors(&ncoms[0],NumOfMolecules,nthreads);
+    for(int k=0; k < 3*NumOfMolecules; k++) ncoms[k] += RefComs[k];
+
+    MoveMolecules(p_crd,&ncoms[0]);
+    RefComs = ncoms;
+
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,120 @@
+#ifndef AmberImagingH
+#define AmberImagingH
+/** \ingroup AmberGeometry*/
+/*! \file AmberImaging.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+#include <ASLMainHeader.hpp>
+#include <AmberBox.hpp>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+class CAmberTopology;
+class CAmberRestart;
+class CAmberMaskAtoms;
+
+//---------------------------------------------------------------------------
+
+/// molecule-aware imaging of snapshots
+
+/*! molecules are taken from CAmberTopology::InitMoleculeIndexes (they are
+    detected from bonds, thus they do not depend on NSP from BoxInfo),
+    molecules are made whole by walking bonds, so they can be larger than
+    half of the box, all operations run in parallel over atoms or molecules
+*/
+
+class ASL_PACKAGE CAmberImaging {
+public:
+    CAmberImaging(void);
+    ~CAmberImaging(void);
+
+    /// set topology and prepare list of molecules
+    bool SetTopology(CAmberTopology* p_top);
+
+    /// set number of threads
+    void SetNumberOfThreads(int nthreads);
+
+    /// get number of threads
+    int GetNumberOfThreads(void);
+
+    /// set atoms whose centre of mass is placed to the centre of box
+    /*! NULL or empty mask disables centring
+    */
+    bool SetCentreMask(CAmberMaskAtoms* p_mask);
+
+    /// image around origin instead of box centre
+    void SetOriginMode(bool origin);
+
+    /// get number of molecules
+    int GetNumberOfMolecules(void);
+
+    /// make all molecules whole
+    bool MakeMoleculesWhole(CAmberRestart* p_rst);
+
+    /// autoimage snapshot
+    /*! molecules are made whole, the centre mask is centred and each
+        molecule is imaged by its centre of mass into the primary cell
+        (truncated octahedron for octahedral boxes)
+    */
+    bool Autoimage(CAmberRestart* p_rst);
+
+    /// unwrap snapshot
+    /*! molecules are made whole and each molecule is moved to the image
+        which is the closest to its position in the previously unwrapped
+        snapshot, thus periodic jumps are removed from trajectory
+    */
+    bool Unwrap(CAmberRestart* p_rst);
+
+    /// forget reference snapshot of unwrapping
+    void ResetUnwrap(void);
+
+// section of private data ----------------------------------------------------
+private:
+    CAmberTopology*         Topology;
+    int                     NumOfThreads;
+    bool                    OriginMode;
+    CAmberBox               Box;
+    int                     NumOfAtoms;
+    int                     NumOfMolecules;
+
+    // molecules
+    std::vector<int>        MolOffsets;     // NumOfMolecules+1 items
+    std::vector<int>        MolAtoms;       // atoms of molecules in bond walk order
+    std::vector<int>        Parents;        // previous atom in bond walk, -1 for the first atom
+    std::vector<double>     Masses;
+    std::vector<double>     MolMasses;
+
+    // centring
+    std::vector<int>        CentreAtoms;
+
+    // work arrays
+    std::vector<double>     Diffs;
+    std::vector<double>     Coms;
+    std::vector<double>     RefComs;
+
+    bool PrepareBox(CAmberRestart* p_rst);
+    void CalculateComs(const double* p_crd);
+    void MoveMolecules(double* p_crd,const double* p_new_coms);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,385 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberKDTree.hpp>
+#include <AmberRestart.hpp>
+#include <ErrorSystem.hpp>
+#include <algorithm>
+#include <math.h>
+#include <float.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+// nodes with at most this number of atoms are leaves searched linearly
+#define AMBER_KDTREE_LEAF_SIZE      16
+
+// subtrees larger than this are built in separate tasks
+#define AMBER_KDTREE_TASK_SIZE      32768
+
+//------------------------------------------------------------------------------
+
+// order of atoms along one coordinate
+
+class CAmberKDTreeCompare {
+public:
+    CAmberKDTreeCompare(const double* p_crd,int dim)
+        : Coordinates(p_crd), Dim(dim) {}
+
+    bool operator()(int a,int b) const {
+        return( Coordinates[3*a+Dim] < Coordinates[3*b+Dim] );
+    }
+
+private:
+    const double*   Coordinates;
+    int             Dim;
+};
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberKDTree::CAmberKDTree(void)
+{
+    NumOfThreads = 1;
+    NumOfAtoms = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberKDTree::~CAmberKDTree(void)
+{
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberKDTree::SetNumberOfThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfThreads = nthreads;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberKDTree::GetNumberOfThreads(void)
+{
+    return(NumOfThreads);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberKDTree::GetNumberOfAtoms(void)
+{
+    return(NumOfAtoms);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberKDTree::Build(CAmberRestart* p_rst)
+{
+    if( p_rst == NULL ) {
+        ES_ERROR("snapshot is NULL");
+        return(false);
+    }
+
+    std::vector<int> atoms(p_rst->GetNumberOfAtoms());
+    for(unsigned int i=0; i < atoms.size(); i++) atoms[i] = i;
+    return(Build(p_rst,atoms));
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberKDTree::Build(CAmberRestart* p_rst,const std::vector<int>& atoms)
+{
+    NumOfAtoms = 0;
+    Atoms.clear();
+    Positions.clear();
+    SplitDims.clear();
+
+    if( p_rst == NULL ) {
+        ES_ERROR("snapshot is NULL");
+        return(false);
+    }
+
+    int natoms = p_rst->GetNumberOfAtoms();
+    for(unsigned int i=0; i < atoms.size(); i++) {
+        if( (atoms[i] < 0) || (atoms[i] >= natoms) ) {
+            ES_ERROR("atom index out of range");
+            return(false);
+        }
+    }
+
+    const double* p_crd = p_rst->GetCoordinatesBuffer();
+
+    NumOfAtoms = atoms.size();
+    Atoms = atoms;
+    SplitDims.assign(NumOfAtoms,0);
+    if( NumOfAtoms == 0 ) return(true);
+
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        #pragma omp single
+        BuildNode(0,NumOfAtoms,&Atoms[0],p_crd);
+    }
+#else
+    BuildNode(0,NumOfAtoms,&Atoms[0],p_crd);
+#endif
+
+    // positions in tree order
+    Positions.resize(3*NumOfAtoms);
+    for(int i=0; i < NumOfAtoms; i++) {
+        Positions[3*i+0] = p_crd[3*Atoms[i]+0];
+        Positions[3*i+1] = p_crd[3*Atoms[i]+1];
+        Positions[3*i+2] = p_crd[3*Atoms[i]+2];
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberKDTree::BuildNode(int begin,int end,int* p_perm,const double* p_crd)
+{
+    if( end - begin <= AMBER_KDTREE_LEAF_SIZE ) return;
+
+    // split along the largest extent
+    double minc[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+    double maxc[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+    for(int i=begin; i < end; i++) {
+        const double* p_pos = p_crd + 3*p_perm[i];
+        for(int a=0; a < 3; a++) {
+            if( p_pos[a] < minc[a] ) minc[a] = p_pos[a];
+            if( p_pos[a] > maxc[a] ) maxc[a] = p_pos[a];
+        }
+    }
+    int dim = 0;
+    if( maxc[1] - minc[1] > maxc[dim] - minc[dim] ) dim = 1;
+    if( maxc[2] - minc[2] > maxc[dim] - minc[dim] ) dim = 2;
+
+    int mid = (begin + end) / 2;
+    std::nth_element(p_perm+begin,p_perm+mid,p_perm+end,
+                     CAmberKDTreeCompare(p_crd,dim));
+    SplitDims[mid] = dim;
+
+#ifdef _OPENMP
+    if( end - begin > AMBER_KDTREE_TASK_SIZE ) {
+        #pragma omp task
+        BuildNode(begin,mid,p_perm,p_crd);
+        #pragma omp task
+        BuildNode(mid+1,end,p_perm,p_crd);
+        #pragma omp taskwait
+        return;
+    }
+#endif
+    BuildNode(begin,mid,p_perm,p_crd);
+    BuildNode(mid+1,end,p_perm,p_crd);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberKDTree::GetAtomsAroundPoint(const CPoint& pos,double r,std::vector<int>& list)
+{
+    list.clear();
+    if( (NumOfAtoms == 0) || (r < 0.0) ) return;
+
+    double p[3];
+    p[0] = pos.x;
+    p[1] = pos.y;
+    p[2] = pos.z;
+    SearchRadius(0,NumOfAtoms,p,r*r,list);
+    std::sort(list.begin(),list.end());
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberKDTree::SearchRadius(int begin,int end,const double* p_pos,double r2,
+                                std::vector<int>& list)
+{
+    if( end - begin <= AMBER_KDTREE_LEAF_SIZE ) {
+        for(int i=begin; i < end; i++) {
+            double dx = Positions[3*i+0] - p_pos[0];
+            double dy = Positions[3*i+1] - p_pos[1];
+            double dz = Positions[3*i+2] - p_pos[2];
+            if( dx*dx + dy*dy + dz*dz <= r2 ) list.push_back(Atoms[i]);
+        }
+        return;
+    }
+
+    int mid = (begin + end) / 2;
+    int dim = SplitDims[mid];
+
+    double dx = Positions[3*mid+0] - p_pos[0];
+    double dy = Positions[3*mid+1] - p_pos[1];
+    double dz = Positions[3*mid+2] - p_pos[2];
+    if( dx*dx + dy*dy + dz*dz <= r2 ) list.push_back(Atoms[mid]);
+
+    double d = p_pos[dim] - Positions[3*mid+dim];
+    if( d <= 0.0 ) {
+        SearchRadius(begin,mid,p_pos,r2,list);
+        if( d*d <= r2 ) SearchRadius(mid+1,end,p_pos,r2,list);
+    } else {
+        SearchRadius(mid+1,end,p_pos,r2,list);
+        if( d*d <= r2 ) SearchRadius(begin,mid,p_pos,r2,list);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberKDTree::GetNearestAtoms(const CPoint& pos,int k,std::vector<int>& list,
+                                   std::vector<double>* p_dist)
+{
+    list.clear();
+    if( p_dist != NULL ) p_dist->clear();
+    if( (NumOfAtoms == 0) || (k <= 0) ) return;
+
+    double p[3];
+    p[0] = pos.x;
+    p[1] = pos.y;
+    p[2] = pos.z;
+
+    std::vector< std::pair<double,int> > heap;
+    heap.reserve(k);
+    SearchNearest(0,NumOfAtoms,p,k,heap);
+    std::sort_heap(heap.begin(),heap.end());
+
+    for(unsigned int i=0; i < heap.size(); i++) {
+        list.push_back(heap[i].second);
+        if( p_dist != NULL ) p_dist->push_back(sqrt(heap[i].first));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberKDTree::GetNearestAtom(const CPoint& pos,double* p_dist)
+{
+    std::vector<int>    list;
+    std::vector<double> dist;
+    GetNearestAtoms(pos,1,list,&dist);
+    if( list.empty() ) return(-1);
+    if( p_dist != NULL ) *p_dist = dist[0];
+    return(list[0]);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberKDTree::SearchNearest(int begin,int end,const double* p_pos,int k,
+                                 std::vector< std::pair<double,int> >& heap)
+{
+    if( end - begin <= AMBER_KDTREE_LEAF_SIZE ) {
+        for(int i=begin; i < end; i++) {
+            double dx = Positions[3*i+0] - p_pos[0];
+            double dy = Positions[3*i+1] - p_pos[1];
+            double dz = Positions[3*i+2] - p_pos[2];
+            double d2 = dx*dx + dy*dy + dz*dz;
+            if( (int)heap.size() < k ) {
+                heap.push_back(std::make_pair(d2,Atoms[i]));
+                std::push_heap(heap.begin(),heap.end());
+            } else if( d2 < heap.front().first ) {
+                std::pop_heap(heap.begin(),heap.end());
+                heap.back() = std::make_pair(d2,Atoms[i]);
+                std::push_heap(heap.begin(),heap.end());
+            }
+        }
+        return;
+    }
+
+    int mid = (begin + end) / 2;
+    int dim = SplitDims[mid];
+
+    // the median itself
+    SearchNearest(mid,mid+1,p_pos,k,heap);
+
+    double d = p_pos[dim] - Positions[3*mid+dim];
+    int nbegin = d <= 0.0 ? begin : mid+1;
+    int nend = d <= 0.0 ? mid : end;
+    int fbegin = d <= 0.0 ? mid+1 : begin;
+    int fend = d <= 0.0 ? end : mid;
+
+    SearchNearest(nbegin,nend,p_pos,k,heap);
+    if( ((int)heap.size() < k) || (d*d < heap.front().first) ) {
+        SearchNearest(fbegin,fend,p_pos,k,heap);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberKDTree::GetAtomsAroundPoints(const std::vector<CPoint>& points,double r,
+                                        std::vector<int>& offsets,std::vector<int>& list)
+{
+    int npoints = points.size();
+    offsets.assign(npoints+1,0);
+    list.clear();
+
+    std::vector< std::vector<int> > results(npoints);
+
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel for schedule(dynamic,64) num_threads(nthreads)
+#endif
+    for(int i=0; i < npoints; i++) {
+        GetAtomsAroundPoint(points[i],r,results[i]);
+    }
+
+    for(int i=0; i < npoints; i++) {
+        offsets[i+1] = offsets[i] + results[i].size();
+    }
+    list.resize(offsets[npoints]);
+    for(int i=0; i < npoints; i++) {
+        std::copy(results[i].begin(),results[i].end(),list.begin()+offsets[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberKDTree::GetNearestAtoms(const std::vector<CPoint>& points,int k,std::vector<int>& list)
+{
+    int npoints = points.size();
+    if( k < 0 ) k = 0;
+    list.assign((size_t)npoints*k,-1);
+
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel for schedule(dynamic,64) num_threads(nthreads)
+#endif
+    for(int i=0; i < npoints; i++) {
+        std::vector<int> items;
+        GetNearestAtoms(points[i],k,items);
+        for(unsigned int j=0; j < items.size(); j++) list[(size_t)i*k+j] = items[j];
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,104 @@
+#ifndef AmberKDTreeH
+#define AmberKDTreeH
+/** \ingroup AmberGeometry*/
+/*! \file AmberKDTree.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+#include <ASLMainHeader.hpp>
+#include <Point.hpp>
+#include <vector>
+#include <utility>
+
+//---------------------------------------------------------------------------
+
+class CAmberRestart;
+
+//---------------------------------------------------------------------------
+
+/// k-d tree over snapshot positions
+
+/*! the tree is intended for non-periodic systems, nodes are stored in
+    an implicit balanced layout over the permuted atom index array (no
+    pointers), small leaves are searched linearly
+*/
+
+class ASL_PACKAGE CAmberKDTree {
+public:
+    CAmberKDTree(void);
+    ~CAmberKDTree(void);
+
+    /// build tree for all atoms of snapshot
+    bool Build(CAmberRestart* p_rst);
+
+    /// build tree for selected atoms of snapshot
+    bool Build(CAmberRestart* p_rst,const std::vector<int>& atoms);
+
+    /// set number of threads used in build and batched queries
+    void SetNumberOfThreads(int nthreads);
+
+    /// get number of threads
+    int GetNumberOfThreads(void);
+
+    /// get number of atoms in the tree
+    int GetNumberOfAtoms(void);
+
+    /// return sorted list of atoms within radius r of point
+    void GetAtomsAroundPoint(const CPoint& pos,double r,std::vector<int>& list);
+
+    /// return k nearest atoms of point ordered by distance
+    /*! p_dist (if not NULL) receives distances
+    */
+    void GetNearestAtoms(const CPoint& pos,int k,std::vector<int>& list,
+                         std::vector<double>* p_dist=NULL);
+
+    /// return nearest atom of point, -1 for empty tree
+    int GetNearestAtom(const CPoint& pos,double* p_dist=NULL);
+
+    /// batched radius queries
+    /*! atoms within radius r of points[i] are stored in
+        list[offsets[i]] ... list[offsets[i+1]-1]
+    */
+    void GetAtomsAroundPoints(const std::vector<CPoint>& points,double r,
+                              std::vector<int>& offsets,std::vector<int>& list);
+
+    /// batched k nearest neighbour queries
+    /*! k nearest atoms of points[i] are stored in list[i*k] ... list[i*k+k-1],
+        missing items (the tree has less than k atoms) are set to -1
+    */
+    void GetNearestAtoms(const std::vector<CPoint>& points,int k,std::vector<int>& list);
+
+// section of private data ----------------------------------------------------
+private:
+    int                     NumOfThreads;
+    int                     NumOfAtoms;
+    std::vector<int>        Atoms;      // atoms permuted into tree order
+    std::vector<double>     Positions;  // positions in tree order (x,y,z)
+    std::vector<char>       SplitDims;  // split dimension of each node (indexed by its median)
+
+    void BuildNode(int begin,int end,int* p_perm,const double* p_crd);
+    void SearchRadius(int begin,int end,const double* p_pos,double r2,
+                      std::vector<int>& list);
+    void SearchNearest(int begin,int end,const double* p_pos,int k,
+                       std::vector< std::pair<double,int> >& heap);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,358 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberVerletList.hpp>
+#include <AmberRestart.hpp>
+#include <ErrorSystem.hpp>
+#include <SmallString.hpp>
+#include <math.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberVerletList::CAmberVerletList(void)
+{
+    Cutoff = 8.0;
+    Skin = 2.0;
+    NumOfThreads = 1;
+    Valid = false;
+    NumOfBuilds = 0;
+    NumOfUpdates = 0;
+    NumOfAtoms = 0;
+    BoxType = AMBER_BOX_NONE;
+    Snapshot = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberVerletList::~CAmberVerletList(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberVerletList::SetCutoff(double cutoff)
+{
+    if( cutoff != Cutoff ) Valid = false;
+    Cutoff = cutoff;
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberVerletList::GetCutoff(void)
+{
+    return(Cutoff);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberVerletList::SetSkin(double skin)
+{
+    if( skin < 0.0 ) skin = 0.0;
+    if( skin != Skin ) Valid = false;
+    Skin = skin;
+}
+
+//------------------------------------------------------------------------------
+
+double CAmberVerletList::GetSkin(void)
+{
+    return(Skin);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberVerletList::SetNumberOfThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfThreads = nthreads;
+    CellList.SetNumberOfThreads(nthreads);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberVerletList::GetNumberOfThreads(void)
+{
+    return(NumOfThreads);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberVerletList::Invalidate(void)
+{
+    Valid = false;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberVerletList::GetNumberOfBuilds(void)
+{
+    return(NumOfBuilds);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberVerletList::GetNumberOfUpdates(void)
+{
+    return(NumOfUpdates);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberVerletList::IsRebuildNeeded(CAmberRestart* p_rst,CAmberBox* p_box)
+{
+    if( Valid == false ) return(true);
+    if( p_rst == NULL ) return(true);
+    if( p_rst->GetNumberOfAtoms() != NumOfAtoms ) return(true);
+
+    // any change of the box invalidates image shifts of pairs
+    EAmberBoxType type = AMBER_BOX_NONE;
+    if( p_box != NULL ) type = p_box->GetType();
+    if( type != BoxType ) return(true);
+    if( type != AMBER_BOX_NONE ) {
+        if( p_box->GetBoxDimmensions() != BoxDims ) return(true);
+        if( p_box->GetBoxAngles() != BoxAngles ) return(true);
+    }
+
+    // maximum displacement since the last build
+    const double* p_crd = p_rst->GetCoordinatesBuffer();
+
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    std::vector<double> maxd2(nthreads,0.0);
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(nthreads)
+#endif
+    for(int i=0; i < NumOfAtoms; i++) {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        double dx = p_crd[3*i+0] - RefPositions[3*i+0];
+        double dy = p_crd[3*i+1] - RefPositions[3*i+1];
+        double dz = p_crd[3*i+2] - RefPositions[3*i+2];
+        double d2 = dx*dx + dy*dy + dz*dz;
+        if( d2 > maxd2[tid] ) maxd2[tid] = d2;
+    }
+
+    double d2 = 0.0;
+    for(int t=0; t < nthreads; t++) {
+        if( maxd2[t] > d2 ) d2 = maxd2[t];
+    }
+
+    // two atoms can approach each other by twice the maximum displacement
+    return( 4.0*d2 > Skin*Skin );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberVerletList::Update(CAmberRestart* p_rst,CAmberBox* p_box)
+{
+    if( p_rst == NULL ) {
+        ES_ERROR("snapshot is NULL");
+        return(false);
+    }
+    if( Cutoff <= 0.0 ) {
+        ES_ERROR("cutoff must be positive");
+        return(false);
+    }
+
+    NumOfUpdates++;
+    Snapshot = p_rst;
+
+    if( IsRebuildNeeded(p_rst,p_box) == false ) return(true);
+
+    return(Build(p_rst,p_box));
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberVerletList::Build(CAmberRestart* p_rst,CAmberBox* p_box)
+{
+    Valid = false;
+    PairI.clear();
+    PairJ.clear();
+    PairShifts.clear();
+
+    if( CellList.Build(p_rst,p_box,Cutoff+Skin) == false ) {
+        ES_ERROR("unable to build cell list");
+        return(false);
+    }
+
+    std::vector<CPoint> diffs;
+    if( CellList.GetPairs(Cutoff+Skin,PairI,PairJ,NULL,&diffs) == false ) {
+        ES_ERROR("unable to get pairs");
+        return(false);
+    }
+
+    NumOfAtoms = p_rst->GetNumberOfAtoms();
+    const double* p_crd = p_rst->GetCoordinatesBuffer();
+    RefPositions.assign(p_crd,p_crd + 3*NumOfAtoms);
+
+    BoxType = AMBER_BOX_NONE;
+    if( p_box != NULL ) BoxType = p_box->GetType();
+    if( BoxType != AMBER_BOX_NONE ) {
+        BoxDims = p_box->GetBoxDimmensions();
+        BoxAngles = p_box->GetBoxAngles();
+    }
+
+    // image shift converts the raw difference to the minimum image one
+    int npairs = PairI.size();
+    PairShifts.resize(3*npairs);
+
+#ifdef _OPENMP
+    int nthreads = NumOfThreads;
+
+    #pragma omp parallel for num_threads(nthreads)
+#endif
+    for(int k=0; k < npairs; k++) {
+        int i = PairI[k];
+        int j = PairJ[k];
+        PairShifts[3*k+0] = diffs[k].x - (p_crd[3*j+0] - p_crd[3*i+0]);
+        PairShifts[3*k+1] = diffs[k].y - (p_crd[3*j+1] - p_crd[3*i+1]);
+        PairShifts[3*k+2] = diffs[k].z - (p_crd[3*j+2] - p_crd[3*i+2]);
+    }
+
+    NumOfBuilds++;
+    Valid = true;
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CAmberVerletList::GetNumberOfPairs(void)
+{
+    return(PairI.size());
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberVerletList::GetFirstAtom(int pair)
+{
+    return(PairI[pair]);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberVerletList::GetSecondAtom(int pair)
+{
+    return(PairJ[pair]);
+}
+
+//------------------------------------------------------------------------------
+
+const CPoint CAmberVerletList::GetDifference(int pair)
+{
+    CPoint d;
+    if( (Valid == false) || (Snapshot == NULL) ) return(d);
+
+    const double* p_crd = Snapshot->GetCoordinatesBuffer();
+    int i = PairI[pair];
+    int j = PairJ[pair];
+    d.x = p_crd[3*j+0] - p_crd[3*i+0] + PairShifts[3*pair+0];
+    d.y = p_crd[3*j+1] - p_crd[3*i+1] + PairShifts[3*pair+1];
+    d.z = p_crd[3*j+2] - p_crd[3*i+2] + PairShifts[3*pair+2];
+    return(d);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberVerletList::GetPairs(double r,std::vector<int>& ai,std::vector<int>& aj,
+                                std::vector<double>* p_dist)
+{
+    ai.clear();
+    aj.clear();
+    if( p_dist != NULL ) p_dist->clear();
+
+    if( (Valid == false) || (Snapshot == NULL) ) {
+        ES_ERROR("list is not built");
+        return(false);
+    }
+    if( r > Cutoff ) {
+        CSmallString error;
+        error << "radius (" << r << ") is larger than cutoff of list (" << Cutoff << ")";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    const double*   p_crd = Snapshot->GetCoordinatesBuffer();
+    double          r2 = r*r;
+    int             npairs = PairI.size();
+
+    int nthreads = NumOfThreads;
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    std::vector< std::vector<int> >     tai(nthreads);
+    std::vector< std::vector<int> >     taj(nthreads);
+    std::vector< std::vector<double> >  tdist(nthreads);
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+    for(int k=0; k < npairs; k++) {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        int i = PairI[k];
+        int j = PairJ[k];
+        double dx = p_crd[3*j+0] - p_crd[3*i+0] + PairShifts[3*k+0];
+        double dy = p_crd[3*j+1] - p_crd[3*i+1] + PairShifts[3*k+1];
+        double dz = p_crd[3*j+2] - p_crd[3*i+2] + PairShifts[3*k+2];
+        double d2 = dx*dx + dy*dy + dz*dz;
+        if( d2 > r2 ) continue;
+        tai[tid].push_back(i);
+        taj[tid].push_back(j);
+        if( p_dist != NULL ) tdist[tid].push_back(sqrt(d2));
+    }
+
+    for(int t=0; t < nthreads; t++) {
+        ai.insert(ai.end(),tai[t].begin(),tai[t].end());
+        aj.insert(aj.end(),taj[t].begin(),taj[t].end());
+        if( p_dist != NULL ) p_dist->insert(p_dist->end(),tdist[t].begin(),tdist[t].end());
+    }
+
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
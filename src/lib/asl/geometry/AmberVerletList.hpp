@@ -0,0 +1,132 @@
+#ifndef AmberVerletListH
+#define AmberVerletListH
+/** \ingroup AmberGeometry*/
+/*! \file AmberVerletList.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+#include <ASLMainHeader.hpp>
+#include <Point.hpp>
+#include <AmberCellList.hpp>
+#include <AmberBox.hpp>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+class CAmberRestart;
+
+//---------------------------------------------------------------------------
+
+/// Verlet pair list with skin
+
+/*! the list contains all pairs within cutoff+skin at the time of build,
+    it remains valid until an atom moves by more than skin/2 from its build
+    position or the box changes, thus it can be reused for many consecutive
+    trajectory frames
+*/
+
+class ASL_PACKAGE CAmberVerletList {
+public:
+    CAmberVerletList(void);
+    ~CAmberVerletList(void);
+
+    /// set cutoff
+    void SetCutoff(double cutoff);
+
+    /// get cutoff
+    double GetCutoff(void);
+
+    /// set skin
+    void SetSkin(double skin);
+
+    /// get skin
+    double GetSkin(void);
+
+    /// set number of threads
+    void SetNumberOfThreads(int nthreads);
+
+    /// get number of threads
+    int GetNumberOfThreads(void);
+
+    /// update list for snapshot - rebuild only if it is necessary
+    /*! p_box has the same meaning as in CAmberCellList::Build
+    */
+    bool Update(CAmberRestart* p_rst,CAmberBox* p_box);
+
+    /// is rebuild necessary for given snapshot?
+    bool IsRebuildNeeded(CAmberRestart* p_rst,CAmberBox* p_box);
+
+    /// force rebuild during next update
+    void Invalidate(void);
+
+    /// get number of list builds
+    int GetNumberOfBuilds(void);
+
+    /// get number of list updates
+    int GetNumberOfUpdates(void);
+
+    /// get number of pairs in the list (within cutoff+skin at build time)
+    int GetNumberOfPairs(void);
+
+    /// get first atom of pair
+    int GetFirstAtom(int pair);
+
+    /// get second atom of pair
+    int GetSecondAtom(int pair);
+
+    /// get minimum image vector pos(aj)-pos(ai) of pair for the current snapshot
+    const CPoint GetDifference(int pair);
+
+    /// return all pairs ai < aj within radius r (r <= cutoff) for the current snapshot
+    /*! p_dist (if not NULL) receives distances of the pairs
+    */
+    bool GetPairs(double r,std::vector<int>& ai,std::vector<int>& aj,
+                  std::vector<double>* p_dist=NULL);
+
+// section of private data ----------------------------------------------------
+private:
+    CAmberCellList          CellList;
+    double                  Cutoff;
+    double                  Skin;
+    int                     NumOfThreads;
+    bool                    Valid;
+    int                     NumOfBuilds;
+    int                     NumOfUpdates;
+
+    // build reference
+    int                     NumOfAtoms;
+    EAmberBoxType           BoxType;
+    CPoint                  BoxDims;
+    CPoint                  BoxAngles;
+    std::vector<double>     RefPositions;
+
+    // pairs
+    std::vector<int>        PairI;
+    std::vector<int>        PairJ;
+    std::vector<double>     PairShifts;     // image shift of each pair (x,y,z)
+
+    // current snapshot
+    CAmberRestart*          Snapshot;
+
+    bool Build(CAmberRestart* p_rst,CAmberBox* p_box);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,304 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberBitSet.hpp>
+#include <ErrorSystem.hpp>
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#define AMBER_BITSET_SIMD_LOOP  _Pragma("omp simd")
+#else
+#define AMBER_BITSET_SIMD_LOOP
+#endif
+
+//------------------------------------------------------------------------------
+
+static inline int PopCount(uint64_t word)
+{
+#if defined(__GNUC__)
+    return(__builtin_popcountll(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return( (int)((word * 0x0101010101010101ULL) >> 56) );
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+static inline int TrailingZeros(uint64_t word)
+{
+#if defined(__GNUC__)
+    return(__builtin_ctzll(word));
+#else
+    int n = 0;
+    while( (word & 1) == 0 ) {
+        word >>= 1;
+        n++;
+    }
+    return(n);
+#endif
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberBitSet::CAmberBitSet(void)
+{
+    NumOfBits = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberBitSet::CAmberBitSet(int nbits)
+{
+    NumOfBits = 0;
+    Resize(nbits);
+}
+
+//------------------------------------------------------------------------------
+
+CAmberBitSet::~CAmberBitSet(void)
+{
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberBitSet::Resize(int nbits)
+{
+    if( nbits < 0 ) nbits = 0;
+    NumOfBits = nbits;
+    Words.assign((nbits + 63) / 64,0);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberBitSet::GetSize(void) const
+{
+    return(NumOfBits);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::ClearTail(void)
+{
+    if( (NumOfBits & 63) != 0 ) {
+        Words.back() &= ((uint64_t)1 << (NumOfBits & 63)) - 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::SetRange(int index,int length)
+{
+    if( index < 0 ) {
+        length += index;
+        index = 0;
+    }
+    if( index + length > NumOfBits ) length = NumOfBits - index;
+    if( length <= 0 ) return;
+
+    int end = index + length;     // exclusive
+    int fw = index >> 6;
+    int lw = (end - 1) >> 6;
+    uint64_t fmask = ~(uint64_t)0 << (index & 63);
+    uint64_t lmask = ~(uint64_t)0 >> (63 - ((end - 1) & 63));
+
+    if( fw == lw ) {
+        Words[fw] |= fmask & lmask;
+        return;
+    }
+    Words[fw] |= fmask;
+    for(int w=fw+1; w < lw; w++) Words[w] = ~(uint64_t)0;
+    Words[lw] |= lmask;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::SetAll(void)
+{
+    for(size_t w=0; w < Words.size(); w++) Words[w] = ~(uint64_t)0;
+    ClearTail();
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::Clear(void)
+{
+    for(size_t w=0; w < Words.size(); w++) Words[w] = 0;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberBitSet::And(const CAmberBitSet& src)
+{
+    if( src.NumOfBits != NumOfBits ) {
+        ES_ERROR("bit sets differ in size");
+        return;
+    }
+    int             nwords = Words.size();
+    uint64_t*       p_dst = nwords > 0 ? &Words[0] : NULL;
+    const uint64_t* p_src = nwords > 0 ? &src.Words[0] : NULL;
+
+    AMBER_BITSET_SIMD_LOOP
+    for(int w=0; w < nwords; w++) p_dst[w] &= p_src[w];
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::Or(const CAmberBitSet& src)
+{
+    if( src.NumOfBits != NumOfBits ) {
+        ES_ERROR("bit sets differ in size");
+        return;
+    }
+    int             nwords = Words.size();
+    uint64_t*       p_dst = nwords > 0 ? &Words[0] : NULL;
+    const uint64_t* p_src = nwords > 0 ? &src.Words[0] : NULL;
+
+    AMBER_BITSET_SIMD_LOOP
+    for(int w=0; w < nwords; w++) p_dst[w] |= p_src[w];
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::AndNot(const CAmberBitSet& src)
+{
+    if( src.NumOfBits != NumOfBits ) {
+        ES_ERROR("bit sets differ in size");
+        return;
+    }
+    int             nwords = Words.size();
+    uint64_t*       p_dst = nwords > 0 ? &Words[0] : NULL;
+    const uint64_t* p_src = nwords > 0 ? &src.Words[0] : NULL;
+
+    AMBER_BITSET_SIMD_LOOP
+    for(int w=0; w < nwords; w++) p_dst[w] &= ~p_src[w];
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::Not(void)
+{
+    int         nwords = Words.size();
+    uint64_t*   p_dst = nwords > 0 ? &Words[0] : NULL;
+
+    AMBER_BITSET_SIMD_LOOP
+    for(int w=0; w < nwords; w++) p_dst[w] = ~p_dst[w];
+
+    ClearTail();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CAmberBitSet::Count(void) const
+{
+    int count = 0;
+    for(size_t w=0; w < Words.size(); w++) count += PopCount(Words[w]);
+    return(count);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberBitSet::Any(void) const
+{
+    for(size_t w=0; w < Words.size(); w++) {
+        if( Words[w] != 0 ) return(true);
+    }
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberBitSet::FindNext(int index) const
+{
+    if( index < 0 ) index = 0;
+    if( index >= NumOfBits ) return(-1);
+
+    int      w = index >> 6;
+    uint64_t word = Words[w] & (~(uint64_t)0 << (index & 63));
+
+    while( word == 0 ) {
+        w++;
+        if( w >= (int)Words.size() ) return(-1);
+        word = Words[w];
+    }
+
+    return( (w << 6) + TrailingZeros(word) );
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::GetIndexes(std::vector<int>& indexes) const
+{
+    indexes.clear();
+    indexes.reserve(Count());
+
+    for(size_t w=0; w < Words.size(); w++) {
+        uint64_t word = Words[w];
+        while( word != 0 ) {
+            indexes.push_back((int)(w << 6) + TrailingZeros(word));
+            word &= word - 1;   // clear the lowest set bit
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBitSet::GetRanges(std::vector<int>& starts,std::vector<int>& lengths) const
+{
+    starts.clear();
+    lengths.clear();
+
+    int index = FindNext(0);
+    while( index >= 0 ) {
+        // find the end of the run
+        int      w = index >> 6;
+        uint64_t word = ~Words[w] & (~(uint64_t)0 << (index & 63));
+        while( word == 0 ) {
+            w++;
+            if( w >= (int)Words.size() ) break;
+            word = ~Words[w];
+        }
+        int end = NumOfBits;
+        if( w < (int)Words.size() ) {
+            end = (w << 6) + TrailingZeros(word);
+            if( end > NumOfBits ) end = NumOfBits;
+        }
+        starts.push_back(index);
+        lengths.push_back(end - index);
+        index = FindNext(end);
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
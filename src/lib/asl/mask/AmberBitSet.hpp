@@ -0,0 +1,131 @@
+#ifndef AmberBitSetH
+#define AmberBitSetH
+/** \ingroup AmberMask*/
+/*! \file AmberBitSet.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+#include <ASLMainHeader.hpp>
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+/// packed set of bits (atom selections)
+
+/*! bits are packed into 64-bit words, bits beyond GetSize() are always zero,
+    set operations work on whole words and are vectorized by compiler
+*/
+
+class ASL_PACKAGE CAmberBitSet {
+public:
+    CAmberBitSet(void);
+    CAmberBitSet(int nbits);
+    ~CAmberBitSet(void);
+
+    // setup -------------------------------------------------------------------
+    /// resize set - all bits are cleared
+    void Resize(int nbits);
+
+    /// get number of bits
+    int  GetSize(void) const;
+
+    // bit access --------------------------------------------------------------
+    /// set bit
+    void Set(int index);
+
+    /// clear bit
+    void Reset(int index);
+
+    /// test bit
+    bool Test(int index) const;
+
+    /// set bits from index to index+length-1
+    void SetRange(int index,int length);
+
+    /// set all bits
+    void SetAll(void);
+
+    /// clear all bits
+    void Clear(void);
+
+    // set algebra -------------------------------------------------------------
+    /// this = this & src
+    void And(const CAmberBitSet& src);
+
+    /// this = this | src
+    void Or(const CAmberBitSet& src);
+
+    /// this = this & ~src
+    void AndNot(const CAmberBitSet& src);
+
+    /// this = ~this
+    void Not(void);
+
+    // results -----------------------------------------------------------------
+    /// return number of set bits
+    int  Count(void) const;
+
+    /// is any bit set?
+    bool Any(void) const;
+
+    /// return the first set bit not lower than index, -1 if there is none
+    int  FindNext(int index) const;
+
+    /// return indexes of set bits
+    void GetIndexes(std::vector<int>& indexes) const;
+
+    /// return contiguous runs of set bits
+    void GetRanges(std::vector<int>& starts,std::vector<int>& lengths) const;
+
+// section of private data ----------------------------------------------------
+private:
+    int                     NumOfBits;
+    std::vector<uint64_t>   Words;
+
+    void ClearTail(void);
+};
+
+//---------------------------------------------------------------------------
+
+// bit access is used in tight loops of selectors, thus it is inlined
+
+inline void CAmberBitSet::Set(int index)
+{
+    Words[index >> 6] |= (uint64_t)1 << (index & 63);
+}
+
+//---------------------------------------------------------------------------
+
+inline void CAmberBitSet::Reset(int index)
+{
+    Words[index >> 6] &= ~((uint64_t)1 << (index & 63));
+}
+
+//---------------------------------------------------------------------------
+
+inline bool CAmberBitSet::Test(int index) const
+{
+    return( (Words[index >> 6] >> (index & 63)) & 1 );
+}
+
+//---------------------------------------------------------------------------
+
+#endif
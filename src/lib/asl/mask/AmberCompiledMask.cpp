@@ -0,0 +1,457 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberCompiledMask.hpp>
+#include <AmberMaskASelection.hpp>
+#include <AmberTopology.hpp>
+#include <AmberRestart.hpp>
+#include <ErrorSystem.hpp>
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+
+// does expression depend on coordinates?
+
+static bool HasDistanceOperator(struct SExpression* p_expr)
+{
+    if( p_expr == NULL ) return(false);
+    if( p_expr->Selection != NULL ) return(false);
+
+    switch(p_expr->Operator) {
+    case O_RLT:
+    case O_RGT:
+    case O_ALT:
+    case O_AGT:
+        return(true);
+    default:
+        break;
+    }
+
+    if( HasDistanceOperator(p_expr->LeftExpression) ) return(true);
+    return( HasDistanceOperator(p_expr->RightExpression) );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberCompiledMaskNode::CAmberCompiledMaskNode(void)
+{
+    Operator = O_NONE;
+    Modificator = D_ORIGIN;
+    Distance = 0.0;
+    Static = false;
+    Result = NULL;
+    Left = NULL;
+    Right = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberCompiledMaskNode::~CAmberCompiledMaskNode(void)
+{
+    if( Result != NULL ) delete Result;
+    if( Left != NULL ) delete Left;
+    if( Right != NULL ) delete Right;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberCompiledMask::CAmberCompiledMask(void)
+{
+    Root = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberCompiledMask::~CAmberCompiledMask(void)
+{
+    Clear();
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberCompiledMask::Clear(void)
+{
+    if( Root != NULL ) delete Root;
+    Root = NULL;
+    SelectedAtoms.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberCompiledMask::AssignTopology(CAmberTopology* p_top)
+{
+    Clear();
+    Mask = NULL;
+    return(Owner.AssignTopology(p_top));
+}
+
+//------------------------------------------------------------------------------
+
+CAmberTopology* CAmberCompiledMask::GetTopology(void) const
+{
+    return(Owner.GetTopology());
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberCompiledMask::SetPeriodicDistances(bool set)
+{
+    Owner.SetPeriodicDistances(set);
+}
+
+//------------------------------------------------------------------------------
+
+const CSmallString& CAmberCompiledMask::GetMask(void) const
+{
+    return(Mask);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCompiledMask::IsDynamic(void) const
+{
+    if( Root == NULL ) return(false);
+    return( Root->Static == false );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberCompiledMask::SetMask(const CSmallString& mask)
+{
+    if( Owner.GetTopology() == NULL ) {
+        ES_ERROR("no topology is assigned with mask");
+        return(false);
+    }
+
+    if( mask == NULL ) {
+        ES_ERROR("mask is empty");
+        return(false);
+    }
+
+    Clear();
+    Mask = mask;
+
+    // init mask parser
+    struct SMaskParser parser;
+    init_mask(&parser);
+
+    // parse mask
+    if( parse_mask(&parser,Mask) != 0 ) {
+        free_mask_tree(&parser);
+        ES_ERROR("unable to parse mask");
+        return(false);
+    }
+
+    // get top mask expression
+    struct SExpression* p_top_expr = get_expression_tree(&parser);
+    if( p_top_expr == NULL ) {
+        free_mask_tree(&parser);
+        ES_ERROR("top expression is NULL");
+        return(false);
+    }
+
+    // compile - static parts are evaluated now
+    Root = Compile(p_top_expr);
+
+    // free parser data
+    free_mask_tree(&parser);
+
+    if( Root == NULL ) {
+        ES_ERROR("unable to compile mask");
+        return(false);
+    }
+
+    if( Root->Static ) UpdateSelectedAtoms();
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+CAmberCompiledMaskNode* CAmberCompiledMask::Compile(struct SExpression* p_expr)
+{
+    if( p_expr == NULL ) {
+        ES_ERROR("p_expr is NULL");
+        return(NULL);
+    }
+
+    CAmberCompiledMaskNode* p_node = NULL;
+    try {
+        p_node = new CAmberCompiledMaskNode;
+        p_node->Result = new CAmberMaskASelection(&Owner);
+    } catch(...) {
+        if( p_node != NULL ) delete p_node;
+        ES_ERROR("unable to allocate node");
+        return(NULL);
+    }
+
+    p_node->Operator = p_expr->Operator;
+    p_node->Modificator = p_expr->Modificator;
+    p_node->Distance = p_expr->Distance;
+
+    // static subtree - evaluate and cache
+    if( HasDistanceOperator(p_expr) == false ) {
+        p_node->Static = true;
+        if( p_node->Result->ExpandAndReduceTree(p_expr) == false ) {
+            ES_ERROR("unable to expand and reduce static subtree");
+            delete p_node;
+            return(NULL);
+        }
+        return(p_node);
+    }
+
+    // dynamic node - compile operands
+    bool result = true;
+    switch(p_expr->Operator) {
+    case O_NOT:
+        p_node->Right = Compile(p_expr->RightExpression);
+        result = p_node->Right != NULL;
+        break;
+    case O_AND:
+    case O_OR:
+        p_node->Left = Compile(p_expr->LeftExpression);
+        p_node->Right = Compile(p_expr->RightExpression);
+        result = (p_node->Left != NULL) && (p_node->Right != NULL);
+        break;
+    case O_RLT:
+    case O_RGT:
+    case O_ALT:
+    case O_AGT:
+        switch(p_expr->Modificator) {
+        case D_ORIGIN:
+        case D_CBOX:
+            break;
+        case D_LIST:
+        case D_COM:
+        case D_PLANE:
+            p_node->Left = Compile(p_expr->LeftExpression);
+            result = p_node->Left != NULL;
+            break;
+        default:
+            ES_ERROR("not implemented distance modificator");
+            result = false;
+            break;
+        }
+        break;
+    default:
+        ES_ERROR("not implemented operator");
+        result = false;
+        break;
+    }
+
+    if( result == false ) {
+        delete p_node;
+        return(NULL);
+    }
+
+    return(p_node);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberCompiledMask::Evaluate(CAmberRestart* p_crd)
+{
+    if( Root == NULL ) {
+        ES_ERROR("mask is not set");
+        return(false);
+    }
+
+    if( Root->Static ) return(true);
+
+    if( p_crd == NULL ) {
+        ES_ERROR("distance operator requires coordinates");
+        return(false);
+    }
+
+    // box of snapshot is kept by owner, the topology is not changed
+    Owner.AssignCoordinates(p_crd);
+    Owner.UpdateSnapshotBox();
+
+    bool result = EvaluateNode(Root);
+    Owner.AssignCoordinates(NULL);
+
+    SelectedAtoms.clear();
+    if( result == false ) {
+        ES_ERROR("unable to evaluate mask");
+        return(false);
+    }
+
+    UpdateSelectedAtoms();
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCompiledMask::EvaluateNode(CAmberCompiledMaskNode* p_node)
+{
+    if( p_node->Static ) return(true);
+
+    if( p_node->Left != NULL ) {
+        if( EvaluateNode(p_node->Left) == false ) return(false);
+    }
+    if( p_node->Right != NULL ) {
+        if( EvaluateNode(p_node->Right) == false ) return(false);
+    }
+
+    CAmberMaskASelection*   p_root = p_node->Result;
+    CAmberMaskASelection*   p_left = p_node->Left != NULL ? p_node->Left->Result : NULL;
+    CAmberMaskASelection*   p_right = p_node->Right != NULL ? p_node->Right->Result : NULL;
+
+    p_root->Atoms.Clear();
+
+    bool result = true;
+    switch(p_node->Operator) {
+    case O_NOT:
+        p_root->Atoms = p_right->Atoms;
+        p_root->Atoms.Not();
+        break;
+    case O_AND:
+        p_root->Atoms = p_left->Atoms;
+        p_root->Atoms.And(p_right->Atoms);
+        break;
+    case O_OR:
+        p_root->Atoms = p_left->Atoms;
+        p_root->Atoms.Or(p_right->Atoms);
+        break;
+    case O_RLT:
+    case O_RGT:
+        switch(p_node->Modificator) {
+        case D_ORIGIN:
+            result = p_root->SelectResidueByDistanceFromOrigin(p_node->Operator,p_node->Distance);
+            break;
+        case D_CBOX:
+            result = p_root->SelectResidueByDistanceFromCentreOfBox(p_node->Operator,p_node->Distance);
+            break;
+        case D_LIST:
+            result = p_root->SelectResidueByDistanceFromList(p_left,p_node->Operator,p_node->Distance);
+            break;
+        case D_COM:
+            result = p_root->SelectResidueByDistanceFromCOM(p_left,p_node->Operator,p_node->Distance);
+            break;
+        case D_PLANE:
+            result = p_root->SelectResidueByDistanceFromPlane(p_left,p_node->Operator,p_node->Distance);
+            break;
+        default:
+            ES_ERROR("not implemented");
+            return(false);
+        }
+        break;
+    case O_ALT:
+    case O_AGT:
+        switch(p_node->Modificator) {
+        case D_ORIGIN:
+            result = p_root->SelectAtomByDistanceFromOrigin(p_node->Operator,p_node->Distance);
+            break;
+        case D_CBOX:
+            result = p_root->SelectAtomByDistanceFromCentreOfBox(p_node->Operator,p_node->Distance);
+            break;
+        case D_LIST:
+            result = p_root->SelectAtomByDistanceFromList(p_left,p_node->Operator,p_node->Distance);
+            break;
+        case D_COM:
+            result = p_root->SelectAtomByDistanceFromCOM(p_left,p_node->Operator,p_node->Distance);
+            break;
+        case D_PLANE:
+            result = p_root->SelectAtomByDistanceFromPlane(p_left,p_node->Operator,p_node->Distance);
+            break;
+        default:
+            ES_ERROR("not implemented");
+            return(false);
+        }
+        break;
+    default:
+        ES_ERROR("not implemented");
+        return(false);
+    }
+
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberCompiledMask::UpdateSelectedAtoms(void)
+{
+    SelectedAtoms.clear();
+    if( Root == NULL ) return;
+
+    std::vector<int> indexes;
+    Root->Result->GetSelectionBits().GetIndexes(indexes);
+
+    CAmberTopology* p_top = Owner.GetTopology();
+    SelectedAtoms.reserve(indexes.size());
+    for(size_t i=0; i < indexes.size(); i++) {
+        SelectedAtoms.push_back(p_top->AtomList.GetAtom(indexes[i]));
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+int CAmberCompiledMask::GetNumberOfTopologyAtoms(void)
+{
+    return(Owner.GetNumberOfTopologyAtoms());
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberCompiledMask::GetNumberOfSelectedAtoms(void)
+{
+    return(SelectedAtoms.size());
+}
+
+//------------------------------------------------------------------------------
+
+CAmberAtom* CAmberCompiledMask::GetSelectedAtom(int index)
+{
+    if( Root == NULL ) return(NULL);
+    return( Root->Result->GetSelectedAtom(index) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCompiledMask::IsAtomSelected(int index)
+{
+    return( GetSelectedAtom(index) != NULL );
+}
+
+//------------------------------------------------------------------------------
+
+CAmberAtom* CAmberCompiledMask::GetSelectedAtomCondensed(int index)
+{
+    return( SelectedAtoms[index] );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
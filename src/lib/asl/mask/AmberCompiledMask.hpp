@@ -0,0 +1,132 @@
+#ifndef AmberCompiledMaskH
+#define AmberCompiledMaskH
+/** \ingroup AmberMask*/
+/*! \file AmberCompiledMask.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+#include <ASLMainHeader.hpp>
+#include <SmallString.hpp>
+#include <AmberMaskAtoms.hpp>
+#include <vector>
+#include "maskparser/AmberMaskParser.hpp"
+
+//---------------------------------------------------------------------------
+
+class CAmberTopology;
+class CAmberRestart;
+class CAmberAtom;
+class CAmberMaskASelection;
+
+//---------------------------------------------------------------------------
+
+/// node of compiled mask
+
+class ASL_PACKAGE CAmberCompiledMaskNode {
+public:
+    CAmberCompiledMaskNode(void);
+    ~CAmberCompiledMaskNode(void);
+
+// section of private data ----------------------------------------------------
+private:
+    enum SOperator          Operator;
+    enum DModificator       Modificator;
+    double                  Distance;
+    bool                    Static;         // subtree does not depend on coordinates
+    CAmberMaskASelection*   Result;         // cached for static nodes
+    CAmberCompiledMaskNode* Left;
+    CAmberCompiledMaskNode* Right;
+
+    friend class CAmberCompiledMask;
+};
+
+//---------------------------------------------------------------------------
+
+/// atom mask parsed once and re-evaluated for each snapshot
+
+/*! the mask is parsed by SetMask, all subtrees without distance operators are
+    evaluated immediately and cached, Evaluate then recomputes only distance
+    operators and the logical operators above them
+*/
+
+class ASL_PACKAGE CAmberCompiledMask {
+public:
+    CAmberCompiledMask(void);
+    ~CAmberCompiledMask(void);
+
+    // setup -------------------------------------------------------------------
+    /// assign topology - previous mask is destroyed
+    bool            AssignTopology(CAmberTopology* p_top);
+    CAmberTopology* GetTopology(void) const;
+
+    /// use minimum image convention in distance operators
+    void            SetPeriodicDistances(bool set);
+
+    /// parse and compile mask
+    /*! static masks are evaluated immediately, dynamic masks (with distance
+        operators) are evaluated by Evaluate
+    */
+    bool            SetMask(const CSmallString& mask);
+
+    /// return current mask specification
+    const CSmallString& GetMask(void) const;
+
+    /// does mask contain distance operators?
+    bool            IsDynamic(void) const;
+
+    // evaluation --------------------------------------------------------------
+    /// evaluate dynamic parts of mask for snapshot
+    /*! the box is taken from p_crd and kept by the mask, the topology is
+        not changed, thus masks sharing one topology can be evaluated
+        concurrently
+    */
+    bool            Evaluate(CAmberRestart* p_crd);
+
+    // results -----------------------------------------------------------------
+    /// get total number of atoms
+    int             GetNumberOfTopologyAtoms(void);
+
+    /// get number of selected atoms
+    int             GetNumberOfSelectedAtoms(void);
+
+    /// get selected atom - index is atom index, NULL is returned for unselected atoms
+    CAmberAtom*     GetSelectedAtom(int index);
+
+    /// is atom selected - index is atom index
+    bool            IsAtomSelected(int index);
+
+    /// return selected atom - index is from 0 to GetNumberOfSelectedAtoms()
+    CAmberAtom*     GetSelectedAtomCondensed(int index);
+
+// section of private data ----------------------------------------------------
+private:
+    CAmberMaskAtoms             Owner;      // provides topology and coordinates to selections
+    CSmallString                Mask;
+    CAmberCompiledMaskNode*     Root;
+    std::vector<CAmberAtom*>    SelectedAtoms;
+
+    CAmberCompiledMaskNode* Compile(struct SExpression* p_expr);
+    bool EvaluateNode(CAmberCompiledMaskNode* p_node);
+    void UpdateSelectedAtoms(void);
+    void Clear(void);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
@@ -28,6 +28,7 @@
 #include <AmberRestart.hpp>
 #include <AmberMaskASelection.hpp>
 #include <AmberMaskAtoms.hpp>
+#include <AmberMaskDistance.hpp>
 
 #include "maskparser/AmberMaskParser.hpp"
 
@@ -38,20 +39,13 @@
 CAmberMaskASelection::CAmberMaskASelection(CAmberMaskAtoms* p_owner)
 {
     Owner = p_owner;
-    if( Owner->GetNumberOfTopologyAtoms() > 0 ) {
-        Atoms = new CAmberAtom*[Owner->GetNumberOfTopologyAtoms()];
-        for(int i=0; i < Owner->GetNumberOfTopologyAtoms(); i++) Atoms[i] = NULL;
-    } else {
-        Atoms = NULL;
-    }
+    Atoms.Resize(Owner->GetNumberOfTopologyAtoms());
 }
 
 //------------------------------------------------------------------------------
 
 CAmberMaskASelection::~CAmberMaskASelection(void)
 {
-    delete[] Atoms;
-    Atoms = NULL;
 }
 
 //==============================================================================
@@ -60,8 +54,8 @@ CAmberMaskASelection::~CAmberMaskASelection(void)
 
 bool CAmberMaskASelection::ExpandAndReduceTree(struct SExpression* p_expr)
 {
-    if( Atoms == NULL ) {
-        ES_ERROR("Atoms is NULL");
+    if( Atoms.GetSize() == 0 ) {
+        ES_ERROR("no atoms to select");
         return(false);
     }
 
@@ -192,31 +186,16 @@ bool CAmberMaskASelection::ExpandAndReduceTree(
     // do arithemetic
     switch(p_expr->Operator) {
     case O_NOT:
-        for(int i=0; i < p_root->Owner->GetNumberOfTopologyAtoms(); i++) {
-            if( p_right->Atoms[i] == NULL ) {
-                p_root->Atoms[i] = p_root->Owner->GetTopology()->AtomList.GetAtom(i);
-            } else {
-                p_root->Atoms[i] = NULL;
-            }
-        }
+        p_root->Atoms = p_right->Atoms;
+        p_root->Atoms.Not();
         break;
     case O_AND:
-        for(int i=0; i < p_root->Owner->GetNumberOfTopologyAtoms(); i++) {
-            if( (p_left->Atoms[i] != NULL) && (p_right->Atoms[i] != NULL) ) {
-                p_root->Atoms[i] = p_root->Owner->GetTopology()->AtomList.GetAtom(i);
-            } else {
-                p_root->Atoms[i] = NULL;
-            }
-        }
+        p_root->Atoms = p_left->Atoms;
+        p_root->Atoms.And(p_right->Atoms);
         break;
     case O_OR:
-        for(int i=0; i < p_root->Owner->GetNumberOfTopologyAtoms(); i++) {
-            if( (p_left->Atoms[i] != NULL) || (p_right->Atoms[i] != NULL) ) {
-                p_root->Atoms[i] = p_root->Owner->GetTopology()->AtomList.GetAtom(i);
-            } else {
-                p_root->Atoms[i] = NULL;
-            }
-        }
+        p_root->Atoms = p_left->Atoms;
+        p_root->Atoms.Or(p_right->Atoms);
         break;
     case O_RLT:
     case O_RGT: {
@@ -307,9 +286,7 @@ bool CAmberMaskASelection::Select(struct SSelection* p_sel)
     while( p_item != NULL ) {
         if( p_item->Index < 0 ) {
             // no matter of selector - this always means all atoms
-            for(int i=0; i < Owner->GetNumberOfTopologyAtoms(); i++) {
-                Atoms[i] = Owner->GetTopology()->AtomList.GetAtom(i);
-            }
+            Atoms.SetAll();
         }
         if( p_item->Index > 0 ) {
             if( p_item->Length >= 1 ) {
@@ -360,14 +337,9 @@ bool CAmberMaskASelection::Select(struct SSelection* p_sel)
 
 void CAmberMaskASelection::SelectAtomByIndex(int index,int length)
 {
-    for(int i=0; i < length; i++) {
-        int aindex = index + i - 1; // transform to index counted from zero
-
-        // check range - this is mandatory because mask can be general
-        if( (aindex >= 0) && (aindex < Owner->GetTopology()->AtomList.GetNumberOfAtoms()) ) {
-            Atoms[aindex] = Owner->GetTopology()->AtomList.GetAtom(aindex);
-        }
-    }
+    // transform to index counted from zero
+    // range is clipped by SetRange - this is mandatory because mask can be general
+    Atoms.SetRange(index - 1,length);
 }
 
 //------------------------------------------------------------------------------
@@ -389,13 +361,11 @@ void CAmberMaskASelection::SelectAtomByName(const char* p_name)
         }
     }
 
-    for(int i=0; i < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); i++) {
-        CAmberAtom* p_atom = Owner->GetTopology()->AtomList.GetAtom(i);
-
-        if( strncmp(p_atom->GetName(),p_name,search_len) == 0 ) {
-            Atoms[i] = p_atom;
-        }
-
+    // use index of names - the cost is proportional to the number of matches
+    int         count;
+    const int*  p_list = Owner->GetTopology()->FindAtomsByName(p_name,search_len,count);
+    for(int i=0; i < count; i++) {
+        Atoms.Set(p_list[i]);
     }
 }
 
@@ -418,11 +388,10 @@ void CAmberMaskASelection::SelectAtomByType(const char* p_name)
         }
     }
 
-    for(int i=0; i < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); i++) {
-        CAmberAtom* p_atom = Owner->GetTopology()->AtomList.GetAtom(i);
-        if( strncmp(p_atom->GetType(),p_name,search_len) == 0 ) {
-            Atoms[i] = p_atom;
-        }
+    int         count;
+    const int*  p_list = Owner->GetTopology()->FindAtomsByType(p_name,search_len,count);
+    for(int i=0; i < count; i++) {
+        Atoms.Set(p_list[i]);
     }
 }
 
@@ -439,10 +408,7 @@ void CAmberMaskASelection::SelectResidueByIndex(int index,int length)
             CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(rindex);
 
             // select whole residue
-            for(int j = 0; j < p_res->GetNumberOfAtoms(); j++) {
-                int aindex = j + p_res->GetFirstAtomIndex();
-                Atoms[aindex] = Owner->GetTopology()->AtomList.GetAtom(aindex);
-            }
+            Atoms.SetRange(p_res->GetFirstAtomIndex(),p_res->GetNumberOfAtoms());
         }
     }
 }
@@ -466,15 +432,11 @@ void CAmberMaskASelection::SelectResidueByName(const char* p_name)
         }
     }
 
-    for(int i=0; i < Owner->GetTopology()->ResidueList.GetNumberOfResidues(); i++) {
-        CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(i);
-
-        if( strncmp(p_res->GetName(),p_name,search_len) == 0 ) {
-            for(int j = 0; j < p_res->GetNumberOfAtoms(); j++) {
-                int aindex = j + p_res->GetFirstAtomIndex();
-                Atoms[aindex] = Owner->GetTopology()->AtomList.GetAtom(aindex);
-            }
-        }
+    int         count;
+    const int*  p_list = Owner->GetTopology()->FindResiduesByName(p_name,search_len,count);
+    for(int i=0; i < count; i++) {
+        CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(p_list[i]);
+        Atoms.SetRange(p_res->GetFirstAtomIndex(),p_res->GetNumberOfAtoms());
     }
 }
 
@@ -492,15 +454,14 @@ bool CAmberMaskASelection::SelectAtomByDistanceFromOrigin(SOperator dist_oper,do
     double dist2 = dist*dist;
 
     for(int i=0; i < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); i++) {
-        CAmberAtom* p_atom = Owner->GetTopology()->AtomList.GetAtom(i);
         CPoint pos = Owner->GetCoordinates()->GetPosition(i);
         double ldist2 = Square(pos);
         switch(dist_oper) {
         case O_ALT:
-            if( ldist2 < dist2 ) Atoms[i] = p_atom;
+            if( ldist2 < dist2 ) Atoms.Set(i);
             break;
         case O_AGT:
-            if( ldist2 > dist2 ) Atoms[i] = p_atom;
+            if( ldist2 > dist2 ) Atoms.Set(i);
             break;
         case O_RLT:
         case O_RGT:
@@ -522,24 +483,23 @@ bool CAmberMaskASelection::SelectAtomByDistanceFromCentreOfBox(SOperator dist_op
         return(false);
     }
 
-    if( Owner->GetTopology()->BoxInfo.GetType() == AMBER_BOX_NONE ) {
+    if( Owner->GetSnapshotBox() == NULL ) {
         ES_ERROR("cbox requires box");
         return(false);
     }
 
     double dist2 = dist*dist;
-    CPoint cbox = Owner->GetTopology()->BoxInfo.GetBoxCenter();
+    CPoint cbox = Owner->GetSnapshotBox()->GetBoxCenter();
 
     for(int i=0; i < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); i++) {
-        CAmberAtom* p_atom = Owner->GetTopology()->AtomList.GetAtom(i);
         CPoint pos = Owner->GetCoordinates()->GetPosition(i);
         double ldist2 = Square(pos-cbox);
         switch(dist_oper) {
         case O_ALT:
-            if( ldist2 < dist2 ) Atoms[i] = p_atom;
+            if( ldist2 < dist2 ) Atoms.Set(i);
             break;
         case O_AGT:
-            if( ldist2 > dist2 ) Atoms[i] = p_atom;
+            if( ldist2 > dist2 ) Atoms.Set(i);
             break;
         case O_RLT:
         case O_RGT:
@@ -562,38 +522,33 @@ bool CAmberMaskASelection::SelectAtomByDistanceFromList(CAmberMaskASelection* p_
         return(false);
     }
 
-    double dist2 = dist*dist;
+    int natoms = Owner->GetTopology()->AtomList.GetNumberOfAtoms();
 
-    for(int i=0; i < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); i++) {
-        CAmberAtom* p_atom1 = Owner->GetTopology()->AtomList.GetAtom(i);
-        CPoint pos1 = Owner->GetCoordinates()->GetPosition(i);
-
-        for(int j=0; j < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); j++) {
-            if( p_left->Atoms[j] == NULL ) continue;
-            CPoint pos2 = Owner->GetCoordinates()->GetPosition(j);
-            double ldist2 = Square(pos2-pos1);
-            bool set = false;
-            switch(dist_oper) {
-            case O_ALT:
-                if( ldist2 < dist2 ) {
-                    Atoms[i] = p_atom1;
-                    set = true;
-                }
-                break;
-            case O_AGT:
-                if( ldist2 > dist2 ) {
-                    Atoms[i] = p_atom1;
-                    set = true;
-                }
-                break;
-            case O_RLT:
-            case O_RGT:
-            default:
-                ES_ERROR("incorrect operator");
-                return(false);
-            }
-            if( set == true ) break;
-        }
+    std::vector<int> refs;
+    p_left->Atoms.GetIndexes(refs);
+
+    std::vector<char> flags;
+    bool              result;
+
+    switch(dist_oper) {
+    case O_ALT:
+        result = CAmberMaskDistance::FlagAtomsCloserThan(Owner->GetTopology(),Owner->GetCoordinates(),
+                                                         Owner->GetPeriodicBox(),refs,dist,flags);
+        break;
+    case O_AGT:
+        result = CAmberMaskDistance::FlagAtomsFartherThan(Owner->GetTopology(),Owner->GetCoordinates(),
+                                                          Owner->GetPeriodicBox(),refs,dist,flags);
+        break;
+    case O_RLT:
+    case O_RGT:
+    default:
+        ES_ERROR("incorrect operator");
+        return(false);
+    }
+    if( result == false ) return(false);
+
+    for(int i=0; i < natoms; i++) {
+        if( flags[i] ) Atoms.Set(i);
     }
 
     return(true);
@@ -613,8 +568,7 @@ bool CAmberMaskASelection::SelectAtomByDistanceFromCOM(CAmberMaskASelection* p_l
     CPoint     com;
     double     tmass = 0.0;
 
-    for(int i=0; i < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); i++) {
-        if( p_left->Atoms[i] == NULL ) continue;
+    for(int i = p_left->Atoms.FindNext(0); i >= 0; i = p_left->Atoms.FindNext(i+1)) {
         CAmberAtom* p_atom = Owner->GetTopology()->AtomList.GetAtom(i);
         double mass = p_atom->GetMass();
         com += Owner->GetCoordinates()->GetPosition(i)*mass;
@@ -628,15 +582,14 @@ bool CAmberMaskASelection::SelectAtomByDistanceFromCOM(CAmberMaskASelection* p_l
 
     // select atoms
     for(int i=0; i < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); i++) {
-        CAmberAtom* p_atom = Owner->GetTopology()->AtomList.GetAtom(i);
         CPoint pos = Owner->GetCoordinates()->GetPosition(i);
         double ldist2 = Square(pos-com);
         switch(dist_oper) {
         case O_ALT:
-            if( ldist2 < dist2 ) Atoms[i] = p_atom;
+            if( ldist2 < dist2 ) Atoms.Set(i);
             break;
         case O_AGT:
-            if( ldist2 > dist2 ) Atoms[i] = p_atom;
+            if( ldist2 > dist2 ) Atoms.Set(i);
             break;
         case O_RLT:
         case O_RGT:
@@ -705,10 +658,7 @@ bool CAmberMaskASelection::SelectResidueByDistanceFromOrigin(SOperator dist_oper
 
         // select residue
         if( set ) {
-            for(int j = 0; j < p_res->GetNumberOfAtoms(); j++) {
-                int aindex = j + p_res->GetFirstAtomIndex();
-                Atoms[aindex] = Owner->GetTopology()->AtomList.GetAtom(aindex);
-            }
+            Atoms.SetRange(p_res->GetFirstAtomIndex(),p_res->GetNumberOfAtoms());
         }
     }
 
@@ -724,13 +674,13 @@ bool CAmberMaskASelection::SelectResidueByDistanceFromCentreOfBox(SOperator dist
         return(false);
     }
 
-    if( Owner->GetTopology()->BoxInfo.GetType() == AMBER_BOX_NONE ) {
+    if( Owner->GetSnapshotBox() == NULL ) {
         ES_ERROR("cbox requires box");
         return(false);
     }
 
     double dist2 = dist*dist;
-    CPoint cbox = Owner->GetTopology()->BoxInfo.GetBoxCenter();
+    CPoint cbox = Owner->GetSnapshotBox()->GetBoxCenter();
 
     for(int i=0; i < Owner->GetTopology()->ResidueList.GetNumberOfResidues(); i++) {
         CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(i);
@@ -760,10 +710,7 @@ bool CAmberMaskASelection::SelectResidueByDistanceFromCentreOfBox(SOperator dist
 
         // select residue
         if( set ) {
-            for(int j = 0; j < p_res->GetNumberOfAtoms(); j++) {
-                int aindex = j + p_res->GetFirstAtomIndex();
-                Atoms[aindex] = Owner->GetTopology()->AtomList.GetAtom(aindex);
-            }
+            Atoms.SetRange(p_res->GetFirstAtomIndex(),p_res->GetNumberOfAtoms());
         }
     }
 
@@ -780,52 +727,44 @@ bool CAmberMaskASelection::SelectResidueByDistanceFromList(CAmberMaskASelection*
         return(false);
     }
 
-    double dist2 = dist*dist;
+    std::vector<int> refs;
+    p_left->Atoms.GetIndexes(refs);
+
+    std::vector<char> flags;
+    bool              result;
+
+    switch(dist_oper) {
+    case O_RLT:
+        result = CAmberMaskDistance::FlagAtomsCloserThan(Owner->GetTopology(),Owner->GetCoordinates(),
+                                                         Owner->GetPeriodicBox(),refs,dist,flags);
+        break;
+    case O_RGT:
+        result = CAmberMaskDistance::FlagAtomsFartherThan(Owner->GetTopology(),Owner->GetCoordinates(),
+                                                          Owner->GetPeriodicBox(),refs,dist,flags);
+        break;
+    case O_ALT:
+    case O_AGT:
+    default:
+        ES_ERROR("incorrect operator");
+        return(false);
+    }
+    if( result == false ) return(false);
 
     for(int i=0; i < Owner->GetTopology()->ResidueList.GetNumberOfResidues(); i++) {
         CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(i);
 
+        // check any atom
         bool set = false;
-
-        // check any distance
         for(int j = 0; j < p_res->GetNumberOfAtoms(); j++) {
-            int aindex = j + p_res->GetFirstAtomIndex();
-            CPoint pos1 = Owner->GetCoordinates()->GetPosition(aindex);
-
-            for(int k=0; k < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); k++) {
-                if( p_left->Atoms[k] == NULL ) continue;
-                CPoint pos2 = Owner->GetCoordinates()->GetPosition(k);
-                double ldist2 = Square(pos2-pos1);
-
-                switch(dist_oper) {
-                case O_RLT:
-                    if( ldist2 < dist2 ) {
-                        set = true;
-                    }
-                    break;
-                case O_RGT:
-                    if( ldist2 > dist2 ) {
-                        set = true;
-                    }
-                    break;
-                case O_ALT:
-                case O_AGT:
-                default:
-                    ES_ERROR("incorrect operator");
-                    return(false);
-                }
-                if( set == true ) break;
+            if( flags[j + p_res->GetFirstAtomIndex()] ) {
+                set = true;
+                break;
             }
-
-            if( set == true ) break;
         }
 
         // select residue
         if( set ) {
-            for(int j = 0; j < p_res->GetNumberOfAtoms(); j++) {
-                int aindex = j + p_res->GetFirstAtomIndex();
-                Atoms[aindex] = Owner->GetTopology()->AtomList.GetAtom(aindex);
-            }
+            Atoms.SetRange(p_res->GetFirstAtomIndex(),p_res->GetNumberOfAtoms());
         }
     }
 
@@ -846,8 +785,7 @@ bool CAmberMaskASelection::SelectResidueByDistanceFromCOM(CAmberMaskASelection*
     CPoint     com;
     double     tmass = 0.0;
 
-    for(int i=0; i < Owner->GetTopology()->AtomList.GetNumberOfAtoms(); i++) {
-        if( p_left->Atoms[i] == NULL ) continue;
+    for(int i = p_left->Atoms.FindNext(0); i >= 0; i = p_left->Atoms.FindNext(i+1)) {
         CAmberAtom* p_atom = Owner->GetTopology()->AtomList.GetAtom(i);
         double mass = p_atom->GetMass();
         com += Owner->GetCoordinates()->GetPosition(i)*mass;
@@ -887,10 +825,7 @@ bool CAmberMaskASelection::SelectResidueByDistanceFromCOM(CAmberMaskASelection*
 
         // select residue
         if( set ) {
-            for(int j = 0; j < p_res->GetNumberOfAtoms(); j++) {
-                int aindex = j + p_res->GetFirstAtomIndex();
-                Atoms[aindex] = Owner->GetTopology()->AtomList.GetAtom(aindex);
-            }
+            Atoms.SetRange(p_res->GetFirstAtomIndex(),p_res->GetNumberOfAtoms());
         }
     }
 
@@ -919,23 +854,23 @@ bool CAmberMaskASelection::SelectResidueByDistanceFromPlane(CAmberMaskASelection
 
 int CAmberMaskASelection::GetNumberOfSelectedAtoms(void)
 {
-    if( Atoms == NULL ) return(0);
-
-    int num_of_select_atoms = 0;
+    return(Atoms.Count());
+}
 
-    for(int i=0; i < Owner->GetNumberOfTopologyAtoms(); i++) {
-        if( Atoms[i] != NULL ) num_of_select_atoms++;
-    }
+//------------------------------------------------------------------------------
 
-    return(num_of_select_atoms);
+CAmberAtom* CAmberMaskASelection::GetSelectedAtom(int index)
+{
+    if( Atoms.GetSize() == 0 ) return(NULL);
+    if( Atoms.Test(index) == false ) return(NULL);
+    return(Owner->GetTopology()->AtomList.GetAtom(index));
 }
 
 //------------------------------------------------------------------------------
 
-CAmberAtom* CAmberMaskASelection::GetSelectedAtom(int index)
+const CAmberBitSet& CAmberMaskASelection::GetSelectionBits(void) const
 {
-    if( Atoms == NULL ) return(NULL);
-    return(Atoms[index]);
+    return(Atoms);
 }
 
 //==============================================================================
@@ -23,6 +23,7 @@
 // =============================================================================
 
 #include <ASLMainHeader.hpp>
+#include <AmberBitSet.hpp>
 #include "maskparser/AmberMaskParser.hpp"
 
 //---------------------------------------------------------------------------
@@ -46,10 +47,13 @@ public:
     int             GetNumberOfSelectedAtoms(void);
     CAmberAtom*     GetSelectedAtom(int index);
 
+    /// return selection as a bit set indexed by atom indexes
+    const CAmberBitSet& GetSelectionBits(void) const;
+
 // section of private data ----------------------------------------------------
 private:
     CAmberMaskAtoms*        Owner;
-    CAmberAtom**            Atoms;
+    CAmberBitSet            Atoms;
 
     static bool ExpandAndReduceTree(CAmberMaskASelection* p_root,
             struct SExpression* p_expr);
@@ -84,6 +88,8 @@ private:
 
     int   strnlen(const char* p_s1,int len);
     bool  firstmatch(const char* p_s1,const char* p_s2,int len);
+
+    friend class CAmberCompiledMask;
 };
 
 //---------------------------------------------------------------------------
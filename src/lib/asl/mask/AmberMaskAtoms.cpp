@@ -30,6 +30,7 @@
 #include <AmberRestart.hpp>
 #include <FortranIO.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberMaskDistance.hpp>
 #include <AmberMaskASelection.hpp>
 
 #include "maskparser/AmberMaskParser.hpp"
@@ -42,6 +43,7 @@ CAmberMaskAtoms::CAmberMaskAtoms(void)
 {
     Topology = NULL;
     Coordinates = NULL;
+    PeriodicDistances = false;
     Selection = NULL;
 }
 
@@ -92,6 +94,47 @@ CAmberRestart* CAmberMaskAtoms::GetCoordinates(void) const
     return(Coordinates);
 }
 
+//------------------------------------------------------------------------------
+
+void CAmberMaskAtoms::SetPeriodicDistances(bool set)
+{
+    PeriodicDistances = set;
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberMaskAtoms::IsPeriodicDistances(void) const
+{
+    return(PeriodicDistances);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberMaskAtoms::UpdateSnapshotBox(void)
+{
+    if( Topology == NULL ) {
+        SnapshotBox.FreeFields();
+        return;
+    }
+    CAmberMaskDistance::InitSnapshotBox(Topology,Coordinates,SnapshotBox);
+}
+
+//------------------------------------------------------------------------------
+
+CAmberBox* CAmberMaskAtoms::GetSnapshotBox(void)
+{
+    if( SnapshotBox.GetType() == AMBER_BOX_NONE ) return(NULL);
+    return(&SnapshotBox);
+}
+
+//------------------------------------------------------------------------------
+
+CAmberBox* CAmberMaskAtoms::GetPeriodicBox(void)
+{
+    if( PeriodicDistances == false ) return(NULL);
+    return(GetSnapshotBox());
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -124,12 +167,8 @@ bool CAmberMaskAtoms::SetMask(const CSmallString& mask)
         return(false);
     }
 
-    // update box information, required by distance operators
-    if( Coordinates != NULL ) {
-        Topology->BoxInfo.SetBoxDimmensions(Coordinates->GetBox());
-        Topology->BoxInfo.SetBoxAngles(Coordinates->GetAngles());
-        Topology->BoxInfo.UpdateBoxMatrices();
-    }
+    // update box of snapshot, required by distance operators
+    UpdateSnapshotBox();
 
     // remove previous selection -----------------------------
     Mask = mask;
@@ -138,18 +177,20 @@ bool CAmberMaskAtoms::SetMask(const CSmallString& mask)
     SelectedAtoms.clear();
 
     // init mask parser
-    init_mask();
+    struct SMaskParser parser;
+    init_mask(&parser);
 
     // parse mask
-    if( parse_mask(Mask) != 0 ) {
-        free_mask_tree();
+    if( parse_mask(&parser,Mask) != 0 ) {
+        free_mask_tree(&parser);
         ES_ERROR("unable to parse mask");
         return(false);
     }
 
     // get top mask expression
-    struct SExpression* p_top_expr = get_expression_tree();
+    struct SExpression* p_top_expr = get_expression_tree(&parser);
     if( p_top_expr == NULL ) {
+        free_mask_tree(&parser);
         ES_ERROR("top expression is NULL");
         return(false);
     }
@@ -158,25 +199,26 @@ bool CAmberMaskAtoms::SetMask(const CSmallString& mask)
     try {
         Selection = new CAmberMaskASelection(this);
     } catch(...) {
-        free_mask_tree();
+        free_mask_tree(&parser);
         ES_ERROR("unable to allocate root selection");
         return(false);
     }
 
     if( Selection->ExpandAndReduceTree(p_top_expr) == false ) {
         ES_ERROR("unable to expand and reduce expression tree");
-        free_mask_tree();
+        free_mask_tree(&parser);
         return(false);
     }
 
     // free parser data
-    free_mask_tree();
+    free_mask_tree(&parser);
 
-    for(int i=0; i < GetNumberOfTopologyAtoms(); i++){
-        CAmberAtom* p_atom = GetSelectedAtom(i);
-        if( p_atom ){
-            SelectedAtoms.push_back(p_atom);
-        }
+    std::vector<int> indexes;
+    Selection->GetSelectionBits().GetIndexes(indexes);
+
+    SelectedAtoms.reserve(indexes.size());
+    for(size_t i=0; i < indexes.size(); i++) {
+        SelectedAtoms.push_back(Topology->AtomList.GetAtom(indexes[i]));
     }
 
     return(true);
@@ -24,6 +24,7 @@
 
 #include <SmallString.hpp>
 #include <ASLMainHeader.hpp>
+#include <AmberBox.hpp>
 #include <vector>
 
 //---------------------------------------------------------------------------
@@ -53,6 +54,21 @@ public:
     bool            AssignCoordinates(CAmberRestart* p_crd);
     CAmberRestart*  GetCoordinates(void) const;
 
+    /// use minimum image convention in distance selections
+    void            SetPeriodicDistances(bool set);
+    bool            IsPeriodicDistances(void) const;
+
+    /// take box of snapshot from topology and assigned coordinates
+    /*! it is called by SetMask, the box of topology is not changed
+    */
+    void            UpdateSnapshotBox(void);
+
+    /// return box of snapshot, NULL is returned if topology does not contain box
+    CAmberBox*      GetSnapshotBox(void);
+
+    /// return box for minimum image convention in distance selections or NULL
+    CAmberBox*      GetPeriodicBox(void);
+
     // mask setup --------------------------------------------------------------
     /// select all atoms
     bool SelectAllAtoms(void);
@@ -95,6 +111,8 @@ public:
 private:
     CAmberTopology*             Topology;
     CAmberRestart*              Coordinates;
+    bool                        PeriodicDistances;
+    CAmberBox                   SnapshotBox;
     CSmallString                Mask;
     CAmberMaskASelection*       Selection;
     std::vector<CAmberAtom*>    SelectedAtoms;
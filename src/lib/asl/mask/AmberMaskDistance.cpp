@@ -0,0 +1,175 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberMaskDistance.hpp>
+#include <AmberTopology.hpp>
+#include <AmberRestart.hpp>
+#include <AmberCellList.hpp>
+#include <ErrorSystem.hpp>
+#include <float.h>
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberBox* CAmberMaskDistance::InitSnapshotBox(CAmberTopology* p_top,CAmberRestart* p_crd,
+                                               CAmberBox& box)
+{
+    box.FreeFields();
+    box.SetType(p_top->BoxInfo.GetType());
+    if( box.GetType() == AMBER_BOX_NONE ) return(NULL);
+
+    box.SetBoxDimmensions(p_top->BoxInfo.GetBoxDimmensions());
+    box.SetBoxAngles(p_top->BoxInfo.GetBoxAngles());
+    if( (p_crd != NULL) && p_crd->IsBoxPresent() ) {
+        box.SetBoxDimmensions(p_crd->GetBox());
+        box.SetBoxAngles(p_crd->GetAngles());
+    }
+    box.UpdateBoxMatrices();
+    return(&box);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberMaskDistance::FlagAtomsCloserThan(CAmberTopology* p_top,CAmberRestart* p_crd,
+                                             CAmberBox* p_box,const std::vector<int>& refs,
+                                             double dist,std::vector<char>& flags)
+{
+    int natoms = p_crd->GetNumberOfAtoms();
+    flags.assign(natoms,0);
+
+    if( natoms != p_top->AtomList.GetNumberOfAtoms() ) {
+        ES_ERROR("coordinates and topology do not match");
+        return(false);
+    }
+
+    if( refs.empty() || (dist == 0.0) ) return(true);
+    if( dist < 0.0 ) dist = -dist;
+
+    // cell list cannot be used for distances larger than inscribed sphere
+    if( (p_box != NULL) && (dist > p_box->GetLargestSphereRadius()) ) {
+        double dist2 = dist*dist;
+        for(int i=0; i < natoms; i++) {
+            CPoint pos1 = p_crd->GetPosition(i);
+            for(unsigned int k=0; k < refs.size(); k++) {
+                CPoint d = p_box->ImageVector(p_crd->GetPosition(refs[k]) - pos1);
+                if( Square(d) < dist2 ) {
+                    flags[i] = 1;
+                    break;
+                }
+            }
+        }
+        return(true);
+    }
+
+    CAmberCellList  cells;
+    std::vector<int> list;
+
+    if( cells.Build(p_crd,p_box,dist) == false ) {
+        ES_ERROR("unable to build cell list");
+        return(false);
+    }
+    if( cells.GetAtomsAroundSet(refs,dist,list,true) == false ) {
+        ES_ERROR("unable to find atoms around set");
+        return(false);
+    }
+
+    for(unsigned int k=0; k < list.size(); k++) flags[list[k]] = 1;
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberMaskDistance::FlagAtomsFartherThan(CAmberTopology* p_top,CAmberRestart* p_crd,
+                                              CAmberBox* p_box,const std::vector<int>& refs,
+                                              double dist,std::vector<char>& flags)
+{
+    int natoms = p_crd->GetNumberOfAtoms();
+    flags.assign(natoms,0);
+
+    if( natoms != p_top->AtomList.GetNumberOfAtoms() ) {
+        ES_ERROR("coordinates and topology do not match");
+        return(false);
+    }
+
+    if( refs.empty() ) return(true);
+
+    double dist2 = dist*dist;
+
+    if( p_box != NULL ) {
+        for(int i=0; i < natoms; i++) {
+            CPoint pos1 = p_crd->GetPosition(i);
+            for(unsigned int k=0; k < refs.size(); k++) {
+                CPoint d = p_box->ImageVector(p_crd->GetPosition(refs[k]) - pos1);
+                if( Square(d) > dist2 ) {
+                    flags[i] = 1;
+                    break;
+                }
+            }
+        }
+        return(true);
+    }
+
+    // bounding box of reference atoms - if its farthest corner is not
+    // farther than dist, no reference atom can be
+    const double* p_pos = p_crd->GetCoordinatesBuffer();
+    double minc[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+    double maxc[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+    for(unsigned int k=0; k < refs.size(); k++) {
+        for(int a=0; a < 3; a++) {
+            double c = p_pos[3*refs[k]+a];
+            if( c < minc[a] ) minc[a] = c;
+            if( c > maxc[a] ) maxc[a] = c;
+        }
+    }
+
+    for(int i=0; i < natoms; i++) {
+        const double* p_pos1 = p_pos + 3*i;
+        double far2 = 0.0;
+        for(int a=0; a < 3; a++) {
+            double d1 = p_pos1[a] - minc[a];
+            double d2 = p_pos1[a] - maxc[a];
+            far2 += d1*d1 > d2*d2 ? d1*d1 : d2*d2;
+        }
+        if( far2 <= dist2 ) continue;
+
+        for(unsigned int k=0; k < refs.size(); k++) {
+            const double* p_pos2 = p_pos + 3*refs[k];
+            double dx = p_pos2[0] - p_pos1[0];
+            double dy = p_pos2[1] - p_pos1[1];
+            double dz = p_pos2[2] - p_pos1[2];
+            if( dx*dx + dy*dy + dz*dz > dist2 ) {
+                flags[i] = 1;
+                break;
+            }
+        }
+    }
+
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
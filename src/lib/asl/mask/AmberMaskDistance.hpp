@@ -0,0 +1,66 @@
+#ifndef AmberMaskDistanceH
+#define AmberMaskDistanceH
+/** \ingroup AmberMask*/
+/*! \file AmberMaskDistance.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+#include <ASLMainHeader.hpp>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+class CAmberTopology;
+class CAmberRestart;
+class CAmberBox;
+
+//---------------------------------------------------------------------------
+
+/// distance queries for mask selections
+
+/*! atoms closer than the distance are found by a cell list built for each
+    query (linear time), minimum image convention is applied if p_box is
+    not NULL, the box is never taken from the topology directly, thus
+    several masks can be evaluated over one topology concurrently
+*/
+
+class ASL_PACKAGE CAmberMaskDistance {
+public:
+    /// init box of snapshot from topology and coordinates
+    /*! only the box geometry is set, box dimensions are taken from
+        coordinates if they are present, NULL is returned if the topology
+        does not contain box
+    */
+    static CAmberBox* InitSnapshotBox(CAmberTopology* p_top,CAmberRestart* p_crd,
+                                      CAmberBox& box);
+
+    /// flag atoms closer than dist to any atom from refs
+    static bool FlagAtomsCloserThan(CAmberTopology* p_top,CAmberRestart* p_crd,
+                                    CAmberBox* p_box,const std::vector<int>& refs,
+                                    double dist,std::vector<char>& flags);
+
+    /// flag atoms farther than dist from any atom from refs
+    static bool FlagAtomsFartherThan(CAmberTopology* p_top,CAmberRestart* p_crd,
+                                     CAmberBox* p_box,const std::vector<int>& refs,
+                                     double dist,std::vector<char>& flags);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
@@ -27,6 +27,7 @@
 #include <AmberTopology.hpp>
 #include <AmberMaskRSelection.hpp>
 #include <AmberMaskResidues.hpp>
+#include <AmberMaskDistance.hpp>
 #include <AmberRestart.hpp>
 
 #include "maskparser/AmberMaskParser.hpp"
@@ -370,13 +371,11 @@ void CAmberMaskRSelection::SelectResidueByName(const char* p_name)
         }
     }
 
-    for(int i=0; i < Owner->GetTopology()->ResidueList.GetNumberOfResidues(); i++) {
-        CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(i);
-
-        if( strncmp(p_res->GetName(),p_name,search_len) == 0 ) {
-            // select residue
-            Residues[i] = p_res;
-        }
+    // use index of names - the cost is proportional to the number of matches
+    int         count;
+    const int*  p_list = Owner->GetTopology()->FindResiduesByName(p_name,search_len,count);
+    for(int i=0; i < count; i++) {
+        Residues[p_list[i]] = Owner->GetTopology()->ResidueList.GetResidue(p_list[i]);
     }
 }
 
@@ -437,13 +436,13 @@ bool CAmberMaskRSelection::SelectResidueByDistanceFromCentreOfBox(
         return(false);
     }
 
-    if( Owner->GetTopology()->BoxInfo.GetType() == AMBER_BOX_NONE ) {
+    if( Owner->GetSnapshotBox() == NULL ) {
         ES_ERROR("cbox requires box");
         return(false);
     }
 
     double dist2 = dist*dist;
-    CPoint cbox = Owner->GetTopology()->BoxInfo.GetBoxCenter();
+    CPoint cbox = Owner->GetSnapshotBox()->GetBoxCenter();
 
     for(int i=0; i < Owner->GetTopology()->ResidueList.GetNumberOfResidues(); i++) {
         CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(i);
@@ -489,53 +488,46 @@ bool CAmberMaskRSelection::SelectResidueByDistanceFromList(
         return(false);
     }
 
-    double dist2 = dist*dist;
+    int nres = Owner->GetTopology()->ResidueList.GetNumberOfResidues();
 
-    for(int i=0; i < Owner->GetTopology()->ResidueList.GetNumberOfResidues(); i++) {
-        CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(i);
+    std::vector<int> refs;
+    for(int k=0; k < nres; k++) {
+        if( p_left->Residues[k] == NULL ) continue;
+        for(int l = 0; l < p_left->Residues[k]->GetNumberOfAtoms(); l++) {
+            refs.push_back(l + p_left->Residues[k]->GetFirstAtomIndex());
+        }
+    }
 
-        bool set = false;
+    std::vector<char> flags;
+    bool              result;
 
+    switch(dist_oper) {
+    case O_RLT:
+        result = CAmberMaskDistance::FlagAtomsCloserThan(Owner->GetTopology(),Owner->GetCoordinates(),
+                                                         Owner->GetPeriodicBox(),refs,dist,flags);
+        break;
+    case O_RGT:
+        result = CAmberMaskDistance::FlagAtomsFartherThan(Owner->GetTopology(),Owner->GetCoordinates(),
+                                                          Owner->GetPeriodicBox(),refs,dist,flags);
+        break;
+    case O_ALT:
+    case O_AGT:
+    default:
+        ES_ERROR("incorrect operator");
+        return(false);
+    }
+    if( result == false ) return(false);
+
+    for(int i=0; i < nres; i++) {
+        CAmberResidue* p_res = Owner->GetTopology()->ResidueList.GetResidue(i);
+
+        // check any atom
         for(int j = 0; j < p_res->GetNumberOfAtoms(); j++) {
-            int aindex = j + p_res->GetFirstAtomIndex();
-            CPoint pos1 = Owner->GetCoordinates()->GetPosition(aindex);
-
-            // check any distance
-            for(int k=0; k < Owner->GetTopology()->ResidueList.GetNumberOfResidues(); k++) {
-                if( p_left->Residues[k] == NULL ) continue;
-
-                for(int l = 0; l < p_left->Residues[k]->GetNumberOfAtoms(); l++) {
-                    int bindex = l + p_left->Residues[k]->GetFirstAtomIndex();
-
-                    CPoint pos2 = Owner->GetCoordinates()->GetPosition(bindex);
-                    double ldist2 = Square(pos2-pos1);
-
-                    switch(dist_oper) {
-                    case O_RLT:
-                        if( ldist2 < dist2 ) {
-                            set = true;
-                        }
-                        break;
-                    case O_RGT:
-                        if( ldist2 > dist2 ) {
-                            set = true;
-                        }
-                        break;
-                    case O_ALT:
-                    case O_AGT:
-                    default:
-                        ES_ERROR("incorrect operator");
-                        return(false);
-                    }
-                    if( set == true ) break;
-                }
-                if( set == true ) break;
+            if( flags[j + p_res->GetFirstAtomIndex()] ) {
+                Residues[i] = p_res;
+                break;
             }
-            if( set == true ) break;
         }
-
-        // select residue
-        if( set ) Residues[i] = p_res;
     }
 
     return(true);
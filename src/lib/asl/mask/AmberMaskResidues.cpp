@@ -31,6 +31,7 @@
 #include <AmberMaskRSelection.hpp>
 #include <FortranIO.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberMaskDistance.hpp>
 
 #include "maskparser/AmberMaskParser.hpp"
 
@@ -42,6 +43,7 @@ CAmberMaskResidues::CAmberMaskResidues(void)
 {
     Topology = NULL;
     Coordinates = NULL;
+    PeriodicDistances = false;
     Selection = NULL;
 }
 
@@ -92,6 +94,47 @@ CAmberRestart* CAmberMaskResidues::GetCoordinates(void) const
     return(Coordinates);
 }
 
+//------------------------------------------------------------------------------
+
+void CAmberMaskResidues::SetPeriodicDistances(bool set)
+{
+    PeriodicDistances = set;
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberMaskResidues::IsPeriodicDistances(void) const
+{
+    return(PeriodicDistances);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberMaskResidues::UpdateSnapshotBox(void)
+{
+    if( Topology == NULL ) {
+        SnapshotBox.FreeFields();
+        return;
+    }
+    CAmberMaskDistance::InitSnapshotBox(Topology,Coordinates,SnapshotBox);
+}
+
+//------------------------------------------------------------------------------
+
+CAmberBox* CAmberMaskResidues::GetSnapshotBox(void)
+{
+    if( SnapshotBox.GetType() == AMBER_BOX_NONE ) return(NULL);
+    return(&SnapshotBox);
+}
+
+//------------------------------------------------------------------------------
+
+CAmberBox* CAmberMaskResidues::GetPeriodicBox(void)
+{
+    if( PeriodicDistances == false ) return(NULL);
+    return(GetSnapshotBox());
+}
+
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
@@ -124,12 +167,8 @@ bool CAmberMaskResidues::SetMask(const CSmallString& mask)
         return(false);
     }
 
-    // update box information, required by distance operators
-    if( Coordinates != NULL ) {
-        Topology->BoxInfo.SetBoxDimmensions(Coordinates->GetBox());
-        Topology->BoxInfo.SetBoxAngles(Coordinates->GetAngles());
-        Topology->BoxInfo.UpdateBoxMatrices();
-    }
+    // update box of snapshot, required by distance operators
+    UpdateSnapshotBox();
 
     // remove previous selection -----------------------------
     Mask = mask;
@@ -138,18 +177,20 @@ bool CAmberMaskResidues::SetMask(const CSmallString& mask)
     SelectedResidues.clear();
 
     // init mask parser
-    init_mask();
+    struct SMaskParser parser;
+    init_mask(&parser);
 
     // parse mask
-    if( parse_mask(Mask) != 0 ) {
-        free_mask_tree();
+    if( parse_mask(&parser,Mask) != 0 ) {
+        free_mask_tree(&parser);
         ES_ERROR("unable to parse mask");
         return(false);
     }
 
     // get top mask expression
-    struct SExpression* p_top_expr = get_expression_tree();
+    struct SExpression* p_top_expr = get_expression_tree(&parser);
     if( p_top_expr == NULL ) {
+        free_mask_tree(&parser);
         ES_ERROR("top expression is NULL");
         return(false);
     }
@@ -158,19 +199,19 @@ bool CAmberMaskResidues::SetMask(const CSmallString& mask)
     try {
         Selection = new CAmberMaskRSelection(this);
     } catch(...) {
-        free_mask_tree();
+        free_mask_tree(&parser);
         ES_ERROR("unable to allocate root selection");
         return(false);
     }
 
     if( Selection->ExpandAndReduceTree(p_top_expr) == false ) {
         ES_ERROR("unable to expand and reduce expression tree");
-        free_mask_tree();
+        free_mask_tree(&parser);
         return(false);
     }
 
     // free parser data
-    free_mask_tree();
+    free_mask_tree(&parser);
 
     for(int i=0; i < GetNumberOfTopologyResidues(); i++){
         CAmberResidue* p_res = GetSelectedResidue(i);
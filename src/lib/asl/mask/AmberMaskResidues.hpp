@@ -25,6 +25,7 @@
 #include <SmallString.hpp>
 #include <SimpleList.hpp>
 #include <ASLMainHeader.hpp>
+#include <AmberBox.hpp>
 #include <vector>
 
 //---------------------------------------------------------------------------
@@ -54,6 +55,21 @@ public:
     bool            AssignCoordinates(CAmberRestart* p_crd);
     CAmberRestart*  GetCoordinates(void) const;
 
+    /// use minimum image convention in distance selections
+    void            SetPeriodicDistances(bool set);
+    bool            IsPeriodicDistances(void) const;
+
+    /// take box of snapshot from topology and assigned coordinates
+    /*! it is called by SetMask, the box of topology is not changed
+    */
+    void            UpdateSnapshotBox(void);
+
+    /// return box of snapshot, NULL is returned if topology does not contain box
+    CAmberBox*      GetSnapshotBox(void);
+
+    /// return box for minimum image convention in distance selections or NULL
+    CAmberBox*      GetPeriodicBox(void);
+
     // mask setup --------------------------------------------------------------
     /// select all residues
     bool SelectAllResidues(void);
@@ -96,6 +112,8 @@ public:
 private:
     CAmberTopology*                 Topology;
     CAmberRestart*                  Coordinates;
+    bool                            PeriodicDistances;
+    CAmberBox                       SnapshotBox;
     CSmallString                    Mask;
     CAmberMaskRSelection*           Selection;
     std::vector<CAmberResidue*>     SelectedResidues;
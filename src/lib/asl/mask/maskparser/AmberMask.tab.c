@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -61,8 +66,8 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 6 "AmberMask.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 6 "AmberMask.y"
 
 #include <malloc.h>
 #include <stdlib.h>
@@ -70,130 +75,166 @@
 #include <stdio.h>
 #include <string.h>
 #include "AmberMaskParser.hpp"
-#define YYERROR_VERBOSE
 
-#line 76 "AmberMask.tab.c" /* yacc.c:339  */
+#line 80 "AmberMask.tab.c"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "AmberMask.tab.h".  */
-#ifndef YY_YY_AMBERMASK_TAB_H_INCLUDED
-# define YY_YY_AMBERMASK_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    STRING = 258,
-    INUMBER = 259,
-    RNUMBER = 260,
-    STAR = 261,
-    COMMA = 262,
-    RANGE = 263,
-    RSELECTOR = 264,
-    ASELECTOR = 265,
-    TSELECTOR = 266,
-    RLT = 267,
-    RGT = 268,
-    ALT = 269,
-    AGT = 270,
-    NOT = 271,
-    AND = 272,
-    OR = 273,
-    RBRA = 274,
-    LBRA = 275,
-    ERROR = 276,
-    ORIGIN = 277,
-    CBOX = 278,
-    LIST = 279,
-    COM = 280,
-    PLANE = 281
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE YYSTYPE;
-union YYSTYPE
+#include "AmberMask.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 16 "AmberMask.y" /* yacc.c:355  */
-
-    SGrammar                gValue;
-    SInteger                iValue;
-    SReal                   rValue;
-    SString                 sValue;
-    struct SListItem*       itemValue;
-    struct SList*           listValue;
-    struct SSelection*      selValue;
-    struct SExpression*     exprValue;
-    
-
-#line 155 "AmberMask.tab.c" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_STRING = 3,                     /* STRING  */
+  YYSYMBOL_INUMBER = 4,                    /* INUMBER  */
+  YYSYMBOL_RNUMBER = 5,                    /* RNUMBER  */
+  YYSYMBOL_STAR = 6,                       /* STAR  */
+  YYSYMBOL_COMMA = 7,                      /* COMMA  */
+  YYSYMBOL_RANGE = 8,                      /* RANGE  */
+  YYSYMBOL_RSELECTOR = 9,                  /* RSELECTOR  */
+  YYSYMBOL_ASELECTOR = 10,                 /* ASELECTOR  */
+  YYSYMBOL_TSELECTOR = 11,                 /* TSELECTOR  */
+  YYSYMBOL_RLT = 12,                       /* RLT  */
+  YYSYMBOL_RGT = 13,                       /* RGT  */
+  YYSYMBOL_ALT = 14,                       /* ALT  */
+  YYSYMBOL_AGT = 15,                       /* AGT  */
+  YYSYMBOL_NOT = 16,                       /* NOT  */
+  YYSYMBOL_AND = 17,                       /* AND  */
+  YYSYMBOL_OR = 18,                        /* OR  */
+  YYSYMBOL_RBRA = 19,                      /* RBRA  */
+  YYSYMBOL_LBRA = 20,                      /* LBRA  */
+  YYSYMBOL_ERROR = 21,                     /* ERROR  */
+  YYSYMBOL_ORIGIN = 22,                    /* ORIGIN  */
+  YYSYMBOL_CBOX = 23,                      /* CBOX  */
+  YYSYMBOL_LIST = 24,                      /* LIST  */
+  YYSYMBOL_COM = 25,                       /* COM  */
+  YYSYMBOL_PLANE = 26,                     /* PLANE  */
+  YYSYMBOL_YYACCEPT = 27,                  /* $accept  */
+  YYSYMBOL_amber_mask = 28,                /* amber_mask  */
+  YYSYMBOL_expr = 29,                      /* expr  */
+  YYSYMBOL_selection = 30,                 /* selection  */
+  YYSYMBOL_sel_list = 31,                  /* sel_list  */
+  YYSYMBOL_list = 32,                      /* list  */
+  YYSYMBOL_item = 33                       /* item  */
 };
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+/* Unqualified %code blocks.  */
+#line 32 "AmberMask.y"
 
-#endif /* !YY_YY_AMBERMASK_TAB_H_INCLUDED  */
+int yylex(YYSTYPE* p_lval,struct SMaskParser* p_parser);
 
-/* Copy the second part of user declarations.  */
-
-#line 170 "AmberMask.tab.c" /* yacc.c:358  */
+#line 152 "AmberMask.tab.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -201,15 +242,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -223,47 +277,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -276,8 +326,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -342,8 +406,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -352,17 +415,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -375,11 +438,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -391,12 +454,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -419,17 +482,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  95
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   281
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -463,53 +529,55 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,    58,    58,    64,    76,    87,    98,   112,   117,   129,
-     141,   153,   165,   177,   190,   202,   214,   226,   238,   250,
-     263,   275,   287,   299,   311,   323,   336,   348,   360,   372,
-     384,   396,   411,   447,   485,   494,   503,   514,   517,   539,
-     551,   560,   570,   580
+       0,    67,    67,    73,    85,    96,   107,   121,   126,   138,
+     150,   162,   174,   186,   199,   211,   223,   235,   247,   259,
+     272,   284,   296,   308,   320,   332,   345,   357,   369,   381,
+     393,   405,   420,   456,   494,   503,   512,   523,   526,   548,
+     560,   569,   579,   589
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "STRING", "INUMBER", "RNUMBER", "STAR",
-  "COMMA", "RANGE", "RSELECTOR", "ASELECTOR", "TSELECTOR", "RLT", "RGT",
-  "ALT", "AGT", "NOT", "AND", "OR", "RBRA", "LBRA", "ERROR", "ORIGIN",
-  "CBOX", "LIST", "COM", "PLANE", "$accept", "amber_mask", "expr",
-  "selection", "sel_list", "list", "item", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "STRING", "INUMBER",
+  "RNUMBER", "STAR", "COMMA", "RANGE", "RSELECTOR", "ASELECTOR",
+  "TSELECTOR", "RLT", "RGT", "ALT", "AGT", "NOT", "AND", "OR", "RBRA",
+  "LBRA", "ERROR", "ORIGIN", "CBOX", "LIST", "COM", "PLANE", "$accept",
+  "amber_mask", "expr", "selection", "sel_list", "list", "item", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -19
+#define YYPACT_NINF (-19)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-19)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
       -4,     5,     5,     5,    -4,    -4,    22,    68,   -18,   -10,
@@ -524,10 +592,10 @@ static const yytype_int8 yypact[] =
      -19,   -19,   -19,   -19,   -19
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     2,     3,    43,    41,    38,    34,    37,    39,
@@ -541,22 +609,22 @@ static const yytype_uint8 yydefact[] =
       18,    25,    31,    13,    19
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -19,   -19,    -1,   -19,    -2,   -19,    57
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,    11,    12,    13,    17,    18,    19
+       0,    11,    12,    13,    17,    18,    19
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint8 yytable[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
       20,    21,    32,    22,    23,     1,     2,     3,    14,    15,
       33,    16,     4,    43,    44,    34,     5,    35,     6,     7,
@@ -590,9 +658,9 @@ static const yytype_int8 yycheck[] =
        5,     5,     5,     5
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     9,    10,    11,    16,    20,    22,    23,    24,    25,
       26,    28,    29,    30,     3,     4,     6,    31,    32,    33,
@@ -606,8 +674,8 @@ static const yytype_uint8 yystos[] =
        5,     5,     5,     5,     5
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    27,    28,    29,    29,    29,    29,    29,    29,    29,
       29,    29,    29,    29,    29,    29,    29,    29,    29,    29,
@@ -616,8 +684,8 @@ static const yytype_uint8 yyr1[] =
       32,    33,    33,    33
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     1,     3,     3,     2,     3,     3,     3,
        3,     6,     6,     6,     3,     3,     3,     6,     6,     6,
@@ -627,39 +695,39 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (p_parser, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -676,55 +744,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, p_parser); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct SMaskParser* p_parser)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (p_parser);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct SMaskParser* p_parser)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, p_parser);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -733,7 +799,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -756,21 +822,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, struct SMaskParser* p_parser)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], p_parser);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -778,15 +844,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, p_parser); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -809,28 +875,76 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -844,10 +958,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -855,14 +969,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -873,7 +986,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -888,36 +1004,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -941,63 +1041,78 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
+    default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
       YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1006,7 +1121,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1018,46 +1133,41 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, struct SMaskParser* p_parser)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (p_parser);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
@@ -1065,45 +1175,54 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (struct SMaskParser* p_parser)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1111,71 +1230,75 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1183,30 +1306,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1217,18 +1341,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, p_parser);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1256,15 +1391,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1279,7 +1412,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1299,32 +1432,32 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 58 "AmberMask.y" /* yacc.c:1646  */
-    { TopExpression = (yyvsp[0].exprValue); (yyval.exprValue) = (yyvsp[0].exprValue); }
-#line 1306 "AmberMask.tab.c" /* yacc.c:1646  */
+  case 2: /* amber_mask: expr  */
+#line 67 "AmberMask.y"
+                        { p_parser->TopExpression = (yyvsp[0].exprValue); (yyval.exprValue) = (yyvsp[0].exprValue); }
+#line 1439 "AmberMask.tab.c"
     break;
 
-  case 3:
-#line 64 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 3: /* expr: selection  */
+#line 73 "AmberMask.y"
+              {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Selection = (yyvsp[0].selValue);
         (yyval.exprValue) = p_expr;
         }
-#line 1320 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1453 "AmberMask.tab.c"
     break;
 
-  case 4:
-#line 76 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 4: /* expr: expr AND expr  */
+#line 85 "AmberMask.y"
+                    {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND; 
@@ -1332,15 +1465,15 @@ yyreduce:
         p_expr->RightExpression = (yyvsp[0].exprValue);
         (yyval.exprValue) = p_expr;
         }
-#line 1336 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1469 "AmberMask.tab.c"
     break;
 
-  case 5:
-#line 87 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 5: /* expr: expr OR expr  */
+#line 96 "AmberMask.y"
+                   {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_OR;
@@ -1348,15 +1481,15 @@ yyreduce:
         p_expr->RightExpression = (yyvsp[0].exprValue);
         (yyval.exprValue) = p_expr;
         }
-#line 1352 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1485 "AmberMask.tab.c"
     break;
 
-  case 6:
-#line 98 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 6: /* expr: NOT expr  */
+#line 107 "AmberMask.y"
+               {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_NOT;
@@ -1364,23 +1497,23 @@ yyreduce:
         p_expr->RightExpression = (yyvsp[0].exprValue);
         (yyval.exprValue) = p_expr;
         }
-#line 1368 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1501 "AmberMask.tab.c"
     break;
 
-  case 7:
-#line 112 "AmberMask.y" /* yacc.c:1646  */
-    {
+  case 7: /* expr: LBRA expr RBRA  */
+#line 121 "AmberMask.y"
+                     {
         (yyval.exprValue) = (yyvsp[-1].exprValue);
         }
-#line 1376 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1509 "AmberMask.tab.c"
     break;
 
-  case 8:
-#line 117 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 8: /* expr: ORIGIN ALT RNUMBER  */
+#line 126 "AmberMask.y"
+                         {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -1389,15 +1522,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1393 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1526 "AmberMask.tab.c"
     break;
 
-  case 9:
-#line 129 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 9: /* expr: CBOX ALT RNUMBER  */
+#line 138 "AmberMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -1406,15 +1539,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1410 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1543 "AmberMask.tab.c"
     break;
 
-  case 10:
-#line 141 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 10: /* expr: expr ALT RNUMBER  */
+#line 150 "AmberMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -1423,15 +1556,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1427 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1560 "AmberMask.tab.c"
     break;
 
-  case 11:
-#line 153 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 11: /* expr: LIST LBRA expr RBRA ALT RNUMBER  */
+#line 162 "AmberMask.y"
+                                      {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -1440,15 +1573,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1444 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1577 "AmberMask.tab.c"
     break;
 
-  case 12:
-#line 165 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 12: /* expr: COM LBRA expr RBRA ALT RNUMBER  */
+#line 174 "AmberMask.y"
+                                     {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -1457,15 +1590,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1461 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1594 "AmberMask.tab.c"
     break;
 
-  case 13:
-#line 177 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 13: /* expr: PLANE LBRA expr RBRA ALT RNUMBER  */
+#line 186 "AmberMask.y"
+                                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -1474,15 +1607,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1478 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1611 "AmberMask.tab.c"
     break;
 
-  case 14:
-#line 190 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 14: /* expr: ORIGIN AGT RNUMBER  */
+#line 199 "AmberMask.y"
+                         {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -1491,15 +1624,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1495 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1628 "AmberMask.tab.c"
     break;
 
-  case 15:
-#line 202 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 15: /* expr: CBOX AGT RNUMBER  */
+#line 211 "AmberMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -1508,15 +1641,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1512 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1645 "AmberMask.tab.c"
     break;
 
-  case 16:
-#line 214 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 16: /* expr: expr AGT RNUMBER  */
+#line 223 "AmberMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -1525,15 +1658,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1529 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1662 "AmberMask.tab.c"
     break;
 
-  case 17:
-#line 226 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 17: /* expr: LIST LBRA expr RBRA AGT RNUMBER  */
+#line 235 "AmberMask.y"
+                                      {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -1542,15 +1675,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1546 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1679 "AmberMask.tab.c"
     break;
 
-  case 18:
-#line 238 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 18: /* expr: COM LBRA expr RBRA AGT RNUMBER  */
+#line 247 "AmberMask.y"
+                                     {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -1559,15 +1692,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1563 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1696 "AmberMask.tab.c"
     break;
 
-  case 19:
-#line 250 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 19: /* expr: PLANE LBRA expr RBRA AGT RNUMBER  */
+#line 259 "AmberMask.y"
+                                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -1576,15 +1709,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1580 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1713 "AmberMask.tab.c"
     break;
 
-  case 20:
-#line 263 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 20: /* expr: ORIGIN RLT RNUMBER  */
+#line 272 "AmberMask.y"
+                         {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -1593,15 +1726,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1597 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1730 "AmberMask.tab.c"
     break;
 
-  case 21:
-#line 275 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 21: /* expr: CBOX RLT RNUMBER  */
+#line 284 "AmberMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -1610,15 +1743,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1614 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1747 "AmberMask.tab.c"
     break;
 
-  case 22:
-#line 287 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 22: /* expr: expr RLT RNUMBER  */
+#line 296 "AmberMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -1627,15 +1760,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1631 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1764 "AmberMask.tab.c"
     break;
 
-  case 23:
-#line 299 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 23: /* expr: LIST LBRA expr RBRA RLT RNUMBER  */
+#line 308 "AmberMask.y"
+                                      {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -1644,15 +1777,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1648 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1781 "AmberMask.tab.c"
     break;
 
-  case 24:
-#line 311 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 24: /* expr: COM LBRA expr RBRA RLT RNUMBER  */
+#line 320 "AmberMask.y"
+                                     {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -1661,15 +1794,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1665 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1798 "AmberMask.tab.c"
     break;
 
-  case 25:
-#line 323 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 25: /* expr: PLANE LBRA expr RBRA RLT RNUMBER  */
+#line 332 "AmberMask.y"
+                                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -1678,15 +1811,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1682 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1815 "AmberMask.tab.c"
     break;
 
-  case 26:
-#line 336 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 26: /* expr: ORIGIN RGT RNUMBER  */
+#line 345 "AmberMask.y"
+                         {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -1695,15 +1828,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1699 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1832 "AmberMask.tab.c"
     break;
 
-  case 27:
-#line 348 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 27: /* expr: CBOX RGT RNUMBER  */
+#line 357 "AmberMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -1712,15 +1845,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1716 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1849 "AmberMask.tab.c"
     break;
 
-  case 28:
-#line 360 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 28: /* expr: expr RGT RNUMBER  */
+#line 369 "AmberMask.y"
+                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -1729,15 +1862,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1733 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1866 "AmberMask.tab.c"
     break;
 
-  case 29:
-#line 372 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 29: /* expr: LIST LBRA expr RBRA RGT RNUMBER  */
+#line 381 "AmberMask.y"
+                                      {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -1746,15 +1879,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1750 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1883 "AmberMask.tab.c"
     break;
 
-  case 30:
-#line 384 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 30: /* expr: COM LBRA expr RBRA RGT RNUMBER  */
+#line 393 "AmberMask.y"
+                                     {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -1763,15 +1896,15 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1767 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1900 "AmberMask.tab.c"
     break;
 
-  case 31:
-#line 396 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SExpression* p_expr = AllocateExpression();
+  case 31: /* expr: PLANE LBRA expr RBRA RGT RNUMBER  */
+#line 405 "AmberMask.y"
+                                       {
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -1780,39 +1913,39 @@ yyreduce:
         p_expr->Distance = (yyvsp[0].rValue).Number;
         (yyval.exprValue) = p_expr;
         }
-#line 1784 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1917 "AmberMask.tab.c"
     break;
 
-  case 32:
-#line 411 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SSelection* p_lsel = AllocateSelection(T_RSELECTOR,(yyvsp[-2].listValue));
+  case 32: /* expr: RSELECTOR sel_list ASELECTOR sel_list  */
+#line 420 "AmberMask.y"
+                                            {
+        struct SSelection* p_lsel = AllocateSelection(p_parser,T_RSELECTOR,(yyvsp[-2].listValue));
         if( p_lsel == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_parser,"unable to allocate memory for the residue selection");
             YYERROR;
             }
-        struct SExpression* p_lexpr = AllocateExpression();
+        struct SExpression* p_lexpr = AllocateExpression(p_parser);
         if( p_lexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_lexpr->Selection = p_lsel;
 
-        struct SSelection* p_rsel = AllocateSelection(T_ASELECTOR,(yyvsp[0].listValue));
+        struct SSelection* p_rsel = AllocateSelection(p_parser,T_ASELECTOR,(yyvsp[0].listValue));
         if( p_rsel == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_parser,"unable to allocate memory for the atom selection");
             YYERROR;
             }
-        struct SExpression* p_rexpr = AllocateExpression();
+        struct SExpression* p_rexpr = AllocateExpression(p_parser);
         if( p_rexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_rexpr->Selection = p_rsel;
 
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND;
@@ -1820,39 +1953,39 @@ yyreduce:
         p_expr->RightExpression = p_rexpr;
         (yyval.exprValue) = p_expr;
         }
-#line 1824 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1957 "AmberMask.tab.c"
     break;
 
-  case 33:
-#line 447 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SSelection* p_lsel = AllocateSelection(T_RSELECTOR,(yyvsp[-2].listValue));
+  case 33: /* expr: RSELECTOR sel_list TSELECTOR sel_list  */
+#line 456 "AmberMask.y"
+                                            {
+        struct SSelection* p_lsel = AllocateSelection(p_parser,T_RSELECTOR,(yyvsp[-2].listValue));
         if( p_lsel == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_parser,"unable to allocate memory for the residue selection");
             YYERROR;
             }
-        struct SExpression* p_lexpr = AllocateExpression();
+        struct SExpression* p_lexpr = AllocateExpression(p_parser);
         if( p_lexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_lexpr->Selection = p_lsel;
 
-        struct SSelection* p_rsel = AllocateSelection(T_TSELECTOR,(yyvsp[0].listValue));
+        struct SSelection* p_rsel = AllocateSelection(p_parser,T_TSELECTOR,(yyvsp[0].listValue));
         if( p_rsel == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_parser,"unable to allocate memory for the atom selection");
             YYERROR;
             }
-        struct SExpression* p_rexpr = AllocateExpression();
+        struct SExpression* p_rexpr = AllocateExpression(p_parser);
         if( p_rexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_rexpr->Selection = p_rsel;
 
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND;
@@ -1860,69 +1993,69 @@ yyreduce:
         p_expr->RightExpression = p_rexpr;
         (yyval.exprValue) = p_expr;
         }
-#line 1864 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 1997 "AmberMask.tab.c"
     break;
 
-  case 34:
-#line 485 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SSelection* p_selection = AllocateSelection(T_RSELECTOR,(yyvsp[0].listValue));
+  case 34: /* selection: RSELECTOR sel_list  */
+#line 494 "AmberMask.y"
+                       {
+        struct SSelection* p_selection = AllocateSelection(p_parser,T_RSELECTOR,(yyvsp[0].listValue));
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_parser,"unable to allocate memory for the residue selection");
             YYERROR;
             }
         (yyval.selValue) = p_selection;
         }
-#line 1877 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2010 "AmberMask.tab.c"
     break;
 
-  case 35:
-#line 494 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SSelection* p_selection = AllocateSelection(T_ASELECTOR,(yyvsp[0].listValue));
+  case 35: /* selection: ASELECTOR sel_list  */
+#line 503 "AmberMask.y"
+                         {
+        struct SSelection* p_selection = AllocateSelection(p_parser,T_ASELECTOR,(yyvsp[0].listValue));
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_parser,"unable to allocate memory for the atom selection");
             YYERROR;
             }
         (yyval.selValue) = p_selection;
         }
-#line 1890 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2023 "AmberMask.tab.c"
     break;
 
-  case 36:
-#line 503 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SSelection* p_selection = AllocateSelection(T_TSELECTOR,(yyvsp[0].listValue));
+  case 36: /* selection: TSELECTOR sel_list  */
+#line 512 "AmberMask.y"
+                        {
+        struct SSelection* p_selection = AllocateSelection(p_parser,T_TSELECTOR,(yyvsp[0].listValue));
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the type selection");
+            yyerror(p_parser,"unable to allocate memory for the type selection");
             YYERROR;
             }
         (yyval.selValue) = p_selection;
         }
-#line 1903 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2036 "AmberMask.tab.c"
     break;
 
-  case 37:
-#line 514 "AmberMask.y" /* yacc.c:1646  */
-    {
+  case 37: /* sel_list: list  */
+#line 523 "AmberMask.y"
+         {
         (yyval.listValue) = (yyvsp[0].listValue);
         }
-#line 1911 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2044 "AmberMask.tab.c"
     break;
 
-  case 38:
-#line 517 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SListItem* p_item = AllocateListItem();
+  case 38: /* sel_list: STAR  */
+#line 526 "AmberMask.y"
+           {
+        struct SListItem* p_item = AllocateListItem(p_parser);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_parser,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = -1;
 
-        struct SList* p_list = AllocateList();
+        struct SList* p_list = AllocateList(p_parser);
         if( p_list == NULL ){
-            yyerror("unable to allocate memory for the list");
+            yyerror(p_parser,"unable to allocate memory for the list");
             YYERROR;
             }
         /* add everything item to the list */
@@ -1931,16 +2064,16 @@ yyreduce:
 
         (yyval.listValue) = p_list;
         }
-#line 1935 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2068 "AmberMask.tab.c"
     break;
 
-  case 39:
-#line 539 "AmberMask.y" /* yacc.c:1646  */
-    {
+  case 39: /* list: item  */
+#line 548 "AmberMask.y"
+         {
         /* create list node */
-        struct SList* p_list = AllocateList();
+        struct SList* p_list = AllocateList(p_parser);
         if( p_list == NULL ){
-            yyerror("unable to allocate memory for the list");
+            yyerror(p_parser,"unable to allocate memory for the list");
             YYERROR;
             }
         /* add item to the list */
@@ -1948,66 +2081,67 @@ yyreduce:
         p_list->LastItem = (yyvsp[0].itemValue);
         (yyval.listValue) = p_list;
         }
-#line 1952 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2085 "AmberMask.tab.c"
     break;
 
-  case 40:
-#line 551 "AmberMask.y" /* yacc.c:1646  */
-    {
+  case 40: /* list: list COMMA item  */
+#line 560 "AmberMask.y"
+                      {
         /* add item to the list */
         (yyvsp[-2].listValue)->LastItem->NextItem = (yyvsp[0].itemValue);
         (yyvsp[-2].listValue)->LastItem = (yyvsp[0].itemValue);
         (yyval.listValue) = (yyvsp[-2].listValue);
         }
-#line 1963 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2096 "AmberMask.tab.c"
     break;
 
-  case 41:
-#line 560 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SListItem* p_item = AllocateListItem();
+  case 41: /* item: INUMBER  */
+#line 569 "AmberMask.y"
+            {
+        struct SListItem* p_item = AllocateListItem(p_parser);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_parser,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = (yyvsp[0].iValue).Number;
         p_item->Length = 1;
         (yyval.itemValue) = p_item;
         }
-#line 1978 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2111 "AmberMask.tab.c"
     break;
 
-  case 42:
-#line 570 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SListItem* p_item = AllocateListItem();
+  case 42: /* item: INUMBER RANGE INUMBER  */
+#line 579 "AmberMask.y"
+                            {
+        struct SListItem* p_item = AllocateListItem(p_parser);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_parser,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = (yyvsp[-2].iValue).Number;
         p_item->Length = (yyvsp[0].iValue).Number - (yyvsp[-2].iValue).Number + 1;
         (yyval.itemValue) = p_item;
         }
-#line 1993 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2126 "AmberMask.tab.c"
     break;
 
-  case 43:
-#line 580 "AmberMask.y" /* yacc.c:1646  */
-    {
-        struct SListItem* p_item = AllocateListItem();
+  case 43: /* item: STRING  */
+#line 589 "AmberMask.y"
+             {
+        struct SListItem* p_item = AllocateListItem(p_parser);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_parser,"unable to allocate memory for the item");
             YYERROR;
             }
         strncpy(p_item->Name,(yyvsp[0].sValue).String,4);
         (yyval.itemValue) = p_item;
         }
-#line 2007 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2140 "AmberMask.tab.c"
     break;
 
 
-#line 2011 "AmberMask.tab.c" /* yacc.c:1646  */
+#line 2144 "AmberMask.tab.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2021,25 +2155,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2050,50 +2182,44 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        yyerror (p_parser, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2108,7 +2234,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, p_parser);
           yychar = YYEMPTY;
         }
     }
@@ -2122,12 +2248,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2144,13 +2269,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2164,7 +2290,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, p_parser);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2176,7 +2302,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2187,33 +2313,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (p_parser, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, p_parser);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2222,28 +2352,27 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, p_parser);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 591 "AmberMask.y" /* yacc.c:1906  */
+
+#line 600 "AmberMask.y"
 
 /* ========================================================================== */
 
-int parse_mask(const char* p_mask)
+int parse_mask(struct SMaskParser* p_parser,const char* p_mask)
 {
- yy_scan_string(p_mask);
- int rvalue = yyparse();
- yylex_destroy();
- return(rvalue);
+ free_mask_tree(p_parser);
+ p_parser->Mask = p_mask;
+ p_parser->LexPosition = 1;
+ return(yyparse(p_parser));
 }
 
@@ -10,9 +10,14 @@ AMBER Mask Parser Analyzer
 #include <stdio.h>
 #include <string.h>
 #include "AmberMaskParser.hpp"
-#define YYERROR_VERBOSE
 %}
 
+/* the parser is reentrant, all its state is kept in SMaskParser */
+%define api.pure full
+%define parse.error verbose
+%parse-param { struct SMaskParser* p_parser }
+%lex-param   { struct SMaskParser* p_parser }
+
 %union{
     SGrammar                gValue;
     SInteger                iValue;
@@ -24,6 +29,10 @@ AMBER Mask Parser Analyzer
     struct SExpression*     exprValue;
     };
 
+%code {
+int yylex(YYSTYPE* p_lval,struct SMaskParser* p_parser);
+}
+
 /* recognized tokens -------------------------------------------------------- */
 %token <sValue> STRING
 %token <iValue> INUMBER
@@ -55,16 +64,16 @@ AMBER Mask Parser Analyzer
 %%
 
 amber_mask:
-    expr                { TopExpression = $1; $$ = $1; }
+    expr                { p_parser->TopExpression = $1; $$ = $1; }
     ;
 
 expr:
 /* SELECTION ---------------------------------------------------------------- */
 
     selection {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Selection = $1;
@@ -74,9 +83,9 @@ expr:
 /* LOGICAL OPERATORS -------------------------------------------------------- */
 
     | expr AND expr {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND; 
@@ -85,9 +94,9 @@ expr:
         $$ = p_expr;
         }
     | expr OR expr {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_OR;
@@ -96,9 +105,9 @@ expr:
         $$ = p_expr;
         }
     | NOT expr {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_NOT;
@@ -115,9 +124,9 @@ expr:
 
 /* DISTANCE OPERATORS ------------------------------------------------------- */
     | ORIGIN ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -127,9 +136,9 @@ expr:
         $$ = p_expr;
         }
     | CBOX ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -139,9 +148,9 @@ expr:
         $$ = p_expr;
         }
     | expr ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -151,9 +160,9 @@ expr:
         $$ = p_expr;
         }
     | LIST LBRA expr RBRA ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -163,9 +172,9 @@ expr:
         $$ = p_expr;
         }
     | COM LBRA expr RBRA ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -175,9 +184,9 @@ expr:
         $$ = p_expr;
         }
     | PLANE LBRA expr RBRA ALT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_ALT;
@@ -188,9 +197,9 @@ expr:
         }
 
     | ORIGIN AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -200,9 +209,9 @@ expr:
         $$ = p_expr;
         }
     | CBOX AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -212,9 +221,9 @@ expr:
         $$ = p_expr;
         }
     | expr AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -224,9 +233,9 @@ expr:
         $$ = p_expr;
         }
     | LIST LBRA expr RBRA AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -236,9 +245,9 @@ expr:
         $$ = p_expr;
         }
     | COM LBRA expr RBRA AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -248,9 +257,9 @@ expr:
         $$ = p_expr;
         }
     | PLANE LBRA expr RBRA AGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AGT;
@@ -261,9 +270,9 @@ expr:
         }
 
     | ORIGIN RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -273,9 +282,9 @@ expr:
         $$ = p_expr;
         }
     | CBOX RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -285,9 +294,9 @@ expr:
         $$ = p_expr;
         }
     | expr RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -297,9 +306,9 @@ expr:
         $$ = p_expr;
         }
     | LIST LBRA expr RBRA RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -309,9 +318,9 @@ expr:
         $$ = p_expr;
         }
     | COM LBRA expr RBRA RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -321,9 +330,9 @@ expr:
         $$ = p_expr;
         }
     | PLANE LBRA expr RBRA RLT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RLT;
@@ -334,9 +343,9 @@ expr:
         }
 
     | ORIGIN RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -346,9 +355,9 @@ expr:
         $$ = p_expr;
         }
     | CBOX RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -358,9 +367,9 @@ expr:
         $$ = p_expr;
         }
     | expr RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -370,9 +379,9 @@ expr:
         $$ = p_expr;
         }
     | LIST LBRA expr RBRA RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -382,9 +391,9 @@ expr:
         $$ = p_expr;
         }
     | COM LBRA expr RBRA RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -394,9 +403,9 @@ expr:
         $$ = p_expr;
         }
     | PLANE LBRA expr RBRA RGT RNUMBER {
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_RGT;
@@ -409,33 +418,33 @@ expr:
 /* SELECTORS ---------------------------------------------------------------- */
 
     | RSELECTOR sel_list ASELECTOR sel_list {
-        struct SSelection* p_lsel = AllocateSelection(T_RSELECTOR,$2);
+        struct SSelection* p_lsel = AllocateSelection(p_parser,T_RSELECTOR,$2);
         if( p_lsel == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_parser,"unable to allocate memory for the residue selection");
             YYERROR;
             }
-        struct SExpression* p_lexpr = AllocateExpression();
+        struct SExpression* p_lexpr = AllocateExpression(p_parser);
         if( p_lexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_lexpr->Selection = p_lsel;
 
-        struct SSelection* p_rsel = AllocateSelection(T_ASELECTOR,$4);
+        struct SSelection* p_rsel = AllocateSelection(p_parser,T_ASELECTOR,$4);
         if( p_rsel == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_parser,"unable to allocate memory for the atom selection");
             YYERROR;
             }
-        struct SExpression* p_rexpr = AllocateExpression();
+        struct SExpression* p_rexpr = AllocateExpression(p_parser);
         if( p_rexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_rexpr->Selection = p_rsel;
 
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND;
@@ -445,33 +454,33 @@ expr:
         }
 
     | RSELECTOR sel_list TSELECTOR sel_list {
-        struct SSelection* p_lsel = AllocateSelection(T_RSELECTOR,$2);
+        struct SSelection* p_lsel = AllocateSelection(p_parser,T_RSELECTOR,$2);
         if( p_lsel == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_parser,"unable to allocate memory for the residue selection");
             YYERROR;
             }
-        struct SExpression* p_lexpr = AllocateExpression();
+        struct SExpression* p_lexpr = AllocateExpression(p_parser);
         if( p_lexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_lexpr->Selection = p_lsel;
 
-        struct SSelection* p_rsel = AllocateSelection(T_TSELECTOR,$4);
+        struct SSelection* p_rsel = AllocateSelection(p_parser,T_TSELECTOR,$4);
         if( p_rsel == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_parser,"unable to allocate memory for the atom selection");
             YYERROR;
             }
-        struct SExpression* p_rexpr = AllocateExpression();
+        struct SExpression* p_rexpr = AllocateExpression(p_parser);
         if( p_rexpr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_rexpr->Selection = p_rsel;
 
-        struct SExpression* p_expr = AllocateExpression();
+        struct SExpression* p_expr = AllocateExpression(p_parser);
         if( p_expr == NULL ){
-            yyerror("unable to allocate memory for the expression");
+            yyerror(p_parser,"unable to allocate memory for the expression");
             YYERROR;
             }
         p_expr->Operator = O_AND;
@@ -483,27 +492,27 @@ expr:
 
 selection:
     RSELECTOR sel_list {
-        struct SSelection* p_selection = AllocateSelection(T_RSELECTOR,$2);
+        struct SSelection* p_selection = AllocateSelection(p_parser,T_RSELECTOR,$2);
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the residue selection");
+            yyerror(p_parser,"unable to allocate memory for the residue selection");
             YYERROR;
             }
         $$ = p_selection;
         }
 
     | ASELECTOR sel_list {
-        struct SSelection* p_selection = AllocateSelection(T_ASELECTOR,$2);
+        struct SSelection* p_selection = AllocateSelection(p_parser,T_ASELECTOR,$2);
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the atom selection");
+            yyerror(p_parser,"unable to allocate memory for the atom selection");
             YYERROR;
             }
         $$ = p_selection;
         }
 
     | TSELECTOR sel_list{
-        struct SSelection* p_selection = AllocateSelection(T_TSELECTOR,$2);
+        struct SSelection* p_selection = AllocateSelection(p_parser,T_TSELECTOR,$2);
         if( p_selection == NULL ){
-            yyerror("unable to allocate memory for the type selection");
+            yyerror(p_parser,"unable to allocate memory for the type selection");
             YYERROR;
             }
         $$ = p_selection;
@@ -515,16 +524,16 @@ sel_list:
         $$ = $1;
         }
     | STAR {
-        struct SListItem* p_item = AllocateListItem();
+        struct SListItem* p_item = AllocateListItem(p_parser);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_parser,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = -1;
 
-        struct SList* p_list = AllocateList();
+        struct SList* p_list = AllocateList(p_parser);
         if( p_list == NULL ){
-            yyerror("unable to allocate memory for the list");
+            yyerror(p_parser,"unable to allocate memory for the list");
             YYERROR;
             }
         /* add everything item to the list */
@@ -538,9 +547,9 @@ sel_list:
 list:
     item {
         /* create list node */
-        struct SList* p_list = AllocateList();
+        struct SList* p_list = AllocateList(p_parser);
         if( p_list == NULL ){
-            yyerror("unable to allocate memory for the list");
+            yyerror(p_parser,"unable to allocate memory for the list");
             YYERROR;
             }
         /* add item to the list */
@@ -558,9 +567,9 @@ list:
 
 item:
     INUMBER {
-        struct SListItem* p_item = AllocateListItem();
+        struct SListItem* p_item = AllocateListItem(p_parser);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_parser,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = $1.Number;
@@ -568,9 +577,9 @@ item:
         $$ = p_item;
         }
     | INUMBER RANGE INUMBER {
-        struct SListItem* p_item = AllocateListItem();
+        struct SListItem* p_item = AllocateListItem(p_parser);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_parser,"unable to allocate memory for the item");
             YYERROR;
             }
         p_item->Index = $1.Number;
@@ -578,9 +587,9 @@ item:
         $$ = p_item;
         }
     | STRING {
-        struct SListItem* p_item = AllocateListItem();
+        struct SListItem* p_item = AllocateListItem(p_parser);
         if( p_item == NULL ){
-            yyerror("unable to allocate memory for the item");
+            yyerror(p_parser,"unable to allocate memory for the item");
             YYERROR;
             }
         strncpy(p_item->Name,$1.String,4);
@@ -591,11 +600,11 @@ item:
 %%
 /* ========================================================================== */
 
-int parse_mask(const char* p_mask)
+int parse_mask(struct SMaskParser* p_parser,const char* p_mask)
 {
- yy_scan_string(p_mask);
- int rvalue = yyparse();
- yylex_destroy();
- return(rvalue);
+ free_mask_tree(p_parser);
+ p_parser->Mask = p_mask;
+ p_parser->LexPosition = 1;
+ return(yyparse(p_parser));
 }
 
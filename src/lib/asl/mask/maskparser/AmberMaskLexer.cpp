@@ -0,0 +1,214 @@
+/* =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// ========================================================================== */
+
+#include "AmberMaskParser.hpp"
+#include "AmberMask.tab.h"
+#include <stdio.h>
+#include <string.h>
+
+// reentrant lexical analyzer of masks
+// the scanner reads p_parser->Mask from p_parser->LexPosition, there is no
+// other state, thus masks can be parsed in several threads simultaneously
+
+// token rules:
+//    string        [0-9]*[a-zA-Z]+[a-zA-Z0-9$^+_*=\-']*
+//    rnumber       [0-9]+[.]?[0-9]*
+//    inumber       [0-9]+
+// the longest match wins, keywords and integers win over strings and real
+// numbers of the same length
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+static bool is_alpha(char c)
+{
+    return( ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) );
+}
+
+//------------------------------------------------------------------------------
+
+static bool is_digit(char c)
+{
+    return( (c >= '0') && (c <= '9') );
+}
+
+//------------------------------------------------------------------------------
+
+static bool is_string_tail(char c)
+{
+    if( is_alpha(c) || is_digit(c) ) return(true);
+    if( c == '\0' ) return(false);
+    return( strchr("$^+_*=-'",c) != NULL );
+}
+
+//------------------------------------------------------------------------------
+
+// return length of string token at p_text or zero
+static int match_string(const char* p_text)
+{
+    int len = 0;
+    while( is_digit(p_text[len]) ) len++;
+    if( ! is_alpha(p_text[len]) ) return(0);
+    while( is_alpha(p_text[len]) ) len++;
+    while( is_string_tail(p_text[len]) ) len++;
+    return(len);
+}
+
+//------------------------------------------------------------------------------
+
+// return length of number token at p_text and real = true for real number
+static int match_number(const char* p_text,bool& real)
+{
+    int len = 0;
+    real = false;
+    while( is_digit(p_text[len]) ) len++;
+    if( len == 0 ) return(0);
+    if( p_text[len] == '.' ) {
+        real = true;
+        len++;
+        while( is_digit(p_text[len]) ) len++;
+    }
+    return(len);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+struct SMaskToken {
+    const char* Text;
+    int         Token;
+};
+
+// longer operators must precede their prefixes
+static const struct SMaskToken MaskOperators[] = {
+    { "@%", TSELECTOR },
+    { "<:", RLT },
+    { ">:", RGT },
+    { "<@", ALT },
+    { ">@", AGT },
+    { "*",  STAR },
+    { ",",  COMMA },
+    { "-",  RANGE },
+    { ":",  RSELECTOR },
+    { "@",  ASELECTOR },
+    { "&",  AND },
+    { "|",  OR },
+    { "!",  NOT },
+    { "(",  LBRA },
+    { ")",  RBRA },
+    { NULL, 0 }
+};
+
+static const struct SMaskToken MaskKeywords[] = {
+    { "origin", ORIGIN },
+    { "cbox",   CBOX },
+    { "list",   LIST },
+    { "com",    COM },
+    { "plane",  PLANE },
+    { NULL, 0 }
+};
+
+//------------------------------------------------------------------------------
+
+extern "C" int yylex(YYSTYPE* p_lval,struct SMaskParser* p_parser)
+{
+    if( p_parser->Mask == NULL ) return(0);
+
+    // LexPosition is counted from one
+    const char* p_text = p_parser->Mask + p_parser->LexPosition - 1;
+
+    // skip white spaces
+    while( (*p_text == ' ') || (*p_text == '\t') ) {
+        p_text++;
+        p_parser->LexPosition++;
+    }
+
+    int position = p_parser->LexPosition;
+
+    if( *p_text == '\0' ) return(0);
+
+    if( *p_text == '\n' ) {
+        pperror("new line character is not allowed in mask specification",position);
+        return(ERROR);
+    }
+
+    // names, keywords and numbers
+    bool real;
+    int  slen = match_string(p_text);
+    int  nlen = match_number(p_text,real);
+
+    if( (slen > 0) && (slen > nlen) ) {
+        for(int i=0; MaskKeywords[i].Text != NULL; i++) {
+            if( ((int)strlen(MaskKeywords[i].Text) == slen) &&
+                (strncmp(MaskKeywords[i].Text,p_text,slen) == 0) ) {
+                p_lval->gValue.Position = position;
+                p_parser->LexPosition += slen;
+                return(MaskKeywords[i].Token);
+            }
+        }
+        p_lval->sValue.Position = position;
+        if( slen > 4 ) {
+            pperror("name is too long (max 4 characters)",position);
+        }
+        memset(p_lval->sValue.String,' ',4);
+        memcpy(p_lval->sValue.String,p_text,slen < 4 ? slen : 4);
+        p_parser->LexPosition += slen;
+        return(STRING);
+    }
+
+    if( nlen > 0 ) {
+        char buffer[64];
+        int  blen = nlen < 63 ? nlen : 63;
+        memcpy(buffer,p_text,blen);
+        buffer[blen] = '\0';
+        p_parser->LexPosition += nlen;
+        if( real ) {
+            p_lval->rValue.Position = position;
+            if( sscanf(buffer,"%lf",&p_lval->rValue.Number) != 1 ) {
+                pperror("unable to convert string to real number",position);
+            }
+            return(RNUMBER);
+        }
+        p_lval->iValue.Position = position;
+        if( sscanf(buffer,"%d",&p_lval->iValue.Number) != 1 ) {
+            pperror("unable to convert string to integer",position);
+        }
+        return(INUMBER);
+    }
+
+    // operators
+    for(int i=0; MaskOperators[i].Text != NULL; i++) {
+        int olen = strlen(MaskOperators[i].Text);
+        if( strncmp(MaskOperators[i].Text,p_text,olen) == 0 ) {
+            p_lval->gValue.Position = position;
+            p_parser->LexPosition += olen;
+            return(MaskOperators[i].Token);
+        }
+    }
+
+    pperror("unexpected character in mask specification",position);
+    return(ERROR);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -27,24 +27,22 @@
 
 using namespace std;
 
-//------------------------------------------------------------------------------
-
-int                 LexPosition     = 0;
-struct SExpression* TopExpression   = NULL;
-
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-// track info about allocation
-vector<SListItem*>      ListItemAllocations;
-vector<SList*>          ListAllocations;
-vector<SSelection*>     SelectionAllocations;
-vector<SExpression*>    ExpressionAllocations;
+// track info about allocation - owned by individual parsers
+struct SMaskAllocations {
+    vector<SListItem*>      ListItemAllocations;
+    vector<SList*>          ListAllocations;
+    vector<SSelection*>     SelectionAllocations;
+    vector<SExpression*>    ExpressionAllocations;
+};
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 bool print_expression(FILE* p_fout,struct SExpression* p_expr);
 bool print_selection(FILE* p_fout,struct SSelection* p_sel);
 bool print_list(FILE* p_fout,struct SList* p_list);
+struct SMaskAllocations* GetAllocations(struct SMaskParser* p_parser);
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -52,60 +50,68 @@ bool print_list(FILE* p_fout,struct SList* p_list);
 
 // int main(void)
 // {
-//  init_mask();
-//  parse_mask(":4GA");
-//  print_expression_tree(get_expression_tree());
-//  free_mask_tree();
+//  struct SMaskParser parser;
+//  init_mask(&parser);
+//  parse_mask(&parser,":4GA");
+//  print_expression_tree(get_expression_tree(&parser));
+//  free_mask_tree(&parser);
 // }
 
 //==============================================================================
 //------------------------------------------------------------------------------
 //==============================================================================
 
-int init_mask(void)
+int init_mask(struct SMaskParser* p_parser)
 {
-    free_mask_tree();
-    LexPosition = 1;
-    TopExpression = NULL;
+    // parser state can be uninitialized here
+    p_parser->Mask = NULL;
+    p_parser->LexPosition = 1;
+    p_parser->TopExpression = NULL;
+    p_parser->Allocations = NULL;
     return(0);
 }
 
 //------------------------------------------------------------------------------
 
-// int parse_mask(const char* p_mask);
+// int parse_mask(struct SMaskParser* p_parser,const char* p_mask);
 
 //------------------------------------------------------------------------------
 
-struct SExpression* get_expression_tree(void) {
-    return(TopExpression);
+struct SExpression* get_expression_tree(struct SMaskParser* p_parser) {
+    return(p_parser->TopExpression);
 }
 
 //------------------------------------------------------------------------------
 
-int free_mask_tree(void)
+int free_mask_tree(struct SMaskParser* p_parser)
 {
-    for(unsigned int i=0; i < ListItemAllocations.size(); i++) {
-        delete ListItemAllocations[i];
-    }
-    ListItemAllocations.clear();
+    struct SMaskAllocations* p_alloc = p_parser->Allocations;
 
-    for(unsigned int i=0; i < ListAllocations.size(); i++) {
-        delete ListAllocations[i];
+    p_parser->Allocations = NULL;
+    p_parser->LexPosition = 0;
+    p_parser->TopExpression = NULL;
+
+    if( p_alloc == NULL ) return(0);
+
+    for(unsigned int i=0; i < p_alloc->ListItemAllocations.size(); i++) {
+        delete p_alloc->ListItemAllocations[i];
     }
-    ListAllocations.clear();
+    p_alloc->ListItemAllocations.clear();
 
-    for(unsigned int i=0; i < SelectionAllocations.size(); i++) {
-        delete SelectionAllocations[i];
+    for(unsigned int i=0; i < p_alloc->ListAllocations.size(); i++) {
+        delete p_alloc->ListAllocations[i];
     }
-    SelectionAllocations.clear();
+    p_alloc->ListAllocations.clear();
 
-    for(unsigned int i=0; i < ExpressionAllocations.size(); i++) {
-        delete ExpressionAllocations[i];
+    for(unsigned int i=0; i < p_alloc->SelectionAllocations.size(); i++) {
+        delete p_alloc->SelectionAllocations[i];
     }
-    ExpressionAllocations.clear();
+    p_alloc->SelectionAllocations.clear();
 
-    LexPosition = 0;
-    TopExpression = NULL;
+    for(unsigned int i=0; i < p_alloc->ExpressionAllocations.size(); i++) {
+        delete p_alloc->ExpressionAllocations[i];
+    }
+    delete p_alloc;
 
     return(0);
 }
@@ -234,7 +240,7 @@ bool print_list(FILE* p_fout,struct SList* p_list)
 //------------------------------------------------------------------------------
 //==============================================================================
 
-int yyerror(const char* p_error)
+int yyerror(struct SMaskParser* p_parser,const char* p_error)
 {
     ES_ERROR(p_error);
     return(0);
@@ -254,7 +260,17 @@ int pperror(const char* p_error,int position)
 //------------------------------------------------------------------------------
 //==============================================================================
 
-struct SListItem* AllocateListItem(void) {
+struct SMaskAllocations* GetAllocations(struct SMaskParser* p_parser)
+{
+    if( p_parser->Allocations == NULL ) {
+        p_parser->Allocations = new struct SMaskAllocations;
+    }
+    return(p_parser->Allocations);
+}
+
+//------------------------------------------------------------------------------
+
+struct SListItem* AllocateListItem(struct SMaskParser* p_parser) {
     struct SListItem* p_item = new struct SListItem;
 
     p_item->Index = 0;
@@ -262,37 +278,38 @@ struct SListItem* AllocateListItem(void) {
     memset(p_item->Name,' ',4);
     p_item->NextItem = NULL;
 
-    ListItemAllocations.push_back(p_item);
+    GetAllocations(p_parser)->ListItemAllocations.push_back(p_item);
     return(p_item);
 }
 
 //------------------------------------------------------------------------------
 
-struct SList* AllocateList(void) {
+struct SList* AllocateList(struct SMaskParser* p_parser) {
     struct SList* p_list = new struct SList;
 
     p_list->FirstItem = NULL;
     p_list->LastItem = NULL;
 
-    ListAllocations.push_back(p_list);
+    GetAllocations(p_parser)->ListAllocations.push_back(p_list);
     return(p_list);
 }
 
 //------------------------------------------------------------------------------
 
-struct SSelection* AllocateSelection(enum SType type,struct SList* p_list) {
+struct SSelection* AllocateSelection(struct SMaskParser* p_parser,
+                                     enum SType type,struct SList* p_list) {
     struct SSelection* p_sel = new struct SSelection;
 
     p_sel->Type = type;
     p_sel->Items = p_list;
 
-    SelectionAllocations.push_back(p_sel);
+    GetAllocations(p_parser)->SelectionAllocations.push_back(p_sel);
     return(p_sel);
 }
 
 //------------------------------------------------------------------------------
 
-struct SExpression* AllocateExpression(void) {
+struct SExpression* AllocateExpression(struct SMaskParser* p_parser) {
     struct SExpression* p_expr = new struct SExpression;
 
     p_expr->Operator = O_NONE;
@@ -301,7 +318,7 @@ struct SExpression* AllocateExpression(void) {
     p_expr->LeftExpression = NULL;
     p_expr->RightExpression = NULL;
 
-    ExpressionAllocations.push_back(p_expr);
+    GetAllocations(p_parser)->ExpressionAllocations.push_back(p_expr);
     return(p_expr);
 }
 
@@ -98,9 +98,17 @@ struct SExpression {
     struct SExpression*     RightExpression;
 };
 
-/* global variables --------------------------------------------------------- */
-extern int                 LexPosition;        /* position in a mask during lexical analysis */
-extern struct SExpression* TopExpression;      /* top expression to be evaluated */
+/* parser state ------------------------------------------------------------- */
+
+struct SMaskAllocations;
+
+/* all state of one parser job, parsers with different states can run concurrently */
+struct SMaskParser {
+    const char*                 Mask;           /* mask being parsed */
+    int                         LexPosition;    /* position in a mask during lexical analysis */
+    struct SExpression*         TopExpression;  /* top expression to be evaluated */
+    struct SMaskAllocations*    Allocations;    /* nodes of expression tree owned by the parser */
+};
 
 /* global functions --------------------------------------------------------- */
 #ifdef __cplusplus
@@ -108,33 +116,31 @@ extern "C" {
 #endif
 
     /* init mask parser for new job */
-    extern int init_mask(void);
+    extern int init_mask(struct SMaskParser* p_parser);
 
     /* parse mask */
-    extern int parse_mask(const char* p_mask);
+    extern int parse_mask(struct SMaskParser* p_parser,const char* p_mask);
 
     /* free data associated with parsed mask */
-    extern int free_mask_tree(void);
+    extern int free_mask_tree(struct SMaskParser* p_parser);
 
     /* get top node of mask expression */
-    extern struct SExpression* get_expression_tree(void);
+    extern struct SExpression* get_expression_tree(struct SMaskParser* p_parser);
 
     /* print mask expression */
     extern int print_expression_tree(struct SExpression* p_expr);
 
     /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
-    extern int yyerror(const char* p_error);
-    extern int yylex(void);
-    extern struct yy_buffer_state* yy_scan_string(const char* p_string);
-    extern int yylex_destroy(void);
+    extern int yyerror(struct SMaskParser* p_parser,const char* p_error);
     extern int pperror(const char* p_error,int position);
 
     /* helper functions */
-    extern struct SListItem*   AllocateListItem(void);
-    extern struct SList*       AllocateList(void);
-    extern struct SSelection*  AllocateSelection(enum SType type,struct SList* p_list);
-    extern struct SExpression* AllocateExpression(void);
+    extern struct SListItem*   AllocateListItem(struct SMaskParser* p_parser);
+    extern struct SList*       AllocateList(struct SMaskParser* p_parser);
+    extern struct SSelection*  AllocateSelection(struct SMaskParser* p_parser,
+                                                 enum SType type,struct SList* p_list);
+    extern struct SExpression* AllocateExpression(struct SMaskParser* p_parser);
 
     /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
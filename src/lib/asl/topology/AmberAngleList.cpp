@@ -24,7 +24,9 @@
 #include <AmberAngle.hpp>
 #include <AmberAngleList.hpp>
 #include <FortranIO.hpp>
+#include <AmberFortranWriter.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberLoadErrors.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -276,7 +278,7 @@ bool CAmberAngleList::LoadAngleTK(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NUMANG; i++) {
         if( fortranio.ReadReal(p_type->TK) == false ) {
-            ES_ERROR("unable to load TK item");
+            AMBER_LOAD_ERROR("unable to load TK item");
             return(false);
         }
         p_type++;
@@ -296,7 +298,7 @@ bool CAmberAngleList::LoadAngleTEQ(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NUMANG; i++) {
         if( fortranio.ReadReal(p_type->TEQ) == false ) {
-            ES_ERROR("unable to load TEQ item");
+            AMBER_LOAD_ERROR("unable to load TEQ item");
             return(false);
         }
         p_type++;
@@ -316,19 +318,19 @@ bool CAmberAngleList::LoadAnglesWithHydrogens(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NTHETH; i++) {
         if( fortranio.ReadInt(p_angle->IT) == false ) {
-            ES_ERROR("unable to load IT item");
+            AMBER_LOAD_ERROR("unable to load IT item");
             return(false);
         }
         if( fortranio.ReadInt(p_angle->JT) == false ) {
-            ES_ERROR("unable to load JT item");
+            AMBER_LOAD_ERROR("unable to load JT item");
             return(false);
         }
         if( fortranio.ReadInt(p_angle->KT) == false ) {
-            ES_ERROR("unable to load KT item");
+            AMBER_LOAD_ERROR("unable to load KT item");
             return(false);
         }
         if( fortranio.ReadInt(p_angle->ICT) == false ) {
-            ES_ERROR("unable to load ICT item");
+            AMBER_LOAD_ERROR("unable to load ICT item");
             return(false);
         }
 
@@ -355,19 +357,19 @@ bool CAmberAngleList::LoadAnglesWithoutHydrogens(FILE* p_file,const char* p_form
 
     for(int i=0; i<MTHETA; i++) {
         if( fortranio.ReadInt(p_angle->IT) == false ) {
-            ES_ERROR("unable to load IT item");
+            AMBER_LOAD_ERROR("unable to load IT item");
             return(false);
         }
         if( fortranio.ReadInt(p_angle->JT) == false ) {
-            ES_ERROR("unable to load JT item");
+            AMBER_LOAD_ERROR("unable to load JT item");
             return(false);
         }
         if( fortranio.ReadInt(p_angle->KT) == false ) {
-            ES_ERROR("unable to load KT item");
+            AMBER_LOAD_ERROR("unable to load KT item");
             return(false);
         }
         if( fortranio.ReadInt(p_angle->ICT) == false ) {
-            ES_ERROR("unable to load ICT item");
+            AMBER_LOAD_ERROR("unable to load ICT item");
             return(false);
         }
 
@@ -394,15 +396,15 @@ bool CAmberAngleList::LoadPerturbedAngles(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NGPER; i++) {
         if( fortranio.ReadInt(p_angle->IT) == false ) {
-            ES_ERROR("unable to load IT item");
+            AMBER_LOAD_ERROR("unable to load IT item");
             return(false);
         }
         if( fortranio.ReadInt(p_angle->JT) == false ) {
-            ES_ERROR("unable to load JT item");
+            AMBER_LOAD_ERROR("unable to load JT item");
             return(false);
         }
         if( fortranio.ReadInt(p_angle->KT) == false ) {
-            ES_ERROR("unable to load KT item");
+            AMBER_LOAD_ERROR("unable to load KT item");
             return(false);
         }
 
@@ -428,7 +430,7 @@ bool CAmberAngleList::LoadPerturbedAngleTypeIndexes(FILE* p_file,const char* p_f
 
     for(int i=0; i<NGPER; i++) {
         if( fortranio.ReadInt(p_angle->ICT) == false ) {
-            ES_ERROR("unable to load ICT item");
+            AMBER_LOAD_ERROR("unable to load ICT item");
             return(false);
         }
         // reindex
@@ -441,7 +443,7 @@ bool CAmberAngleList::LoadPerturbedAngleTypeIndexes(FILE* p_file,const char* p_f
 
     for(int i=0; i<NGPER; i++) {
         if( fortranio.ReadInt(p_angle->PCT) == false ) {
-            ES_ERROR("unable to load PCT item");
+            AMBER_LOAD_ERROR("unable to load PCT item");
             return(false);
         }
         // reindex
@@ -457,19 +459,19 @@ bool CAmberAngleList::LoadPerturbedAngleTypeIndexes(FILE* p_file,const char* p_f
 
 bool CAmberAngleList::SaveAngleTK(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAngleType* p_type = AngleTypes;
 
     for(int i=0; i<NUMANG; i++) {
         if( fortranio.WriteReal(p_type->TK) == false ) {
-            ES_ERROR("unable to save TK item");
+            AMBER_LOAD_ERROR("unable to save TK item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -477,19 +479,19 @@ bool CAmberAngleList::SaveAngleTK(FILE* p_file,const char* p_format)
 
 bool CAmberAngleList::SaveAngleTEQ(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAngleType* p_type = AngleTypes;
 
     for(int i=0; i<NUMANG; i++) {
         if( fortranio.WriteReal(p_type->TEQ) == false ) {
-            ES_ERROR("unable to save TEQ item");
+            AMBER_LOAD_ERROR("unable to save TEQ item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -497,32 +499,32 @@ bool CAmberAngleList::SaveAngleTEQ(FILE* p_file,const char* p_format)
 
 bool CAmberAngleList::SaveAnglesWithHydrogens(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAngle* p_angle = AngleWithHydrogens;
 
     for(int i=0; i<NTHETH; i++) {
         if( fortranio.WriteInt(p_angle->IT*3) == false ) {
-            ES_ERROR("unable to save IT item");
+            AMBER_LOAD_ERROR("unable to save IT item");
             return(false);
         }
         if( fortranio.WriteInt(p_angle->JT*3) == false ) {
-            ES_ERROR("unable to save JT item");
+            AMBER_LOAD_ERROR("unable to save JT item");
             return(false);
         }
         if( fortranio.WriteInt(p_angle->KT*3) == false ) {
-            ES_ERROR("unable to save KT item");
+            AMBER_LOAD_ERROR("unable to save KT item");
             return(false);
         }
         if( fortranio.WriteInt(p_angle->ICT+1) == false ) {
-            ES_ERROR("unable to save ICT item");
+            AMBER_LOAD_ERROR("unable to save ICT item");
             return(false);
         }
 
         p_angle++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -530,32 +532,32 @@ bool CAmberAngleList::SaveAnglesWithHydrogens(FILE* p_file,const char* p_format)
 
 bool CAmberAngleList::SaveAnglesWithoutHydrogens(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAngle* p_angle = AngleWithoutHydrogens;
 
     for(int i=0; i<MTHETA; i++) {
         if( fortranio.WriteInt(p_angle->IT*3) == false ) {
-            ES_ERROR("unable to save IT item");
+            AMBER_LOAD_ERROR("unable to save IT item");
             return(false);
         }
         if( fortranio.WriteInt(p_angle->JT*3) == false ) {
-            ES_ERROR("unable to save JT item");
+            AMBER_LOAD_ERROR("unable to save JT item");
             return(false);
         }
         if( fortranio.WriteInt(p_angle->KT*3) == false ) {
-            ES_ERROR("unable to save KT item");
+            AMBER_LOAD_ERROR("unable to save KT item");
             return(false);
         }
         if( fortranio.WriteInt(p_angle->ICT+1) == false ) {
-            ES_ERROR("unable to save ICT item");
+            AMBER_LOAD_ERROR("unable to save ICT item");
             return(false);
         }
 
         p_angle++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -563,28 +565,28 @@ bool CAmberAngleList::SaveAnglesWithoutHydrogens(FILE* p_file,const char* p_form
 
 bool CAmberAngleList::SavePerturbedAngles(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAngle* p_angle = PerturbedAngles;
 
     for(int i=0; i<NGPER; i++) {
         if( fortranio.WriteInt(p_angle->IT*3) == false ) {
-            ES_ERROR("unable to save IT item");
+            AMBER_LOAD_ERROR("unable to save IT item");
             return(false);
         }
         if( fortranio.WriteInt(p_angle->JT*3) == false ) {
-            ES_ERROR("unable to save JT item");
+            AMBER_LOAD_ERROR("unable to save JT item");
             return(false);
         }
         if( fortranio.WriteInt(p_angle->KT*3) == false ) {
-            ES_ERROR("unable to save KT item");
+            AMBER_LOAD_ERROR("unable to save KT item");
             return(false);
         }
 
         p_angle++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -592,14 +594,14 @@ bool CAmberAngleList::SavePerturbedAngles(FILE* p_file,const char* p_format)
 
 bool CAmberAngleList::SavePerturbedAngleTypeIndexes(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAngle* p_angle = PerturbedAngles;
 
     for(int i=0; i<NGPER; i++) {
         if( fortranio.WriteInt(p_angle->ICT + 1) == false ) {
-            ES_ERROR("unable to save ICT item");
+            AMBER_LOAD_ERROR("unable to save ICT item");
             return(false);
         }
         p_angle++;
@@ -608,13 +610,13 @@ bool CAmberAngleList::SavePerturbedAngleTypeIndexes(FILE* p_file,const char* p_f
     p_angle = PerturbedAngles;
     for(int i=0; i<NGPER; i++) {
         if( fortranio.WriteInt(p_angle->PCT + 1) == false ) {
-            ES_ERROR("unable to save PCT item");
+            AMBER_LOAD_ERROR("unable to save PCT item");
             return(false);
         }
         p_angle++;
     }
 
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -21,6 +21,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <AmberAtom.hpp>
+#include <AmberAtomList.hpp>
 
 #include <PeriodicTable.hpp>
 
@@ -53,6 +54,9 @@ CAmberAtom::CAmberAtom(void)
     Residue = NULL;
     MoleculeIndex = -1;
     AtomIndex = -1;
+    AtomList = NULL;
+    Neighbours = NULL;
+    NumOfNeighbours = 0;
 }
 
 //==============================================================================
@@ -83,6 +87,7 @@ double CAmberAtom::GetMass(void) const
 void CAmberAtom::SetMass(double mass)
 {
     AMASS = mass;
+    InvalidateArrays();
 }
 
 //------------------------------------------------------------------------------
@@ -168,6 +173,7 @@ double CAmberAtom::GetRadius(void) const
 void CAmberAtom::SetRadius(double radius)
 {
     RADIUS = radius;
+    InvalidateArrays();
 }
 
 //------------------------------------------------------------------------------
@@ -182,6 +188,7 @@ double CAmberAtom::GetScreenValue(void) const
 void CAmberAtom::SetScreenValue(double screen)
 {
     SCREEN = screen;
+    InvalidateArrays();
 }
 
 //------------------------------------------------------------------------------
@@ -201,6 +208,7 @@ void CAmberAtom::SetCharge(double charge,bool pert)
 {
     if( pert == false ) {
         CHRG = charge;
+        InvalidateArrays();
     } else {
         CGPER = charge;
     }
@@ -223,6 +231,7 @@ void CAmberAtom::SetStandardCharge(double charge,bool pert)
 {
     if( pert == false ) {
         CHRG = charge*18.2223;
+        InvalidateArrays();
     } else {
         CGPER = charge*18.2223;
     }
@@ -245,6 +254,7 @@ void CAmberAtom::SetIAC(int iac_index,bool pert)
 {
     if( pert == false ) {
         IAC = iac_index;
+        InvalidateArrays();
     } else {
         IACPER = iac_index;
     }
@@ -284,6 +294,7 @@ int CAmberAtom::GetAtomicNumber(void) const
 void CAmberAtom::SetAtomicNumber(int z)
 {
     ATOMIC_NUMBER = z;
+    InvalidateArrays();
 }
 
 //------------------------------------------------------------------------------
@@ -327,20 +338,29 @@ int CAmberAtom::GuessZ(void) const
 
 int CAmberAtom::GetNumberOfNeighbourAtoms(void)
 {
-    return(NeighbourIndexes.size());
+    return(NumOfNeighbours);
 }
 
 //------------------------------------------------------------------------------
 
 int CAmberAtom::GetNeighbourAtomIndex(int index)
 {
-    std::set<int>::iterator it = NeighbourIndexes.begin();
-    for(int i=0; i < index; i++) it++;
-    if( it != NeighbourIndexes.end() ){
-        return(*it);
-    } else {
-        return(-1);
-    }
+    if( (index < 0) || (index >= NumOfNeighbours) ) return(-1);
+    return(Neighbours[index]);
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberAtom::GetNeighbourAtoms(void) const
+{
+    return(Neighbours);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberAtom::InvalidateArrays(void)
+{
+    if( AtomList != NULL ) AtomList->InvalidateArrays();
 }
 
 //==============================================================================
@@ -25,11 +25,11 @@
 #include <stdio.h>
 #include <ASLMainHeader.hpp>
 #include <SmallString.hpp>
-#include <set>
 
 // -----------------------------------------------------------------------------
 
 class CAmberResidue;
+class CAmberAtomList;
 
 // -----------------------------------------------------------------------------
 
@@ -149,11 +149,16 @@ public:
     int GuessZ(void) const;
 
     /// get number of neighbour atoms
+    /*! this information is initialized by CAmberTopology:BuidListOfNeighbourAtoms()
+    */
     int GetNumberOfNeighbourAtoms(void);
 
     /// get neighbour atom index
     int GetNeighbourAtomIndex(int index);
 
+    /// get sorted list of neighbour atom indexes
+    const int* GetNeighbourAtoms(void) const;
+
 // section of private data ----------------------------------------------------
 private:
     // common properties -------------------------------------------------------
@@ -249,8 +254,17 @@ private:
     /// atom index
     int             AtomIndex;
 
-    /// list of neighbour atom indexes
-    std::set<int>   NeighbourIndexes;
+    /// atom list in which atom belongs
+    CAmberAtomList* AtomList;
+
+    /// list of neighbour atom indexes (owned by topology)
+    const int*      Neighbours;
+
+    /// number of neighbour atoms
+    int             NumOfNeighbours;
+
+    /// invalidate property arrays of owning atom list
+    void InvalidateArrays(void);
 
     friend class CAmberAtomList;
     friend class CAmberResidueList;
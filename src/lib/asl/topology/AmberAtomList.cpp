@@ -22,7 +22,10 @@
 #include <stdlib.h>
 #include <AmberAtomList.hpp>
 #include <FortranIO.hpp>
+#include <AmberFortranWriter.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberLoadErrors.hpp>
+#include <AmberResidue.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -35,6 +38,7 @@ CAmberAtomList::CAmberAtomList(void)
     IFPOL = 0;
     Atoms =  NULL;
     AtomicNumberLoaded = false;
+    ArraysValid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -59,7 +63,10 @@ void CAmberAtomList::InitFields(int iNATOM,int iIFPERT,int iIFPOL,int iNUMEXTRA)
 
     if( NATOM > 0 ) Atoms = new CAmberAtom[NATOM];
 
-    for(int i=0; i < NATOM; i++) Atoms[i].AtomIndex = i;
+    for(int i=0; i < NATOM; i++) {
+        Atoms[i].AtomIndex = i;
+        Atoms[i].AtomList = this;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -72,6 +79,8 @@ void CAmberAtomList::FreeFields(void)
     NATOM = 0;
     IFPERT = 0;
     IFPOL = 0;
+
+    InvalidateArrays();
 }
 
 //==============================================================================
@@ -134,6 +143,7 @@ void CAmberAtomList::operator = (const CAmberAtomList& src)
     // copy atoms
     for(int i=0; i<NATOM; i++){
         Atoms[i] = src.Atoms[i];
+        Atoms[i].AtomList = this;
     }
 }
 
@@ -141,6 +151,132 @@ void CAmberAtomList::operator = (const CAmberAtomList& src)
 //------------------------------------------------------------------------------
 //==============================================================================
 
+const double* CAmberAtomList::GetChargeArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&Charges[0]);
+}
+
+//------------------------------------------------------------------------------
+
+const double* CAmberAtomList::GetMassArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&Masses[0]);
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberAtomList::GetIACArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&IACs[0]);
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberAtomList::GetTypeIndexArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&TypeIndexes[0]);
+}
+
+//------------------------------------------------------------------------------
+
+const double* CAmberAtomList::GetRadiusArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&Radii[0]);
+}
+
+//------------------------------------------------------------------------------
+
+const double* CAmberAtomList::GetScreenArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&Screens[0]);
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberAtomList::GetAtomicNumberArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&AtomicNumbers[0]);
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberAtomList::GetResidueIndexArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&ResidueIndexes[0]);
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberAtomList::GetMoleculeIndexArray(void)
+{
+    UpdateArrays();
+    if( NATOM == 0 ) return(NULL);
+    return(&MoleculeIndexes[0]);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberAtomList::UpdateArrays(void)
+{
+    if( ArraysValid == true ) return;
+
+    Charges.resize(NATOM);
+    Masses.resize(NATOM);
+    IACs.resize(NATOM);
+    TypeIndexes.resize(NATOM);
+    Radii.resize(NATOM);
+    Screens.resize(NATOM);
+    AtomicNumbers.resize(NATOM);
+    ResidueIndexes.resize(NATOM);
+    MoleculeIndexes.resize(NATOM);
+
+    for(int i=0; i < NATOM; i++) {
+        CAmberAtom* p_atom = &Atoms[i];
+        Charges[i] = p_atom->CHRG;
+        Masses[i] = p_atom->AMASS;
+        IACs[i] = p_atom->IAC;
+        TypeIndexes[i] = p_atom->IAC - 1;
+        Radii[i] = p_atom->RADIUS;
+        Screens[i] = p_atom->SCREEN;
+        AtomicNumbers[i] = p_atom->ATOMIC_NUMBER;
+        if( p_atom->Residue != NULL ) {
+            ResidueIndexes[i] = p_atom->Residue->GetIndex();
+        } else {
+            ResidueIndexes[i] = -1;
+        }
+        MoleculeIndexes[i] = p_atom->MoleculeIndex;
+    }
+
+    ArraysValid = true;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberAtomList::InvalidateArrays(void)
+{
+    ArraysValid = false;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
 bool CAmberAtomList::LoadAtomNames(FILE* p_file,const char* p_format)
 {
     CFortranIO fortranio(p_file);
@@ -150,7 +286,7 @@ bool CAmberAtomList::LoadAtomNames(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadString(p_atom->IGRAPH) == false ) {
-            ES_ERROR("unable to load IGRAPH item");
+            AMBER_LOAD_ERROR("unable to load IGRAPH item");
             return(false);
         }
         p_atom++;
@@ -170,7 +306,7 @@ bool CAmberAtomList::LoadAtomCharges(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadReal(p_atom->CHRG) == false ) {
-            ES_ERROR("unable to load CHRG item");
+            AMBER_LOAD_ERROR("unable to load CHRG item");
             return(false);
         }
         p_atom++;
@@ -190,7 +326,7 @@ bool CAmberAtomList::LoadAtomAtomicNumbers(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadInt(p_atom->ATOMIC_NUMBER) == false ) {
-            ES_ERROR("unable to load ATOMIC_NUMBER item");
+            AMBER_LOAD_ERROR("unable to load ATOMIC_NUMBER item");
             return(false);
         }
         p_atom++;
@@ -210,7 +346,7 @@ bool CAmberAtomList::LoadAtomMasses(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadReal(p_atom->AMASS) == false ) {
-            ES_ERROR("unable to load AMASS item");
+            AMBER_LOAD_ERROR("unable to load AMASS item");
             return(false);
         }
         p_atom++;
@@ -230,7 +366,7 @@ bool CAmberAtomList::LoadAtomIACs(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadInt(p_atom->IAC) == false ) {
-            ES_ERROR("unable to load IAC item");
+            AMBER_LOAD_ERROR("unable to load IAC item");
             return(false);
         }
         p_atom++;
@@ -250,7 +386,7 @@ bool CAmberAtomList::LoadAtomNUMEXs(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadInt(p_atom->NUMEX) == false ) {
-            ES_ERROR("unable to load NUMEX item");
+            AMBER_LOAD_ERROR("unable to load NUMEX item");
             return(false);
         }
         p_atom++;
@@ -279,7 +415,7 @@ bool CAmberAtomList::LoadAtomPol(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadReal(p_atom->ATPOL) == false ) {
-            ES_ERROR("unable to load ATPOL item");
+            AMBER_LOAD_ERROR("unable to load ATPOL item");
             return(false);
         }
         p_atom++;
@@ -292,19 +428,19 @@ bool CAmberAtomList::LoadAtomPol(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomNames(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteString(p_atom->IGRAPH) == false ) {
-            ES_ERROR("unable to save IGRAPH item");
+            AMBER_LOAD_ERROR("unable to save IGRAPH item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -312,19 +448,19 @@ bool CAmberAtomList::SaveAtomNames(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomCharges(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteReal(p_atom->CHRG) == false ) {
-            ES_ERROR("unable to save CHRG item");
+            AMBER_LOAD_ERROR("unable to save CHRG item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -332,19 +468,19 @@ bool CAmberAtomList::SaveAtomCharges(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomAtomicNumbers(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteInt(p_atom->ATOMIC_NUMBER) == false ) {
-            ES_ERROR("unable to save ATOMIC_NUMBER item");
+            AMBER_LOAD_ERROR("unable to save ATOMIC_NUMBER item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -352,19 +488,19 @@ bool CAmberAtomList::SaveAtomAtomicNumbers(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomMasses(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteReal(p_atom->AMASS) == false ) {
-            ES_ERROR("unable to save AMASS item");
+            AMBER_LOAD_ERROR("unable to save AMASS item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -372,19 +508,19 @@ bool CAmberAtomList::SaveAtomMasses(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomIACs(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteInt(p_atom->IAC) == false ) {
-            ES_ERROR("unable to save AMASS item");
+            AMBER_LOAD_ERROR("unable to save AMASS item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -392,19 +528,19 @@ bool CAmberAtomList::SaveAtomIACs(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomNUMEXs(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteInt(p_atom->NUMEX) == false ) {
-            ES_ERROR("unable to save NUMEX item");
+            AMBER_LOAD_ERROR("unable to save NUMEX item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -412,19 +548,19 @@ bool CAmberAtomList::SaveAtomNUMEXs(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomPol(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteReal(p_atom->ATPOL) == false ) {
-            ES_ERROR("unable to save ATPOL item");
+            AMBER_LOAD_ERROR("unable to save ATPOL item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -439,7 +575,7 @@ bool CAmberAtomList::LoadAtomISYMBL(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadString(p_atom->ISYMBL) == false ) {
-            ES_ERROR("unable to load ISYMBL item");
+            AMBER_LOAD_ERROR("unable to load ISYMBL item");
             return(false);
         }
         p_atom++;
@@ -459,7 +595,7 @@ bool CAmberAtomList::LoadAtomITREE(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadString(p_atom->ITREE) == false ) {
-            ES_ERROR("unable to load ISYMBL item");
+            AMBER_LOAD_ERROR("unable to load ISYMBL item");
             return(false);
         }
         p_atom++;
@@ -479,7 +615,7 @@ bool CAmberAtomList::LoadAtomJOIN(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadInt(p_atom->JOIN) == false ) {
-            ES_ERROR("unable to load JOIN item");
+            AMBER_LOAD_ERROR("unable to load JOIN item");
             return(false);
         }
         p_atom++;
@@ -499,7 +635,7 @@ bool CAmberAtomList::LoadAtomIROTAT(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadInt(p_atom->IROTAT) == false ) {
-            ES_ERROR("unable to load IROTAT item");
+            AMBER_LOAD_ERROR("unable to load IROTAT item");
             return(false);
         }
         p_atom++;
@@ -512,19 +648,19 @@ bool CAmberAtomList::LoadAtomIROTAT(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomISYMBL(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteString(p_atom->ISYMBL) == false ) {
-            ES_ERROR("unable to save ISYMBL item");
+            AMBER_LOAD_ERROR("unable to save ISYMBL item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -532,19 +668,19 @@ bool CAmberAtomList::SaveAtomISYMBL(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomITREE(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteString(p_atom->ITREE) == false ) {
-            ES_ERROR("unable to save ISYMBL item");
+            AMBER_LOAD_ERROR("unable to save ISYMBL item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -552,19 +688,19 @@ bool CAmberAtomList::SaveAtomITREE(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomJOIN(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteInt(p_atom->JOIN) == false ) {
-            ES_ERROR("unable to save JOIN item");
+            AMBER_LOAD_ERROR("unable to save JOIN item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -572,19 +708,19 @@ bool CAmberAtomList::SaveAtomJOIN(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomIROTAT(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteInt(p_atom->IROTAT) == false ) {
-            ES_ERROR("unable to save IROTAT item");
+            AMBER_LOAD_ERROR("unable to save IROTAT item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -599,7 +735,7 @@ bool CAmberAtomList::LoadPertAtomNames(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadString(p_atom->IGRPER) == false ) {
-            ES_ERROR("unable to load IGRPER item");
+            AMBER_LOAD_ERROR("unable to load IGRPER item");
             return(false);
         }
         p_atom++;
@@ -619,7 +755,7 @@ bool CAmberAtomList::LoadPertAtomISYMBL(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadString(p_atom->ISMPER) == false ) {
-            ES_ERROR("unable to load ISMPER item");
+            AMBER_LOAD_ERROR("unable to load ISMPER item");
             return(false);
         }
         p_atom++;
@@ -639,7 +775,7 @@ bool CAmberAtomList::LoadPertAtomCharges(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadReal(p_atom->CGPER) == false ) {
-            ES_ERROR("unable to load CGPER item");
+            AMBER_LOAD_ERROR("unable to load CGPER item");
             return(false);
         }
         p_atom++;
@@ -659,7 +795,7 @@ bool CAmberAtomList::LoadPertAtomPertFlag(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadInt(p_atom->IAPER) == false ) {
-            ES_ERROR("unable to load IAPER item");
+            AMBER_LOAD_ERROR("unable to load IAPER item");
             return(false);
         }
         p_atom++;
@@ -679,7 +815,7 @@ bool CAmberAtomList::LoadPertAtomIAC(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadInt(p_atom->IACPER) == false ) {
-            ES_ERROR("unable to load IACPER item");
+            AMBER_LOAD_ERROR("unable to load IACPER item");
             return(false);
         }
         p_atom++;
@@ -699,7 +835,7 @@ bool CAmberAtomList::LoadPertAtomPol(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadReal(p_atom->ATPOL1) == false ) {
-            ES_ERROR("unable to load ATPOL1 item");
+            AMBER_LOAD_ERROR("unable to load ATPOL1 item");
             return(false);
         }
         p_atom++;
@@ -719,7 +855,7 @@ bool CAmberAtomList::LoadPertAtomALMPER(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadReal(p_atom->ALMPER) == false ) {
-            ES_ERROR("unable to load ALMPER item");
+            AMBER_LOAD_ERROR("unable to load ALMPER item");
             return(false);
         }
         p_atom++;
@@ -732,19 +868,19 @@ bool CAmberAtomList::LoadPertAtomALMPER(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SavePertAtomNames(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteString(p_atom->IGRPER) == false ) {
-            ES_ERROR("unable to save IGRPER item");
+            AMBER_LOAD_ERROR("unable to save IGRPER item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -752,19 +888,19 @@ bool CAmberAtomList::SavePertAtomNames(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SavePertAtomISYMBL(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteString(p_atom->ISMPER) == false ) {
-            ES_ERROR("unable to save ISMPER item");
+            AMBER_LOAD_ERROR("unable to save ISMPER item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -772,19 +908,19 @@ bool CAmberAtomList::SavePertAtomISYMBL(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SavePertAtomCharges(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteReal(p_atom->CGPER) == false ) {
-            ES_ERROR("unable to save CGPER item");
+            AMBER_LOAD_ERROR("unable to save CGPER item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -792,19 +928,19 @@ bool CAmberAtomList::SavePertAtomCharges(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SavePertAtomPertFlag(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteInt(p_atom->IAPER) == false ) {
-            ES_ERROR("unable to save IAPER item");
+            AMBER_LOAD_ERROR("unable to save IAPER item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -812,19 +948,19 @@ bool CAmberAtomList::SavePertAtomPertFlag(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SavePertAtomIAC(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteInt(p_atom->IACPER) == false ) {
-            ES_ERROR("unable to save IACPER item");
+            AMBER_LOAD_ERROR("unable to save IACPER item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -832,19 +968,19 @@ bool CAmberAtomList::SavePertAtomIAC(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SavePertAtomPol(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteReal(p_atom->ATPOL1) == false ) {
-            ES_ERROR("unable to save ATPOL1 item");
+            AMBER_LOAD_ERROR("unable to save ATPOL1 item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -852,19 +988,19 @@ bool CAmberAtomList::SavePertAtomPol(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SavePertAtomALMPER(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteReal(p_atom->ALMPER) == false ) {
-            ES_ERROR("unable to save ALMPER item");
+            AMBER_LOAD_ERROR("unable to save ALMPER item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -888,7 +1024,7 @@ bool CAmberAtomList::LoadAtomRadii(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadReal(p_atom->RADIUS) == false ) {
-            ES_ERROR("unable to load RADIUS item");
+            AMBER_LOAD_ERROR("unable to load RADIUS item");
             return(false);
         }
         p_atom++;
@@ -908,7 +1044,7 @@ bool CAmberAtomList::LoadAtomScreen(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.ReadReal(p_atom->SCREEN) == false ) {
-            ES_ERROR("unable to load SCREEN item");
+            AMBER_LOAD_ERROR("unable to load SCREEN item");
             return(false);
         }
         p_atom++;
@@ -923,12 +1059,12 @@ bool CAmberAtomList::SaveAtomRadiusSet(FILE* p_file,const char* p_format)
 {
     if( RadiusSet == NULL ) return(true);
 
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     fortranio.WriteString(RadiusSet);
 
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -936,19 +1072,19 @@ bool CAmberAtomList::SaveAtomRadiusSet(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomRadii(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteReal(p_atom->RADIUS) == false ) {
-            ES_ERROR("unable to save RADIUS item");
+            AMBER_LOAD_ERROR("unable to save RADIUS item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -956,19 +1092,19 @@ bool CAmberAtomList::SaveAtomRadii(FILE* p_file,const char* p_format)
 
 bool CAmberAtomList::SaveAtomScreen(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberAtom* p_atom = Atoms;
 
     for(int i=0; i<NATOM; i++) {
         if( fortranio.WriteReal(p_atom->SCREEN) == false ) {
-            ES_ERROR("unable to save SCREEN item");
+            AMBER_LOAD_ERROR("unable to save SCREEN item");
             return(false);
         }
         p_atom++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -26,6 +26,7 @@
 #include <ASLMainHeader.hpp>
 #include <SmallString.hpp>
 #include <AmberAtom.hpp>
+#include <vector>
 
 //---------------------------------------------------------------------------
 
@@ -63,6 +64,48 @@ public:
     /// overload assigment operator
     void operator = (const CAmberAtomList& src);
 
+// property arrays -------------------------------------------------------------
+    /// return array of charges (internal AMBER units)
+    /*! property arrays are contiguous copies of atom data, they are built
+        on the first request and invalidated when atoms are modified,
+        returned pointers are valid until the next modification,
+        arrays should be built by UpdateArrays in advance if they are
+        requested from several threads
+    */
+    const double* GetChargeArray(void);
+
+    /// return array of masses
+    const double* GetMassArray(void);
+
+    /// return array of atom type indexes (IAC)
+    const int* GetIACArray(void);
+
+    /// return array of zero-based atom type indexes (IAC-1)
+    /*! it indexes rows of CAmberNonBondedList::GetParamTable
+    */
+    const int* GetTypeIndexArray(void);
+
+    /// return array of GB radii
+    const double* GetRadiusArray(void);
+
+    /// return array of GB screening parameters
+    const double* GetScreenArray(void);
+
+    /// return array of atomic numbers
+    const int* GetAtomicNumberArray(void);
+
+    /// return array of residue indexes (-1 for atoms without residue)
+    const int* GetResidueIndexArray(void);
+
+    /// return array of molecule indexes (see CAmberAtom::GetMoleculeIndex)
+    const int* GetMoleculeIndexArray(void);
+
+    /// build property arrays if they are not valid
+    void UpdateArrays(void);
+
+    /// invalidate property arrays
+    void InvalidateArrays(void);
+
 // section of private data ----------------------------------------------------
 private:
     /// NATOM  : total number of atoms
@@ -83,6 +126,18 @@ private:
 
     CAmberAtom* Atoms;
 
+    // property arrays
+    bool                ArraysValid;
+    std::vector<double> Charges;
+    std::vector<double> Masses;
+    std::vector<int>    IACs;
+    std::vector<int>    TypeIndexes;
+    std::vector<double> Radii;
+    std::vector<double> Screens;
+    std::vector<int>    AtomicNumbers;
+    std::vector<int>    ResidueIndexes;
+    std::vector<int>    MoleculeIndexes;
+
     bool LoadAtomNames(FILE* p_file,const char* p_format);
     bool LoadAtomCharges(FILE* p_file,const char* p_format);
     bool LoadAtomAtomicNumbers(FILE* p_file,const char* p_format);
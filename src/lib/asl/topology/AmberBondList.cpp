@@ -22,7 +22,9 @@
 #include <stdlib.h>
 #include <AmberBondList.hpp>
 #include <FortranIO.hpp>
+#include <AmberFortranWriter.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberLoadErrors.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -228,7 +230,7 @@ bool CAmberBondList::LoadBondRK(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NUMBND; i++) {
         if( fortranio.ReadReal(p_type->RK) == false ) {
-            ES_ERROR("unable to load RK item");
+            AMBER_LOAD_ERROR("unable to load RK item");
             return(false);
         }
         p_type++;
@@ -248,7 +250,7 @@ bool CAmberBondList::LoadBondREQ(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NUMBND; i++) {
         if( fortranio.ReadReal(p_type->REQ) == false ) {
-            ES_ERROR("unable to load REQ item");
+            AMBER_LOAD_ERROR("unable to load REQ item");
             return(false);
         }
         p_type++;
@@ -268,15 +270,15 @@ bool CAmberBondList::LoadBondsWithHydrogens(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NBONH; i++) {
         if( fortranio.ReadInt(p_bond->IB) == false ) {
-            ES_ERROR("unable to load IB item");
+            AMBER_LOAD_ERROR("unable to load IB item");
             return(false);
         }
         if( fortranio.ReadInt(p_bond->JB) == false ) {
-            ES_ERROR("unable to load JB item");
+            AMBER_LOAD_ERROR("unable to load JB item");
             return(false);
         }
         if( fortranio.ReadInt(p_bond->ICB) == false ) {
-            ES_ERROR("unable to load ICB item");
+            AMBER_LOAD_ERROR("unable to load ICB item");
             return(false);
         }
 
@@ -301,15 +303,15 @@ bool CAmberBondList::LoadBondsWithoutHydrogens(FILE* p_file,const char* p_format
 
     for(int i=0; i<MBONA; i++) {
         if( fortranio.ReadInt(p_bond->IB) == false ) {
-            ES_ERROR("unable to load IB item");
+            AMBER_LOAD_ERROR("unable to load IB item");
             return(false);
         }
         if( fortranio.ReadInt(p_bond->JB) == false ) {
-            ES_ERROR("unable to load JB item");
+            AMBER_LOAD_ERROR("unable to load JB item");
             return(false);
         }
         if( fortranio.ReadInt(p_bond->ICB) == false ) {
-            ES_ERROR("unable to load ICB item");
+            AMBER_LOAD_ERROR("unable to load ICB item");
             return(false);
         }
 
@@ -335,11 +337,11 @@ bool CAmberBondList::LoadPerturbedBonds(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NBPER; i++) {
         if( fortranio.ReadInt(p_bond->IB) == false ) {
-            ES_ERROR("unable to load IB item");
+            AMBER_LOAD_ERROR("unable to load IB item");
             return(false);
         }
         if( fortranio.ReadInt(p_bond->JB) == false ) {
-            ES_ERROR("unable to load JB item");
+            AMBER_LOAD_ERROR("unable to load JB item");
             return(false);
         }
         // reindex
@@ -363,7 +365,7 @@ bool CAmberBondList::LoadPerturbedBondTypeIndexes(FILE* p_file,const char* p_for
 
     for(int i=0; i<NBPER; i++) {
         if( fortranio.ReadInt(p_bond->ICB) == false ) {
-            ES_ERROR("unable to load ICB item");
+            AMBER_LOAD_ERROR("unable to load ICB item");
             return(false);
         }
         // reindex
@@ -376,7 +378,7 @@ bool CAmberBondList::LoadPerturbedBondTypeIndexes(FILE* p_file,const char* p_for
 
     for(int i=0; i<NBPER; i++) {
         if( fortranio.ReadInt(p_bond->PCB) == false ) {
-            ES_ERROR("unable to load PCB item");
+            AMBER_LOAD_ERROR("unable to load PCB item");
             return(false);
         }
         // reindex
@@ -392,19 +394,19 @@ bool CAmberBondList::LoadPerturbedBondTypeIndexes(FILE* p_file,const char* p_for
 
 bool CAmberBondList::SaveBondRK(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberBondType* p_type = BondTypes;
 
     for(int i=0; i<NUMBND; i++) {
         if( fortranio.WriteReal(p_type->RK) == false ) {
-            ES_ERROR("unable to save RK item");
+            AMBER_LOAD_ERROR("unable to save RK item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -412,19 +414,19 @@ bool CAmberBondList::SaveBondRK(FILE* p_file,const char* p_format)
 
 bool CAmberBondList::SaveBondREQ(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberBondType* p_type = BondTypes;
 
     for(int i=0; i<NUMBND; i++) {
         if( fortranio.WriteReal(p_type->REQ) == false ) {
-            ES_ERROR("unable to save REQ item");
+            AMBER_LOAD_ERROR("unable to save REQ item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -432,28 +434,28 @@ bool CAmberBondList::SaveBondREQ(FILE* p_file,const char* p_format)
 
 bool CAmberBondList::SaveBondsWithHydrogens(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberBond* p_bond = BondsWithHydrogens;
 
     for(int i=0; i<NBONH; i++) {
         if( fortranio.WriteInt(p_bond->IB*3) == false ) {
-            ES_ERROR("unable to save IB item");
+            AMBER_LOAD_ERROR("unable to save IB item");
             return(false);
         }
         if( fortranio.WriteInt(p_bond->JB*3) == false ) {
-            ES_ERROR("unable to saveJB item");
+            AMBER_LOAD_ERROR("unable to saveJB item");
             return(false);
         }
         if( fortranio.WriteInt(p_bond->ICB+1) == false ) {
-            ES_ERROR("unable to saveICB item");
+            AMBER_LOAD_ERROR("unable to saveICB item");
             return(false);
         }
 
         p_bond++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -461,28 +463,28 @@ bool CAmberBondList::SaveBondsWithHydrogens(FILE* p_file,const char* p_format)
 
 bool CAmberBondList::SaveBondsWithoutHydrogens(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberBond* p_bond = BondsWithoutHydrogens;
 
     for(int i=0; i<MBONA; i++) {
         if( fortranio.WriteInt(p_bond->IB*3) == false ) {
-            ES_ERROR("unable to save IB item");
+            AMBER_LOAD_ERROR("unable to save IB item");
             return(false);
         }
         if( fortranio.WriteInt(p_bond->JB*3) == false ) {
-            ES_ERROR("unable to save JB item");
+            AMBER_LOAD_ERROR("unable to save JB item");
             return(false);
         }
         if( fortranio.WriteInt(p_bond->ICB+1) == false ) {
-            ES_ERROR("unable to save ICB item");
+            AMBER_LOAD_ERROR("unable to save ICB item");
             return(false);
         }
 
         p_bond++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -490,23 +492,23 @@ bool CAmberBondList::SaveBondsWithoutHydrogens(FILE* p_file,const char* p_format
 
 bool CAmberBondList::SavePerturbedBonds(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberBond* p_bond = PerturbedBonds;
 
     for(int i=0; i<NBPER; i++) {
         if( fortranio.WriteInt(p_bond->IB*3) == false ) {
-            ES_ERROR("unable to save IB item");
+            AMBER_LOAD_ERROR("unable to save IB item");
             return(false);
         }
         if( fortranio.WriteInt(p_bond->JB*3) == false ) {
-            ES_ERROR("unable to save JB item");
+            AMBER_LOAD_ERROR("unable to save JB item");
             return(false);
         }
         p_bond++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -514,14 +516,14 @@ bool CAmberBondList::SavePerturbedBonds(FILE* p_file,const char* p_format)
 
 bool CAmberBondList::SavePerturbedBondTypeIndexes(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberBond* p_bond = PerturbedBonds;
 
     for(int i=0; i<NBPER; i++) {
         if( fortranio.WriteInt(p_bond->ICB+1) == false ) {
-            ES_ERROR("unable to save ICB item");
+            AMBER_LOAD_ERROR("unable to save ICB item");
             return(false);
         }
         p_bond++;
@@ -530,13 +532,13 @@ bool CAmberBondList::SavePerturbedBondTypeIndexes(FILE* p_file,const char* p_for
     p_bond = PerturbedBonds;
     for(int i=0; i<NBPER; i++) {
         if( fortranio.WriteInt(p_bond->PCB+1) == false ) {
-            ES_ERROR("unable to save PCB item");
+            AMBER_LOAD_ERROR("unable to save PCB item");
             return(false);
         }
         p_bond++;
     }
 
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
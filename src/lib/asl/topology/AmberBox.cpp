@@ -22,7 +22,9 @@
 #include <stdlib.h>
 #include <AmberBox.hpp>
 #include <FortranIO.hpp>
+#include <AmberFortranWriter.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberLoadErrors.hpp>
 #include <limits.h>
 #include <float.h>
 
@@ -620,23 +622,23 @@ bool CAmberBox::LoadSolventPointers(FILE* p_file,const char* p_format)
     fortranio.SetFormat(p_format);
 
     if( fortranio.ReadInt(IPTRES) == false ) {
-        ES_ERROR("unable load IPTRES item");
+        AMBER_LOAD_ERROR("unable load IPTRES item");
         return(false);
     }
 
     if( fortranio.ReadInt(NSPM) == false ) {
-        ES_ERROR("unable load NSPM item");
+        AMBER_LOAD_ERROR("unable load NSPM item");
         return(false);
     }
 
     if( fortranio.ReadInt(NSPSOL) == false ) {
-        ES_ERROR("unable load NSPSOL item");
+        AMBER_LOAD_ERROR("unable load NSPSOL item");
         return(false);
     }
 
     // allocate fields
     if( (NSP = new int[NSPM]) == NULL ) {
-        ES_ERROR("unable allocate NSP array");
+        AMBER_LOAD_ERROR("unable allocate NSP array");
         return(false);
     }
 
@@ -654,7 +656,7 @@ bool CAmberBox::LoadNumsOfMolecules(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NSPM; i++) {
         if( fortranio.ReadInt(*p_item) == false ) {
-            ES_ERROR("unable load NSP item");
+            AMBER_LOAD_ERROR("unable load NSP item");
             return(false);
         }
         p_item++;
@@ -676,7 +678,7 @@ bool CAmberBox::LoadBoxInfo(FILE* p_file,const char* p_format)
     fortranio.SetFormat(p_format);
 
     if( fortranio.ReadReal(ANGS[0]) == false ) {
-        ES_ERROR("unable load BETA item");
+        AMBER_LOAD_ERROR("unable load BETA item");
         return(false);
     }
 
@@ -685,7 +687,7 @@ bool CAmberBox::LoadBoxInfo(FILE* p_file,const char* p_format)
 
     for(int i=0; i<3; i++) {
         if( fortranio.ReadReal(DIMM[i]) == false ) {
-            ES_ERROR("nable load BOX item");
+            AMBER_LOAD_ERROR("nable load BOX item");
             return(false);
         }
     }
@@ -707,25 +709,25 @@ bool CAmberBox::SaveAmber6Box(FILE* p_file)
 
 bool CAmberBox::SaveSolventPointers(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     if( fortranio.WriteInt(IPTRES) == false ) {
-        ES_ERROR("unable save IPTRES item");
+        AMBER_LOAD_ERROR("unable save IPTRES item");
         return(false);
     }
 
     if( fortranio.WriteInt(NSPM) == false ) {
-        ES_ERROR("unable save NSPM item");
+        AMBER_LOAD_ERROR("unable save NSPM item");
         return(false);
     }
 
     if( fortranio.WriteInt(NSPSOL) == false ) {
-        ES_ERROR("unable save NSPSOL item");
+        AMBER_LOAD_ERROR("unable save NSPSOL item");
         return(false);
     }
 
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -733,19 +735,19 @@ bool CAmberBox::SaveSolventPointers(FILE* p_file,const char* p_format)
 
 bool CAmberBox::SaveNumsOfMolecules(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     int* p_item = NSP;
 
     for(int i=0; i<NSPM; i++) {
         if( fortranio.WriteInt(*p_item) == false ) {
-            ES_ERROR("unable save NSP item");
+            AMBER_LOAD_ERROR("unable save NSP item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -753,21 +755,21 @@ bool CAmberBox::SaveNumsOfMolecules(FILE* p_file,const char* p_format)
 
 bool CAmberBox::SaveBoxInfo(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     if( fortranio.WriteReal(ANGS[0]) == false ) {
-        ES_ERROR("unable save BETA item");
+        AMBER_LOAD_ERROR("unable save BETA item");
         return(false);
     }
 
     for(int i=0; i<3; i++) {
         if( fortranio.WriteReal(DIMM[i]) == false ) {
-            ES_ERROR("unable save BOX item");
+            AMBER_LOAD_ERROR("unable save BOX item");
             return(false);
         }
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -128,6 +128,20 @@ public:
     /// image vector
     const CPoint ImageVector(const CPoint& vec);
 
+    /// image points in place
+    /*! p_pos is contiguous array of x,y,z coordinates of npoints points,
+        the result is the same as from ImagePoint(pos,0,0,0,origin,familiar),
+        with default arguments points are wrapped into the primary cell
+    */
+    void ImagePoints(double* p_pos,int npoints,
+                     bool origin=false,bool familiar=false,int nthreads=1);
+
+    /// image difference vectors in place
+    /*! p_vec is contiguous array of x,y,z components of nvectors vectors,
+        the result is the same as from ImageVector(vec)
+    */
+    void ImageVectors(double* p_vec,int nvectors,int nthreads=1);
+
     /// overload assigment operator
     void operator = (const CAmberBox& src);
 
@@ -163,6 +177,8 @@ private:
     bool SaveBoxInfo(FILE* p_file,const char* p_format);
 
     friend class CAmberTopology;
+    friend class CAmberCellList;
+    friend class CAmberDistanceMatrix;
 };
 
 //---------------------------------------------------------------------------
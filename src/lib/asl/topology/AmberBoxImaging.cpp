@@ -0,0 +1,237 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberBox.hpp>
+#include <math.h>
+#include <float.h>
+
+//------------------------------------------------------------------------------
+
+// bulk imaging - the box type switch is resolved once per call, matrices are
+// copied to locals so that the compiler does not assume aliasing with the
+// coordinate array, loops are branch-free and can be vectorized
+
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#define AMBER_BOX_PARALLEL_LOOP  _Pragma("omp parallel for simd num_threads(nthreads)")
+#elif defined(_OPENMP)
+#define AMBER_BOX_PARALLEL_LOOP  _Pragma("omp parallel for num_threads(nthreads)")
+#else
+#define AMBER_BOX_PARALLEL_LOOP
+#endif
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberBox::ImagePoints(double* p_pos,int npoints,
+                            bool origin,bool familiar,int nthreads)
+{
+    if( (p_pos == NULL) || (npoints <= 0) ) return;
+    if( nthreads < 1 ) nthreads = 1;
+
+    double c = origin ? 0.5 : 0.0;
+
+    switch(GetType()) {
+    default:
+    case AMBER_BOX_NONE:
+        return;
+
+    case AMBER_BOX_STANDARD: {
+        double lx = UCELL[0][0], ly = UCELL[1][1], lz = UCELL[2][2];
+        double rx = RECIP[0][0], ry = RECIP[1][1], rz = RECIP[2][2];
+
+        AMBER_BOX_PARALLEL_LOOP
+        for(int i=0; i < npoints; i++) {
+            double* p = p_pos + 3*i;
+            p[0] = p[0] - lx*(floor(p[0]*rx) + c);
+            p[1] = p[1] - ly*(floor(p[1]*ry) + c);
+            p[2] = p[2] - lz*(floor(p[2]*rz) + c);
+        }
+    }
+    return;
+
+    case AMBER_BOX_OCTAHEDRAL: {
+        double u00 = UCELL[0][0], u01 = UCELL[0][1], u02 = UCELL[0][2];
+        double u10 = UCELL[1][0], u11 = UCELL[1][1], u12 = UCELL[1][2];
+        double u20 = UCELL[2][0], u21 = UCELL[2][1], u22 = UCELL[2][2];
+        double r00 = RECIP[0][0], r01 = RECIP[0][1], r02 = RECIP[0][2];
+        double r10 = RECIP[1][0], r11 = RECIP[1][1], r12 = RECIP[1][2];
+        double r20 = RECIP[2][0], r21 = RECIP[2][1], r22 = RECIP[2][2];
+
+        if( familiar == false ) {
+            AMBER_BOX_PARALLEL_LOOP
+            for(int i=0; i < npoints; i++) {
+                double* p = p_pos + 3*i;
+                double fx = floor(p[0]*r00 + p[1]*r01 + p[2]*r02) + c;
+                double fy = floor(p[0]*r10 + p[1]*r11 + p[2]*r12) + c;
+                double fz = floor(p[0]*r20 + p[1]*r21 + p[2]*r22) + c;
+                double x = p[0] - (fx*u00 + fy*u01 + fz*u02);
+                double y = p[1] - (fx*u10 + fy*u11 + fz*u12);
+                double z = p[2] - (fx*u20 + fy*u21 + fz*u22);
+                p[0] = x;
+                p[1] = y;
+                p[2] = z;
+            }
+            return;
+        }
+
+        // familiar imaging - image closest to the cell centre from
+        // the primary cell and its 26 neighbours
+        double ox = 0.5*(u00 + u01 + u02);
+        double oy = 0.5*(u10 + u11 + u12);
+        double oz = 0.5*(u20 + u21 + u22);
+
+        AMBER_BOX_PARALLEL_LOOP
+        for(int i=0; i < npoints; i++) {
+            double* p = p_pos + 3*i;
+            double fx = p[0]*r00 + p[1]*r01 + p[2]*r02;
+            double fy = p[0]*r10 + p[1]*r11 + p[2]*r12;
+            double fz = p[0]*r20 + p[1]*r21 + p[2]*r22;
+            double ffx = floor(fx);
+            double ffy = floor(fy);
+            double ffz = floor(fz);
+            double rfx = fx - ffx;
+            double rfy = fy - ffy;
+            double rfz = fz - ffz;
+
+            double min_dis = DBL_MAX;
+            double mx = 0.0, my = 0.0, mz = 0.0;
+            for(int lx=-1; lx <= 1; lx++) {
+                for(int ly=-1; ly <= 1; ly++) {
+                    for(int lz=-1; lz <= 1; lz++) {
+                        double ofx = rfx + lx;
+                        double ofy = rfy + ly;
+                        double ofz = rfz + lz;
+                        double px = ofx*u00 + ofy*u01 + ofz*u02 - ox;
+                        double py = ofx*u10 + ofy*u11 + ofz*u12 - oy;
+                        double pz = ofx*u20 + ofy*u21 + ofz*u22 - oz;
+                        double ds = px*px + py*py + pz*pz;
+                        bool   better = ds < min_dis;
+                        min_dis = better ? ds : min_dis;
+                        mx = better ? lx : mx;
+                        my = better ? ly : my;
+                        mz = better ? lz : mz;
+                    }
+                }
+            }
+
+            ffx = ffx - mx + c;
+            ffy = ffy - my + c;
+            ffz = ffz - mz + c;
+            double x = p[0] - (ffx*u00 + ffy*u01 + ffz*u02);
+            double y = p[1] - (ffx*u10 + ffy*u11 + ffz*u12);
+            double z = p[2] - (ffx*u20 + ffy*u21 + ffz*u22);
+            p[0] = x;
+            p[1] = y;
+            p[2] = z;
+        }
+    }
+    return;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberBox::ImageVectors(double* p_vec,int nvectors,int nthreads)
+{
+    if( (p_vec == NULL) || (nvectors <= 0) ) return;
+    if( nthreads < 1 ) nthreads = 1;
+
+    switch(GetType()) {
+    default:
+    case AMBER_BOX_NONE:
+        return;
+
+    case AMBER_BOX_STANDARD: {
+        double lx = UCELL[0][0], ly = UCELL[1][1], lz = UCELL[2][2];
+        double rx = RECIP[0][0], ry = RECIP[1][1], rz = RECIP[2][2];
+
+        AMBER_BOX_PARALLEL_LOOP
+        for(int i=0; i < nvectors; i++) {
+            double* p = p_vec + 3*i;
+            p[0] = p[0] - lx*floor(p[0]*rx + 0.5);
+            p[1] = p[1] - ly*floor(p[1]*ry + 0.5);
+            p[2] = p[2] - lz*floor(p[2]*rz + 0.5);
+        }
+    }
+    return;
+
+    case AMBER_BOX_OCTAHEDRAL: {
+        double u00 = UCELL[0][0], u01 = UCELL[0][1], u02 = UCELL[0][2];
+        double u10 = UCELL[1][0], u11 = UCELL[1][1], u12 = UCELL[1][2];
+        double u20 = UCELL[2][0], u21 = UCELL[2][1], u22 = UCELL[2][2];
+        double r00 = RECIP[0][0], r01 = RECIP[0][1], r02 = RECIP[0][2];
+        double r10 = RECIP[1][0], r11 = RECIP[1][1], r12 = RECIP[1][2];
+        double r20 = RECIP[2][0], r21 = RECIP[2][1], r22 = RECIP[2][2];
+
+        // vector is first imaged into the parallelepiped centred at origin,
+        // then the shortest vector from it and its 26 neighbours is taken
+        AMBER_BOX_PARALLEL_LOOP
+        for(int i=0; i < nvectors; i++) {
+            double* p = p_vec + 3*i;
+            double fx = p[0]*r00 + p[1]*r01 + p[2]*r02;
+            double fy = p[0]*r10 + p[1]*r11 + p[2]*r12;
+            double fz = p[0]*r20 + p[1]*r21 + p[2]*r22;
+            double nx = floor(fx + 0.5);
+            double ny = floor(fy + 0.5);
+            double nz = floor(fz + 0.5);
+            double gx = fx - nx;
+            double gy = fy - ny;
+            double gz = fz - nz;
+
+            double min_dis = DBL_MAX;
+            double mx = 0.0, my = 0.0, mz = 0.0;
+            for(int lx=-1; lx <= 1; lx++) {
+                for(int ly=-1; ly <= 1; ly++) {
+                    for(int lz=-1; lz <= 1; lz++) {
+                        double ofx = gx + lx;
+                        double ofy = gy + ly;
+                        double ofz = gz + lz;
+                        double px = ofx*u00 + ofy*u01 + ofz*u02;
+                        double py = ofx*u10 + ofy*u11 + ofz*u12;
+                        double pz = ofx*u20 + ofy*u21 + ofz*u22;
+                        double ds = px*px + py*py + pz*pz;
+                        bool   better = ds < min_dis;
+                        min_dis = better ? ds : min_dis;
+                        mx = better ? lx : mx;
+                        my = better ? ly : my;
+                        mz = better ? lz : mz;
+                    }
+                }
+            }
+
+            nx -= mx;
+            ny -= my;
+            nz -= mz;
+            double x = p[0] - (nx*u00 + ny*u01 + nz*u02);
+            double y = p[1] - (nx*u10 + ny*u11 + nz*u12);
+            double z = p[2] - (nx*u20 + ny*u21 + nz*u22);
+            p[0] = x;
+            p[1] = y;
+            p[2] = z;
+        }
+    }
+    return;
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
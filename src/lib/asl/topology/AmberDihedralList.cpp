@@ -22,7 +22,9 @@
 #include <stdlib.h>
 #include <AmberDihedralList.hpp>
 #include <FortranIO.hpp>
+#include <AmberFortranWriter.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberLoadErrors.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -280,7 +282,7 @@ bool CAmberDihedralList::LoadDihedralPK(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.ReadReal(p_type->PK) == false ) {
-            ES_ERROR("unable to load TEQ item");
+            AMBER_LOAD_ERROR("unable to load TEQ item");
             return(false);
         }
         p_type++;
@@ -300,7 +302,7 @@ bool CAmberDihedralList::LoadDihedralPN(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.ReadReal(p_type->PN) == false ) {
-            ES_ERROR("unable to load PN item");
+            AMBER_LOAD_ERROR("unable to load PN item");
             return(false);
         }
         p_type++;
@@ -319,7 +321,7 @@ bool CAmberDihedralList::LoadDihedralPHASE(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.ReadReal(p_type->PHASE) == false ) {
-            ES_ERROR("unable to load PHASE item");
+            AMBER_LOAD_ERROR("unable to load PHASE item");
             return(false);
         }
         p_type++;
@@ -339,7 +341,7 @@ bool CAmberDihedralList::LoadDihedralSCEE(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.ReadReal(p_type->SCEE_SCALE) == false ) {
-            ES_ERROR("unable to load SCEE_SCALE item");
+            AMBER_LOAD_ERROR("unable to load SCEE_SCALE item");
             return(false);
         }
         p_type++;
@@ -359,7 +361,7 @@ bool CAmberDihedralList::LoadDihedralSCNB(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.ReadReal(p_type->SCNB_SCALE) == false ) {
-            ES_ERROR("unable to load SCNB_SCALE item");
+            AMBER_LOAD_ERROR("unable to load SCNB_SCALE item");
             return(false);
         }
         p_type++;
@@ -379,23 +381,23 @@ bool CAmberDihedralList::LoadDihedralsWithHydrogens(FILE* p_file,const char* p_f
 
     for(int i=0; i<NPHIH; i++) {
         if( fortranio.ReadInt(p_dihedral->IP) == false ) {
-            ES_ERROR("unable to load IP item");
+            AMBER_LOAD_ERROR("unable to load IP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->JP) == false ) {
-            ES_ERROR("unable to load JP item");
+            AMBER_LOAD_ERROR("unable to load JP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->KP) == false ) {
-            ES_ERROR("unable to load KP item");
+            AMBER_LOAD_ERROR("unable to load KP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->LP) == false ) {
-            ES_ERROR("unable to load LP item");
+            AMBER_LOAD_ERROR("unable to load LP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->ICP) == false ) {
-            ES_ERROR("unable to load ICP item");
+            AMBER_LOAD_ERROR("unable to load ICP item");
             return(false);
         }
 
@@ -437,23 +439,23 @@ bool CAmberDihedralList::LoadDihedralsWithoutHydrogens(FILE* p_file,const char*
 
     for(int i=0; i<MPHIA; i++) {
         if( fortranio.ReadInt(p_dihedral->IP) == false ) {
-            ES_ERROR("unable to load IP item");
+            AMBER_LOAD_ERROR("unable to load IP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->JP) == false ) {
-            ES_ERROR("unable to load JP item");
+            AMBER_LOAD_ERROR("unable to load JP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->KP) == false ) {
-            ES_ERROR("unable to load KP item");
+            AMBER_LOAD_ERROR("unable to load KP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->LP) == false ) {
-            ES_ERROR("unable to load LP item");
+            AMBER_LOAD_ERROR("unable to load LP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->ICP) == false ) {
-            ES_ERROR("unable to load ICP item");
+            AMBER_LOAD_ERROR("unable to load ICP item");
             return(false);
         }
 
@@ -494,19 +496,19 @@ bool CAmberDihedralList::LoadPerturbedDihedrals(FILE* p_file,const char* p_forma
 
     for(int i=0; i<NDPER; i++) {
         if( fortranio.ReadInt(p_dihedral->IP) == false ) {
-            ES_ERROR("unable to load IP item");
+            AMBER_LOAD_ERROR("unable to load IP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->JP) == false ) {
-            ES_ERROR("unable to load JP item");
+            AMBER_LOAD_ERROR("unable to load JP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->KP) == false ) {
-            ES_ERROR("unable to load KP item");
+            AMBER_LOAD_ERROR("unable to load KP item");
             return(false);
         }
         if( fortranio.ReadInt(p_dihedral->LP) == false ) {
-            ES_ERROR("unable to load LP item");
+            AMBER_LOAD_ERROR("unable to load LP item");
             return(false);
         }
 
@@ -547,7 +549,7 @@ bool CAmberDihedralList::LoadPerturbedDihedralTypeIndexes(FILE* p_file,const cha
 
     for(int i=0; i<NDPER; i++) {
         if( fortranio.ReadInt(p_dihedral->ICP) == false ) {
-            ES_ERROR("unable to load ICP item");
+            AMBER_LOAD_ERROR("unable to load ICP item");
             return(false);
         }
 
@@ -560,7 +562,7 @@ bool CAmberDihedralList::LoadPerturbedDihedralTypeIndexes(FILE* p_file,const cha
     p_dihedral = PerturbedDihedrals;
     for(int i=0; i<NDPER; i++) {
         if( fortranio.ReadInt(p_dihedral->PCP) == false ) {
-            ES_ERROR("unable to load PCP item");
+            AMBER_LOAD_ERROR("unable to load PCP item");
             return(false);
         }
 
@@ -577,19 +579,19 @@ bool CAmberDihedralList::LoadPerturbedDihedralTypeIndexes(FILE* p_file,const cha
 
 bool CAmberDihedralList::SaveDihedralPK(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedralType* p_type = DihedralTypes;
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.WriteReal(p_type->PK) == false ) {
-            ES_ERROR("unable to save TEQ item");
+            AMBER_LOAD_ERROR("unable to save TEQ item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -597,19 +599,19 @@ bool CAmberDihedralList::SaveDihedralPK(FILE* p_file,const char* p_format)
 
 bool CAmberDihedralList::SaveDihedralPN(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedralType* p_type = DihedralTypes;
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.WriteReal(p_type->PN) == false ) {
-            ES_ERROR("unable to save PN item");
+            AMBER_LOAD_ERROR("unable to save PN item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -617,19 +619,19 @@ bool CAmberDihedralList::SaveDihedralPN(FILE* p_file,const char* p_format)
 
 bool CAmberDihedralList::SaveDihedralPHASE(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedralType* p_type = DihedralTypes;
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.WriteReal(p_type->PHASE) == false ) {
-            ES_ERROR("unable to save PHASE item");
+            AMBER_LOAD_ERROR("unable to save PHASE item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -637,19 +639,19 @@ bool CAmberDihedralList::SaveDihedralPHASE(FILE* p_file,const char* p_format)
 
 bool CAmberDihedralList::SaveDihedralSCEE(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedralType* p_type = DihedralTypes;
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.WriteReal(p_type->SCEE_SCALE) == false ) {
-            ES_ERROR("unable to save SCEE_SCALE item");
+            AMBER_LOAD_ERROR("unable to save SCEE_SCALE item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -657,19 +659,19 @@ bool CAmberDihedralList::SaveDihedralSCEE(FILE* p_file,const char* p_format)
 
 bool CAmberDihedralList::SaveDihedralSCNB(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedralType* p_type = DihedralTypes;
 
     for(int i=0; i<NPTRA; i++) {
         if( fortranio.WriteReal(p_type->SCNB_SCALE) == false ) {
-            ES_ERROR("unable to save SCNB_SCALE item");
+            AMBER_LOAD_ERROR("unable to save SCNB_SCALE item");
             return(false);
         }
         p_type++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -677,7 +679,7 @@ bool CAmberDihedralList::SaveDihedralSCNB(FILE* p_file,const char* p_format)
 
 bool CAmberDihedralList::SaveDihedralsWithHydrogens(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedral* p_dihedral = DihedralWithHydrogens;
@@ -685,35 +687,35 @@ bool CAmberDihedralList::SaveDihedralsWithHydrogens(FILE* p_file,const char* p_f
 
     for(int i=0; i<NPHIH; i++) {
         if( fortranio.WriteInt(p_dihedral->IP*3) == false ) {
-            ES_ERROR("unable to save IP item");
+            AMBER_LOAD_ERROR("unable to save IP item");
             return(false);
         }
         if( fortranio.WriteInt(p_dihedral->JP*3) == false ) {
-            ES_ERROR("unable to save JP item");
+            AMBER_LOAD_ERROR("unable to save JP item");
             return(false);
         }
 
         value = p_dihedral->KP;
         if( (p_dihedral->Type == -1) || (p_dihedral->Type == -2) ) value *= -1;
         if( fortranio.WriteInt(value*3) == false ) {
-            ES_ERROR("unable to save KP item");
+            AMBER_LOAD_ERROR("unable to save KP item");
             return(false);
         }
 
         value = p_dihedral->LP;
         if( (p_dihedral->Type == 1) || (p_dihedral->Type == -2) ) value *= -1;
         if( fortranio.WriteInt(value*3) == false ) {
-            ES_ERROR("unable to save LP item");
+            AMBER_LOAD_ERROR("unable to save LP item");
             return(false);
         }
 
         if( fortranio.WriteInt(p_dihedral->ICP+1) == false ) {
-            ES_ERROR("unable to save ICP item");
+            AMBER_LOAD_ERROR("unable to save ICP item");
             return(false);
         }
         p_dihedral++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -721,7 +723,7 @@ bool CAmberDihedralList::SaveDihedralsWithHydrogens(FILE* p_file,const char* p_f
 
 bool CAmberDihedralList::SaveDihedralsWithoutHydrogens(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedral* p_dihedral = DihedralWithoutHydrogens;
@@ -730,35 +732,35 @@ bool CAmberDihedralList::SaveDihedralsWithoutHydrogens(FILE* p_file,const char*
 
     for(int i=0; i<MPHIA; i++) {
         if( fortranio.WriteInt(p_dihedral->IP*3) == false ) {
-            ES_ERROR("unable to save IP item");
+            AMBER_LOAD_ERROR("unable to save IP item");
             return(false);
         }
         if( fortranio.WriteInt(p_dihedral->JP*3) == false ) {
-            ES_ERROR("unable to save JP item");
+            AMBER_LOAD_ERROR("unable to save JP item");
             return(false);
         }
 
         value = p_dihedral->KP;
         if( (p_dihedral->Type == -1) || (p_dihedral->Type == -2) ) value *= -1;
         if( fortranio.WriteInt(value*3) == false ) {
-            ES_ERROR("unable to save KP item");
+            AMBER_LOAD_ERROR("unable to save KP item");
             return(false);
         }
 
         value = p_dihedral->LP;
         if( (p_dihedral->Type == 1) || (p_dihedral->Type == -2) ) value *= -1;
         if( fortranio.WriteInt(value*3) == false ) {
-            ES_ERROR("unable to save LP item");
+            AMBER_LOAD_ERROR("unable to save LP item");
             return(false);
         }
         if( fortranio.WriteInt(p_dihedral->ICP+1) == false ) {
-            ES_ERROR("unable to save ICP item");
+            AMBER_LOAD_ERROR("unable to save ICP item");
             return(false);
         }
 
         p_dihedral++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -766,7 +768,7 @@ bool CAmberDihedralList::SaveDihedralsWithoutHydrogens(FILE* p_file,const char*
 
 bool CAmberDihedralList::SavePerturbedDihedrals(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedral* p_dihedral = PerturbedDihedrals;
@@ -775,31 +777,31 @@ bool CAmberDihedralList::SavePerturbedDihedrals(FILE* p_file,const char* p_forma
 
     for(int i=0; i<NDPER; i++) {
         if( fortranio.WriteInt(p_dihedral->IP*3) == false ) {
-            ES_ERROR("unable to save IP item");
+            AMBER_LOAD_ERROR("unable to save IP item");
             return(false);
         }
         if( fortranio.WriteInt(p_dihedral->JP*3) == false ) {
-            ES_ERROR("unable to save JP item");
+            AMBER_LOAD_ERROR("unable to save JP item");
             return(false);
         }
 
         value = p_dihedral->KP;
         if( p_dihedral->Type == -1 ) value *= -1;
         if( fortranio.WriteInt(p_dihedral->KP) == false ) {
-            ES_ERROR("unable to save KP item");
+            AMBER_LOAD_ERROR("unable to save KP item");
             return(false);
         }
 
         value = p_dihedral->LP;
         if( p_dihedral->Type == 1 ) value *= -1;
         if( fortranio.WriteInt(p_dihedral->LP) == false ) {
-            ES_ERROR("unable to save LP item");
+            AMBER_LOAD_ERROR("unable to save LP item");
             return(false);
         }
 
         p_dihedral++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -807,14 +809,14 @@ bool CAmberDihedralList::SavePerturbedDihedrals(FILE* p_file,const char* p_forma
 
 bool CAmberDihedralList::SavePerturbedDihedralTypeIndexes(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberDihedral* p_dihedral = PerturbedDihedrals;
 
     for(int i=0; i<NDPER; i++) {
         if( fortranio.WriteInt(p_dihedral->ICP + 1) == false ) {
-            ES_ERROR("unable to save ICP item");
+            AMBER_LOAD_ERROR("unable to save ICP item");
             return(false);
         }
         p_dihedral++;
@@ -823,13 +825,13 @@ bool CAmberDihedralList::SavePerturbedDihedralTypeIndexes(FILE* p_file,const cha
     p_dihedral = PerturbedDihedrals;
     for(int i=0; i<NDPER; i++) {
         if( fortranio.WriteInt(p_dihedral->PCP + 1) == false ) {
-            ES_ERROR("unable to save ICP item");
+            AMBER_LOAD_ERROR("unable to save ICP item");
             return(false);
         }
         p_dihedral++;
     }
 
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
 
     return(true);
 }
@@ -0,0 +1,249 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <AmberFortranWriter.hpp>
+#include <AmberLoadErrors.hpp>
+#include <FortranIO.hpp>
+#include <ErrorSystem.hpp>
+#include <SmallString.hpp>
+
+//------------------------------------------------------------------------------
+
+// items are formatted in the same way as by CFortranIO:
+//   I - right justified integer (%*d), wider numbers are not truncated
+//   E - exponent form (%*.*E)
+//   A - left justified string padded by spaces (%-*s)
+// each line contains at most ItemsPerLine items
+
+#define AMBER_WRITER_BUFFER_SIZE    65536
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberFortranWriter::CAmberFortranWriter(FILE* p_file)
+{
+    File = p_file;
+    FortranIO = NULL;
+    Type = 0;
+    ItemsPerLine = 1;
+    Width = 0;
+    Precision = 0;
+    ItemIndex = 0;
+    NumOfItems = 0;
+    Error = false;
+    BufferSize = AMBER_WRITER_BUFFER_SIZE;
+    Buffer = new char[BufferSize];
+    BufferPos = 0;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberFortranWriter::~CAmberFortranWriter(void)
+{
+    Flush();
+    if( FortranIO != NULL ) delete FortranIO;
+    if( Buffer != NULL ) delete[] Buffer;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberFortranWriter::SetFormat(const char* p_format)
+{
+    ItemIndex = 0;
+    NumOfItems = 0;
+    Type = 0;
+
+    // decode [count]type[width][.precision]
+    const char* p_c = p_format;
+    int count = 0;
+    while( isdigit(*p_c) ) count = count*10 + (*p_c++ - '0');
+    if( count == 0 ) count = 1;
+    char type = toupper(*p_c);
+    if( *p_c != '\0' ) p_c++;
+    int width = 0;
+    while( isdigit(*p_c) ) width = width*10 + (*p_c++ - '0');
+    int precision = 0;
+    if( *p_c == '.' ) {
+        p_c++;
+        while( isdigit(*p_c) ) precision = precision*10 + (*p_c++ - '0');
+    }
+
+    if( (*p_c == '\0') && (width > 0) && ((type == 'I') || (type == 'E') || (type == 'A')) ) {
+        Type = type;
+        ItemsPerLine = count;
+        Width = width;
+        Precision = precision;
+        return(true);
+    }
+
+    // unsupported descriptor
+    if( Flush() == false ) return(false);
+    if( FortranIO == NULL ) FortranIO = new CFortranIO(File);
+    FortranIO->SetFormat(p_format);
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberFortranWriter::WriteInt(int number)
+{
+    if( Type == 0 ) {
+        if( FortranIO == NULL ) return(false);
+        return(FortranIO->WriteInt(number));
+    }
+    if( Reserve(Width + 12) == false ) return(false);
+
+    // convert in reverse order
+    char            digits[12];
+    int             ndigits = 0;
+    unsigned int    value = number < 0 ? 0u - (unsigned int)number : (unsigned int)number;
+    do {
+        digits[ndigits++] = '0' + value % 10;
+        value /= 10;
+    } while( value != 0 );
+    if( number < 0 ) digits[ndigits++] = '-';
+
+    char* p_buf = Buffer + BufferPos;
+    for(int i = ndigits; i < Width; i++) *p_buf++ = ' ';
+    while( ndigits > 0 ) *p_buf++ = digits[--ndigits];
+    BufferPos = p_buf - Buffer;
+
+    EndItem();
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberFortranWriter::WriteReal(double number)
+{
+    if( Type == 0 ) {
+        if( FortranIO == NULL ) return(false);
+        return(FortranIO->WriteReal(number));
+    }
+    if( Reserve(Width + Precision + 32) == false ) return(false);
+
+    int len = sprintf(Buffer + BufferPos,"%*.*E",Width,Precision,number);
+    if( len < 0 ) {
+        AMBER_LOAD_ERROR("unable to format real number");
+        Error = true;
+        return(false);
+    }
+    BufferPos += len;
+
+    EndItem();
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberFortranWriter::WriteString(const char* p_string)
+{
+    if( Type == 0 ) {
+        if( FortranIO == NULL ) return(false);
+        return(FortranIO->WriteString(p_string));
+    }
+    if( p_string == NULL ) p_string = "";
+
+    int len = strlen(p_string);
+    if( Reserve(len > Width ? len : Width) == false ) return(false);
+
+    memcpy(Buffer + BufferPos,p_string,len);
+    BufferPos += len;
+    for(int i = len; i < Width; i++) Buffer[BufferPos++] = ' ';
+
+    EndItem();
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberFortranWriter::WriteEndOfSection(void)
+{
+    if( Type == 0 ) {
+        if( FortranIO == NULL ) return(false);
+        return(FortranIO->WriteEndOfSection());
+    }
+    if( Reserve(1) == false ) return(false);
+
+    if( (ItemIndex > 0) || (NumOfItems == 0) ) {
+        Buffer[BufferPos++] = '\n';
+    }
+    ItemIndex = 0;
+    NumOfItems = 0;
+
+    return(Flush());
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberFortranWriter::Flush(void)
+{
+    if( Error == true ) return(false);
+    if( BufferPos == 0 ) return(true);
+
+    if( fwrite(Buffer,1,BufferPos,File) != (size_t)BufferPos ) {
+        AMBER_LOAD_ERROR("unable to write data");
+        Error = true;
+        return(false);
+    }
+    BufferPos = 0;
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberFortranWriter::Reserve(int len)
+{
+    // one extra character for the line terminator
+    len++;
+    if( BufferPos + len <= BufferSize ) return(true);
+    if( Flush() == false ) return(false);
+    if( len <= BufferSize ) return(true);
+
+    // item does not fit into the buffer
+    delete[] Buffer;
+    BufferSize = len;
+    Buffer = new char[BufferSize];
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberFortranWriter::EndItem(void)
+{
+    NumOfItems++;
+    ItemIndex++;
+    if( ItemIndex >= ItemsPerLine ) {
+        Buffer[BufferPos++] = '\n';
+        ItemIndex = 0;
+    }
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,92 @@
+#ifndef AmberFortranWriterH
+#define AmberFortranWriterH
+/** \ingroup AmberTopology*/
+/*! \file AmberFortranWriter.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <stdio.h>
+#include <ASLMainHeader.hpp>
+
+//---------------------------------------------------------------------------
+
+class CFortranIO;
+
+//---------------------------------------------------------------------------
+
+/// buffered writer of topology sections
+/*! the writer is a replacement of CFortranIO for output of topology sections,
+    items are formatted directly into memory buffer, which is flushed to the
+    file in large blocks, integer (I), exponent (E) and character (A)
+    descriptors are formatted by the writer, other descriptors are passed
+    to CFortranIO
+*/
+
+class ASL_PACKAGE CAmberFortranWriter {
+public:
+    CAmberFortranWriter(FILE* p_file);
+    ~CAmberFortranWriter(void);
+
+    /// set format of items, e.g. 10I8, 5E16.8, 20a4
+    bool SetFormat(const char* p_format);
+
+    /// write integer item
+    bool WriteInt(int number);
+
+    /// write real item
+    bool WriteReal(double number);
+
+    /// write string item
+    bool WriteString(const char* p_string);
+
+    /// terminate section, the last line is finished
+    /*! an empty line is written for sections without items
+    */
+    bool WriteEndOfSection(void);
+
+    /// write buffered data to the file
+    bool Flush(void);
+
+// section of private data ----------------------------------------------------
+private:
+    FILE*       File;
+    CFortranIO* FortranIO;      // fallback for unsupported descriptors
+    char        Type;           // I, E, A, or zero for fallback
+    int         ItemsPerLine;
+    int         Width;
+    int         Precision;
+    int         ItemIndex;      // index of item on the line
+    int         NumOfItems;     // number of items in section
+    bool        Error;
+
+    char*       Buffer;
+    int         BufferSize;
+    int         BufferPos;
+
+    /// make room for len characters
+    bool Reserve(int len);
+
+    /// finish item, line is terminated if it is full
+    void EndItem(void);
+};
+
+//---------------------------------------------------------------------------
+
+#endif
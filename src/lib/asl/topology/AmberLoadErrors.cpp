@@ -0,0 +1,92 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberLoadErrors.hpp>
+
+//------------------------------------------------------------------------------
+
+// active list of the calling thread
+static CAmberLoadErrors* ActiveLoadErrors = NULL;
+
+#ifdef _OPENMP
+#pragma omp threadprivate(ActiveLoadErrors)
+#endif
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberLoadErrors::Activate(void)
+{
+    ActiveLoadErrors = this;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberLoadErrors::Deactivate(void)
+{
+    if( ActiveLoadErrors == this ) ActiveLoadErrors = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberLoadErrors::Report(void)
+{
+    for(unsigned int i=0; i < Messages.size(); i++) {
+        if( Warnings[i] ) {
+            ES_WARNING(Messages[i]);
+        } else {
+            ES_ERROR(Messages[i]);
+        }
+    }
+    Messages.clear();
+    Warnings.clear();
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberLoadErrors::IsActive(void)
+{
+    return(ActiveLoadErrors != NULL);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberLoadErrors::AddError(const CSmallString& error)
+{
+    if( ActiveLoadErrors == NULL ) return;
+    ActiveLoadErrors->Messages.push_back(error);
+    ActiveLoadErrors->Warnings.push_back(false);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberLoadErrors::AddWarning(const CSmallString& warning)
+{
+    if( ActiveLoadErrors == NULL ) return;
+    ActiveLoadErrors->Messages.push_back(warning);
+    ActiveLoadErrors->Warnings.push_back(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,90 @@
+#ifndef AmberLoadErrorsH
+#define AmberLoadErrorsH
+/** \ingroup AmberTopology*/
+/*! \file AmberLoadErrors.hpp */
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <ASLMainHeader.hpp>
+#include <SmallString.hpp>
+#include <ErrorSystem.hpp>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+/// messages of topology loaders and writers that are reported later
+
+/*! the global error stack must not be accessed from several threads,
+    thus sections decoded or formatted concurrently record their messages
+    into their own lists, which are reported in the file order afterwards;
+    the list is active only in the thread that called Activate()
+*/
+
+class ASL_PACKAGE CAmberLoadErrors {
+public:
+    /// start recording messages of the calling thread
+    void Activate(void);
+
+    /// stop recording messages of the calling thread
+    void Deactivate(void);
+
+    /// report recorded messages to the error stack in the recorded order
+    void Report(void);
+
+    /// is any list active in the calling thread?
+    static bool IsActive(void);
+
+    /// record error into the active list
+    static void AddError(const CSmallString& error);
+
+    /// record warning into the active list
+    static void AddWarning(const CSmallString& warning);
+
+// section of private data ----------------------------------------------------
+private:
+    std::vector<CSmallString>   Messages;
+    std::vector<bool>           Warnings;
+};
+
+//---------------------------------------------------------------------------
+
+// to be used instead of ES_ERROR and ES_WARNING in topology loaders and writers
+
+#define AMBER_LOAD_ERROR(x) \
+    do { \
+        if( CAmberLoadErrors::IsActive() ) { \
+            CAmberLoadErrors::AddError(x); \
+        } else { \
+            ES_ERROR(x); \
+        } \
+    } while(0)
+
+#define AMBER_LOAD_WARNING(x) \
+    do { \
+        if( CAmberLoadErrors::IsActive() ) { \
+            CAmberLoadErrors::AddWarning(x); \
+        } else { \
+            ES_WARNING(x); \
+        } \
+    } while(0)
+
+//---------------------------------------------------------------------------
+
+#endif
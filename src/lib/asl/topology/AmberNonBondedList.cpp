@@ -22,7 +22,9 @@
 #include <stdlib.h>
 #include <AmberNonBondedList.hpp>
 #include <FortranIO.hpp>
+#include <AmberFortranWriter.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberLoadErrors.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -42,6 +44,9 @@ CAmberNonBondedList::CAmberNonBondedList(void)
     NEXT = 0;
     NATYP = 0;
     NPHB = 0;
+    ParamTableValid = false;
+    ParamTableMemory = NULL;
+    ParamTable = NULL;
 }
 
 //------------------------------------------------------------------------------
@@ -113,6 +118,8 @@ void CAmberNonBondedList::FreeFields(void)
     NEXT = 0;
     NATYP = 0;
     NPHB = 0;
+
+    FreeParamTable();
 }
 
 //==============================================================================
@@ -203,6 +210,7 @@ int CAmberNonBondedList::GetICOIndex(int index)
 
 void CAmberNonBondedList::SetICOIndex(int index,int value)
 {
+    InvalidateParamTable();
     ICO[index] = value;
 }
 
@@ -243,6 +251,7 @@ double CAmberNonBondedList::GetBParam(int icoindex)
 
 void CAmberNonBondedList::SetAParam(double value,int icoindex)
 {
+    InvalidateParamTable();
     if( icoindex == 0 ) return;
     int type = icoindex;
     icoindex = abs(icoindex) - 1;
@@ -254,6 +263,7 @@ void CAmberNonBondedList::SetAParam(double value,int icoindex)
 
 void CAmberNonBondedList::SetBParam(double value,int icoindex)
 {
+    InvalidateParamTable();
     if( icoindex == 0 ) return;
     int type = icoindex;
     icoindex = abs(icoindex) - 1;
@@ -278,7 +288,7 @@ void CAmberNonBondedList::operator = (const CAmberNonBondedList& src)
 
     for(int i=0; i<NTYPES*(NTYPES+1)/2; i++) {
         CN1[i] = src.CN1[i];
-        CN1[i] = src.CN1[i];
+        CN2[i] = src.CN2[i];
     }
 
     for(int i=0; i<NEXT; i++) {
@@ -296,6 +306,69 @@ void CAmberNonBondedList::operator = (const CAmberNonBondedList& src)
 //------------------------------------------------------------------------------
 //==============================================================================
 
+const CAmberNBParams* CAmberNonBondedList::GetParamTable(void)
+{
+    UpdateParamTable();
+    return(ParamTable);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNonBondedList::UpdateParamTable(void)
+{
+    if( ParamTableValid == true ) return;
+
+    FreeParamTable();
+
+    if( NTYPES > 0 ) {
+        // align table to 64 bytes (cache line)
+        ParamTableMemory = new char[NTYPES*NTYPES*sizeof(CAmberNBParams) + 64];
+        size_t offset = (64 - ((size_t)ParamTableMemory % 64)) % 64;
+        ParamTable = (CAmberNBParams*)(ParamTableMemory + offset);
+
+        for(int i=0; i < NTYPES*NTYPES; i++) {
+            CAmberNBParams* p_item = &ParamTable[i];
+            int ico = ICO[i];
+            p_item->A = 0.0;
+            p_item->B = 0.0;
+            p_item->Type = 0;
+            p_item->Padding[0] = p_item->Padding[1] = p_item->Padding[2] = 0;
+            if( ico > 0 ) {
+                p_item->A = CN1[ico-1];
+                p_item->B = CN2[ico-1];
+                p_item->Type = 1;
+            } else if( ico < 0 ) {
+                p_item->A = ASOL[-ico-1];
+                p_item->B = BSOL[-ico-1];
+                p_item->Type = -1;
+            }
+        }
+    }
+
+    ParamTableValid = true;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNonBondedList::InvalidateParamTable(void)
+{
+    ParamTableValid = false;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNonBondedList::FreeParamTable(void)
+{
+    if( ParamTableMemory != NULL ) delete[] ParamTableMemory;
+    ParamTableMemory = NULL;
+    ParamTable = NULL;
+    ParamTableValid = false;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
 bool CAmberNonBondedList::LoadICOs(FILE* p_file,const char* p_format)
 {
     CFortranIO fortranio(p_file);
@@ -305,7 +378,7 @@ bool CAmberNonBondedList::LoadICOs(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NTYPES*NTYPES; i++) {
         if( fortranio.ReadInt(*p_item) == false ) {
-            ES_ERROR("unable to load ICO item");
+            AMBER_LOAD_ERROR("unable to load ICO item");
             return(false);
         }
         p_item++;
@@ -325,7 +398,7 @@ bool CAmberNonBondedList::LoadSOLTY(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NATYP; i++) {
         if( fortranio.ReadReal(*p_item) == false ) {
-            ES_ERROR("unable to load SOLTY item");
+            AMBER_LOAD_ERROR("unable to load SOLTY item");
             return(false);
         }
         p_item++;
@@ -345,7 +418,7 @@ bool CAmberNonBondedList::LoadCN1(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NTYPES*(NTYPES+1)/2; i++) {
         if( fortranio.ReadReal(*p_item) == false ) {
-            ES_ERROR("unable to load CN1 item");
+            AMBER_LOAD_ERROR("unable to load CN1 item");
             return(false);
         }
         p_item++;
@@ -365,7 +438,7 @@ bool CAmberNonBondedList::LoadCN2(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NTYPES*(NTYPES+1)/2; i++) {
         if( fortranio.ReadReal(*p_item) == false ) {
-            ES_ERROR("unable to load CN2 item");
+            AMBER_LOAD_ERROR("unable to load CN2 item");
             return(false);
         }
         p_item++;
@@ -385,7 +458,7 @@ bool CAmberNonBondedList::LoadNATEX(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NEXT; i++) {
         if( fortranio.ReadInt(*p_item) == false ) {
-            ES_ERROR("unable to load NATEX item");
+            AMBER_LOAD_ERROR("unable to load NATEX item");
             return(false);
         }
         *p_item = *p_item - 1;
@@ -406,7 +479,7 @@ bool CAmberNonBondedList::LoadASOL(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NPHB; i++) {
         if( fortranio.ReadReal(*p_item) == false ) {
-            ES_ERROR("unable to load ASOL item");
+            AMBER_LOAD_ERROR("unable to load ASOL item");
             return(false);
         }
         p_item++;
@@ -426,7 +499,7 @@ bool CAmberNonBondedList::LoadBSOL(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NPHB; i++) {
         if( fortranio.ReadReal(*p_item) == false ) {
-            ES_ERROR("unable to load BSOL item");
+            AMBER_LOAD_ERROR("unable to load BSOL item");
             return(false);
         }
         p_item++;
@@ -446,7 +519,7 @@ bool CAmberNonBondedList::LoadHBCUT(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NPHB; i++) {
         if( fortranio.ReadReal(*p_item) == false ) {
-            ES_ERROR("unable to load HBCUT item");
+            AMBER_LOAD_ERROR("unable to load HBCUT item");
             return(false);
         }
         p_item++;
@@ -459,19 +532,19 @@ bool CAmberNonBondedList::LoadHBCUT(FILE* p_file,const char* p_format)
 
 bool CAmberNonBondedList::SaveICOs(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     int* p_item = ICO;
 
     for(int i=0; i<NTYPES*NTYPES; i++) {
         if( fortranio.WriteInt(*p_item) == false ) {
-            ES_ERROR("unable to save item");
+            AMBER_LOAD_ERROR("unable to save item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -479,19 +552,19 @@ bool CAmberNonBondedList::SaveICOs(FILE* p_file,const char* p_format)
 
 bool CAmberNonBondedList::SaveSOLTY(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     double* p_item = SOLTY;
 
     for(int i=0; i<NATYP; i++) {
         if( fortranio.WriteReal(*p_item) == false ) {
-            ES_ERROR("unable to save SOLTY item");
+            AMBER_LOAD_ERROR("unable to save SOLTY item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -499,19 +572,19 @@ bool CAmberNonBondedList::SaveSOLTY(FILE* p_file,const char* p_format)
 
 bool CAmberNonBondedList::SaveCN1(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     double* p_item = CN1;
 
     for(int i=0; i<NTYPES*(NTYPES+1)/2; i++) {
         if( fortranio.WriteReal(*p_item) == false ) {
-            ES_ERROR("unable to save CN1 item");
+            AMBER_LOAD_ERROR("unable to save CN1 item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -519,19 +592,19 @@ bool CAmberNonBondedList::SaveCN1(FILE* p_file,const char* p_format)
 
 bool CAmberNonBondedList::SaveCN2(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     double* p_item = CN2;
 
     for(int i=0; i<NTYPES*(NTYPES+1)/2; i++) {
         if( fortranio.WriteReal(*p_item) == false ) {
-            ES_ERROR("unable to save CN2 item");
+            AMBER_LOAD_ERROR("unable to save CN2 item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -539,19 +612,19 @@ bool CAmberNonBondedList::SaveCN2(FILE* p_file,const char* p_format)
 
 bool CAmberNonBondedList::SaveNATEX(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     int* p_item = NATEX;
 
     for(int i=0; i<NEXT; i++) {
         if( fortranio.WriteInt((*p_item) + 1) == false ) {
-            ES_ERROR("unable to save NATEX item");
+            AMBER_LOAD_ERROR("unable to save NATEX item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -559,19 +632,19 @@ bool CAmberNonBondedList::SaveNATEX(FILE* p_file,const char* p_format)
 
 bool CAmberNonBondedList::SaveASOL(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     double* p_item = ASOL;
 
     for(int i=0; i<NPHB; i++) {
         if( fortranio.WriteReal(*p_item) == false ) {
-            ES_ERROR("unable to save ASOL item");
+            AMBER_LOAD_ERROR("unable to save ASOL item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -579,19 +652,19 @@ bool CAmberNonBondedList::SaveASOL(FILE* p_file,const char* p_format)
 
 bool CAmberNonBondedList::SaveBSOL(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     double* p_item = BSOL;
 
     for(int i=0; i<NPHB; i++) {
         if( fortranio.WriteReal(*p_item) == false ) {
-            ES_ERROR("unable to save BSOL item");
+            AMBER_LOAD_ERROR("unable to save BSOL item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -599,19 +672,19 @@ bool CAmberNonBondedList::SaveBSOL(FILE* p_file,const char* p_format)
 
 bool CAmberNonBondedList::SaveHBCUT(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     double* p_item = HBCUT;
 
     for(int i=0; i<NPHB; i++) {
         if( fortranio.WriteReal(*p_item) == false ) {
-            ES_ERROR("unable to save HBCUT item");
+            AMBER_LOAD_ERROR("unable to save HBCUT item");
             return(false);
         }
         p_item++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -28,6 +28,17 @@
 
 //---------------------------------------------------------------------------
 
+/// nonbonded parameters for a pair of atom types
+
+struct CAmberNBParams {
+    double  A;          // CN1 or ASOL
+    double  B;          // CN2 or BSOL
+    int     Type;       // +1 - 12-6, -1 - 12-10, 0 - no parameters
+    int     Padding[3]; // item size is 32 bytes (two items per cache line)
+};
+
+//---------------------------------------------------------------------------
+
 /// nonbonded interaction description for topology
 
 class ASL_PACKAGE CAmberNonBondedList {
@@ -121,6 +132,23 @@ public:
     /// overload assigment operator
     void operator = (const CAmberNonBondedList& src);
 
+// dense parameter table -------------------------------------------------------
+    /// return dense table of nonbonded parameters
+    /*! the table has NTYPES*NTYPES items, parameters for atom types ti and tj
+        (zero-based, i.e. IAC-1, see CAmberAtomList::GetTypeIndexArray) are
+        at ti*NTYPES+tj, the table is aligned to cache line, it is built on
+        the first request and invalidated when ICO, CN1, CN2, ASOL or BSOL
+        are modified via the set methods, it should be built by
+        UpdateParamTable in advance if it is requested from several threads
+    */
+    const CAmberNBParams* GetParamTable(void);
+
+    /// build dense table of nonbonded parameters if it is not valid
+    void UpdateParamTable(void);
+
+    /// invalidate dense table of nonbonded parameters
+    void InvalidateParamTable(void);
+
 // section of private data ----------------------------------------------------
 private:
     /// NTYPES : total number of distinct atom types
@@ -145,6 +173,13 @@ private:
     double*         HBCUT;
     double*         SOLTY;
 
+    // dense parameter table
+    bool            ParamTableValid;
+    char*           ParamTableMemory;   // allocated memory
+    CAmberNBParams* ParamTable;         // aligned table
+
+    void FreeParamTable(void);
+
     bool LoadBasicInfo(FILE* p_file,const char* p_format);
     bool LoadICOs(FILE* p_file,const char* p_format);
     bool LoadSOLTY(FILE* p_file,const char* p_format);
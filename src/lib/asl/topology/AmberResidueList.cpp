@@ -22,7 +22,9 @@
 #include <stdlib.h>
 #include <AmberResidueList.hpp>
 #include <FortranIO.hpp>
+#include <AmberFortranWriter.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberLoadErrors.hpp>
 
 //==============================================================================
 //------------------------------------------------------------------------------
@@ -97,6 +99,8 @@ void CAmberResidueList::ReinitAtomResiduePointers(CAmberAtomList* p_atomlist)
         p_res++;
     }
 
+    p_atomlist->InvalidateArrays();
+
     p_prev->NumOfAtoms = p_atomlist->GetNumberOfAtoms() - p_prev->IPRES + 1;
     CAmberAtom* p_atom = p_atomlist->GetAtom(p_prev->IPRES-1);
     for(int j=0; j<p_prev->NumOfAtoms; j++) {
@@ -193,7 +197,7 @@ bool CAmberResidueList::LoadResidueNames(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NRES; i++) {
         if( fortranio.ReadString(p_res->LABRES) == false ) {
-            ES_ERROR("unable to load LABRES item");
+            AMBER_LOAD_ERROR("unable to load LABRES item");
             return(false);
         }
         p_res->Index = i;
@@ -215,13 +219,13 @@ bool CAmberResidueList::LoadResidueIPRES(FILE* p_file,
 
     for(int i=0; i<NRES; i++) {
         if( fortranio.ReadInt(p_res->IPRES) == false ) {
-            ES_ERROR("unable to load IPRES item");
+            AMBER_LOAD_ERROR("unable to load IPRES item");
             return(false);
         }
         if( p_res->IPRES == 0 ){
             CSmallString error;
             error << "IPRES is zero for residue: " << i+1 << " (topology was most likely incorrectly built)";
-            ES_ERROR(error);
+            AMBER_LOAD_ERROR(error);
             return(false);
         }
         if( i != 0 ) {
@@ -236,6 +240,8 @@ bool CAmberResidueList::LoadResidueIPRES(FILE* p_file,
         p_res++;
     }
 
+    p_atomlist->InvalidateArrays();
+
     p_prev->NumOfAtoms = p_atomlist->GetNumberOfAtoms() - p_prev->IPRES + 1;
     CAmberAtom* p_atom = p_atomlist->GetAtom(p_prev->IPRES-1);
     for(int j=0; j<p_prev->NumOfAtoms; j++) {
@@ -257,7 +263,7 @@ bool CAmberResidueList::LoadResiduePertNames(FILE* p_file,const char* p_format)
 
     for(int i=0; i<NRES; i++) {
         if( fortranio.ReadString(p_res->PERRES) == false ) {
-            ES_ERROR("unable to load PERRES item");
+            AMBER_LOAD_ERROR("unable to load PERRES item");
             return(false);
         }
         p_res++;
@@ -269,19 +275,19 @@ bool CAmberResidueList::LoadResiduePertNames(FILE* p_file,const char* p_format)
 
 bool CAmberResidueList::SaveResidueNames(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberResidue* p_res = Residues;
 
     for(int i=0; i<NRES; i++) {
         if( fortranio.WriteString(p_res->LABRES) == false ) {
-            ES_ERROR("unable to save LABRES item");
+            AMBER_LOAD_ERROR("unable to save LABRES item");
             return(false);
         }
         p_res++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -290,19 +296,19 @@ bool CAmberResidueList::SaveResidueNames(FILE* p_file,const char* p_format)
 bool CAmberResidueList::SaveResidueIPRES(FILE* p_file,
         CAmberAtomList* p_atomlist,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberResidue* p_res = Residues;
 
     for(int i=0; i<NRES; i++) {
         if( fortranio.WriteInt(p_res->IPRES) == false ) {
-            ES_ERROR("unable to save IPRES item");
+            AMBER_LOAD_ERROR("unable to save IPRES item");
             return(false);
         }
         p_res++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
     return(true);
 }
 
@@ -310,19 +316,19 @@ bool CAmberResidueList::SaveResidueIPRES(FILE* p_file,
 
 bool CAmberResidueList::SaveResiduePertNames(FILE* p_file,const char* p_format)
 {
-    CFortranIO fortranio(p_file);
+    CAmberFortranWriter fortranio(p_file);
     fortranio.SetFormat(p_format);
 
     CAmberResidue* p_res = Residues;
 
     for(int i=0; i<NRES; i++) {
         if( fortranio.WriteString(p_res->PERRES) == false ) {
-            ES_ERROR("unable to save PERRES item");
+            AMBER_LOAD_ERROR("unable to save PERRES item");
             return(false);
         }
         p_res++;
     }
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
 
     return(true);
 }
@@ -99,6 +99,12 @@ bool CAmberSubTopology::PrepareNewTopology(void)
         return(false);
     }
 
+    // skipped sections would be silently missing in the new topology
+    if( OldTopology->GetLoadedParts() != AMBER_LOAD_ALL ) {
+        ES_ERROR("old topology is not loaded completely");
+        return(false);
+    }
+
     bool result;
 
     result = PrepareAtoms();
@@ -202,20 +208,18 @@ bool CAmberSubTopology::PrepareAtoms(void)
 bool CAmberSubTopology::PrepareResidues(void)
 {
     // determine number of residues ---------------------------------------------
+    // residues are ordered by their first selected atoms
+    // count number of selected atoms in each old residue
 
     vector<int> residues;
+    vector<int> resatoms(OldTopology->ResidueList.GetNumberOfResidues(),0);
 
     for(int i = 0; i < Mask->GetNumberOfTopologyAtoms(); i++) {
         CAmberAtom* p_atom = Mask->GetSelectedAtom(i);
         if( p_atom != NULL ) {
-            bool new_res = true;
-            for(unsigned int j=0; j < residues.size(); j++) {
-                if( residues[j] == p_atom->GetResidue()->GetIndex() ) {
-                    new_res = false;
-                    break;
-                }
-            }
-            if( new_res == true ) residues.push_back(p_atom->GetResidue()->GetIndex());
+            int resid = p_atom->GetResidue()->GetIndex();
+            if( resatoms[resid] == 0 ) residues.push_back(resid);
+            resatoms[resid]++;
         }
     }
 
@@ -228,14 +232,7 @@ bool CAmberSubTopology::PrepareResidues(void)
     // determine number of atoms in the largest residue ---------------------------
     int maxatom = 0;
     for(unsigned int i=0; i < residues.size(); i++) {
-        CAmberResidue* p_oldres = OldTopology->ResidueList.GetResidue(i);
-        int real_num_of_atoms = 0;
-        for(int j=0; j < p_oldres->GetNumberOfAtoms(); j++) {
-            if( Mask->IsAtomSelected(j + p_oldres->GetFirstAtomIndex()) == true ) {
-                real_num_of_atoms++;
-            }
-        }
-        if( maxatom < real_num_of_atoms ) maxatom = real_num_of_atoms;
+        if( maxatom < resatoms[residues[i]] ) maxatom = resatoms[residues[i]];
     }
 
     // allocate fields ------------------------------------------------------------
@@ -248,13 +245,8 @@ bool CAmberSubTopology::PrepareResidues(void)
         CAmberResidue* p_oldres = OldTopology->ResidueList.GetResidue(residues[i]);
         p_res->SetName(p_oldres->GetName());
         p_res->SetFirstAtomIndex(first_atom_index);
-        int real_num_of_atoms = 0;
-        for(int j=0; j < p_oldres->GetNumberOfAtoms(); j++) {
-            if( Mask->IsAtomSelected(j + p_oldres->GetFirstAtomIndex()) == true ) {
-                first_atom_index++;
-                real_num_of_atoms++;
-            }
-        }
+        int real_num_of_atoms = resatoms[residues[i]];
+        first_atom_index += real_num_of_atoms;
         // check incomplete residue atom selection
         if( real_num_of_atoms != p_oldres->GetNumberOfAtoms() ) {
             fprintf(ReportFile,"  WARNING: Incomplete residue selection for residue :%03d%s!!\n",p_oldres->GetIndex()+1,p_oldres->GetName());
@@ -271,6 +263,7 @@ bool CAmberSubTopology::PrepareNonbondedList(void)
 {
     // determine number of distinct atom types ------------------------------------
     vector<int> iactypes;
+    vector<int> iacmap(OldTopology->NonBondedList.GetNumberOfTypes()+1,0);
 
     int new_atom_index = 0;
     for(int i = 0; i < Mask->GetNumberOfTopologyAtoms(); i++) {
@@ -278,18 +271,18 @@ bool CAmberSubTopology::PrepareNonbondedList(void)
         if( p_atom != NULL ) {
             CAmberAtom* p_newatom = AtomList.GetAtom(new_atom_index);
 
-            bool new_type = true;
-            for(unsigned int j=0; j < iactypes.size(); j++) {
-                if( iactypes[j] == p_atom->GetIAC() ) {
-                    new_type = false;
-                    p_newatom->SetIAC(j+1);
-                    break;
-                }
+            int iac = p_atom->GetIAC();
+            if( (iac < 1) || (iac >= (int)iacmap.size()) ) {
+                CSmallString error;
+                error << "illegal atom type index (" << iac << ") for atom " << i+1;
+                ES_ERROR(error);
+                return(false);
             }
-            if( new_type == true ) {
-                iactypes.push_back(p_atom->GetIAC());
-                p_newatom->SetIAC(iactypes.size());
+            if( iacmap[iac] == 0 ) {
+                iactypes.push_back(iac);
+                iacmap[iac] = iactypes.size();
             }
+            p_newatom->SetIAC(iacmap[iac]);
 
             new_atom_index++;
         }
@@ -301,12 +294,12 @@ bool CAmberSubTopology::PrepareNonbondedList(void)
     new_atom_index = 0;
     for(int i=0; i < OldTopology->AtomList.GetNumberOfAtoms(); i++) {
         CAmberAtom* p_oldatom = OldTopology->AtomList.GetAtom(i);
-        if( Mask->IsAtomSelected(i) == true ) {
+        if( IsSelected(i) ) {
             // determine real number of excluded atoms
             int new_numex = 0;
             for(int j = 0; j < p_oldatom->GetNUMEX(); j++) {
                 int nat_index = OldTopology->NonBondedList.GetNATEX(j + numex_offset);
-                if( (nat_index >= 0) && (Mask->IsAtomSelected(nat_index) == true) ) {
+                if( (nat_index >= 0) && IsSelected(nat_index) ) {
                     new_numex++;
                 }
             }
@@ -399,11 +392,11 @@ bool CAmberSubTopology::PrepareNonbondedList(void)
     numex_offset = 0;
     for(int i=0; i < OldTopology->AtomList.GetNumberOfAtoms(); i++) {
         CAmberAtom* p_oldatom = OldTopology->AtomList.GetAtom(i);
-        if( Mask->IsAtomSelected(i) == true ) {
+        if( IsSelected(i) ) {
             int my_excluded = 0;
             for(int j = 0; j < p_oldatom->GetNUMEX(); j++) {
                 int nat_index = OldTopology->NonBondedList.GetNATEX(j + numex_offset);
-                if( (nat_index >= 0) && Mask->IsAtomSelected(nat_index) == true ) {
+                if( (nat_index >= 0) && IsSelected(nat_index) ) {
                     NonBondedList.SetNATEX(new_numex_offset,AtomMapper[nat_index]);
                     new_numex_offset++;
                     my_excluded++;
@@ -423,90 +416,92 @@ bool CAmberSubTopology::PrepareNonbondedList(void)
 
 //------------------------------------------------------------------------------
 
+inline int CAmberSubTopology::IsSelected(int index) const
+{
+    return( AtomMapper[index] >= 0 ? 1 : 0 );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberSubTopology::MapType(std::vector<int>& typemap,std::vector<int>& types,int type)
+{
+    if( (type < 0) || (type >= (int)typemap.size()) ) {
+        CSmallString error;
+        error << "illegal type index (" << type+1 << ")";
+        ES_ERROR(error);
+        return(false);
+    }
+    if( typemap[type] < 0 ) {
+        typemap[type] = types.size();
+        types.push_back(type);
+    }
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
 bool CAmberSubTopology::PrepareBonds(void)
 {
+    // classify bonds -------------------------------------------------------------
+    // number of selected atoms in each bond
+    int nbondsh = OldTopology->BondList.GetNumberOfBondsWithHydrogen();
+    int nbonds = OldTopology->BondList.GetNumberOfBondsWithoutHydrogen();
+
+    vector<char> selh(nbondsh);
+    vector<char> sel(nbonds);
+
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < nbondsh; i++) {
+        CAmberBond* p_bond = OldTopology->BondList.GetBondWithHydrogen(i);
+        selh[i] = IsSelected(p_bond->GetIB()) + IsSelected(p_bond->GetJB());
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < nbonds; i++) {
+        CAmberBond* p_bond = OldTopology->BondList.GetBondWithoutHydrogen(i);
+        sel[i] = IsSelected(p_bond->GetIB()) + IsSelected(p_bond->GetJB());
+    }
+
     // determine number of bonds with hydrogens -----------------------------------
-    int numbondh0 = 0;
-    int numbondh1 = 0;
+    int numbondh0 = 0;  // contain all atoms
+    int numbondh1 = 0;  // contain at least one atom
 
     vector<int> bondwithhydrogens;
 
-    for(int i=0; i < OldTopology->BondList.GetNumberOfBondsWithHydrogen(); i++) {
-        //check if bond contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        bool pass1 = false;   // contain at least one atom
-        CAmberBond* p_bond = OldTopology->BondList.GetBondWithHydrogen(i);
-        if( Mask->IsAtomSelected(p_bond->GetIB()) == true ) {
-            pass1 = true;
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_bond->GetJB()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            numbondh0++;
-            bondwithhydrogens.push_back(i);
-        }
-        if( pass1 == true ) numbondh1++;
+    for(int i=0; i < nbondsh; i++) {
+        if( selh[i] == 2 ) bondwithhydrogens.push_back(i);
+        if( selh[i] > 0 ) numbondh1++;
     }
+    numbondh0 = bondwithhydrogens.size();
 
     // determine number of bonds without hydrogens ------------------------------
-    int numbond0 = 0;
-    int numbond1 = 0;
+    int numbond0 = 0;   // contain all atoms
+    int numbond1 = 0;   // contain at least one atom
 
     vector<int> bondwithouthydrogens;
 
-    for(int i=0; i < OldTopology->BondList.GetNumberOfBondsWithoutHydrogen(); i++) {
-        //check if bond contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        bool pass1 = false;   // contain at least one atom
-        CAmberBond* p_bond = OldTopology->BondList.GetBondWithoutHydrogen(i);
-        if( Mask->IsAtomSelected(p_bond->GetIB()) == true ) {
-            pass1 = true;
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_bond->GetJB()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            numbond0++;
-            bondwithouthydrogens.push_back(i);
-        }
-        if( pass1 == true ) numbond1++;
+    for(int i=0; i < nbonds; i++) {
+        if( sel[i] == 2 ) bondwithouthydrogens.push_back(i);
+        if( sel[i] > 0 ) numbond1++;
     }
+    numbond0 = bondwithouthydrogens.size();
 
+    // determine number of unique bond types --------------------------------------
+    // types are numbered in the order of the first occurence in GetBond()
     vector<int> bondtypeindexes;
+    vector<int> bondtypemap(OldTopology->BondList.GetNumberOfBondTypes(),-1);
 
-    // determine number of unique bond types --------------------------------------
-    for(int i=0; i < OldTopology->BondList.GetNumberOfBonds(); i++) {
-        //check if bond contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        CAmberBond* p_bond = OldTopology->BondList.GetBond(i);
-        if( Mask->IsAtomSelected(p_bond->GetIB()) == true ) {
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_bond->GetJB()) == true ) {
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            // check if it is new type
-            bool new_type = true;
-            for(unsigned int j=0; j < bondtypeindexes.size(); j++) {
-                if( bondtypeindexes[j] == p_bond->GetICB() ) {
-                    new_type = false;
-                    break;
-                }
-            }
-            if( new_type == true ) bondtypeindexes.push_back(p_bond->GetICB());
-        }
+    for(unsigned int i=0; i < bondwithouthydrogens.size(); i++) {
+        CAmberBond* p_bond = OldTopology->BondList.GetBondWithoutHydrogen(bondwithouthydrogens[i]);
+        if( MapType(bondtypemap,bondtypeindexes,p_bond->GetICB()) == false ) return(false);
+    }
+    for(unsigned int i=0; i < bondwithhydrogens.size(); i++) {
+        CAmberBond* p_bond = OldTopology->BondList.GetBondWithHydrogen(bondwithhydrogens[i]);
+        if( MapType(bondtypemap,bondtypeindexes,p_bond->GetICB()) == false ) return(false);
     }
 
     // print info about bonds -----------------------------------------------------
@@ -554,38 +549,28 @@ bool CAmberSubTopology::PrepareBonds(void)
     }
 
     // copy bonds with hydrogens --------------------------------------------------
-    for(unsigned int i=0; i < bondwithhydrogens.size(); i++) {
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < (int)bondwithhydrogens.size(); i++) {
         CAmberBond* p_bond = BondList.GetBondWithHydrogen(i);
         CAmberBond* p_oldbond = OldTopology->BondList.GetBondWithHydrogen(bondwithhydrogens[i]);
         p_bond->SetIB(AtomMapper[p_oldbond->GetIB()]);
         p_bond->SetJB(AtomMapper[p_oldbond->GetJB()]);
-        // find bond type
-        unsigned int type = 0;
-        for(unsigned int j=0; j < bondtypeindexes.size(); j++) {
-            if( bondtypeindexes[j] == p_oldbond->GetICB() ) {
-                type = j;
-                break;
-            }
-        }
-        p_bond->SetICB(type);
+        p_bond->SetICB(bondtypemap[p_oldbond->GetICB()]);
         p_bond->SetPCB(0);
     }
 
     // copy bonds without hydrogens --------------------------------------------------
-    for(unsigned int i=0; i < bondwithouthydrogens.size(); i++) {
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < (int)bondwithouthydrogens.size(); i++) {
         CAmberBond* p_bond = BondList.GetBondWithoutHydrogen(i);
         CAmberBond* p_oldbond = OldTopology->BondList.GetBondWithoutHydrogen(bondwithouthydrogens[i]);
         p_bond->SetIB(AtomMapper[p_oldbond->GetIB()]);
         p_bond->SetJB(AtomMapper[p_oldbond->GetJB()]);
-        // find bond type
-        unsigned int type = 0;
-        for(unsigned int j=0; j < bondtypeindexes.size(); j++) {
-            if( bondtypeindexes[j] == p_oldbond->GetICB() ) {
-                type = j;
-                break;
-            }
-        }
-        p_bond->SetICB(type);
+        p_bond->SetICB(bondtypemap[p_oldbond->GetICB()]);
         p_bond->SetPCB(0);
     }
 
@@ -596,107 +581,66 @@ bool CAmberSubTopology::PrepareBonds(void)
 
 bool CAmberSubTopology::PrepareAngles(void)
 {
+    // classify angles ------------------------------------------------------------
+    // number of selected atoms in each angle
+    int nanglesh = OldTopology->AngleList.GetNumberOfAnglesWithHydrogen();
+    int nangles = OldTopology->AngleList.GetNumberOfAnglesWithoutHydrogen();
+
+    vector<char> selh(nanglesh);
+    vector<char> sel(nangles);
+
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < nanglesh; i++) {
+        CAmberAngle* p_angle = OldTopology->AngleList.GetAngleWithHydrogen(i);
+        selh[i] = IsSelected(p_angle->GetIT()) + IsSelected(p_angle->GetJT()) + IsSelected(p_angle->GetKT());
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < nangles; i++) {
+        CAmberAngle* p_angle = OldTopology->AngleList.GetAngleWithoutHydrogen(i);
+        sel[i] = IsSelected(p_angle->GetIT()) + IsSelected(p_angle->GetJT()) + IsSelected(p_angle->GetKT());
+    }
+
     // determine number of angles with hydrogens --------------------------------
-    int numangleh0 = 0;
-    int numangleh1 = 0;
+    int numangleh0 = 0;  // contain all atoms
+    int numangleh1 = 0;  // contain at least one atom
 
     vector<int> anglewithhydrogens;
 
-    for(int i=0; i < OldTopology->AngleList.GetNumberOfAnglesWithHydrogen(); i++) {
-        //check if angle contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        bool pass1 = false;   // contain at least one atom
-        CAmberAngle* p_angle = OldTopology->AngleList.GetAngleWithHydrogen(i);
-        if( Mask->IsAtomSelected(p_angle->GetIT()) == true ) {
-            pass1 = true;
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_angle->GetJT()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_angle->GetKT()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            numangleh0++;
-            anglewithhydrogens.push_back(i);
-        }
-        if( pass1 == true ) numangleh1++;
+    for(int i=0; i < nanglesh; i++) {
+        if( selh[i] == 3 ) anglewithhydrogens.push_back(i);
+        if( selh[i] > 0 ) numangleh1++;
     }
+    numangleh0 = anglewithhydrogens.size();
 
     // determine number of angles without hydrogens ------------------------------
-
-    int numangle0 = 0;
-    int numangle1 = 0;
+    int numangle0 = 0;   // contain all atoms
+    int numangle1 = 0;   // contain at least one atom
 
     vector<int> anglewithouthydrogens;
 
-    for(int i=0; i < OldTopology->AngleList.GetNumberOfAnglesWithoutHydrogen(); i++) {
-        //check if angle contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        bool pass1 = false;   // contain at least one atom
-        CAmberAngle* p_angle = OldTopology->AngleList.GetAngleWithoutHydrogen(i);
-        if( Mask->IsAtomSelected(p_angle->GetIT()) == true ) {
-            pass1 = true;
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_angle->GetJT()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_angle->GetKT()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            numangle0++;
-            anglewithouthydrogens.push_back(i);
-        }
-        if( pass1 == true ) numangle1++;
+    for(int i=0; i < nangles; i++) {
+        if( sel[i] == 3 ) anglewithouthydrogens.push_back(i);
+        if( sel[i] > 0 ) numangle1++;
     }
-
-    vector<int> angletypeindexes;
+    numangle0 = anglewithouthydrogens.size();
 
     // determine number of unique angle types -------------------------------------
+    // types are numbered in the order of the first occurence in GetAngle()
+    vector<int> angletypeindexes;
+    vector<int> angletypemap(OldTopology->AngleList.GetNumberOfAngleTypes(),-1);
 
-    for(int i=0; i < OldTopology->AngleList.GetNumberOfAngles(); i++) {
-        //check if angle contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        CAmberAngle* p_angle = OldTopology->AngleList.GetAngle(i);
-        if( Mask->IsAtomSelected(p_angle->GetIT()) == true ) {
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_angle->GetJT()) == true ) {
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_angle->GetKT()) == true ) {
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            // check if it is new type
-            bool new_type = true;
-            for(unsigned int j=0; j < angletypeindexes.size(); j++) {
-                if( angletypeindexes[j] == p_angle->GetICT() ) {
-                    new_type = false;
-                    break;
-                }
-            }
-            if( new_type == true ) angletypeindexes.push_back(p_angle->GetICT());
-        }
+    for(unsigned int i=0; i < anglewithouthydrogens.size(); i++) {
+        CAmberAngle* p_angle = OldTopology->AngleList.GetAngleWithoutHydrogen(anglewithouthydrogens[i]);
+        if( MapType(angletypemap,angletypeindexes,p_angle->GetICT()) == false ) return(false);
+    }
+    for(unsigned int i=0; i < anglewithhydrogens.size(); i++) {
+        CAmberAngle* p_angle = OldTopology->AngleList.GetAngleWithHydrogen(anglewithhydrogens[i]);
+        if( MapType(angletypemap,angletypeindexes,p_angle->GetICT()) == false ) return(false);
     }
 
     // print info about angles -----------------------------------------------------
@@ -743,40 +687,30 @@ bool CAmberSubTopology::PrepareAngles(void)
     }
 
     // copy angles with hydrogens --------------------------------------------------
-    for(unsigned int i=0; i < anglewithhydrogens.size(); i++) {
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < (int)anglewithhydrogens.size(); i++) {
         CAmberAngle* p_angle = AngleList.GetAngleWithHydrogen(i);
         CAmberAngle* p_oldangle = OldTopology->AngleList.GetAngleWithHydrogen(anglewithhydrogens[i]);
         p_angle->SetIT(AtomMapper[p_oldangle->GetIT()]);
         p_angle->SetJT(AtomMapper[p_oldangle->GetJT()]);
         p_angle->SetKT(AtomMapper[p_oldangle->GetKT()]);
-        // find bond type
-        unsigned int type = 0;
-        for(unsigned int j=0; j < angletypeindexes.size(); j++) {
-            if( angletypeindexes[j] == p_oldangle->GetICT() ) {
-                type = j;
-                break;
-            }
-        }
-        p_angle->SetICT(type);
+        p_angle->SetICT(angletypemap[p_oldangle->GetICT()]);
         p_angle->SetPCT(0);
     }
 
     // copy angles without hydrogens --------------------------------------------------
-    for(unsigned int i=0; i < anglewithouthydrogens.size(); i++) {
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < (int)anglewithouthydrogens.size(); i++) {
         CAmberAngle* p_angle = AngleList.GetAngleWithoutHydrogen(i);
         CAmberAngle* p_oldangle = OldTopology->AngleList.GetAngleWithoutHydrogen(anglewithouthydrogens[i]);
         p_angle->SetIT(AtomMapper[p_oldangle->GetIT()]);
         p_angle->SetJT(AtomMapper[p_oldangle->GetJT()]);
         p_angle->SetKT(AtomMapper[p_oldangle->GetKT()]);
-        // find bond type
-        unsigned int type = 0;
-        for(unsigned int j=0; j < angletypeindexes.size(); j++) {
-            if( angletypeindexes[j] == p_oldangle->GetICT() ) {
-                type = j;
-                break;
-            }
-        }
-        p_angle->SetICT(type);
+        p_angle->SetICT(angletypemap[p_oldangle->GetICT()]);
         p_angle->SetPCT(0);
     }
 
@@ -787,122 +721,66 @@ bool CAmberSubTopology::PrepareAngles(void)
 
 bool CAmberSubTopology::PrepareDihedrals(void)
 {
+    // classify dihedrals ------------------------------------------------------------
+    // number of selected atoms in each dihedral
+    int ndihedralsh = OldTopology->DihedralList.GetNumberOfDihedralsWithHydrogen();
+    int ndihedrals = OldTopology->DihedralList.GetNumberOfDihedralsWithoutHydrogen();
+
+    vector<char> selh(ndihedralsh);
+    vector<char> sel(ndihedrals);
+
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < ndihedralsh; i++) {
+        CAmberDihedral* p_dihedral = OldTopology->DihedralList.GetDihedralWithHydrogen(i);
+        selh[i] = IsSelected(p_dihedral->GetIP()) + IsSelected(p_dihedral->GetJP()) + IsSelected(p_dihedral->GetKP()) + IsSelected(p_dihedral->GetLP());
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < ndihedrals; i++) {
+        CAmberDihedral* p_dihedral = OldTopology->DihedralList.GetDihedralWithoutHydrogen(i);
+        sel[i] = IsSelected(p_dihedral->GetIP()) + IsSelected(p_dihedral->GetJP()) + IsSelected(p_dihedral->GetKP()) + IsSelected(p_dihedral->GetLP());
+    }
+
     // determine number of dihedrals with hydrogens --------------------------------
-    int numdihedralh0 = 0;
-    int numdihedralh1 = 0;
+    int numdihedralh0 = 0;  // contain all atoms
+    int numdihedralh1 = 0;  // contain at least one atom
 
     vector<int> dihedralwithhydrogens;
 
-    for(int i=0; i < OldTopology->DihedralList.GetNumberOfDihedralsWithHydrogen(); i++) {
-        //check if dihedral contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        bool pass1 = false;   // contain at least one atom
-        CAmberDihedral* p_dihedral = OldTopology->DihedralList.GetDihedralWithHydrogen(i);
-        if( Mask->IsAtomSelected(p_dihedral->GetIP()) == true ) {
-            pass1 = true;
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetJP()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetKP()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetLP()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            numdihedralh0++;
-            dihedralwithhydrogens.push_back(i);
-        }
-        if( pass1 == true ) numdihedralh1++;
+    for(int i=0; i < ndihedralsh; i++) {
+        if( selh[i] == 4 ) dihedralwithhydrogens.push_back(i);
+        if( selh[i] > 0 ) numdihedralh1++;
     }
+    numdihedralh0 = dihedralwithhydrogens.size();
 
     // determine number of dihedrals without hydrogens ------------------------------
-    int numdihedral0 = 0;
-    int numdihedral1 = 0;
+    int numdihedral0 = 0;   // contain all atoms
+    int numdihedral1 = 0;   // contain at least one atom
 
     vector<int> dihedralwithouthydrogens;
 
-    for(int i=0; i < OldTopology->DihedralList.GetNumberOfDihedralsWithoutHydrogen(); i++) {
-        //check if dihedral contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        bool pass1 = false;   // contain at least one atom
-        CAmberDihedral* p_dihedral = OldTopology->DihedralList.GetDihedralWithoutHydrogen(i);
-        if( Mask->IsAtomSelected(p_dihedral->GetIP()) == true ) {
-            pass1 = true;
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetJP()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetKP()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetLP()) == true ) {
-            pass1 = true;
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            numdihedral0++;
-            dihedralwithouthydrogens.push_back(i);
-        }
-        if( pass1 == true ) numdihedral1++;
+    for(int i=0; i < ndihedrals; i++) {
+        if( sel[i] == 4 ) dihedralwithouthydrogens.push_back(i);
+        if( sel[i] > 0 ) numdihedral1++;
     }
+    numdihedral0 = dihedralwithouthydrogens.size();
 
+    // determine number of unique dihedral types -------------------------------------
+    // types are numbered in the order of the first occurence in GetDihedral()
     vector<int> dihedraltypeindexes;
+    vector<int> dihedraltypemap(OldTopology->DihedralList.GetNumberOfDihedralTypes(),-1);
 
-    // determine number of unique dihedral types --------------------------------------
-    for(int i=0; i < OldTopology->DihedralList.GetNumberOfDihedrals(); i++) {
-        //check if dihedral contains any atom from mask
-        bool pass0 = false;   // contain all atoms
-        CAmberDihedral* p_dihedral = OldTopology->DihedralList.GetDihedral(i);
-        if( Mask->IsAtomSelected(p_dihedral->GetIP()) == true ) {
-            pass0 = true;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetJP()) == true ) {
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetKP()) == true ) {
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( Mask->IsAtomSelected(p_dihedral->GetLP()) == true ) {
-            pass0 &= true;
-        } else {
-            pass0 &= false;
-        }
-        if( pass0 == true ) {
-            // check if it is new type
-            bool new_type = true;
-            for(unsigned int j=0; j < dihedraltypeindexes.size(); j++) {
-                if( dihedraltypeindexes[j] == p_dihedral->GetICP() ) {
-                    new_type = false;
-                    break;
-                }
-            }
-            if( new_type == true ) dihedraltypeindexes.push_back(p_dihedral->GetICP());
-        }
+    for(unsigned int i=0; i < dihedralwithouthydrogens.size(); i++) {
+        CAmberDihedral* p_dihedral = OldTopology->DihedralList.GetDihedralWithoutHydrogen(dihedralwithouthydrogens[i]);
+        if( MapType(dihedraltypemap,dihedraltypeindexes,p_dihedral->GetICP()) == false ) return(false);
+    }
+    for(unsigned int i=0; i < dihedralwithhydrogens.size(); i++) {
+        CAmberDihedral* p_dihedral = OldTopology->DihedralList.GetDihedralWithHydrogen(dihedralwithhydrogens[i]);
+        if( MapType(dihedraltypemap,dihedraltypeindexes,p_dihedral->GetICP()) == false ) return(false);
     }
 
     // print info about dihedrals -----------------------------------------------------
@@ -954,10 +832,11 @@ bool CAmberSubTopology::PrepareDihedrals(void)
         p_dihedraltype->SetSCNB(p_olddihedraltype->GetSCNB());
     }
 
-    int pokus = 0;
-
     // copy angles with hydrogens --------------------------------------------------
-    for(unsigned int i=0; i < dihedralwithhydrogens.size(); i++) {
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < (int)dihedralwithhydrogens.size(); i++) {
         CAmberDihedral* p_dihedral = DihedralList.GetDihedralWithHydrogen(i);
         CAmberDihedral* p_olddihedral= OldTopology->DihedralList.GetDihedralWithHydrogen(dihedralwithhydrogens[i]);
 
@@ -977,29 +856,23 @@ bool CAmberSubTopology::PrepareDihedrals(void)
             p_dihedral->SetLP(AtomMapper[p_olddihedral->GetLP()]);
             p_dihedral->SetType(p_olddihedral->GetType());
         }
-        if( p_olddihedral->GetType() == 0 ) pokus++;
-
-        // find bond type
-        unsigned int type = 0;
-        for(unsigned int j=0; j < dihedraltypeindexes.size(); j++) {
-            if( dihedraltypeindexes[j] == p_olddihedral->GetICP() ) {
-                type = j;
-                break;
-            }
-        }
-        p_dihedral->SetICP(type);
+
+        p_dihedral->SetICP(dihedraltypemap[p_olddihedral->GetICP()]);
         p_dihedral->SetPCP(0);
     }
 
     // copy angles without hydrogens --------------------------------------------------
-    for(unsigned int i=0; i < dihedralwithouthydrogens.size(); i++) {
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for(int i=0; i < (int)dihedralwithouthydrogens.size(); i++) {
         CAmberDihedral* p_dihedral = DihedralList.GetDihedralWithoutHydrogen(i);
         CAmberDihedral* p_olddihedral = OldTopology->DihedralList.GetDihedralWithoutHydrogen(dihedralwithouthydrogens[i]);
 
         // WARNING !!!!! : KP and LP value must be non-zero values !!!!!
         //                 becase sign(KP) and sign(LP) determine type of dihedral (sign for zero number is not defined)
 
-        if( ((AtomMapper[p_olddihedral->GetKP()]) == 0) || ((AtomMapper[p_olddihedral->GetKP()]) == 0) ) {
+        if( (AtomMapper[p_olddihedral->GetKP()] == 0) || (AtomMapper[p_olddihedral->GetLP()] == 0) ) {
             p_dihedral->SetIP(AtomMapper[p_olddihedral->GetLP()]);
             p_dihedral->SetJP(AtomMapper[p_olddihedral->GetKP()]);
             p_dihedral->SetKP(AtomMapper[p_olddihedral->GetJP()]);
@@ -1013,15 +886,7 @@ bool CAmberSubTopology::PrepareDihedrals(void)
             p_dihedral->SetType(p_olddihedral->GetType());
         }
 
-        // find bond type
-        unsigned int type = 0;
-        for(unsigned int j=0; j < dihedraltypeindexes.size(); j++) {
-            if( dihedraltypeindexes[j] == p_olddihedral->GetICP() ) {
-                type = j;
-                break;
-            }
-        }
-        p_dihedral->SetICP(type);
+        p_dihedral->SetICP(dihedraltypemap[p_olddihedral->GetICP()]);
         p_dihedral->SetPCP(0);
     }
 
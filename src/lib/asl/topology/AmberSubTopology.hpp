@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <ASLMainHeader.hpp>
 #include <AmberTopology.hpp>
+#include <vector>
 
 //---------------------------------------------------------------------------
 
@@ -70,6 +71,12 @@ private:
     bool PrepareAngles(void);
     bool PrepareDihedrals(void);
     bool CopyTopologyBox(void);
+
+    /// return 1 if atom of old topology is selected (uses AtomMapper)
+    int IsSelected(int index) const;
+
+    /// register old type index, types are numbered in the order of registration
+    bool MapType(std::vector<int>& typemap,std::vector<int>& types,int type);
 };
 
 //---------------------------------------------------------------------------
@@ -21,10 +21,15 @@
 #include <string.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <ctype.h>
 #include <AmberTopology.hpp>
 #include <FortranIO.hpp>
+#include <AmberFortranWriter.hpp>
 #include <ErrorSystem.hpp>
+#include <AmberLoadErrors.hpp>
 #include <list>
+#include <vector>
+#include <algorithm>
 #include <SmallTimeAndDate.hpp>
 
 //------------------------------------------------------------------------------
@@ -45,6 +50,15 @@ CAmberTopology::CAmberTopology(void)
     NCOPY = 0;
     NCOPY_Read = false;
     TotalMass = 0;
+    NumOfLoadThreads = 1;
+    NumOfSaveThreads = 1;
+    LoadOptions = AMBER_LOAD_ALL;
+    LoadedParts = AMBER_LOAD_ALL;
+    ExclusionOffsets = NULL;
+    ExclusionList = NULL;
+    NeighbourOffsets = NULL;
+    NeighbourList = NULL;
+    ContentHashValid = false;
 
     // amber_7 defaults
     fTITLE="20a4";
@@ -109,6 +123,8 @@ CAmberTopology::CAmberTopology(void)
 
 CAmberTopology::~CAmberTopology(void)
 {
+    FreeExclusionIndex();
+    FreeListOfNeighbourAtoms();
 }
 
 //==============================================================================
@@ -131,7 +147,18 @@ void CAmberTopology::Clean(void)
     BoxInfo.FreeFields();
     CapInfo.FreeFields();
 
+    FreeExclusionIndex();
+    FreeListOfNeighbourAtoms();
+    FreeNameIndexes();
+
+    MolFirstAtom.clear();
+    MolLastAtom.clear();
+    MolNumOfAtoms.clear();
+
+    InvalidateContentHash();
+
     FakeTopology = false;
+    LoadedParts = AMBER_LOAD_ALL;
 }
 
 //==============================================================================
@@ -208,72 +235,158 @@ bool CAmberTopology::InitResidueNumOfBondsWithHydrogen(void)
 
 bool CAmberTopology::InitMoleculeIndexes(void)
 {
-    int            mol_index = 0;
-    CAmberResidue* p_last_res = NULL;
+    int natoms = AtomList.GetNumberOfAtoms();
+
+    MolFirstAtom.clear();
+    MolLastAtom.clear();
+    MolNumOfAtoms.clear();
 
-    // assign initial indexes, we assume that residues are not built from several molecules
+    if( natoms <= 0 ) return(true);
 
-    for(int j=0; j<AtomList.GetNumberOfAtoms(); j++) {
+    // we assume that residues are not built from several molecules
+    // thus each run of atoms from the same residue is initially one set
+    // the set is represented by atom with the lowest index (disjoint-set forest)
+
+    std::vector<int>    parent(natoms);
+    std::vector<int>    init_index(natoms);
+    int                 mol_index = 0;
+    CAmberResidue*      p_last_res = NULL;
+    int                 first = 0;
+
+    for(int j=0; j < natoms; j++) {
         CAmberAtom* p_atom = AtomList.GetAtom(j);
-        if( p_atom != NULL ) {
-            if( p_last_res != p_atom->GetResidue() ) {
-                p_last_res = p_atom->GetResidue();
-                mol_index++;
-            }
-            p_atom->MoleculeIndex = mol_index;
+        if( (j == 0) || (p_last_res != p_atom->GetResidue()) ) {
+            p_last_res = p_atom->GetResidue();
+            mol_index++;
+            first = j;
         }
+        parent[j] = first;
+        init_index[j] = mol_index;
     }
 
-    CAmberAtom*     p_at1;
-    CAmberAtom*     p_at2;
-    bool            passed = false;
-    int             pass_index = 0;
-
-    // this is iterative aproach, but it is quit fast
+    // join sets connected by bonds
+    for(int i = 0; i < BondList.GetNumberOfBonds(); i++) {
+        CAmberBond* p_bond = BondList.GetBond(i);
+        if( p_bond == NULL ) continue;
+        int at1 = p_bond->GetIB();
+        int at2 = p_bond->GetJB();
+        if( (at1 < 0) || (at1 >= natoms) || (at2 < 0) || (at2 >= natoms) ) continue;
 
-    while( passed == false ) {
-        // printf("Pass index: %d\n",pass_index);
-        pass_index++;
-        passed = true;
+        int r1 = FindMoleculeRoot(parent,at1);
+        int r2 = FindMoleculeRoot(parent,at2);
+        if( r1 == r2 ) continue;
 
-        for(int i = 0; i < BondList.GetNumberOfBondsWithoutHydrogen(); i++) {
-            CAmberBond* p_bond = BondList.GetBondWithoutHydrogen(i);
-            if( p_bond != NULL ) {
+        // use lower index
+        if( r1 < r2 ) {
+            parent[r2] = r1;
+        } else {
+            parent[r1] = r2;
+        }
+    }
 
-                p_at1 = AtomList.GetAtom(p_bond->GetIB());
-                p_at2 = AtomList.GetAtom(p_bond->GetJB());
+    // assign indexes - the root has the lowest initial index in its molecule
+    // molecules are numbered in the order of their first atoms
+    std::vector<int>    mol_order(natoms,-1);
 
-                if( p_at1->GetMoleculeIndex() != p_at2->GetMoleculeIndex() ) {
-                    passed = false;
-                    // use lower index
-                    if( p_at1->GetMoleculeIndex() < p_at2->GetMoleculeIndex() ) {
-                        p_at2->MoleculeIndex = p_at1->GetMoleculeIndex();
-                    } else {
-                        p_at1->MoleculeIndex = p_at2->GetMoleculeIndex();
-                    }
-                }
+    for(int j=0; j < natoms; j++) {
+        CAmberAtom* p_atom = AtomList.GetAtom(j);
+        int root = FindMoleculeRoot(parent,j);
+        p_atom->MoleculeIndex = init_index[root];
 
-            }
+        int mol = mol_order[root];
+        if( mol < 0 ) {
+            mol = MolFirstAtom.size();
+            mol_order[root] = mol;
+            MolFirstAtom.push_back(j);
+            MolLastAtom.push_back(j);
+            MolNumOfAtoms.push_back(0);
         }
+        MolLastAtom[mol] = j;
+        MolNumOfAtoms[mol]++;
     }
 
-    // check consistency
-    for(int i = 0; i < BondList.GetNumberOfBondsWithHydrogen(); i++) {
-        CAmberBond* p_bond = BondList.GetBondWithHydrogen(i);
-        if( p_bond != NULL ) {
+    AtomList.InvalidateArrays();
 
-            p_at1 = AtomList.GetAtom(p_bond->GetIB());
-            p_at2 = AtomList.GetAtom(p_bond->GetJB());
+    return(true);
+}
 
-            if( p_at1->GetMoleculeIndex() != p_at2->GetMoleculeIndex() ) {
-                // use lower index
-                if( p_at1->GetMoleculeIndex() < p_at2->GetMoleculeIndex() ) {
-                    p_at2->MoleculeIndex = p_at1->GetMoleculeIndex();
-                } else {
-                    p_at1->MoleculeIndex = p_at2->GetMoleculeIndex();
-                }
-            }
+//------------------------------------------------------------------------------
+
+int CAmberTopology::FindMoleculeRoot(std::vector<int>& parent,int index)
+{
+    int root = index;
+    while( parent[root] != root ) root = parent[root];
+
+    // path compression
+    while( parent[index] != root ) {
+        int next = parent[index];
+        parent[index] = root;
+        index = next;
+    }
+
+    return(root);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetNumberOfMolecules(void)
+{
+    return(MolFirstAtom.size());
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetMoleculeFirstAtom(int mol)
+{
+    return(MolFirstAtom[mol]);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetMoleculeLastAtom(int mol)
+{
+    return(MolLastAtom[mol]);
+}
+
+//------------------------------------------------------------------------------
 
+int CAmberTopology::GetMoleculeNumberOfAtoms(int mol)
+{
+    return(MolNumOfAtoms[mol]);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberTopology::IsMoleculeContinuous(int mol)
+{
+    return( MolLastAtom[mol] - MolFirstAtom[mol] + 1 == MolNumOfAtoms[mol] );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberTopology::CheckMoleculesWithBox(void)
+{
+    if( BoxInfo.GetType() == AMBER_BOX_NONE ) return(true);
+    if( BoxInfo.GetNumberOfMolecules() <= 0 ) return(true);
+
+    if( BoxInfo.GetNumberOfMolecules() != GetNumberOfMolecules() ) {
+        CSmallString error;
+        error << "number of molecules in box info (" << BoxInfo.GetNumberOfMolecules()
+              << ") differs from number of molecules detected from bonds ("
+              << GetNumberOfMolecules() << ")";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    for(int i=0; i < GetNumberOfMolecules(); i++) {
+        if( (BoxInfo.GetNumberOfAtomsInMolecule(i) != MolNumOfAtoms[i]) ||
+            (IsMoleculeContinuous(i) == false) ) {
+            CSmallString error;
+            error << "molecule " << i+1 << " in box info has " << BoxInfo.GetNumberOfAtomsInMolecule(i)
+                  << " atoms but molecule detected from bonds has " << MolNumOfAtoms[i]
+                  << " atoms (from " << MolFirstAtom[i]+1 << " to " << MolLastAtom[i]+1 << ")";
+            ES_ERROR(error);
+            return(false);
         }
     }
 
@@ -284,17 +397,96 @@ bool CAmberTopology::InitMoleculeIndexes(void)
 
 void CAmberTopology::BuidListOfNeighbourAtoms(void)
 {
+    FreeListOfNeighbourAtoms();
+
+    int natoms = AtomList.GetNumberOfAtoms();
+    if( natoms <= 0 ) return;
+
+    NeighbourOffsets = new int[natoms+1];
+    for(int i=0; i <= natoms; i++) NeighbourOffsets[i] = 0;
+
+    // count degrees
+    int total = 0;
     for(int i = 0; i < BondList.GetNumberOfBonds(); i++) {
         CAmberBond* p_bond = BondList.GetBond(i);
         int at1 = p_bond->GetIB();
         int at2 = p_bond->GetJB();
+        if( (at1 < 0) || (at1 >= natoms) || (at2 < 0) || (at2 >= natoms) || (at1 == at2) ) continue;
+        NeighbourOffsets[at1+1]++;
+        NeighbourOffsets[at2+1]++;
+        total += 2;
+    }
 
-        CAmberAtom* p_at1 = AtomList.GetAtom(at1);
-        p_at1->NeighbourIndexes.insert(at2);
+    for(int i=0; i < natoms; i++) {
+        NeighbourOffsets[i+1] += NeighbourOffsets[i];
+    }
 
-        CAmberAtom* p_at2 = AtomList.GetAtom(at2);
-        p_at2->NeighbourIndexes.insert(at1);
+    NeighbourList = new int[total > 0 ? total : 1];
+
+    // fill partners, fill pointers are kept in a temporary copy of offsets
+    vector<int> pos(NeighbourOffsets,NeighbourOffsets+natoms);
+    for(int i = 0; i < BondList.GetNumberOfBonds(); i++) {
+        CAmberBond* p_bond = BondList.GetBond(i);
+        int at1 = p_bond->GetIB();
+        int at2 = p_bond->GetJB();
+        if( (at1 < 0) || (at1 >= natoms) || (at2 < 0) || (at2 >= natoms) || (at1 == at2) ) continue;
+        NeighbourList[pos[at1]++] = at2;
+        NeighbourList[pos[at2]++] = at1;
+    }
+
+    // sort and remove duplicate bonds
+    int ci = 0;
+    for(int i=0; i < natoms; i++) {
+        int* p_first = NeighbourList + NeighbourOffsets[i];
+        int* p_last = NeighbourList + NeighbourOffsets[i+1];
+        sort(p_first,p_last);
+        p_last = unique(p_first,p_last);
+        NeighbourOffsets[i] = ci;
+        for(int* p_it = p_first; p_it != p_last; p_it++) {
+            NeighbourList[ci++] = *p_it;
+        }
+    }
+    NeighbourOffsets[natoms] = ci;
+
+    // update atoms
+    for(int i=0; i < natoms; i++) {
+        CAmberAtom* p_atom = AtomList.GetAtom(i);
+        p_atom->Neighbours = NeighbourList + NeighbourOffsets[i];
+        p_atom->NumOfNeighbours = NeighbourOffsets[i+1] - NeighbourOffsets[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::FreeListOfNeighbourAtoms(void)
+{
+    for(int i=0; i < AtomList.GetNumberOfAtoms(); i++) {
+        CAmberAtom* p_atom = AtomList.GetAtom(i);
+        p_atom->Neighbours = NULL;
+        p_atom->NumOfNeighbours = 0;
+    }
+
+    if( NeighbourOffsets != NULL ) delete[] NeighbourOffsets;
+    NeighbourOffsets = NULL;
+    if( NeighbourList != NULL ) delete[] NeighbourList;
+    NeighbourList = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberTopology::GetNeighbourAtoms(int ai,int& count)
+{
+    count = 0;
+    if( (ai < 0) || (ai >= AtomList.GetNumberOfAtoms()) ) return(NULL);
+
+    if( NeighbourOffsets == NULL ) {
+        BuidListOfNeighbourAtoms();
+        if( NeighbourOffsets == NULL ) return(NULL);
     }
+
+    count = NeighbourOffsets[ai+1] - NeighbourOffsets[ai];
+    if( count == 0 ) return(NULL);
+    return(NeighbourList + NeighbourOffsets[ai]);
 }
 
 //------------------------------------------------------------------------------
@@ -322,24 +514,83 @@ bool CAmberTopology::IsNBPairExcluded(int ai,int aj)
         ai = t;
     }
 
-    // calculate index
-    int li = 1;
-    for(int i=0; i < ai; i++){
-        CAmberAtom* p_atom = AtomList.GetAtom(i);
-        li +=  p_atom->GetNUMEX();
+    if( ExclusionOffsets == NULL ) {
+        if( BuildExclusionIndex() == false ) return(false);
     }
-    CAmberAtom* p_atom = AtomList.GetAtom(ai);
-    int lu = li + p_atom->GetNUMEX();
 
-    // correction for fortran indexes
-    li--;
-    lu--;
-    for(int i=li; i < lu; i++){
-        if( aj == NonBondedList.GetNATEX(i) ){
-            return(true);
+    // binary search in sorted list of partners
+    const int* p_first = ExclusionList + ExclusionOffsets[ai];
+    const int* p_last = ExclusionList + ExclusionOffsets[ai+1];
+    return( binary_search(p_first,p_last,aj) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberTopology::BuildExclusionIndex(void)
+{
+    FreeExclusionIndex();
+
+    int natoms = AtomList.GetNumberOfAtoms();
+    int nnatex = NonBondedList.GetNumberOfExcludedAtoms();
+
+    // check consistency of NUMEX and NATEX
+    int total = 0;
+    for(int i=0; i < natoms; i++){
+        total += AtomList.GetAtom(i)->GetNUMEX();
+    }
+    if( total > nnatex ){
+        CSmallString error;
+        error << "sum of NUMEX (" << total << ") exceeds size of NATEX (" << nnatex << ")";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    ExclusionOffsets = new int[natoms+1];
+    ExclusionList = new int[total > 0 ? total : 1];
+
+    int li = 0;     // index to NATEX
+    int ci = 0;     // index to ExclusionList
+
+    for(int i=0; i < natoms; i++){
+        ExclusionOffsets[i] = ci;
+        int numex = AtomList.GetAtom(i)->GetNUMEX();
+        for(int j=0; j < numex; j++){
+            int aj = NonBondedList.GetNATEX(li++);
+            // placeholder for atoms without any exclusion is -1
+            if( (aj < 0) || (aj >= natoms) ) continue;
+            ExclusionList[ci++] = aj;
         }
+        sort(ExclusionList + ExclusionOffsets[i],ExclusionList + ci);
     }
-    return(false);
+    ExclusionOffsets[natoms] = ci;
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::FreeExclusionIndex(void)
+{
+    if( ExclusionOffsets != NULL ) delete[] ExclusionOffsets;
+    ExclusionOffsets = NULL;
+    if( ExclusionList != NULL ) delete[] ExclusionList;
+    ExclusionList = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberTopology::GetExcludedAtoms(int ai,int& count)
+{
+    count = 0;
+    if( (ai < 0) || (ai >= AtomList.GetNumberOfAtoms()) ) return(NULL);
+
+    if( ExclusionOffsets == NULL ) {
+        if( BuildExclusionIndex() == false ) return(NULL);
+    }
+
+    count = ExclusionOffsets[ai+1] - ExclusionOffsets[ai];
+    if( count == 0 ) return(NULL);
+    return(ExclusionList + ExclusionOffsets[ai]);
 }
 
 //------------------------------------------------------------------------------
@@ -433,9 +684,16 @@ void CAmberTopology::operator = (const CAmberTopology& src)
     CapInfo = src.CapInfo;
 
     FakeTopology = src.FakeTopology;
+    LoadedParts = src.LoadedParts;
 
     ResidueList.ReinitAtomResiduePointers(&AtomList);
     InitMoleculeIndexes();
+
+    // atoms point to the bond graph of src
+    FreeListOfNeighbourAtoms();
+    if( src.NeighbourOffsets != NULL ) BuidListOfNeighbourAtoms();
+
+    BuildNameIndexes();
 }
 
 //==============================================================================
@@ -771,7 +1029,14 @@ bool CAmberTopology::Load(const CSmallString& file_name,bool allow_stdin)
         }
     }
 
-    bool result = Load(p_top);
+    bool result;
+
+    if( (NumOfLoadThreads > 1) && (p_top != stdin) ) {
+        // sections are decoded concurrently from independent streams
+        result = LoadParallel(file_name,p_top);
+    } else {
+        result = Load(p_top);
+    }
 
     if( result == true ) {
         Name = file_name;
@@ -786,6 +1051,82 @@ bool CAmberTopology::Load(const CSmallString& file_name,bool allow_stdin)
 
 //------------------------------------------------------------------------------
 
+bool CAmberTopology::LoadParallel(const CSmallString& file_name,FILE* p_fin)
+{
+    Clean();
+
+    char buffer[255];
+    if( (fgets(buffer,254,p_fin) == NULL) || (strstr(buffer,"%VERSION") == NULL) ) {
+        // AMBER 6 format is strictly sequential
+        rewind(p_fin);
+        return(Load(p_fin));
+    }
+
+    Version=AMBER_VERSION_7;
+    bool result = LoadAmber7Parallel(file_name,p_fin);
+
+    if( result == false ) {
+        ES_ERROR("unable to load topology file in AMBER 7 format");
+    } else {
+        BuildNameIndexes();
+    }
+
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::SetNumberOfLoadThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfLoadThreads = nthreads;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetNumberOfLoadThreads(void)
+{
+    return(NumOfLoadThreads);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::SetNumberOfSaveThreads(int nthreads)
+{
+    if( nthreads < 1 ) nthreads = 1;
+    NumOfSaveThreads = nthreads;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetNumberOfSaveThreads(void)
+{
+    return(NumOfSaveThreads);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::SetLoadOptions(int options)
+{
+    LoadOptions = options & AMBER_LOAD_ALL;
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetLoadOptions(void)
+{
+    return(LoadOptions);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetLoadedParts(void)
+{
+    return(LoadedParts);
+}
+
+//------------------------------------------------------------------------------
+
 bool CAmberTopology::Load(FILE* p_fin)
 {
     Clean();
@@ -818,6 +1159,8 @@ bool CAmberTopology::Load(FILE* p_fin)
             ES_ERROR("unable to load topology file in AMBER 7 format");
             break;
         }
+    } else {
+        BuildNameIndexes();
     }
 
     return(result);
@@ -1020,6 +1363,7 @@ bool CAmberTopology::LoadFakeTopologyFromG96(FILE* p_fin)
     }
 
     ResidueList.ReinitAtomResiduePointers(&AtomList);
+    BuildNameIndexes();
 
     return(true);
 }
@@ -1071,6 +1415,11 @@ bool CAmberTopology::Save(FILE* p_fout,EAmberVersion version)
         return(false);
     }
 
+    if( LoadedParts != AMBER_LOAD_ALL ){
+        ES_ERROR("cannot save partially loaded topology");
+        return(false);
+    }
+
     bool result;
 
     if( version == AMBER_VERSION_NONE ) version = Version;
@@ -1279,656 +1628,865 @@ bool CAmberTopology::LoadAmber7(FILE* p_top)
     char        *p_sname;
 
     while( (p_sname = fortranio.GetNameOfSection()) != NULL  ) {
-        if( strcmp(p_sname,"%FLAG TITLE") == 0 ) {
-            fTITLE = fortranio.GetFormatOfSection("%FLAG TITLE");
-            if( fTITLE == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG TITLE section");
-                return(false);
-            }
-            // OK - force to read the whole line
-            fortranio.SetFormat("1A80");
-            if( fortranio.ReadString(ITITL) == false ) return(false);
-            continue;
+        bool found = false;
+        if( LoadAmber7Section(p_top,fortranio,p_sname,found) == false ) return(false);
+        if( found == true ) continue;
+
+        // section was not found
+        CSmallString warning;
+        warning << "unrecognized section in topology '" << p_sname << ";";
+        ES_WARNING(warning);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberTopology::LoadAmber7Section(FILE* p_top,CFortranIO& fortranio,
+                                       const char* p_sname,bool& found)
+{
+    found = true;
+
+    // section from skipped group - it is passed by GetNameOfSection()
+    if( (GetSectionGroup(p_sname) & LoadedParts) == 0 ) return(true);
+
+    if( strcmp(p_sname,"%FLAG TITLE") == 0 ) {
+        fTITLE = fortranio.GetFormatOfSection("%FLAG TITLE");
+        if( fTITLE == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG TITLE section");
+            return(false);
         }
+        // OK - force to read the whole line
+        fortranio.SetFormat("1A80");
+        if( fortranio.ReadString(ITITL) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG POINTERS") == 0 ) {
-            fPOINTERS = fortranio.GetFormatOfSection("%FLAG POINTERS");
-            if( fPOINTERS == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG POINTERS section");
-                return(false);
-            }
-            if( LoadBasicInfo(p_top,fPOINTERS,AMBER_VERSION_7) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG POINTERS") == 0 ) {
+        fPOINTERS = fortranio.GetFormatOfSection("%FLAG POINTERS");
+        if( fPOINTERS == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG POINTERS section");
+            return(false);
         }
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG ATOM_NAME") == 0 ) {
-            fATOM_NAME = fortranio.GetFormatOfSection("%FLAG ATOM_NAME");
-            if( fATOM_NAME == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG ATOM_NAME section");
-                return(false);
-            }
-            if( AtomList.LoadAtomNames(p_top,fATOM_NAME) == false ) return(false);
-            continue;
+        if( LoadBasicInfo(p_top,fPOINTERS,AMBER_VERSION_7) == false ) return(false);
+        return(true);
+    }
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG ATOM_NAME") == 0 ) {
+        fATOM_NAME = fortranio.GetFormatOfSection("%FLAG ATOM_NAME");
+        if( fATOM_NAME == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ATOM_NAME section");
+            return(false);
         }
+        if( AtomList.LoadAtomNames(p_top,fATOM_NAME) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG CHARGE") == 0 ) {
-            fCHARGE = fortranio.GetFormatOfSection("%FLAG CHARGE");
-            if( fCHARGE == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG CHARGE section");
-                return(false);
-            }
-            if( AtomList.LoadAtomCharges(p_top,fCHARGE) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG CHARGE") == 0 ) {
+        fCHARGE = fortranio.GetFormatOfSection("%FLAG CHARGE");
+        if( fCHARGE == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG CHARGE section");
+            return(false);
         }
+        if( AtomList.LoadAtomCharges(p_top,fCHARGE) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG ATOMIC_NUMBER") == 0 ) {
-            fATOMIC_NUMBER = fortranio.GetFormatOfSection("%FLAG ATOMIC_NUMBER");
-            if( fATOMIC_NUMBER == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG ATOMIC_NUMBER section");
-                return(false);
-            }
-            if( AtomList.LoadAtomAtomicNumbers(p_top,fATOMIC_NUMBER) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG ATOMIC_NUMBER") == 0 ) {
+        fATOMIC_NUMBER = fortranio.GetFormatOfSection("%FLAG ATOMIC_NUMBER");
+        if( fATOMIC_NUMBER == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ATOMIC_NUMBER section");
+            return(false);
         }
+        if( AtomList.LoadAtomAtomicNumbers(p_top,fATOMIC_NUMBER) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG MASS") == 0 ) {
-            fMASS = fortranio.GetFormatOfSection("%FLAG MASS");
-            if( fMASS == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG MASS section");
-                return(false);
-            }
-            if( AtomList.LoadAtomMasses(p_top,fMASS) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG MASS") == 0 ) {
+        fMASS = fortranio.GetFormatOfSection("%FLAG MASS");
+        if( fMASS == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG MASS section");
+            return(false);
         }
+        if( AtomList.LoadAtomMasses(p_top,fMASS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG ATOM_TYPE_INDEX") == 0 ) {
-            fATOM_TYPE_INDEX = fortranio.GetFormatOfSection("%FLAG ATOM_TYPE_INDEX");
-            if( fATOM_TYPE_INDEX == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG ATOM_TYPE_INDEX section");
-                return(false);
-            }
-            if( AtomList.LoadAtomIACs(p_top,fATOM_TYPE_INDEX) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG ATOM_TYPE_INDEX") == 0 ) {
+        fATOM_TYPE_INDEX = fortranio.GetFormatOfSection("%FLAG ATOM_TYPE_INDEX");
+        if( fATOM_TYPE_INDEX == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ATOM_TYPE_INDEX section");
+            return(false);
         }
+        if( AtomList.LoadAtomIACs(p_top,fATOM_TYPE_INDEX) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG NUMBER_EXCLUDED_ATOMS") == 0 ) {
-            fNUMBER_EXCLUDED_ATOMS = fortranio.GetFormatOfSection("%FLAG NUMBER_EXCLUDED_ATOMS");
-            if( fNUMBER_EXCLUDED_ATOMS == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG NUMBER_EXCLUDED_ATOMS section");
-                return(false);
-            }
-            if( AtomList.LoadAtomNUMEXs(p_top,fNUMBER_EXCLUDED_ATOMS) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG NUMBER_EXCLUDED_ATOMS") == 0 ) {
+        fNUMBER_EXCLUDED_ATOMS = fortranio.GetFormatOfSection("%FLAG NUMBER_EXCLUDED_ATOMS");
+        if( fNUMBER_EXCLUDED_ATOMS == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG NUMBER_EXCLUDED_ATOMS section");
+            return(false);
         }
+        if( AtomList.LoadAtomNUMEXs(p_top,fNUMBER_EXCLUDED_ATOMS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG NONBONDED_PARM_INDEX") == 0 ) {
-            fNONBONDED_PARM_INDEX = fortranio.GetFormatOfSection("%FLAG NONBONDED_PARM_INDEX");
-            if( fNONBONDED_PARM_INDEX == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG NONBONDED_PARM_INDEX section");
-                return(false);
-            }
-            if( NonBondedList.LoadICOs(p_top,fNONBONDED_PARM_INDEX) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG NONBONDED_PARM_INDEX") == 0 ) {
+        fNONBONDED_PARM_INDEX = fortranio.GetFormatOfSection("%FLAG NONBONDED_PARM_INDEX");
+        if( fNONBONDED_PARM_INDEX == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG NONBONDED_PARM_INDEX section");
+            return(false);
         }
+        if( NonBondedList.LoadICOs(p_top,fNONBONDED_PARM_INDEX) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG RESIDUE_LABEL") == 0 ) {
-            fRESIDUE_LABEL = fortranio.GetFormatOfSection("%FLAG RESIDUE_LABEL");
-            if( fRESIDUE_LABEL == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG RESIDUE_LABEL section");
-                return(false);
-            }
-            if( ResidueList.LoadResidueNames(p_top,fRESIDUE_LABEL) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG RESIDUE_LABEL") == 0 ) {
+        fRESIDUE_LABEL = fortranio.GetFormatOfSection("%FLAG RESIDUE_LABEL");
+        if( fRESIDUE_LABEL == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG RESIDUE_LABEL section");
+            return(false);
         }
+        if( ResidueList.LoadResidueNames(p_top,fRESIDUE_LABEL) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG RESIDUE_POINTER") == 0 ) {
-            fRESIDUE_POINTER = fortranio.GetFormatOfSection("%FLAG RESIDUE_POINTER");
-            if( fRESIDUE_POINTER == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG RESIDUE_POINTER section");
-                return(false);
-            }
-            if( ResidueList.LoadResidueIPRES(p_top,&AtomList,fRESIDUE_POINTER) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG RESIDUE_POINTER") == 0 ) {
+        fRESIDUE_POINTER = fortranio.GetFormatOfSection("%FLAG RESIDUE_POINTER");
+        if( fRESIDUE_POINTER == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG RESIDUE_POINTER section");
+            return(false);
         }
+        if( ResidueList.LoadResidueIPRES(p_top,&AtomList,fRESIDUE_POINTER) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG BOND_FORCE_CONSTANT") == 0 ) {
-            fBOND_FORCE_CONSTANT = fortranio.GetFormatOfSection("%FLAG BOND_FORCE_CONSTANT");
-            if( fBOND_FORCE_CONSTANT == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG BOND_FORCE_CONSTANT section");
-                return(false);
-            }
-            if( BondList.LoadBondRK(p_top,fBOND_FORCE_CONSTANT) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG BOND_FORCE_CONSTANT") == 0 ) {
+        fBOND_FORCE_CONSTANT = fortranio.GetFormatOfSection("%FLAG BOND_FORCE_CONSTANT");
+        if( fBOND_FORCE_CONSTANT == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG BOND_FORCE_CONSTANT section");
+            return(false);
         }
+        if( BondList.LoadBondRK(p_top,fBOND_FORCE_CONSTANT) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG BOND_EQUIL_VALUE") == 0 ) {
-            fBOND_EQUIL_VALUE = fortranio.GetFormatOfSection("%FLAG BOND_EQUIL_VALUE");
-            if( fBOND_EQUIL_VALUE == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG BOND_EQUIL_VALUE section");
-                return(false);
-            }
-            if( BondList.LoadBondREQ(p_top,fBOND_EQUIL_VALUE) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG BOND_EQUIL_VALUE") == 0 ) {
+        fBOND_EQUIL_VALUE = fortranio.GetFormatOfSection("%FLAG BOND_EQUIL_VALUE");
+        if( fBOND_EQUIL_VALUE == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG BOND_EQUIL_VALUE section");
+            return(false);
         }
+        if( BondList.LoadBondREQ(p_top,fBOND_EQUIL_VALUE) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG ANGLE_FORCE_CONSTANT") == 0 ) {
-            fANGLE_FORCE_CONSTANT = fortranio.GetFormatOfSection("%FLAG ANGLE_FORCE_CONSTANT");
-            if( fANGLE_FORCE_CONSTANT == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG ANGLE_FORCE_CONSTANT section");
-                return(false);
-            }
-            if( AngleList.LoadAngleTK(p_top,fANGLE_FORCE_CONSTANT) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG ANGLE_FORCE_CONSTANT") == 0 ) {
+        fANGLE_FORCE_CONSTANT = fortranio.GetFormatOfSection("%FLAG ANGLE_FORCE_CONSTANT");
+        if( fANGLE_FORCE_CONSTANT == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ANGLE_FORCE_CONSTANT section");
+            return(false);
         }
+        if( AngleList.LoadAngleTK(p_top,fANGLE_FORCE_CONSTANT) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG ANGLE_EQUIL_VALUE") == 0 ) {
-            fANGLE_EQUIL_VALUE = fortranio.GetFormatOfSection("%FLAG ANGLE_EQUIL_VALUE");
-            if( fANGLE_EQUIL_VALUE == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG ANGLE_EQUIL_VALUE section");
-                return(false);
-            }
-            if( AngleList.LoadAngleTEQ(p_top,fANGLE_EQUIL_VALUE) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG ANGLE_EQUIL_VALUE") == 0 ) {
+        fANGLE_EQUIL_VALUE = fortranio.GetFormatOfSection("%FLAG ANGLE_EQUIL_VALUE");
+        if( fANGLE_EQUIL_VALUE == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ANGLE_EQUIL_VALUE section");
+            return(false);
         }
+        if( AngleList.LoadAngleTEQ(p_top,fANGLE_EQUIL_VALUE) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG DIHEDRAL_FORCE_CONSTANT") == 0 ) {
-            fDIHEDRAL_FORCE_CONSTANT = fortranio.GetFormatOfSection("%FLAG DIHEDRAL_FORCE_CONSTANT");
-            if( fDIHEDRAL_FORCE_CONSTANT == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG DIHEDRAL_FORCE_CONSTANT section");
-                return(false);
-            }
-            if( DihedralList.LoadDihedralPK(p_top,fDIHEDRAL_FORCE_CONSTANT) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG DIHEDRAL_FORCE_CONSTANT") == 0 ) {
+        fDIHEDRAL_FORCE_CONSTANT = fortranio.GetFormatOfSection("%FLAG DIHEDRAL_FORCE_CONSTANT");
+        if( fDIHEDRAL_FORCE_CONSTANT == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG DIHEDRAL_FORCE_CONSTANT section");
+            return(false);
         }
+        if( DihedralList.LoadDihedralPK(p_top,fDIHEDRAL_FORCE_CONSTANT) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG DIHEDRAL_PERIODICITY") == 0 ) {
-            fDIHEDRAL_PERIODICITY = fortranio.GetFormatOfSection("%FLAG DIHEDRAL_PERIODICITY");
-            if( fDIHEDRAL_PERIODICITY == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG DIHEDRAL_PERIODICITY section");
-                return(false);
-            }
-            if( DihedralList.LoadDihedralPN(p_top,fDIHEDRAL_PERIODICITY) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG DIHEDRAL_PERIODICITY") == 0 ) {
+        fDIHEDRAL_PERIODICITY = fortranio.GetFormatOfSection("%FLAG DIHEDRAL_PERIODICITY");
+        if( fDIHEDRAL_PERIODICITY == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG DIHEDRAL_PERIODICITY section");
+            return(false);
         }
+        if( DihedralList.LoadDihedralPN(p_top,fDIHEDRAL_PERIODICITY) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG DIHEDRAL_PHASE") == 0 ) {
-            fDIHEDRAL_PHASE = fortranio.GetFormatOfSection("%FLAG DIHEDRAL_PHASE");
-            if( fDIHEDRAL_PHASE == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG DIHEDRAL_PHASE section");
-                return(false);
-            }
-            if( DihedralList.LoadDihedralPHASE(p_top,fDIHEDRAL_PHASE) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG DIHEDRAL_PHASE") == 0 ) {
+        fDIHEDRAL_PHASE = fortranio.GetFormatOfSection("%FLAG DIHEDRAL_PHASE");
+        if( fDIHEDRAL_PHASE == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG DIHEDRAL_PHASE section");
+            return(false);
         }
+        if( DihedralList.LoadDihedralPHASE(p_top,fDIHEDRAL_PHASE) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG SCEE_SCALE_FACTOR") == 0 ) {
-            fSCEE_SCALE_FACTOR = fortranio.GetFormatOfSection("%FLAG SCEE_SCALE_FACTOR");
-            if( fSCEE_SCALE_FACTOR == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG SCEE_SCALE_FACTOR section");
-                return(false);
-            }
-            if( DihedralList.LoadDihedralSCEE(p_top,fSCEE_SCALE_FACTOR) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG SCEE_SCALE_FACTOR") == 0 ) {
+        fSCEE_SCALE_FACTOR = fortranio.GetFormatOfSection("%FLAG SCEE_SCALE_FACTOR");
+        if( fSCEE_SCALE_FACTOR == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG SCEE_SCALE_FACTOR section");
+            return(false);
         }
+        if( DihedralList.LoadDihedralSCEE(p_top,fSCEE_SCALE_FACTOR) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG SCNB_SCALE_FACTOR") == 0 ) {
-            fSCNB_SCALE_FACTOR = fortranio.GetFormatOfSection("%FLAG SCNB_SCALE_FACTOR");
-            if( fSCNB_SCALE_FACTOR == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG SCNB_SCALE_FACTOR section");
-                return(false);
-            }
-            if( DihedralList.LoadDihedralSCNB(p_top,fSCNB_SCALE_FACTOR) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG SCNB_SCALE_FACTOR") == 0 ) {
+        fSCNB_SCALE_FACTOR = fortranio.GetFormatOfSection("%FLAG SCNB_SCALE_FACTOR");
+        if( fSCNB_SCALE_FACTOR == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG SCNB_SCALE_FACTOR section");
+            return(false);
         }
+        if( DihedralList.LoadDihedralSCNB(p_top,fSCNB_SCALE_FACTOR) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG SOLTY") == 0 ) {
-            fSOLTY = fortranio.GetFormatOfSection("%FLAG SOLTY");
-            if( fSOLTY == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG SOLTY section");
-                return(false);
-            }
-            if( NonBondedList.LoadSOLTY(p_top,fSOLTY) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG SOLTY") == 0 ) {
+        fSOLTY = fortranio.GetFormatOfSection("%FLAG SOLTY");
+        if( fSOLTY == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG SOLTY section");
+            return(false);
         }
+        if( NonBondedList.LoadSOLTY(p_top,fSOLTY) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG LENNARD_JONES_ACOEF") == 0 ) {
-            fLENNARD_JONES_ACOEF = fortranio.GetFormatOfSection("%FLAG LENNARD_JONES_ACOEF");
-            if( fLENNARD_JONES_ACOEF == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG LENNARD_JONES_ACOEF section");
-                return(false);
-            }
-            if( NonBondedList.LoadCN1(p_top,fLENNARD_JONES_ACOEF) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG LENNARD_JONES_ACOEF") == 0 ) {
+        fLENNARD_JONES_ACOEF = fortranio.GetFormatOfSection("%FLAG LENNARD_JONES_ACOEF");
+        if( fLENNARD_JONES_ACOEF == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG LENNARD_JONES_ACOEF section");
+            return(false);
         }
+        if( NonBondedList.LoadCN1(p_top,fLENNARD_JONES_ACOEF) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG LENNARD_JONES_BCOEF") == 0 ) {
-            fLENNARD_JONES_BCOEF = fortranio.GetFormatOfSection("%FLAG LENNARD_JONES_BCOEF");
-            if( fLENNARD_JONES_BCOEF == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG LENNARD_JONES_BCOEF section");
-                return(false);
-            }
-            if( NonBondedList.LoadCN2(p_top,fLENNARD_JONES_BCOEF) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG LENNARD_JONES_BCOEF") == 0 ) {
+        fLENNARD_JONES_BCOEF = fortranio.GetFormatOfSection("%FLAG LENNARD_JONES_BCOEF");
+        if( fLENNARD_JONES_BCOEF == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG LENNARD_JONES_BCOEF section");
+            return(false);
         }
+        if( NonBondedList.LoadCN2(p_top,fLENNARD_JONES_BCOEF) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG BONDS_INC_HYDROGEN") == 0 ) {
-            fBONDS_INC_HYDROGEN = fortranio.GetFormatOfSection("%FLAG BONDS_INC_HYDROGEN");
-            if( fBONDS_INC_HYDROGEN == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG BONDS_INC_HYDROGEN section");
-                return(false);
-            }
-            if( BondList.LoadBondsWithHydrogens(p_top,fBONDS_INC_HYDROGEN) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG BONDS_INC_HYDROGEN") == 0 ) {
+        fBONDS_INC_HYDROGEN = fortranio.GetFormatOfSection("%FLAG BONDS_INC_HYDROGEN");
+        if( fBONDS_INC_HYDROGEN == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG BONDS_INC_HYDROGEN section");
+            return(false);
         }
+        if( BondList.LoadBondsWithHydrogens(p_top,fBONDS_INC_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG BONDS_WITHOUT_HYDROGEN") == 0 ) {
-            fBONDS_WITHOUT_HYDROGEN = fortranio.GetFormatOfSection("%FLAG BONDS_WITHOUT_HYDROGEN");
-            if( fBONDS_WITHOUT_HYDROGEN == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG BONDS_WITHOUT_HYDROGEN section");
-                return(false);
-            }
-            if( BondList.LoadBondsWithoutHydrogens(p_top,fBONDS_WITHOUT_HYDROGEN) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG BONDS_WITHOUT_HYDROGEN") == 0 ) {
+        fBONDS_WITHOUT_HYDROGEN = fortranio.GetFormatOfSection("%FLAG BONDS_WITHOUT_HYDROGEN");
+        if( fBONDS_WITHOUT_HYDROGEN == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG BONDS_WITHOUT_HYDROGEN section");
+            return(false);
         }
+        if( BondList.LoadBondsWithoutHydrogens(p_top,fBONDS_WITHOUT_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG ANGLES_INC_HYDROGEN") == 0 ) {
-            fANGLES_INC_HYDROGEN = fortranio.GetFormatOfSection("%FLAG ANGLES_INC_HYDROGEN");
-            if( fANGLES_INC_HYDROGEN == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG ANGLES_INC_HYDROGEN section");
-                return(false);
-            }
-            if( AngleList.LoadAnglesWithHydrogens(p_top,fANGLES_INC_HYDROGEN) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG ANGLES_INC_HYDROGEN") == 0 ) {
+        fANGLES_INC_HYDROGEN = fortranio.GetFormatOfSection("%FLAG ANGLES_INC_HYDROGEN");
+        if( fANGLES_INC_HYDROGEN == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ANGLES_INC_HYDROGEN section");
+            return(false);
         }
+        if( AngleList.LoadAnglesWithHydrogens(p_top,fANGLES_INC_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-        if( strcmp(p_sname,"%FLAG ANGLES_WITHOUT_HYDROGEN") == 0 ) {
-            fANGLES_WITHOUT_HYDROGEN = fortranio.GetFormatOfSection("%FLAG ANGLES_WITHOUT_HYDROGEN");
-            if( fANGLES_WITHOUT_HYDROGEN == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG ANGLES_WITHOUT_HYDROGEN section");
-                return(false);
-            }
-            if( AngleList.LoadAnglesWithoutHydrogens(p_top,fANGLES_WITHOUT_HYDROGEN) == false ) return(false);
-            continue;
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG ANGLES_WITHOUT_HYDROGEN") == 0 ) {
+        fANGLES_WITHOUT_HYDROGEN = fortranio.GetFormatOfSection("%FLAG ANGLES_WITHOUT_HYDROGEN");
+        if( fANGLES_WITHOUT_HYDROGEN == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ANGLES_WITHOUT_HYDROGEN section");
+            return(false);
+        }
+        if( AngleList.LoadAnglesWithoutHydrogens(p_top,fANGLES_WITHOUT_HYDROGEN) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG DIHEDRALS_INC_HYDROGEN") == 0 ) {
+        fDIHEDRALS_INC_HYDROGEN = fortranio.GetFormatOfSection("%FLAG DIHEDRALS_INC_HYDROGEN");
+        if( fDIHEDRALS_INC_HYDROGEN == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG DIHEDRALS_INC_HYDROGEN section");
+            return(false);
+        }
+        if( DihedralList.LoadDihedralsWithHydrogens(p_top,fDIHEDRALS_INC_HYDROGEN) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG DIHEDRALS_WITHOUT_HYDROGEN") == 0 ) {
+        fDIHEDRALS_WITHOUT_HYDROGEN = fortranio.GetFormatOfSection("%FLAG DIHEDRALS_WITHOUT_HYDROGEN");
+        if( fDIHEDRALS_WITHOUT_HYDROGEN == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG DIHEDRALS_WITHOUT_HYDROGEN section");
+            return(false);
+        }
+        if( DihedralList.LoadDihedralsWithoutHydrogens(p_top,fDIHEDRALS_WITHOUT_HYDROGEN) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG EXCLUDED_ATOMS_LIST") == 0 ) {
+        fEXCLUDED_ATOMS_LIST = fortranio.GetFormatOfSection("%FLAG EXCLUDED_ATOMS_LIST");
+        if( fEXCLUDED_ATOMS_LIST == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG EXCLUDED_ATOMS_LIST section");
+            return(false);
+        }
+        if( NonBondedList.LoadNATEX(p_top,fEXCLUDED_ATOMS_LIST) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG HBOND_ACOEF") == 0 ) {
+        fHBOND_ACOEF = fortranio.GetFormatOfSection("%FLAG HBOND_ACOEF");
+        if( fHBOND_ACOEF == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG HBOND_ACOEF section");
+            return(false);
+        }
+        if( NonBondedList.LoadASOL(p_top,fHBOND_ACOEF) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG HBOND_BCOEF") == 0 ) {
+        fHBOND_BCOEF = fortranio.GetFormatOfSection("%FLAG HBOND_BCOEF");
+        if( fHBOND_BCOEF == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG HBOND_BCOEF section");
+            return(false);
+        }
+        if( NonBondedList.LoadBSOL(p_top,fHBOND_BCOEF) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG HBCUT") == 0 ) {
+        fHBCUT = fortranio.GetFormatOfSection("%FLAG HBCUT");
+        if( fHBCUT == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG HBCUT section");
+            return(false);
+        }
+        if( NonBondedList.LoadHBCUT(p_top,fHBCUT) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG AMBER_ATOM_TYPE") == 0 ) {
+        fAMBER_ATOM_TYPE = fortranio.GetFormatOfSection("%FLAG AMBER_ATOM_TYPE");
+        if( fAMBER_ATOM_TYPE == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG AMBER_ATOM_TYPE section");
+            return(false);
+        }
+        if( AtomList.LoadAtomISYMBL(p_top,fAMBER_ATOM_TYPE) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG TREE_CHAIN_CLASSIFICATION") == 0 ) {
+        fTREE_CHAIN_CLASSIFICATION = fortranio.GetFormatOfSection("%FLAG TREE_CHAIN_CLASSIFICATION");
+        if( fTREE_CHAIN_CLASSIFICATION == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG TREE_CHAIN_CLASSIFICATION section");
+            return(false);
+        }
+        if( AtomList.LoadAtomITREE(p_top,fTREE_CHAIN_CLASSIFICATION) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG JOIN_ARRAY") == 0 ) {
+        fJOIN_ARRAY = fortranio.GetFormatOfSection("%FLAG JOIN_ARRAY");
+        if( fJOIN_ARRAY == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG JOIN_ARRAY section");
+            return(false);
+        }
+        if( AtomList.LoadAtomJOIN(p_top,fJOIN_ARRAY) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG IROTAT") == 0 ) {
+        fIROTAT = fortranio.GetFormatOfSection("%FLAG IROTAT");
+        if( fIROTAT == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG IROTAT section");
+            return(false);
         }
+        if( AtomList.LoadAtomIROTAT(p_top,fIROTAT) == false ) return(false);
+        return(true);
+    }
+
+    if( BoxInfo.GetType() != AMBER_BOX_NONE ) { // load box info
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG DIHEDRALS_INC_HYDROGEN") == 0 ) {
-            fDIHEDRALS_INC_HYDROGEN = fortranio.GetFormatOfSection("%FLAG DIHEDRALS_INC_HYDROGEN");
-            if( fDIHEDRALS_INC_HYDROGEN == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG DIHEDRALS_INC_HYDROGEN section");
+        if( strcmp(p_sname,"%FLAG SOLVENT_POINTERS") == 0 ) {
+            fSOLVENT_POINTERS = fortranio.GetFormatOfSection("%FLAG SOLVENT_POINTERS");
+            if( fSOLVENT_POINTERS == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG SOLVENT_POINTERS section");
                 return(false);
             }
-            if( DihedralList.LoadDihedralsWithHydrogens(p_top,fDIHEDRALS_INC_HYDROGEN) == false ) return(false);
-            continue;
+            if( BoxInfo.LoadSolventPointers(p_top,fSOLVENT_POINTERS) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG DIHEDRALS_WITHOUT_HYDROGEN") == 0 ) {
-            fDIHEDRALS_WITHOUT_HYDROGEN = fortranio.GetFormatOfSection("%FLAG DIHEDRALS_WITHOUT_HYDROGEN");
-            if( fDIHEDRALS_WITHOUT_HYDROGEN == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG DIHEDRALS_WITHOUT_HYDROGEN section");
+        if( strcmp(p_sname,"%FLAG ATOMS_PER_MOLECULE") == 0 ) {
+            fATOMS_PER_MOLECULE = fortranio.GetFormatOfSection("%FLAG ATOMS_PER_MOLECULE");
+            if( fATOMS_PER_MOLECULE == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ATOMS_PER_MOLECULE section");
                 return(false);
             }
-            if( DihedralList.LoadDihedralsWithoutHydrogens(p_top,fDIHEDRALS_WITHOUT_HYDROGEN) == false ) return(false);
-            continue;
+            if( BoxInfo.LoadNumsOfMolecules(p_top,fATOMS_PER_MOLECULE) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG EXCLUDED_ATOMS_LIST") == 0 ) {
-            fEXCLUDED_ATOMS_LIST = fortranio.GetFormatOfSection("%FLAG EXCLUDED_ATOMS_LIST");
-            if( fEXCLUDED_ATOMS_LIST == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG EXCLUDED_ATOMS_LIST section");
+        if( strcmp(p_sname,"%FLAG BOX_DIMENSIONS") == 0 ) {
+            fBOX_DIMENSIONS = fortranio.GetFormatOfSection("%FLAG BOX_DIMENSIONS");
+            if( fBOX_DIMENSIONS == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG BOX_DIMENSIONS section");
                 return(false);
             }
-            if( NonBondedList.LoadNATEX(p_top,fEXCLUDED_ATOMS_LIST) == false ) return(false);
-            continue;
+            if( BoxInfo.LoadBoxInfo(p_top,fBOX_DIMENSIONS) == false ) return(false);
+            return(true);
+        }
+    }
+
+    //-----------------------------------
+    // this is a new section in amber9
+    if( strcmp(p_sname,"%FLAG RADIUS_SET") == 0 ) {
+        fRADIUS_SET = fortranio.GetFormatOfSection("%FLAG RADIUS_SET");
+        if( fRADIUS_SET == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG RADIUS_SET section");
+            return(false);
+        }
+        if( AtomList.LoadAtomRadiusSet(p_top,fRADIUS_SET) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG RADII") == 0 ) {
+        fRADII = fortranio.GetFormatOfSection("%FLAG RADII");
+        if( fRADII == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG RADII section");
+            return(false);
+        }
+        if( AtomList.LoadAtomRadii(p_top,fRADII) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG SCREEN") == 0 ) {
+        fSCREEN = fortranio.GetFormatOfSection("%FLAG SCREEN");
+        if( fSCREEN == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG SCREEN section");
+            return(false);
+        }
+        if( AtomList.LoadAtomScreen(p_top,fSCREEN) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG IPOL") == 0 ) {
+        fIPOL = fortranio.GetFormatOfSection("%FLAG IPOL");
+        if( fIPOL == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG IPOL section");
+            return(false);
+        }
+        if( AtomList.LoadAtomIPol(p_top,fIPOL) == false ) return(false);
+        return(true);
+    }
+
+    //-----------------------------------
+    if( strcmp(p_sname,"%FLAG POL") == 0 ) {
+        fPOL = fortranio.GetFormatOfSection("%FLAG POL");
+        if( fPOL == NULL ) {
+            AMBER_LOAD_ERROR("unable to decode data format of %%FLAG POL section");
+            return(false);
         }
+        if( AtomList.LoadAtomPol(p_top,fPOL) == false ) return(false);
+        return(true);
+    }
 
+    if( AtomList.HasPertInfo() == true ) {
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG HBOND_ACOEF") == 0 ) {
-            fHBOND_ACOEF = fortranio.GetFormatOfSection("%FLAG HBOND_ACOEF");
-            if( fHBOND_ACOEF == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG HBOND_ACOEF section");
+        if( strcmp(p_sname,"%FLAG PERT_BOND_ATOMS") == 0 ) {
+            fPERT_BOND_ATOMS = fortranio.GetFormatOfSection("%FLAG PERT_BOND_ATOMS");
+            if( fPERT_BOND_ATOMS == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_BOND_ATOMS section");
                 return(false);
             }
-            if( NonBondedList.LoadASOL(p_top,fHBOND_ACOEF) == false ) return(false);
-            continue;
+            if( BondList.LoadPerturbedBonds(p_top,fPERT_BOND_ATOMS) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG HBOND_BCOEF") == 0 ) {
-            fHBOND_BCOEF = fortranio.GetFormatOfSection("%FLAG HBOND_BCOEF");
-            if( fHBOND_BCOEF == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG HBOND_BCOEF section");
+        if( strcmp(p_sname,"%FLAG PERT_BOND_PARAMS") == 0 ) {
+            fPERT_BOND_PARAMS = fortranio.GetFormatOfSection("%FLAG PERT_BOND_PARAMS");
+            if( fPERT_BOND_PARAMS == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_BOND_PARAMS section");
                 return(false);
             }
-            if( NonBondedList.LoadBSOL(p_top,fHBOND_BCOEF) == false ) return(false);
-            continue;
+            if( BondList.LoadPerturbedBondTypeIndexes(p_top,fPERT_BOND_PARAMS) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG HBCUT") == 0 ) {
-            fHBCUT = fortranio.GetFormatOfSection("%FLAG HBCUT");
-            if( fHBCUT == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG HBCUT section");
+        if( strcmp(p_sname,"%FLAG PERT_ANGLE_ATOMS") == 0 ) {
+            fPERT_ANGLE_ATOMS = fortranio.GetFormatOfSection("%FLAG PERT_ANGLE_ATOMS");
+            if( fPERT_ANGLE_ATOMS == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_ANGLE_ATOMS section");
                 return(false);
             }
-            if( NonBondedList.LoadHBCUT(p_top,fHBCUT) == false ) return(false);
-            continue;
+            if( AngleList.LoadPerturbedAngles(p_top,fPERT_ANGLE_ATOMS) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG AMBER_ATOM_TYPE") == 0 ) {
-            fAMBER_ATOM_TYPE = fortranio.GetFormatOfSection("%FLAG AMBER_ATOM_TYPE");
-            if( fAMBER_ATOM_TYPE == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG AMBER_ATOM_TYPE section");
+        if( strcmp(p_sname,"%FLAG PERT_ANGLE_PARAMS") == 0 ) {
+            fPERT_ANGLE_PARAMS = fortranio.GetFormatOfSection("%FLAG PERT_ANGLE_PARAMS");
+            if( fPERT_ANGLE_PARAMS == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_ANGLE_PARAMS section");
                 return(false);
             }
-            if( AtomList.LoadAtomISYMBL(p_top,fAMBER_ATOM_TYPE) == false ) return(false);
-            continue;
+            if( AngleList.LoadPerturbedAngleTypeIndexes(p_top,fPERT_ANGLE_PARAMS) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG TREE_CHAIN_CLASSIFICATION") == 0 ) {
-            fTREE_CHAIN_CLASSIFICATION = fortranio.GetFormatOfSection("%FLAG TREE_CHAIN_CLASSIFICATION");
-            if( fTREE_CHAIN_CLASSIFICATION == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG TREE_CHAIN_CLASSIFICATION section");
+        if( strcmp(p_sname,"%FLAG PERT_DIHEDRAL_ATOMS") == 0 ) {
+            fPERT_DIHEDRAL_ATOMS = fortranio.GetFormatOfSection("%FLAG PERT_DIHEDRAL_ATOMS");
+            if( fPERT_DIHEDRAL_ATOMS == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_DIHEDRAL_ATOMS section");
                 return(false);
             }
-            if( AtomList.LoadAtomITREE(p_top,fTREE_CHAIN_CLASSIFICATION) == false ) return(false);
-            continue;
+            if( DihedralList.LoadPerturbedDihedrals(p_top,fPERT_DIHEDRAL_ATOMS) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG JOIN_ARRAY") == 0 ) {
-            fJOIN_ARRAY = fortranio.GetFormatOfSection("%FLAG JOIN_ARRAY");
-            if( fJOIN_ARRAY == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG JOIN_ARRAY section");
+        if( strcmp(p_sname,"%FLAG PERT_DIHEDRAL_PARAMS") == 0 ) {
+            fPERT_DIHEDRAL_PARAMS = fortranio.GetFormatOfSection("%FLAG PERT_DIHEDRAL_PARAMS");
+            if( fPERT_DIHEDRAL_PARAMS == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_DIHEDRAL_PARAMS section");
                 return(false);
             }
-            if( AtomList.LoadAtomJOIN(p_top,fJOIN_ARRAY) == false ) return(false);
-            continue;
+            if( DihedralList.LoadPerturbedDihedralTypeIndexes(p_top,fPERT_DIHEDRAL_PARAMS) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG IROTAT") == 0 ) {
-            fIROTAT = fortranio.GetFormatOfSection("%FLAG IROTAT");
-            if( fIROTAT == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG IROTAT section");
+        if( strcmp(p_sname,"%FLAG PERT_RESIDUE_NAME") == 0 ) {
+            fPERT_RESIDUE_NAME = fortranio.GetFormatOfSection("%FLAG PERT_RESIDUE_NAME");
+            if( fPERT_RESIDUE_NAME == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_RESIDUE_NAME section");
                 return(false);
             }
-            if( AtomList.LoadAtomIROTAT(p_top,fIROTAT) == false ) return(false);
-            continue;
+            if( ResidueList.LoadResiduePertNames(p_top,fPERT_RESIDUE_NAME) == false ) return(false);
+            return(true);
         }
 
-        if( BoxInfo.GetType() != AMBER_BOX_NONE ) { // load box info
-
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG SOLVENT_POINTERS") == 0 ) {
-                fSOLVENT_POINTERS = fortranio.GetFormatOfSection("%FLAG SOLVENT_POINTERS");
-                if( fSOLVENT_POINTERS == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG SOLVENT_POINTERS section");
-                    return(false);
-                }
-                if( BoxInfo.LoadSolventPointers(p_top,fSOLVENT_POINTERS) == false ) return(false);
-                continue;
-            }
-
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG ATOMS_PER_MOLECULE") == 0 ) {
-                fATOMS_PER_MOLECULE = fortranio.GetFormatOfSection("%FLAG ATOMS_PER_MOLECULE");
-                if( fATOMS_PER_MOLECULE == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG ATOMS_PER_MOLECULE section");
-                    return(false);
-                }
-                if( BoxInfo.LoadNumsOfMolecules(p_top,fATOMS_PER_MOLECULE) == false ) return(false);
-                continue;
-            }
-
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG BOX_DIMENSIONS") == 0 ) {
-                fBOX_DIMENSIONS = fortranio.GetFormatOfSection("%FLAG BOX_DIMENSIONS");
-                if( fBOX_DIMENSIONS == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG BOX_DIMENSIONS section");
-                    return(false);
-                }
-                if( BoxInfo.LoadBoxInfo(p_top,fBOX_DIMENSIONS) == false ) return(false);
-                continue;
+        //-----------------------------------
+        if( strcmp(p_sname,"%FLAG PERT_ATOM_NAME") == 0 ) {
+            fPERT_ATOM_NAME = fortranio.GetFormatOfSection("%FLAG PERT_ATOM_NAME");
+            if( fPERT_ATOM_NAME == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_ATOM_NAME section");
+                return(false);
             }
+            if( AtomList.LoadPertAtomNames(p_top,fPERT_ATOM_NAME) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        // this is a new section in amber9
-        if( strcmp(p_sname,"%FLAG RADIUS_SET") == 0 ) {
-            fRADIUS_SET = fortranio.GetFormatOfSection("%FLAG RADIUS_SET");
-            if( fRADIUS_SET == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG RADIUS_SET section");
+        if( strcmp(p_sname,"%FLAG PERT_ATOM_SYMBOL") == 0 ) {
+            fPERT_ATOM_SYMBOL = fortranio.GetFormatOfSection("%FLAG PERT_ATOM_SYMBOL");
+            if( fPERT_ATOM_SYMBOL == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_ATOM_SYMBOL section");
                 return(false);
             }
-            if( AtomList.LoadAtomRadiusSet(p_top,fRADIUS_SET) == false ) return(false);
-            continue;
+            if( AtomList.LoadPertAtomISYMBL(p_top,fPERT_ATOM_SYMBOL) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG RADII") == 0 ) {
-            fRADII = fortranio.GetFormatOfSection("%FLAG RADII");
-            if( fRADII == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG RADII section");
+        if( strcmp(p_sname,"%FLAG ALMPER") == 0 ) {
+            fALMPER = fortranio.GetFormatOfSection("%FLAG ALMPER");
+            if( fALMPER == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG ALMPER section");
                 return(false);
             }
-            if( AtomList.LoadAtomRadii(p_top,fRADII) == false ) return(false);
-            continue;
+            if( AtomList.LoadPertAtomALMPER(p_top,fALMPER) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG SCREEN") == 0 ) {
-            fSCREEN = fortranio.GetFormatOfSection("%FLAG SCREEN");
-            if( fSCREEN == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG SCREEN section");
+        if( strcmp(p_sname,"%FLAG IAPER") == 0 ) {
+            fIAPER = fortranio.GetFormatOfSection("%FLAG IAPER");
+            if( fIAPER == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG IAPER section");
                 return(false);
             }
-            if( AtomList.LoadAtomScreen(p_top,fSCREEN) == false ) return(false);
-            continue;
+            if( AtomList.LoadPertAtomPertFlag(p_top,fIAPER) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG IPOL") == 0 ) {
-            fIPOL = fortranio.GetFormatOfSection("%FLAG IPOL");
-            if( fIPOL == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG IPOL section");
+        if( strcmp(p_sname,"%FLAG  PERT_ATOM_TYPE_INDEX") == 0 ) {
+            fPERT_ATOM_TYPE_INDEX = fortranio.GetFormatOfSection("%FLAG  PERT_ATOM_TYPE_INDEX");
+            if( fPERT_ATOM_TYPE_INDEX == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG  PERT_ATOM_TYPE_INDEX section");
                 return(false);
             }
-            if( AtomList.LoadAtomIPol(p_top,fIPOL) == false ) return(false);
-            continue;
+            if( AtomList.LoadPertAtomIAC(p_top,fPERT_ATOM_TYPE_INDEX) == false ) return(false);
+            return(true);
         }
 
         //-----------------------------------
-        if( strcmp(p_sname,"%FLAG POL") == 0 ) {
-            fPOL = fortranio.GetFormatOfSection("%FLAG POL");
-            if( fPOL == NULL ) {
-                ES_ERROR("unable to decode data format of %%FLAG POL section");
+        if( strcmp(p_sname,"%FLAG PERT_CHARGE") == 0 ) {
+            fPERT_CHARGE = fortranio.GetFormatOfSection("%FLAG PERT_CHARGE");
+            if( fPERT_CHARGE == NULL ) {
+                AMBER_LOAD_ERROR("unable to decode data format of %%FLAG PERT_CHARGE section");
                 return(false);
             }
-            if( AtomList.LoadAtomPol(p_top,fPOL) == false ) return(false);
-            continue;
+            if( AtomList.LoadPertAtomCharges(p_top,fPERT_CHARGE) == false ) return(false);
+            return(true);
         }
+    }
+    // section was not found
+    found = false;
+    return(true);
+}
 
-        if( AtomList.HasPertInfo() == true ) {
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_BOND_ATOMS") == 0 ) {
-                fPERT_BOND_ATOMS = fortranio.GetFormatOfSection("%FLAG PERT_BOND_ATOMS");
-                if( fPERT_BOND_ATOMS == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_BOND_ATOMS section");
-                    return(false);
-                }
-                if( BondList.LoadPerturbedBonds(p_top,fPERT_BOND_ATOMS) == false ) return(false);
-                continue;
-            }
+//------------------------------------------------------------------------------
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_BOND_PARAMS") == 0 ) {
-                fPERT_BOND_PARAMS = fortranio.GetFormatOfSection("%FLAG PERT_BOND_PARAMS");
-                if( fPERT_BOND_PARAMS == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_BOND_PARAMS section");
-                    return(false);
-                }
-                if( BondList.LoadPerturbedBondTypeIndexes(p_top,fPERT_BOND_PARAMS) == false ) return(false);
-                continue;
-            }
+class CAmberSectionOffset {
+public:
+    CSmallString    Name;       // section name as returned by GetNameOfSection()
+    long            Offset;     // position of the %FLAG line in the file
+    bool            Found;
+    bool            Result;
+    CAmberLoadErrors Errors;    // messages recorded during concurrent decoding
+};
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_ANGLE_ATOMS") == 0 ) {
-                fPERT_ANGLE_ATOMS = fortranio.GetFormatOfSection("%FLAG PERT_ANGLE_ATOMS");
-                if( fPERT_ANGLE_ATOMS == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_ANGLE_ATOMS section");
-                    return(false);
-                }
-                if( AngleList.LoadPerturbedAngles(p_top,fPERT_ANGLE_ATOMS) == false ) return(false);
-                continue;
-            }
+//------------------------------------------------------------------------------
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_ANGLE_PARAMS") == 0 ) {
-                fPERT_ANGLE_PARAMS = fortranio.GetFormatOfSection("%FLAG PERT_ANGLE_PARAMS");
-                if( fPERT_ANGLE_PARAMS == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_ANGLE_PARAMS section");
-                    return(false);
+bool CAmberTopology::LoadAmber7Parallel(const CSmallString& file_name,FILE* p_top)
+{
+    // locate all sections ----------------------------
+    vector<CAmberSectionOffset> sections;
+
+    char    buffer[256];
+    bool    line_start = true;
+    long    offset = ftell(p_top);
+
+    while( fgets(buffer,sizeof(buffer),p_top) != NULL ) {
+        if( line_start && (strncmp(buffer,"%FLAG",5) == 0) ) {
+            CAmberSectionOffset section;
+            int len = strlen(buffer);
+            while( (len > 0) && isspace(buffer[len-1]) ) len--;
+            buffer[len] = '\0';
+            section.Name = buffer;
+            section.Offset = offset;
+            section.Found = false;
+            section.Result = false;
+            for(unsigned int i=0; i < sections.size(); i++) {
+                if( sections[i].Name == section.Name ) {
+                    // the last occurence wins in the sequential mode, which cannot
+                    // be reproduced by concurrent decoding
+                    CSmallString warning;
+                    warning << "duplicit section '" << section.Name << "' in topology, parallel load disabled";
+                    ES_WARNING(warning);
+                    fseek(p_top,0,SEEK_SET);
+                    fgets(buffer,sizeof(buffer),p_top);     // skip %VERSION
+                    return(LoadAmber7(p_top));
                 }
-                if( AngleList.LoadPerturbedAngleTypeIndexes(p_top,fPERT_ANGLE_PARAMS) == false ) return(false);
-                continue;
             }
+            sections.push_back(section);
+        }
+        line_start = strchr(buffer,'\n') != NULL;
+        offset = ftell(p_top);
+    }
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_DIHEDRAL_ATOMS") == 0 ) {
-                fPERT_DIHEDRAL_ATOMS = fortranio.GetFormatOfSection("%FLAG PERT_DIHEDRAL_ATOMS");
-                if( fPERT_DIHEDRAL_ATOMS == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_DIHEDRAL_ATOMS section");
-                    return(false);
-                }
-                if( DihedralList.LoadPerturbedDihedrals(p_top,fPERT_DIHEDRAL_ATOMS) == false ) return(false);
-                continue;
-            }
+    // TITLE and POINTERS must be decoded first -------
+    // POINTERS allocates all lists and determines which optional sections are present
+    for(unsigned int i=0; i < sections.size(); i++) {
+        if( (sections[i].Name != "%FLAG TITLE") && (sections[i].Name != "%FLAG POINTERS") ) continue;
+        fseek(p_top,sections[i].Offset,SEEK_SET);
+        CFortranIO fortranio(p_top,true);
+        char* p_sname = fortranio.GetNameOfSection();
+        if( p_sname == NULL ) return(false);
+        if( LoadAmber7Section(p_top,fortranio,p_sname,sections[i].Found) == false ) return(false);
+        sections[i].Result = true;
+    }
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_DIHEDRAL_PARAMS") == 0 ) {
-                fPERT_DIHEDRAL_PARAMS = fortranio.GetFormatOfSection("%FLAG PERT_DIHEDRAL_PARAMS");
-                if( fPERT_DIHEDRAL_PARAMS == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_DIHEDRAL_PARAMS section");
-                    return(false);
-                }
-                if( DihedralList.LoadPerturbedDihedralTypeIndexes(p_top,fPERT_DIHEDRAL_PARAMS) == false ) return(false);
-                continue;
-            }
+    // remaining sections are independent -------------
+    // each section is decoded from its own file stream into disjoint data
+    int nsections = sections.size();
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_RESIDUE_NAME") == 0 ) {
-                fPERT_RESIDUE_NAME = fortranio.GetFormatOfSection("%FLAG PERT_RESIDUE_NAME");
-                if( fPERT_RESIDUE_NAME == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_RESIDUE_NAME section");
-                    return(false);
-                }
-                if( ResidueList.LoadResiduePertNames(p_top,fPERT_RESIDUE_NAME) == false ) return(false);
-                continue;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic,1) num_threads(NumOfLoadThreads)
+#endif
+    for(int i=0; i < nsections; i++) {
+        if( (sections[i].Name == "%FLAG TITLE") || (sections[i].Name == "%FLAG POINTERS") ) continue;
+        FILE* p_file = fopen(file_name,"r");
+        if( p_file == NULL ) continue;
+        // errors are not reported from workers but recorded for each section
+        sections[i].Errors.Activate();
+        if( fseek(p_file,sections[i].Offset,SEEK_SET) == 0 ) {
+            CFortranIO fortranio(p_file,true);
+            char* p_sname = fortranio.GetNameOfSection();
+            if( p_sname != NULL ) {
+                sections[i].Result = LoadAmber7Section(p_file,fortranio,p_sname,sections[i].Found);
             }
+        }
+        sections[i].Errors.Deactivate();
+        fclose(p_file);
+    }
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_ATOM_NAME") == 0 ) {
-                fPERT_ATOM_NAME = fortranio.GetFormatOfSection("%FLAG PERT_ATOM_NAME");
-                if( fPERT_ATOM_NAME == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_ATOM_NAME section");
-                    return(false);
-                }
-                if( AtomList.LoadPertAtomNames(p_top,fPERT_ATOM_NAME) == false ) return(false);
-                continue;
-            }
+    // report in the file order -----------------------
+    for(int i=0; i < nsections; i++) {
+        sections[i].Errors.Report();
+        if( sections[i].Result == false ) {
+            CSmallString error;
+            error << "unable to decode section '" << sections[i].Name << "'";
+            ES_ERROR(error);
+            return(false);
+        }
+        if( sections[i].Found == false ) {
+            CSmallString warning;
+            warning << "unrecognized section in topology '" << sections[i].Name << ";";
+            ES_WARNING(warning);
+        }
+    }
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_ATOM_SYMBOL") == 0 ) {
-                fPERT_ATOM_SYMBOL = fortranio.GetFormatOfSection("%FLAG PERT_ATOM_SYMBOL");
-                if( fPERT_ATOM_SYMBOL == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_ATOM_SYMBOL section");
-                    return(false);
-                }
-                if( AtomList.LoadPertAtomISYMBL(p_top,fPERT_ATOM_SYMBOL) == false ) return(false);
-                continue;
-            }
+    return(true);
+}
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG ALMPER") == 0 ) {
-                fALMPER = fortranio.GetFormatOfSection("%FLAG ALMPER");
-                if( fALMPER == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG ALMPER section");
-                    return(false);
-                }
-                if( AtomList.LoadPertAtomALMPER(p_top,fALMPER) == false ) return(false);
-                continue;
-            }
+//------------------------------------------------------------------------------
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG IAPER") == 0 ) {
-                fIAPER = fortranio.GetFormatOfSection("%FLAG IAPER");
-                if( fIAPER == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG IAPER section");
-                    return(false);
-                }
-                if( AtomList.LoadPertAtomPertFlag(p_top,fIAPER) == false ) return(false);
-                continue;
-            }
+class CAmberSectionGroup {
+public:
+    const char* Name;
+    int         Group;
+};
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG  PERT_ATOM_TYPE_INDEX") == 0 ) {
-                fPERT_ATOM_TYPE_INDEX = fortranio.GetFormatOfSection("%FLAG  PERT_ATOM_TYPE_INDEX");
-                if( fPERT_ATOM_TYPE_INDEX == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG  PERT_ATOM_TYPE_INDEX section");
-                    return(false);
-                }
-                if( AtomList.LoadPertAtomIAC(p_top,fPERT_ATOM_TYPE_INDEX) == false ) return(false);
-                continue;
-            }
+static const CAmberSectionGroup SectionGroups[] = {
+    {"%FLAG ATOM_NAME",                     AMBER_LOAD_ATOMS},
+    {"%FLAG CHARGE",                        AMBER_LOAD_ATOMS},
+    {"%FLAG ATOMIC_NUMBER",                 AMBER_LOAD_ATOMS},
+    {"%FLAG MASS",                          AMBER_LOAD_ATOMS},
+    {"%FLAG ATOM_TYPE_INDEX",               AMBER_LOAD_ATOMS},
+    {"%FLAG RESIDUE_LABEL",                 AMBER_LOAD_ATOMS},
+    {"%FLAG RESIDUE_POINTER",               AMBER_LOAD_ATOMS},
+    {"%FLAG AMBER_ATOM_TYPE",               AMBER_LOAD_ATOMS},
+    {"%FLAG TREE_CHAIN_CLASSIFICATION",     AMBER_LOAD_ATOMS},
+    {"%FLAG JOIN_ARRAY",                    AMBER_LOAD_ATOMS},
+    {"%FLAG IROTAT",                        AMBER_LOAD_ATOMS},
+    {"%FLAG IPOL",                          AMBER_LOAD_ATOMS},
+    {"%FLAG POL",                           AMBER_LOAD_ATOMS},
+
+    {"%FLAG BOND_FORCE_CONSTANT",           AMBER_LOAD_BONDED},
+    {"%FLAG BOND_EQUIL_VALUE",              AMBER_LOAD_BONDED},
+    {"%FLAG ANGLE_FORCE_CONSTANT",          AMBER_LOAD_BONDED},
+    {"%FLAG ANGLE_EQUIL_VALUE",             AMBER_LOAD_BONDED},
+    {"%FLAG DIHEDRAL_FORCE_CONSTANT",       AMBER_LOAD_BONDED},
+    {"%FLAG DIHEDRAL_PERIODICITY",          AMBER_LOAD_BONDED},
+    {"%FLAG DIHEDRAL_PHASE",                AMBER_LOAD_BONDED},
+    {"%FLAG SCEE_SCALE_FACTOR",             AMBER_LOAD_BONDED},
+    {"%FLAG SCNB_SCALE_FACTOR",             AMBER_LOAD_BONDED},
+    {"%FLAG BONDS_INC_HYDROGEN",            AMBER_LOAD_BONDED},
+    {"%FLAG BONDS_WITHOUT_HYDROGEN",        AMBER_LOAD_BONDED},
+    {"%FLAG ANGLES_INC_HYDROGEN",           AMBER_LOAD_BONDED},
+    {"%FLAG ANGLES_WITHOUT_HYDROGEN",       AMBER_LOAD_BONDED},
+    {"%FLAG DIHEDRALS_INC_HYDROGEN",        AMBER_LOAD_BONDED},
+    {"%FLAG DIHEDRALS_WITHOUT_HYDROGEN",    AMBER_LOAD_BONDED},
+
+    {"%FLAG NUMBER_EXCLUDED_ATOMS",         AMBER_LOAD_NONBONDED},
+    {"%FLAG NONBONDED_PARM_INDEX",          AMBER_LOAD_NONBONDED},
+    {"%FLAG SOLTY",                         AMBER_LOAD_NONBONDED},
+    {"%FLAG LENNARD_JONES_ACOEF",           AMBER_LOAD_NONBONDED},
+    {"%FLAG LENNARD_JONES_BCOEF",           AMBER_LOAD_NONBONDED},
+    {"%FLAG EXCLUDED_ATOMS_LIST",           AMBER_LOAD_NONBONDED},
+    {"%FLAG HBOND_ACOEF",                   AMBER_LOAD_NONBONDED},
+    {"%FLAG HBOND_BCOEF",                   AMBER_LOAD_NONBONDED},
+    {"%FLAG HBCUT",                         AMBER_LOAD_NONBONDED},
+
+    {"%FLAG SOLVENT_POINTERS",              AMBER_LOAD_BOX},
+    {"%FLAG ATOMS_PER_MOLECULE",            AMBER_LOAD_BOX},
+    // BOX_DIMENSIONS is always loaded, box type is given by POINTERS
+
+    {"%FLAG PERT_BOND_ATOMS",               AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_BOND_PARAMS",              AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_ANGLE_ATOMS",              AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_ANGLE_PARAMS",             AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_DIHEDRAL_ATOMS",           AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_DIHEDRAL_PARAMS",          AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_RESIDUE_NAME",             AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_ATOM_NAME",                AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_ATOM_SYMBOL",              AMBER_LOAD_PERTURBATION},
+    {"%FLAG ALMPER",                        AMBER_LOAD_PERTURBATION},
+    {"%FLAG IAPER",                         AMBER_LOAD_PERTURBATION},
+    {"%FLAG  PERT_ATOM_TYPE_INDEX",         AMBER_LOAD_PERTURBATION},
+    {"%FLAG PERT_CHARGE",                   AMBER_LOAD_PERTURBATION},
+
+    {"%FLAG RADIUS_SET",                    AMBER_LOAD_GBRADII},
+    {"%FLAG RADII",                         AMBER_LOAD_GBRADII},
+    {"%FLAG SCREEN",                        AMBER_LOAD_GBRADII},
+
+    {NULL,                                  0}
+};
 
-            //-----------------------------------
-            if( strcmp(p_sname,"%FLAG PERT_CHARGE") == 0 ) {
-                fPERT_CHARGE = fortranio.GetFormatOfSection("%FLAG PERT_CHARGE");
-                if( fPERT_CHARGE == NULL ) {
-                    ES_ERROR("unable to decode data format of %%FLAG PERT_CHARGE section");
-                    return(false);
-                }
-                if( AtomList.LoadPertAtomCharges(p_top,fPERT_CHARGE) == false ) return(false);
-                continue;
-            }
-        }
-        // section was not found
-        CSmallString warning;
-        warning << "unrecognized section in topology '" << p_sname << ";";
-        ES_WARNING(warning);
-    }
+//------------------------------------------------------------------------------
 
-    return(true);
+int CAmberTopology::GetSectionGroup(const char* p_sname)
+{
+    for(int i=0; SectionGroups[i].Name != NULL; i++) {
+        if( strcmp(p_sname,SectionGroups[i].Name) == 0 ) return(SectionGroups[i].Group);
+    }
+    // TITLE, POINTERS, and unknown sections are always processed
+    return(AMBER_LOAD_ALL);
 }
 
 //==============================================================================
@@ -1952,309 +2510,591 @@ bool CAmberTopology::SaveAmber7(FILE* p_top)
 
     //-----------------------------------
 
-    if( SaveSectionHeader(p_top,"TITLE",fTITLE) == false ) return(false);
-    CSmallString title = ITITL;
-    // trim from left
-    int last = title.Verify(" ",-1,-1,true);
-    if( last != -1 ){
-        title = title.GetSubStringFromTo(0,last);
+    vector<const char*> sections;
+    GetAmber7Sections(sections);
+
+    if( NumOfSaveThreads > 1 ) {
+        return(SaveAmber7Parallel(p_top,sections));
     }
-    if( title == NULL ) title = "default_title";
-    title.Substitute(' ','_');
-    if( (outputlen = fprintf(p_top,"%s",(const char*)title)) <= 0 ) {
-        ES_ERROR("unable write title");
-        return(false);
+
+    for(unsigned int i=0; i < sections.size(); i++) {
+        if( SaveAmber7Section(p_top,sections[i]) == false ) return(false);
     }
-    for(int i = outputlen; i < 80; i++) fputc(' ',p_top);
-    fputc('\n',p_top);
 
-    //-----------------------------------
+    return(true);
+}
 
-    if( SaveSectionHeader(p_top,"POINTERS",fPOINTERS) == false ) return(false);
-    if( SaveBasicInfo(p_top,fPOINTERS,AMBER_VERSION_7) == false ) return(false);
+//------------------------------------------------------------------------------
 
-    //-----------------------------------
+void CAmberTopology::GetAmber7Sections(std::vector<const char*>& sections)
+{
+    sections.clear();
+    sections.push_back("TITLE");
+    sections.push_back("POINTERS");
+    sections.push_back("ATOM_NAME");
+    sections.push_back("CHARGE");
+    if( AtomList.AtomicNumberLoaded ) sections.push_back("ATOMIC_NUMBER");
+    sections.push_back("MASS");
+    sections.push_back("ATOM_TYPE_INDEX");
+    sections.push_back("NUMBER_EXCLUDED_ATOMS");
+    sections.push_back("NONBONDED_PARM_INDEX");
+    sections.push_back("RESIDUE_LABEL");
+    sections.push_back("RESIDUE_POINTER");
+    sections.push_back("BOND_FORCE_CONSTANT");
+    sections.push_back("BOND_EQUIL_VALUE");
+    sections.push_back("ANGLE_FORCE_CONSTANT");
+    sections.push_back("ANGLE_EQUIL_VALUE");
+    sections.push_back("DIHEDRAL_FORCE_CONSTANT");
+    sections.push_back("DIHEDRAL_PERIODICITY");
+    sections.push_back("DIHEDRAL_PHASE");
+    if( DihedralList.SCEEFactorsLoaded ) sections.push_back("SCEE_SCALE_FACTOR");
+    if( DihedralList.SCNBFactorsLoaded ) sections.push_back("SCNB_SCALE_FACTOR");
+    sections.push_back("SOLTY");
+    sections.push_back("LENNARD_JONES_ACOEF");
+    sections.push_back("LENNARD_JONES_BCOEF");
+    sections.push_back("BONDS_INC_HYDROGEN");
+    sections.push_back("BONDS_WITHOUT_HYDROGEN");
+    sections.push_back("ANGLES_INC_HYDROGEN");
+    sections.push_back("ANGLES_WITHOUT_HYDROGEN");
+    sections.push_back("DIHEDRALS_INC_HYDROGEN");
+    sections.push_back("DIHEDRALS_WITHOUT_HYDROGEN");
+    sections.push_back("EXCLUDED_ATOMS_LIST");
+    sections.push_back("HBOND_ACOEF");
+    sections.push_back("HBOND_BCOEF");
+    sections.push_back("HBCUT");
+    sections.push_back("AMBER_ATOM_TYPE");
+    sections.push_back("TREE_CHAIN_CLASSIFICATION");
+    sections.push_back("JOIN_ARRAY");
+    sections.push_back("IROTAT");
 
-    if( SaveSectionHeader(p_top,"ATOM_NAME",fATOM_NAME) == false ) return(false);
-    if( AtomList.SaveAtomNames(p_top,fATOM_NAME) == false ) return(false);
+    if( BoxInfo.GetType() != AMBER_BOX_NONE ) {
+        sections.push_back("SOLVENT_POINTERS");
+        sections.push_back("ATOMS_PER_MOLECULE");
+        sections.push_back("BOX_DIMENSIONS");
+    }
 
-    //-----------------------------------
+    if( AtomList.RadiusSet != NULL ) sections.push_back("RADIUS_SET");
+    sections.push_back("RADII");
+    sections.push_back("SCREEN");
 
-    if( SaveSectionHeader(p_top,"CHARGE",fCHARGE) == false ) return(false);
-    if( AtomList.SaveAtomCharges(p_top,fCHARGE) == false ) return(false);
+    if( AtomList.HasPertInfo() == true ) {
+        sections.push_back("PERT_BOND_ATOMS");
+        sections.push_back("PERT_BOND_PARAMS");
+        sections.push_back("PERT_ANGLE_ATOMS");
+        sections.push_back("PERT_ANGLE_PARAMS");
+        sections.push_back("PERT_DIHEDRAL_ATOMS");
+        sections.push_back("PERT_DIHEDRAL_PARAMS");
+        sections.push_back("PERT_RESIDUE_NAME");
+        sections.push_back("PERT_ATOM_NAME");
+        sections.push_back("PERT_ATOM_SYMBOL");
+        sections.push_back("ALMPER");
+        sections.push_back("IAPER");
+        sections.push_back(" PERT_ATOM_TYPE_INDEX");
+        sections.push_back("PERT_CHARGE");
+    }
+}
 
-    //-----------------------------------
+//------------------------------------------------------------------------------
 
-    if( AtomList.AtomicNumberLoaded ){
-        if( SaveSectionHeader(p_top,"ATOMIC_NUMBER",fATOMIC_NUMBER) == false ) return(false);
-        if( AtomList.SaveAtomAtomicNumbers(p_top,fATOMIC_NUMBER) == false ) return(false);
+bool CAmberTopology::SaveAmber7Section(FILE* p_top,const char* p_sname)
+{
+    if( strcmp(p_sname,"TITLE") == 0 ) {
+        if( SaveSectionHeader(p_top,"TITLE",fTITLE) == false ) return(false);
+        int outputlen;
+        CSmallString title = ITITL;
+        // trim from left
+        int last = title.Verify(" ",-1,-1,true);
+        if( last != -1 ){
+            title = title.GetSubStringFromTo(0,last);
+        }
+        if( title == NULL ) title = "default_title";
+        title.Substitute(' ','_');
+        if( (outputlen = fprintf(p_top,"%s",(const char*)title)) <= 0 ) {
+            AMBER_LOAD_ERROR("unable write title");
+            return(false);
+        }
+        for(int i = outputlen; i < 80; i++) fputc(' ',p_top);
+        fputc('\n',p_top);
+        return(true);
     }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"MASS",fMASS) == false ) return(false);
-    if( AtomList.SaveAtomMasses(p_top,fMASS) == false ) return(false);
+    if( strcmp(p_sname,"POINTERS") == 0 ) {
+        if( SaveSectionHeader(p_top,"POINTERS",fPOINTERS) == false ) return(false);
+        if( SaveBasicInfo(p_top,fPOINTERS,AMBER_VERSION_7) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"ATOM_TYPE_INDEX",fATOM_TYPE_INDEX) == false ) return(false);
-    if( AtomList.SaveAtomIACs(p_top,fATOM_TYPE_INDEX) == false ) return(false);
+    if( strcmp(p_sname,"ATOM_NAME") == 0 ) {
+        if( SaveSectionHeader(p_top,"ATOM_NAME",fATOM_NAME) == false ) return(false);
+        if( AtomList.SaveAtomNames(p_top,fATOM_NAME) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"NUMBER_EXCLUDED_ATOMS",fNUMBER_EXCLUDED_ATOMS) == false ) return(false);
-    if( AtomList.SaveAtomNUMEXs(p_top,fNUMBER_EXCLUDED_ATOMS) == false ) return(false);
+    if( strcmp(p_sname,"CHARGE") == 0 ) {
+        if( SaveSectionHeader(p_top,"CHARGE",fCHARGE) == false ) return(false);
+        if( AtomList.SaveAtomCharges(p_top,fCHARGE) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"NONBONDED_PARM_INDEX",fNONBONDED_PARM_INDEX) == false ) return(false);
-    if( NonBondedList.SaveICOs(p_top,fNONBONDED_PARM_INDEX) == false ) return(false);
+    if( strcmp(p_sname,"ATOMIC_NUMBER") == 0 ) {
+        if( SaveSectionHeader(p_top,"ATOMIC_NUMBER",fATOMIC_NUMBER) == false ) return(false);
+        if( AtomList.SaveAtomAtomicNumbers(p_top,fATOMIC_NUMBER) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"RESIDUE_LABEL",fRESIDUE_LABEL) == false ) return(false);
-    if( ResidueList.SaveResidueNames(p_top,fRESIDUE_LABEL) == false ) return(false);
+    if( strcmp(p_sname,"MASS") == 0 ) {
+        if( SaveSectionHeader(p_top,"MASS",fMASS) == false ) return(false);
+        if( AtomList.SaveAtomMasses(p_top,fMASS) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"RESIDUE_POINTER",fRESIDUE_POINTER) == false ) return(false);
-    if( ResidueList.SaveResidueIPRES(p_top,&AtomList,fRESIDUE_POINTER) == false ) return(false);
+    if( strcmp(p_sname,"ATOM_TYPE_INDEX") == 0 ) {
+        if( SaveSectionHeader(p_top,"ATOM_TYPE_INDEX",fATOM_TYPE_INDEX) == false ) return(false);
+        if( AtomList.SaveAtomIACs(p_top,fATOM_TYPE_INDEX) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"BOND_FORCE_CONSTANT",fBOND_FORCE_CONSTANT) == false ) return(false);
-    if( BondList.SaveBondRK(p_top,fBOND_FORCE_CONSTANT) == false ) return(false);
+    if( strcmp(p_sname,"NUMBER_EXCLUDED_ATOMS") == 0 ) {
+        if( SaveSectionHeader(p_top,"NUMBER_EXCLUDED_ATOMS",fNUMBER_EXCLUDED_ATOMS) == false ) return(false);
+        if( AtomList.SaveAtomNUMEXs(p_top,fNUMBER_EXCLUDED_ATOMS) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"BOND_EQUIL_VALUE",fBOND_EQUIL_VALUE) == false ) return(false);
-    if( BondList.SaveBondREQ(p_top,fBOND_EQUIL_VALUE) == false ) return(false);
+    if( strcmp(p_sname,"NONBONDED_PARM_INDEX") == 0 ) {
+        if( SaveSectionHeader(p_top,"NONBONDED_PARM_INDEX",fNONBONDED_PARM_INDEX) == false ) return(false);
+        if( NonBondedList.SaveICOs(p_top,fNONBONDED_PARM_INDEX) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"ANGLE_FORCE_CONSTANT",fANGLE_FORCE_CONSTANT) == false ) return(false);
-    if( AngleList.SaveAngleTK(p_top,fANGLE_FORCE_CONSTANT) == false ) return(false);
+    if( strcmp(p_sname,"RESIDUE_LABEL") == 0 ) {
+        if( SaveSectionHeader(p_top,"RESIDUE_LABEL",fRESIDUE_LABEL) == false ) return(false);
+        if( ResidueList.SaveResidueNames(p_top,fRESIDUE_LABEL) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"ANGLE_EQUIL_VALUE",fANGLE_EQUIL_VALUE) == false ) return(false);
-    if( AngleList.SaveAngleTEQ(p_top,fANGLE_EQUIL_VALUE) == false ) return(false);
+    if( strcmp(p_sname,"RESIDUE_POINTER") == 0 ) {
+        if( SaveSectionHeader(p_top,"RESIDUE_POINTER",fRESIDUE_POINTER) == false ) return(false);
+        if( ResidueList.SaveResidueIPRES(p_top,&AtomList,fRESIDUE_POINTER) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
+    if( strcmp(p_sname,"BOND_FORCE_CONSTANT") == 0 ) {
+        if( SaveSectionHeader(p_top,"BOND_FORCE_CONSTANT",fBOND_FORCE_CONSTANT) == false ) return(false);
+        if( BondList.SaveBondRK(p_top,fBOND_FORCE_CONSTANT) == false ) return(false);
+        return(true);
+    }
 
-    if( SaveSectionHeader(p_top,"DIHEDRAL_FORCE_CONSTANT",fDIHEDRAL_FORCE_CONSTANT) == false ) return(false);
-    if( DihedralList.SaveDihedralPK(p_top,fDIHEDRAL_FORCE_CONSTANT) == false ) return(false);
+    //-----------------------------------
+    if( strcmp(p_sname,"BOND_EQUIL_VALUE") == 0 ) {
+        if( SaveSectionHeader(p_top,"BOND_EQUIL_VALUE",fBOND_EQUIL_VALUE) == false ) return(false);
+        if( BondList.SaveBondREQ(p_top,fBOND_EQUIL_VALUE) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
+    if( strcmp(p_sname,"ANGLE_FORCE_CONSTANT") == 0 ) {
+        if( SaveSectionHeader(p_top,"ANGLE_FORCE_CONSTANT",fANGLE_FORCE_CONSTANT) == false ) return(false);
+        if( AngleList.SaveAngleTK(p_top,fANGLE_FORCE_CONSTANT) == false ) return(false);
+        return(true);
+    }
 
-    if( SaveSectionHeader(p_top,"DIHEDRAL_PERIODICITY",fDIHEDRAL_PERIODICITY) == false ) return(false);
-    if( DihedralList.SaveDihedralPN(p_top,fDIHEDRAL_PERIODICITY) == false ) return(false);
+    //-----------------------------------
+    if( strcmp(p_sname,"ANGLE_EQUIL_VALUE") == 0 ) {
+        if( SaveSectionHeader(p_top,"ANGLE_EQUIL_VALUE",fANGLE_EQUIL_VALUE) == false ) return(false);
+        if( AngleList.SaveAngleTEQ(p_top,fANGLE_EQUIL_VALUE) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
+    if( strcmp(p_sname,"DIHEDRAL_FORCE_CONSTANT") == 0 ) {
+        if( SaveSectionHeader(p_top,"DIHEDRAL_FORCE_CONSTANT",fDIHEDRAL_FORCE_CONSTANT) == false ) return(false);
+        if( DihedralList.SaveDihedralPK(p_top,fDIHEDRAL_FORCE_CONSTANT) == false ) return(false);
+        return(true);
+    }
 
-    if( SaveSectionHeader(p_top,"DIHEDRAL_PHASE",fDIHEDRAL_PHASE) == false ) return(false);
-    if( DihedralList.SaveDihedralPHASE(p_top,fDIHEDRAL_PHASE) == false ) return(false);
+    //-----------------------------------
+    if( strcmp(p_sname,"DIHEDRAL_PERIODICITY") == 0 ) {
+        if( SaveSectionHeader(p_top,"DIHEDRAL_PERIODICITY",fDIHEDRAL_PERIODICITY) == false ) return(false);
+        if( DihedralList.SaveDihedralPN(p_top,fDIHEDRAL_PERIODICITY) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
+    if( strcmp(p_sname,"DIHEDRAL_PHASE") == 0 ) {
+        if( SaveSectionHeader(p_top,"DIHEDRAL_PHASE",fDIHEDRAL_PHASE) == false ) return(false);
+        if( DihedralList.SaveDihedralPHASE(p_top,fDIHEDRAL_PHASE) == false ) return(false);
+        return(true);
+    }
 
-    if( DihedralList.SCEEFactorsLoaded ){
+    //-----------------------------------
+    if( strcmp(p_sname,"SCEE_SCALE_FACTOR") == 0 ) {
         if( SaveSectionHeader(p_top,"SCEE_SCALE_FACTOR",fSCEE_SCALE_FACTOR) == false ) return(false);
         if( DihedralList.SaveDihedralSCEE(p_top,fSCEE_SCALE_FACTOR) == false ) return(false);
+        return(true);
     }
 
     //-----------------------------------
-
-    if( DihedralList.SCNBFactorsLoaded ){
+    if( strcmp(p_sname,"SCNB_SCALE_FACTOR") == 0 ) {
         if( SaveSectionHeader(p_top,"SCNB_SCALE_FACTOR",fSCNB_SCALE_FACTOR) == false ) return(false);
         if( DihedralList.SaveDihedralSCNB(p_top,fSCNB_SCALE_FACTOR) == false ) return(false);
+        return(true);
     }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"SOLTY",fSOLTY) == false ) return(false);
-    if( NonBondedList.SaveSOLTY(p_top,fSOLTY) == false ) return(false);
+    if( strcmp(p_sname,"SOLTY") == 0 ) {
+        if( SaveSectionHeader(p_top,"SOLTY",fSOLTY) == false ) return(false);
+        if( NonBondedList.SaveSOLTY(p_top,fSOLTY) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"LENNARD_JONES_ACOEF",fLENNARD_JONES_ACOEF) == false ) return(false);
-    if( NonBondedList.SaveCN1(p_top,fLENNARD_JONES_ACOEF) == false ) return(false);
+    if( strcmp(p_sname,"LENNARD_JONES_ACOEF") == 0 ) {
+        if( SaveSectionHeader(p_top,"LENNARD_JONES_ACOEF",fLENNARD_JONES_ACOEF) == false ) return(false);
+        if( NonBondedList.SaveCN1(p_top,fLENNARD_JONES_ACOEF) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"LENNARD_JONES_BCOEF",fLENNARD_JONES_BCOEF) == false ) return(false);
-    if( NonBondedList.SaveCN2(p_top,fLENNARD_JONES_BCOEF) == false ) return(false);
+    if( strcmp(p_sname,"LENNARD_JONES_BCOEF") == 0 ) {
+        if( SaveSectionHeader(p_top,"LENNARD_JONES_BCOEF",fLENNARD_JONES_BCOEF) == false ) return(false);
+        if( NonBondedList.SaveCN2(p_top,fLENNARD_JONES_BCOEF) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"BONDS_INC_HYDROGEN",fBONDS_INC_HYDROGEN) == false ) return(false);
-    if( BondList.SaveBondsWithHydrogens(p_top,fBONDS_INC_HYDROGEN) == false ) return(false);
+    if( strcmp(p_sname,"BONDS_INC_HYDROGEN") == 0 ) {
+        if( SaveSectionHeader(p_top,"BONDS_INC_HYDROGEN",fBONDS_INC_HYDROGEN) == false ) return(false);
+        if( BondList.SaveBondsWithHydrogens(p_top,fBONDS_INC_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"BONDS_WITHOUT_HYDROGEN",fBONDS_WITHOUT_HYDROGEN) == false ) return(false);
-    if( BondList.SaveBondsWithoutHydrogens(p_top,fBONDS_WITHOUT_HYDROGEN) == false ) return(false);
+    if( strcmp(p_sname,"BONDS_WITHOUT_HYDROGEN") == 0 ) {
+        if( SaveSectionHeader(p_top,"BONDS_WITHOUT_HYDROGEN",fBONDS_WITHOUT_HYDROGEN) == false ) return(false);
+        if( BondList.SaveBondsWithoutHydrogens(p_top,fBONDS_WITHOUT_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"ANGLES_INC_HYDROGEN",fANGLES_INC_HYDROGEN) == false ) return(false);
-    if( AngleList.SaveAnglesWithHydrogens(p_top,fANGLES_INC_HYDROGEN) == false ) return(false);
+    if( strcmp(p_sname,"ANGLES_INC_HYDROGEN") == 0 ) {
+        if( SaveSectionHeader(p_top,"ANGLES_INC_HYDROGEN",fANGLES_INC_HYDROGEN) == false ) return(false);
+        if( AngleList.SaveAnglesWithHydrogens(p_top,fANGLES_INC_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"ANGLES_WITHOUT_HYDROGEN",fANGLES_WITHOUT_HYDROGEN) == false ) return(false);
-    if( AngleList.SaveAnglesWithoutHydrogens(p_top,fANGLES_WITHOUT_HYDROGEN) == false ) return(false);
+    if( strcmp(p_sname,"ANGLES_WITHOUT_HYDROGEN") == 0 ) {
+        if( SaveSectionHeader(p_top,"ANGLES_WITHOUT_HYDROGEN",fANGLES_WITHOUT_HYDROGEN) == false ) return(false);
+        if( AngleList.SaveAnglesWithoutHydrogens(p_top,fANGLES_WITHOUT_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"DIHEDRALS_INC_HYDROGEN",fDIHEDRALS_INC_HYDROGEN) == false ) return(false);
-    if( DihedralList.SaveDihedralsWithHydrogens(p_top,fDIHEDRALS_INC_HYDROGEN) == false ) return(false);
+    if( strcmp(p_sname,"DIHEDRALS_INC_HYDROGEN") == 0 ) {
+        if( SaveSectionHeader(p_top,"DIHEDRALS_INC_HYDROGEN",fDIHEDRALS_INC_HYDROGEN) == false ) return(false);
+        if( DihedralList.SaveDihedralsWithHydrogens(p_top,fDIHEDRALS_INC_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"DIHEDRALS_WITHOUT_HYDROGEN",fDIHEDRALS_WITHOUT_HYDROGEN) == false ) return(false);
-    if( DihedralList.SaveDihedralsWithoutHydrogens(p_top,fDIHEDRALS_WITHOUT_HYDROGEN) == false ) return(false);
+    if( strcmp(p_sname,"DIHEDRALS_WITHOUT_HYDROGEN") == 0 ) {
+        if( SaveSectionHeader(p_top,"DIHEDRALS_WITHOUT_HYDROGEN",fDIHEDRALS_WITHOUT_HYDROGEN) == false ) return(false);
+        if( DihedralList.SaveDihedralsWithoutHydrogens(p_top,fDIHEDRALS_WITHOUT_HYDROGEN) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"EXCLUDED_ATOMS_LIST",fEXCLUDED_ATOMS_LIST) == false ) return(false);
-    if( NonBondedList.SaveNATEX(p_top,fEXCLUDED_ATOMS_LIST) == false ) return(false);
+    if( strcmp(p_sname,"EXCLUDED_ATOMS_LIST") == 0 ) {
+        if( SaveSectionHeader(p_top,"EXCLUDED_ATOMS_LIST",fEXCLUDED_ATOMS_LIST) == false ) return(false);
+        if( NonBondedList.SaveNATEX(p_top,fEXCLUDED_ATOMS_LIST) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"HBOND_ACOEF",fHBOND_ACOEF) == false ) return(false);
-    if( NonBondedList.SaveASOL(p_top,fHBOND_ACOEF) == false ) return(false);
+    if( strcmp(p_sname,"HBOND_ACOEF") == 0 ) {
+        if( SaveSectionHeader(p_top,"HBOND_ACOEF",fHBOND_ACOEF) == false ) return(false);
+        if( NonBondedList.SaveASOL(p_top,fHBOND_ACOEF) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"HBOND_BCOEF",fHBOND_BCOEF) == false ) return(false);
-    if( NonBondedList.SaveBSOL(p_top,fHBOND_BCOEF) == false ) return(false);
+    if( strcmp(p_sname,"HBOND_BCOEF") == 0 ) {
+        if( SaveSectionHeader(p_top,"HBOND_BCOEF",fHBOND_BCOEF) == false ) return(false);
+        if( NonBondedList.SaveBSOL(p_top,fHBOND_BCOEF) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"HBCUT",fHBCUT) == false ) return(false);
-    if( NonBondedList.SaveHBCUT(p_top,fHBCUT) == false ) return(false);
+    if( strcmp(p_sname,"HBCUT") == 0 ) {
+        if( SaveSectionHeader(p_top,"HBCUT",fHBCUT) == false ) return(false);
+        if( NonBondedList.SaveHBCUT(p_top,fHBCUT) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"AMBER_ATOM_TYPE",fAMBER_ATOM_TYPE) == false ) return(false);
-    if( AtomList.SaveAtomISYMBL(p_top,fAMBER_ATOM_TYPE) == false ) return(false);
+    if( strcmp(p_sname,"AMBER_ATOM_TYPE") == 0 ) {
+        if( SaveSectionHeader(p_top,"AMBER_ATOM_TYPE",fAMBER_ATOM_TYPE) == false ) return(false);
+        if( AtomList.SaveAtomISYMBL(p_top,fAMBER_ATOM_TYPE) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"TREE_CHAIN_CLASSIFICATION",fTREE_CHAIN_CLASSIFICATION) == false ) return(false);
-    if( AtomList.SaveAtomITREE(p_top,fTREE_CHAIN_CLASSIFICATION) == false ) return(false);
+    if( strcmp(p_sname,"TREE_CHAIN_CLASSIFICATION") == 0 ) {
+        if( SaveSectionHeader(p_top,"TREE_CHAIN_CLASSIFICATION",fTREE_CHAIN_CLASSIFICATION) == false ) return(false);
+        if( AtomList.SaveAtomITREE(p_top,fTREE_CHAIN_CLASSIFICATION) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"JOIN_ARRAY",fJOIN_ARRAY) == false ) return(false);
-    if( AtomList.SaveAtomJOIN(p_top,fJOIN_ARRAY) == false ) return(false);
+    if( strcmp(p_sname,"JOIN_ARRAY") == 0 ) {
+        if( SaveSectionHeader(p_top,"JOIN_ARRAY",fJOIN_ARRAY) == false ) return(false);
+        if( AtomList.SaveAtomJOIN(p_top,fJOIN_ARRAY) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"IROTAT",fIROTAT) == false ) return(false);
-    if( AtomList.SaveAtomIROTAT(p_top,fIROTAT) == false ) return(false);
+    if( strcmp(p_sname,"IROTAT") == 0 ) {
+        if( SaveSectionHeader(p_top,"IROTAT",fIROTAT) == false ) return(false);
+        if( AtomList.SaveAtomIROTAT(p_top,fIROTAT) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
-
-    if( BoxInfo.GetType() != AMBER_BOX_NONE ) { // load box info
-
+    if( strcmp(p_sname,"SOLVENT_POINTERS") == 0 ) {
         if( SaveSectionHeader(p_top,"SOLVENT_POINTERS",fSOLVENT_POINTERS) == false ) return(false);
         if( BoxInfo.SaveSolventPointers(p_top,fSOLVENT_POINTERS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"ATOMS_PER_MOLECULE") == 0 ) {
         if( SaveSectionHeader(p_top,"ATOMS_PER_MOLECULE",fATOMS_PER_MOLECULE) == false ) return(false);
         if( BoxInfo.SaveNumsOfMolecules(p_top,fATOMS_PER_MOLECULE) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"BOX_DIMENSIONS") == 0 ) {
         if( SaveSectionHeader(p_top,"BOX_DIMENSIONS",fBOX_DIMENSIONS) == false ) return(false);
         if( BoxInfo.SaveBoxInfo(p_top,fBOX_DIMENSIONS) == false ) return(false);
+        return(true);
     }
 
     //-----------------------------------
-
-    if( AtomList.RadiusSet != NULL ) {
+    if( strcmp(p_sname,"RADIUS_SET") == 0 ) {
         if( SaveSectionHeader(p_top,"RADIUS_SET",fRADIUS_SET) == false ) return(false);
         if( AtomList.SaveAtomRadiusSet(p_top,fRADIUS_SET) == false ) return(false);
+        return(true);
     }
 
-    if( SaveSectionHeader(p_top,"RADII",fRADII) == false ) return(false);
-    if( AtomList.SaveAtomRadii(p_top,fRADII) == false ) return(false);
-
     //-----------------------------------
-
-    if( SaveSectionHeader(p_top,"SCREEN",fSCREEN) == false ) return(false);
-    if( AtomList.SaveAtomScreen(p_top,fSCREEN) == false ) return(false);
+    if( strcmp(p_sname,"RADII") == 0 ) {
+        if( SaveSectionHeader(p_top,"RADII",fRADII) == false ) return(false);
+        if( AtomList.SaveAtomRadii(p_top,fRADII) == false ) return(false);
+        return(true);
+    }
 
     //-----------------------------------
+    if( strcmp(p_sname,"SCREEN") == 0 ) {
+        if( SaveSectionHeader(p_top,"SCREEN",fSCREEN) == false ) return(false);
+        if( AtomList.SaveAtomScreen(p_top,fSCREEN) == false ) return(false);
+        return(true);
+    }
 
-    if( AtomList.HasPertInfo() == true ) {
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_BOND_ATOMS") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_BOND_ATOMS",fPERT_BOND_ATOMS) == false ) return(false);
         if( BondList.SavePerturbedBonds(p_top,fPERT_BOND_ATOMS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_BOND_PARAMS") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_BOND_PARAMS",fPERT_BOND_PARAMS) == false ) return(false);
         if( BondList.SavePerturbedBondTypeIndexes(p_top,fPERT_BOND_PARAMS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_ANGLE_ATOMS") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_ANGLE_ATOMS",fPERT_ANGLE_ATOMS) == false ) return(false);
         if( AngleList.SavePerturbedAngles(p_top,fPERT_ANGLE_ATOMS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_ANGLE_PARAMS") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_ANGLE_PARAMS",fPERT_ANGLE_PARAMS) == false ) return(false);
         if( AngleList.SavePerturbedAngleTypeIndexes(p_top,fPERT_ANGLE_PARAMS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_DIHEDRAL_ATOMS") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_DIHEDRAL_ATOMS",fPERT_DIHEDRAL_ATOMS) == false ) return(false);
         if( DihedralList.SavePerturbedDihedrals(p_top,fPERT_DIHEDRAL_ATOMS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_DIHEDRAL_PARAMS") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_DIHEDRAL_PARAMS",fPERT_DIHEDRAL_PARAMS) == false ) return(false);
         if( DihedralList.SavePerturbedDihedralTypeIndexes(p_top,fPERT_DIHEDRAL_PARAMS) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_RESIDUE_NAME") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_RESIDUE_NAME",fPERT_RESIDUE_NAME) == false ) return(false);
         if( ResidueList.SaveResiduePertNames(p_top,fPERT_RESIDUE_NAME) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_ATOM_NAME") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_ATOM_NAME",fPERT_ATOM_NAME) == false ) return(false);
         if( AtomList.SavePertAtomNames(p_top,fPERT_ATOM_NAME) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_ATOM_SYMBOL") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_ATOM_SYMBOL",fPERT_ATOM_SYMBOL) == false ) return(false);
         if( AtomList.SavePertAtomISYMBL(p_top,fPERT_ATOM_SYMBOL) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"ALMPER") == 0 ) {
         if( SaveSectionHeader(p_top,"ALMPER",fALMPER) == false ) return(false);
         if( AtomList.SavePertAtomALMPER(p_top,fALMPER) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"IAPER") == 0 ) {
         if( SaveSectionHeader(p_top,"IAPER",fIAPER) == false ) return(false);
         if( AtomList.SavePertAtomPertFlag(p_top,fIAPER) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname," PERT_ATOM_TYPE_INDEX") == 0 ) {
         if( SaveSectionHeader(p_top," PERT_ATOM_TYPE_INDEX",fPERT_ATOM_TYPE_INDEX) == false ) return(false);
         if( AtomList.SavePertAtomIAC(p_top,fPERT_ATOM_TYPE_INDEX) == false ) return(false);
+        return(true);
+    }
 
-        //-----------------------------------
-
+    //-----------------------------------
+    if( strcmp(p_sname,"PERT_CHARGE") == 0 ) {
         if( SaveSectionHeader(p_top,"PERT_CHARGE",fPERT_CHARGE) == false ) return(false);
         if( AtomList.SavePertAtomCharges(p_top,fPERT_CHARGE) == false ) return(false);
+        return(true);
     }
 
-    return(true);
+    //-----------------------------------
+    CSmallString error;
+    error << "unsupported section '" << p_sname << "'";
+    AMBER_LOAD_ERROR(error);
+    return(false);
+}
+
+//------------------------------------------------------------------------------
+
+class CAmberSectionBuffer {
+public:
+    FILE*               File;
+    char*               Data;
+    size_t              Size;
+    bool                Result;
+    CAmberLoadErrors    Errors;     // messages recorded during concurrent formatting
+};
+
+//------------------------------------------------------------------------------
+
+bool CAmberTopology::SaveAmber7Parallel(FILE* p_top,const std::vector<const char*>& sections)
+{
+    int                         nsections = sections.size();
+    vector<CAmberSectionBuffer> buffers(nsections);
+
+    for(int i=0; i < nsections; i++) {
+        buffers[i].File = NULL;
+        buffers[i].Data = NULL;
+        buffers[i].Size = 0;
+        buffers[i].Result = false;
+    }
+
+    // each section is formatted into its own memory stream
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic,1) num_threads(NumOfSaveThreads)
+#endif
+    for(int i=0; i < nsections; i++) {
+#ifdef UNIX
+        buffers[i].File = open_memstream(&buffers[i].Data,&buffers[i].Size);
+#else
+        buffers[i].File = tmpfile();
+#endif
+        if( buffers[i].File == NULL ) continue;
+        buffers[i].Errors.Activate();
+        buffers[i].Result = SaveAmber7Section(buffers[i].File,sections[i]);
+        buffers[i].Errors.Deactivate();
+#ifdef UNIX
+        // data and size are valid after the stream is closed
+        fclose(buffers[i].File);
+        buffers[i].File = NULL;
+#endif
+    }
+
+    // concatenate sections and report errors in the topology order
+    bool result = true;
+    for(int i=0; i < nsections; i++) {
+        if( result == true ) {
+            buffers[i].Errors.Report();
+            if( buffers[i].Result == false ) {
+                CSmallString error;
+                error << "unable to format section '" << sections[i] << "'";
+                ES_ERROR(error);
+                result = false;
+            }
+        }
+#ifdef UNIX
+        if( (result == true) && (buffers[i].Size > 0) ) {
+            if( fwrite(buffers[i].Data,1,buffers[i].Size,p_top) != buffers[i].Size ) {
+                ES_ERROR("unable to write section data");
+                result = false;
+            }
+        }
+        if( buffers[i].Data != NULL ) free(buffers[i].Data);
+#else
+        if( buffers[i].File == NULL ) continue;
+        if( result == true ) {
+            char    data[65536];
+            size_t  len;
+            rewind(buffers[i].File);
+            while( (len = fread(data,1,sizeof(data),buffers[i].File)) > 0 ) {
+                if( fwrite(data,1,len,p_top) != len ) {
+                    ES_ERROR("unable to write section data");
+                    result = false;
+                    break;
+                }
+            }
+        }
+        fclose(buffers[i].File);
+#endif
+    }
+
+    return(result);
 }
 
 //==============================================================================
@@ -2269,7 +3109,7 @@ bool CAmberTopology::SaveSectionHeader(FILE* p_top,const char* p_section_name,
     if( (outputlen = fprintf(p_top,"%%FLAG %s",p_section_name)) <= 0 ) {
         CSmallString    error;
         error << "unable write header of %%FLAG " << p_section_name << " section";
-        ES_ERROR(error);
+        AMBER_LOAD_ERROR(error);
         return(false);
     }
 
@@ -2279,7 +3119,7 @@ bool CAmberTopology::SaveSectionHeader(FILE* p_top,const char* p_section_name,
     if( (outputlen = fprintf(p_top,"%%FORMAT(%s)",(char*)p_section_format)) <= 0 ) {
         CSmallString    error;
         error << "unable write format of %%FLAG " << p_section_name << " section";
-        ES_ERROR(error);
+        AMBER_LOAD_ERROR(error);
         return(false);
     }
 
@@ -2496,6 +3336,32 @@ bool CAmberTopology::LoadBasicInfo(FILE* p_top,const char* p_format,EAmberVersio
         }
     }
 
+    // AMBER 6 topology is read strictly sequentially - all data must be loaded
+    if( version == AMBER_VERSION_6 ) {
+        LoadedParts = AMBER_LOAD_ALL;
+    } else {
+        LoadedParts = LoadOptions;
+    }
+
+    // skipped groups are not allocated
+    if( (LoadedParts & AMBER_LOAD_PERTURBATION) == 0 ) {
+        IFPERT = 0;
+        NBPER = 0;
+        NGPER = 0;
+        NDPER = 0;
+        MBPER = 0;
+        MGPER = 0;
+        MDPER = 0;
+    }
+    if( (LoadedParts & AMBER_LOAD_BONDED) == 0 ) {
+        NBONH = MBONA = NUMBND = NBONA = NBPER = MBPER = 0;
+        NTHETH = MTHETA = NUMANG = NTHETA = NGPER = MGPER = 0;
+        NPHIH = MPHIA = NPTRA = NPHIA = NDPER = MDPER = 0;
+    }
+    if( (LoadedParts & AMBER_LOAD_NONBONDED) == 0 ) {
+        NTYPES = NEXT = NATYP = NPHB = 0;
+    }
+
     // init all fields
     AtomList.InitFields(NATOM,IFPERT,IFPOL,NUMEXTRA);
     ResidueList.InitFields(NRES,NMXRS);
@@ -2513,173 +3379,173 @@ bool CAmberTopology::LoadBasicInfo(FILE* p_top,const char* p_format,EAmberVersio
 
 bool CAmberTopology::SaveBasicInfo(FILE* p_top,const char* p_format,EAmberVersion version)
 {
-    CFortranIO fortranio(p_top);
+    CAmberFortranWriter fortranio(p_top);
     fortranio.SetFormat(p_format);
 
     if( fortranio.WriteInt(AtomList.NATOM) == false ) {
-        ES_ERROR("unable save NATOM item");
+        AMBER_LOAD_ERROR("unable save NATOM item");
         return(false);
     }
 
     if( fortranio.WriteInt(NonBondedList.NTYPES) == false ) {
-        ES_ERROR("unable save NTYPES item");
+        AMBER_LOAD_ERROR("unable save NTYPES item");
         return(false);
     }
 
     if( fortranio.WriteInt(BondList.NBONH) == false ) {
-        ES_ERROR("unable save NBONH item");
+        AMBER_LOAD_ERROR("unable save NBONH item");
         return(false);
     }
 
     if( fortranio.WriteInt(BondList.MBONA) == false ) {
-        ES_ERROR("unable save MBONA item");
+        AMBER_LOAD_ERROR("unable save MBONA item");
         return(false);
     }
 
     if( fortranio.WriteInt(AngleList.NTHETH) == false ) {
-        ES_ERROR("unable save NTHETH item");
+        AMBER_LOAD_ERROR("unable save NTHETH item");
         return(false);
     }
 
     if( fortranio.WriteInt(AngleList.MTHETA) == false ) {
-        ES_ERROR("unable save MTHETA item");
+        AMBER_LOAD_ERROR("unable save MTHETA item");
         return(false);
     }
 
     if( fortranio.WriteInt(DihedralList.NPHIH) == false ) {
-        ES_ERROR("unable save NPHIH item");
+        AMBER_LOAD_ERROR("unable save NPHIH item");
         return(false);
     }
 
     if( fortranio.WriteInt(DihedralList.MPHIA) == false ) {
-        ES_ERROR("unable save MPHIA item");
+        AMBER_LOAD_ERROR("unable save MPHIA item");
         return(false);
     }
 
     if( fortranio.WriteInt(NHPARM) == false ) {
-        ES_ERROR("unable save NHPARM item");
+        AMBER_LOAD_ERROR("unable save NHPARM item");
         return(false);
     }
 
     if( fortranio.WriteInt(NPARM) == false ) {
-        ES_ERROR("unable save NPARM item");
+        AMBER_LOAD_ERROR("unable save NPARM item");
         return(false);
     }
 
     if( fortranio.WriteInt(NonBondedList.NEXT) == false ) {
-        ES_ERROR("unable save NEXT item");
+        AMBER_LOAD_ERROR("unable save NEXT item");
         return(false);
     }
 
     if( fortranio.WriteInt(ResidueList.NRES) == false ) {
-        ES_ERROR("unable save NRES item");
+        AMBER_LOAD_ERROR("unable save NRES item");
         return(false);
     }
 
     if( fortranio.WriteInt(BondList.NBONA) == false ) {
-        ES_ERROR("unable save NBONA item");
+        AMBER_LOAD_ERROR("unable save NBONA item");
         return(false);
     }
 
     if( fortranio.WriteInt(AngleList.NTHETA) == false ) {
-        ES_ERROR("unable save NTHETA item");
+        AMBER_LOAD_ERROR("unable save NTHETA item");
         return(false);
     }
 
     if( fortranio.WriteInt(DihedralList.NPHIA) == false ) {
-        ES_ERROR("unable save NPHIA item");
+        AMBER_LOAD_ERROR("unable save NPHIA item");
         return(false);
     }
 
     if( fortranio.WriteInt(BondList.NUMBND) == false ) {
-        ES_ERROR("unable save NUMBND item");
+        AMBER_LOAD_ERROR("unable save NUMBND item");
         return(false);
     }
 
     if( fortranio.WriteInt(AngleList.NUMANG) == false ) {
-        ES_ERROR("unable save NUMANG item");
+        AMBER_LOAD_ERROR("unable save NUMANG item");
         return(false);
     }
 
     if( fortranio.WriteInt(DihedralList.NPTRA) == false ) {
-        ES_ERROR("unable save NPTRA item");
+        AMBER_LOAD_ERROR("unable save NPTRA item");
         return(false);
     }
 
     if( fortranio.WriteInt(NonBondedList.NATYP) == false ) {
-        ES_ERROR("unable save NATYP item");
+        AMBER_LOAD_ERROR("unable save NATYP item");
         return(false);
     }
 
     if( fortranio.WriteInt(NonBondedList.NPHB) == false ) {
-        ES_ERROR("unable save NPHB item");
+        AMBER_LOAD_ERROR("unable save NPHB item");
         return(false);
     }
 
     if( fortranio.WriteInt(AtomList.IFPERT) == false ) {
-        ES_ERROR("unable save IFPERT item");
+        AMBER_LOAD_ERROR("unable save IFPERT item");
         return(false);
     }
 
     if( fortranio.WriteInt(BondList.NBPER) == false ) {
-        ES_ERROR("unable save NBPER item");
+        AMBER_LOAD_ERROR("unable save NBPER item");
         return(false);
     }
 
     if( fortranio.WriteInt(AngleList.NGPER) == false ) {
-        ES_ERROR("unable save NGPER item");
+        AMBER_LOAD_ERROR("unable save NGPER item");
         return(false);
     }
 
     if( fortranio.WriteInt(DihedralList.NDPER) == false ) {
-        ES_ERROR("unable save NDPER item");
+        AMBER_LOAD_ERROR("unable save NDPER item");
         return(false);
     }
 
     if( fortranio.WriteInt(BondList.MBPER) == false ) {
-        ES_ERROR("unable save MBPER item");
+        AMBER_LOAD_ERROR("unable save MBPER item");
         return(false);
     }
 
     if( fortranio.WriteInt(AngleList.MGPER) == false ) {
-        ES_ERROR("unable save MGPER item");
+        AMBER_LOAD_ERROR("unable save MGPER item");
         return(false);
     }
 
     if( fortranio.WriteInt(DihedralList.MDPER) == false ) {
-        ES_ERROR("unable save MDPER item");
+        AMBER_LOAD_ERROR("unable save MDPER item");
         return(false);
     }
 
     if( fortranio.WriteInt(BoxInfo.IFBOX) == false ) {
-        ES_ERROR("unable save IFBOX item");
+        AMBER_LOAD_ERROR("unable save IFBOX item");
         return(false);
     }
 
     if( fortranio.WriteInt(ResidueList.NMXRS) == false ) {
-        ES_ERROR("unable save NMXRS item");
+        AMBER_LOAD_ERROR("unable save NMXRS item");
         return(false);
     }
 
     if( fortranio.WriteInt(CapInfo.IFCAP) == false ) {
-        ES_ERROR("unable save IFCAP item");
+        AMBER_LOAD_ERROR("unable save IFCAP item");
         return(false);
     }
 
     if( version != AMBER_VERSION_6 ) {
         if( fortranio.WriteInt(AtomList.NUMEXTRA) == false ) {
-            ES_ERROR("unable save NUMEXTRA item");
+            AMBER_LOAD_ERROR("unable save NUMEXTRA item");
             return(false);
         }
         if( NCOPY_Read ) {
             if( fortranio.WriteInt(NCOPY) == false ) {
-                ES_ERROR("unable save NCOPY item");
+                AMBER_LOAD_ERROR("unable save NCOPY item");
                 return(false);
             }
         }
     }
 
-    fortranio.WriteEndOfSection();
+    if( fortranio.WriteEndOfSection() == false ) return(false);
 
     return(true);
 }
@@ -23,6 +23,7 @@
 // =============================================================================
 
 #include <stdio.h>
+#include <stdint.h>
 #include <ASLMainHeader.hpp>
 #include <SmallString.hpp>
 #include <AmberAtomList.hpp>
@@ -33,6 +34,12 @@
 #include <AmberNonBondedList.hpp>
 #include <AmberBox.hpp>
 #include <AmberCap.hpp>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+class CFortranIO;
+class CAmberCacheReader;
 
 //---------------------------------------------------------------------------
 
@@ -46,6 +53,84 @@ enum EAmberVersion {
 
 //---------------------------------------------------------------------------
 
+/// groups of topology sections, which can be selectively loaded
+
+enum EAmberLoadOptions {
+    AMBER_LOAD_ATOMS        = 0x0001,   // atoms and residues
+    AMBER_LOAD_BONDED       = 0x0002,   // bonds, angles, dihedrals
+    AMBER_LOAD_NONBONDED    = 0x0004,   // LJ tables, exclusions, hbond terms
+    AMBER_LOAD_BOX          = 0x0008,   // solvent pointers, molecules (box dimensions are always loaded)
+    AMBER_LOAD_PERTURBATION = 0x0010,   // perturbation sections
+    AMBER_LOAD_GBRADII      = 0x0020,   // radius set, radii, screen
+    AMBER_LOAD_ALL          = 0x003F
+};
+
+//---------------------------------------------------------------------------
+
+/// 128-bit content hash of topology
+
+class ASL_PACKAGE CAmberContentHash {
+public:
+    CAmberContentHash(void);
+
+    /// compare two hashes
+    bool operator == (const CAmberContentHash& right) const;
+    bool operator != (const CAmberContentHash& right) const;
+
+    /// is hash ordered before right? (to be used as a key in sorted containers)
+    bool operator < (const CAmberContentHash& right) const;
+
+    /// return hash as 32 hexadecimal digits
+    const CSmallString GetString(void) const;
+
+public:
+    uint64_t    H1;
+    uint64_t    H2;
+};
+
+//---------------------------------------------------------------------------
+
+/// inverted index from four-character names to item indexes
+
+/*! names are packed into 32-bit keys (the first character in the most
+    significant byte), thus the order of keys is the order of names and all
+    names with a common prefix form a continuous range of keys; items are
+    stored in CSR form (offsets into list of items sorted by keys)
+*/
+
+class ASL_PACKAGE CAmberNameIndex {
+public:
+    CAmberNameIndex(void);
+
+    /// build index from names of nitems items
+    void Build(const char** p_names,int nitems);
+
+    /// free index
+    void Free(void);
+
+    /// is index built?
+    bool IsBuilt(void) const;
+
+    /// return items whose names match first len characters of p_name
+    /*! items of all matching names are returned as one continuous list,
+        count is set to the length of the list, NULL is returned if
+        there is no match
+    */
+    const int* Find(const char* p_name,int len,int& count) const;
+
+    /// pack first len characters of name into key
+    static uint32_t MakeKey(const char* p_name,int len=4);
+
+// section of private data ----------------------------------------------------
+private:
+    bool                    Built;
+    std::vector<uint32_t>   Keys;       // sorted unique keys
+    std::vector<int>        Offsets;    // Keys.size()+1 items
+    std::vector<int>        Items;      // items grouped by keys
+};
+
+//---------------------------------------------------------------------------
+
 /// topology description
 
 class ASL_PACKAGE CAmberTopology {
@@ -59,6 +144,56 @@ public:
     /// load topology from a file stream
     bool Load(FILE* p_fin);
 
+    /// set groups of sections that are loaded (EAmberLoadOptions)
+    /*! Sections of skipped groups are not decoded and corresponding lists
+        are not allocated. POINTERS and BOX_DIMENSIONS are always loaded.
+        Options are applied only to AMBER 7 topologies, AMBER 6 topologies
+        are always loaded completely. Partially loaded topology cannot be
+        saved nor used as a source of sub-topology.
+    */
+    void SetLoadOptions(int options);
+
+    /// get groups of sections that are loaded by Load()
+    int GetLoadOptions(void);
+
+    /// get groups of sections that were actually loaded
+    int GetLoadedParts(void);
+
+    /// set number of threads used to decode sections of AMBER 7 topology
+    /*! Sections are decoded concurrently only if the topology is loaded
+        by its name (stdin and file streams are always read sequentially).
+        The resulting topology is identical to the sequential load.
+    */
+    void SetNumberOfLoadThreads(int nthreads);
+
+    /// get number of threads used to decode sections of AMBER 7 topology
+    int GetNumberOfLoadThreads(void);
+
+    /// set number of threads used to format sections of AMBER 7 topology
+    /*! Sections are formatted concurrently into memory buffers, which are
+        written in the topology order. The output is identical to the sequential save.
+    */
+    void SetNumberOfSaveThreads(int nthreads);
+
+    /// get number of threads used to format sections of AMBER 7 topology
+    int GetNumberOfSaveThreads(void);
+
+    /// save binary cache of topology
+    /*! the fingerprint of source_name (the topology file the data were
+        loaded from) is stored in the cache and it is used to validate the cache
+        during its load
+    */
+    bool SaveCache(const CSmallString& cache_name,const CSmallString& source_name);
+
+    /// load topology from binary cache
+    /*! false is returned if the cache does not exist, it is corrupted or
+        it does not correspond to the content of source_name
+    */
+    bool LoadCache(const CSmallString& cache_name,const CSmallString& source_name);
+
+    /// load topology via binary cache, the cache is (re)created if it is not valid
+    bool LoadWithCache(const CSmallString& file_name,const CSmallString& cache_name);
+
     /// load fake topology, if allow_stdin==true then file_name == '-' means stdin
     bool LoadFakeTopologyFromPDB(const CSmallString& file_name,bool mangle_names,bool allow_stdin=false);
 
@@ -104,11 +239,71 @@ public:
     bool InitResidueNumOfBondsWithHydrogen(void);
 
     /// init id of molecules for individual atoms, it is not influenced by informations in BoxInfo
+    /*! molecules are detected in linear time from bonds, the method also
+        prepares list of molecules (see GetNumberOfMolecules)
+    */
     bool InitMoleculeIndexes(void);
 
+    /// return number of molecules detected by InitMoleculeIndexes
+    int GetNumberOfMolecules(void);
+
+    /// return index of the first atom of molecule
+    /*! molecules are ordered by their first atoms, mol is counted from zero
+    */
+    int GetMoleculeFirstAtom(int mol);
+
+    /// return index of the last atom of molecule
+    int GetMoleculeLastAtom(int mol);
+
+    /// return number of atoms in molecule
+    int GetMoleculeNumberOfAtoms(int mol);
+
+    /// return true if atoms of molecule form continuous range
+    bool IsMoleculeContinuous(int mol);
+
+    /// compare detected molecules with NSPM/NSP from BoxInfo
+    bool CheckMoleculesWithBox(void);
+
     /// build list of neighbour atoms
+    /*! neighbours are stored in compressed sparse row form (offsets into
+        sorted list of bonded partners), the list is built in one pass over
+        BondList and must be rebuilt (or freed) if bonds are changed
+    */
     void BuidListOfNeighbourAtoms(void);
 
+    /// free list of neighbour atoms
+    void FreeListOfNeighbourAtoms(void);
+
+    /// return sorted list of atoms bonded to atom ai
+    /*! the list of neighbour atoms is built on the first call, count is set
+        to the length of the list, NULL is returned for an empty list
+    */
+    const int* GetNeighbourAtoms(int ai,int& count);
+
+    /// return all pairs of atoms separated by at most nbonds bonds
+    /*! pairs are returned as ai < aj ordered by ai, dist contains the number
+        of bonds on the shortest path between atoms (1 - 1-2, 2 - 1-3,
+        3 - 1-4 pairs), each atom is searched only up to nbonds bonds
+    */
+    bool GetBondedPairs(int nbonds,std::vector<int>& ai,
+                        std::vector<int>& aj,std::vector<int>& dist);
+
+    /// return number of bonds on the shortest path between two atoms
+    /*! -1 is returned if atoms are not connected or if the path is longer
+        than maxdist (negative maxdist means unlimited search)
+    */
+    int GetBondedDistance(int ai,int aj,int maxdist=-1);
+
+    /// split atoms into rigid fragments separated by rotatable bonds
+    /*! rotatable bond is a bond that is not a part of any ring and that
+        connects two non-terminal atoms (bond orders are not available in
+        topology thus double bonds are also considered to be rotatable),
+        fragments contains fragment index for each atom, rotatable bonds are
+        returned as rb_ai < rb_aj pairs, the number of fragments is returned
+    */
+    int GetRigidFragments(std::vector<int>& fragments,
+                          std::vector<int>& rb_ai,std::vector<int>& rb_aj);
+
     /// overload assigment operator
     void operator = (const CAmberTopology& src);
     
@@ -116,8 +311,64 @@ public:
     double GetTotalMass(void);
 
     /// is NB couple excluded?
+    /*! the query uses exclusion index, which is built on the first call
+    */
     bool IsNBPairExcluded(int ai,int aj);
 
+    /// build index of excluded atoms (CSR offsets into sorted NATEX)
+    /*! the index must be rebuilt (or freed) if NUMEX or NATEX are changed,
+        it should be built in advance if IsNBPairExcluded is called
+        from several threads
+    */
+    bool BuildExclusionIndex(void);
+
+    /// free index of excluded atoms
+    void FreeExclusionIndex(void);
+
+    /// return sorted list of atoms excluded with atom ai
+    /*! only partners listed for ai in NATEX are returned (AMBER stores each
+        pair once for the atom with the lower index), count is set to the
+        length of the list, NULL is returned for an empty list
+    */
+    const int* GetExcludedAtoms(int ai,int& count);
+
+    /// return 128-bit hash of topology content
+    /*! the hash covers atoms, residues, bonded terms, nonbonded tables and
+        molecule layout of the box; title, section formats, and box
+        dimensions are not included, thus topologies that differ only
+        in the formatting of numbers have the same hash; the hash
+        is independent of the platform and of the number of threads, it is
+        calculated on the first call and kept until the topology is
+        cleaned or reloaded
+    */
+    const CAmberContentHash& GetContentHash(void);
+
+    /// invalidate content hash
+    /*! it must be called if the topology lists were modified directly
+    */
+    void InvalidateContentHash(void);
+
+    /// build indexes of atom names, atom types, and residue names
+    /*! the indexes are built when the topology is loaded, they must be
+        rebuilt (or freed) if names are changed
+    */
+    void BuildNameIndexes(void);
+
+    /// free indexes of atom names, atom types, and residue names
+    void FreeNameIndexes(void);
+
+    /// return atoms whose names match first len characters of p_name
+    /*! missing name indexes are built on the first call, count is set to
+        the length of the list, NULL is returned if there is no match
+    */
+    const int* FindAtomsByName(const char* p_name,int len,int& count);
+
+    /// return atoms whose types match first len characters of p_name
+    const int* FindAtomsByType(const char* p_name,int len,int& count);
+
+    /// return residues whose names match first len characters of p_name
+    const int* FindResiduesByName(const char* p_name,int len,int& count);
+
 // section o public data ------------------------------------------------------
 public:
     CAmberAtomList      AtomList;
@@ -154,6 +405,36 @@ private:
     // total mass in g/mol
     double      TotalMass;
 
+    // number of threads used for decoding of sections
+    int         NumOfLoadThreads;
+    int         NumOfSaveThreads;
+
+    // requested and really loaded groups of sections
+    int         LoadOptions;
+    int         LoadedParts;
+
+    // molecules detected by InitMoleculeIndexes
+    std::vector<int>    MolFirstAtom;
+    std::vector<int>    MolLastAtom;
+    std::vector<int>    MolNumOfAtoms;
+
+    // bond graph - CSR representation of BondList
+    int*        NeighbourOffsets;   // NATOM+1 items
+    int*        NeighbourList;      // sorted bonded partners
+
+    // exclusion index - CSR representation of NATEX
+    int*        ExclusionOffsets;   // NATOM+1 items
+    int*        ExclusionList;      // sorted partners, placeholders removed
+
+    // content hash - calculated on demand
+    CAmberContentHash   ContentHash;
+    bool                ContentHashValid;
+
+    // name indexes - built on demand
+    CAmberNameIndex     AtomNameIndex;
+    CAmberNameIndex     AtomTypeIndex;
+    CAmberNameIndex     ResidueNameIndex;
+
     // local copy of formats
     CSmallString fTITLE;
     CSmallString fPOINTERS;
@@ -216,8 +497,15 @@ private:
 
     bool LoadAmber6(FILE* p_top);
     bool LoadAmber7(FILE* p_top);
+    bool LoadAmber7Section(FILE* p_top,CFortranIO& fortranio,
+                                       const char* p_sname,bool& found);
+    bool LoadParallel(const CSmallString& file_name,FILE* p_fin);
+    bool LoadAmber7Parallel(const CSmallString& file_name,FILE* p_top);
     bool SaveAmber6(FILE* p_top);
     bool SaveAmber7(FILE* p_top);
+    void GetAmber7Sections(std::vector<const char*>& sections);
+    bool SaveAmber7Section(FILE* p_top,const char* p_sname);
+    bool SaveAmber7Parallel(FILE* p_top,const std::vector<const char*>& sections);
 
     bool LoadBasicInfo(FILE* p_top,const char* p_format,EAmberVersion version);
     bool SaveBasicInfo(FILE* p_top,const char* p_format,EAmberVersion version);
@@ -225,6 +513,13 @@ private:
                                         const char* p_section_format);
 
     void SetDefaultAmber7Formats(void);
+    static int GetSectionGroup(const char* p_sname);
+    static int FindMoleculeRoot(std::vector<int>& parent,int index);
+
+    bool LoadCachePayload(CAmberCacheReader& reader);
+    static FILE* OpenCacheTemporary(const CSmallString& cache_name,CSmallString& tmp_name);
+    void GetFormats(std::vector<CSmallString*>& formats);
+    void CalculateContentHash(void);
 
 private:
     // disable copy constructor
@@ -0,0 +1,1035 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <AmberTopology.hpp>
+#include <ErrorSystem.hpp>
+#include <vector>
+
+#ifdef UNIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+
+// cache layout:
+//   header  : magic, format version, byte order mark, fingerprint of source
+//   payload : topology, atoms, residues, bonds, angles, dihedrals,
+//             nonbonded list, box, cap - in this order
+// numbers are stored in the native binary representation, the cache is
+// therefore not portable between architectures (this is checked by the header)
+
+#define AMBER_CACHE_MAGIC       "ASLTCACH"
+#define AMBER_CACHE_VERSION     1
+#define AMBER_CACHE_BOM         0x01020304
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+/// fingerprint of source topology file
+
+class CAmberCacheFingerprint {
+public:
+    CAmberCacheFingerprint(void);
+
+    /// calculate fingerprint of file content
+    bool Calculate(const CSmallString& file_name);
+
+    /// compare two fingerprints
+    bool operator == (const CAmberCacheFingerprint& right) const;
+
+public:
+    uint64_t    Size;       // size of file in bytes
+    uint64_t    Hash;       // FNV-1a hash of file content
+};
+
+//------------------------------------------------------------------------------
+
+CAmberCacheFingerprint::CAmberCacheFingerprint(void)
+{
+    Size = 0;
+    Hash = 0;
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheFingerprint::Calculate(const CSmallString& file_name)
+{
+    FILE* p_fin = fopen(file_name,"rb");
+    if( p_fin == NULL ) {
+        CSmallString error;
+        error << "unable to open topology file '" << file_name << "' ("
+              << strerror(errno) << ")";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    unsigned char   buffer[65536];
+    size_t          nread;
+
+    Size = 0;
+    Hash = 14695981039346656037ULL;
+
+    while( (nread = fread(buffer,1,sizeof(buffer),p_fin)) > 0 ) {
+        for(size_t i=0; i < nread; i++) {
+            Hash ^= buffer[i];
+            Hash *= 1099511628211ULL;
+        }
+        Size += nread;
+    }
+
+    bool result = ferror(p_fin) == 0;
+    fclose(p_fin);
+
+    if( result == false ) {
+        CSmallString error;
+        error << "unable to read topology file '" << file_name << "'";
+        ES_ERROR(error);
+    }
+
+    return(result);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheFingerprint::operator == (const CAmberCacheFingerprint& right) const
+{
+    return( (Size == right.Size) && (Hash == right.Hash) );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+/// binary cache writer
+
+class CAmberCacheWriter {
+public:
+    CAmberCacheWriter(FILE* p_fout);
+
+    bool Write(const void* p_data,size_t size);
+    bool WriteInt(int value);
+    bool WriteBool(bool value);
+    bool WriteDouble(double value);
+    bool WriteString(const CSmallString& value);
+
+private:
+    FILE*   File;
+};
+
+//------------------------------------------------------------------------------
+
+CAmberCacheWriter::CAmberCacheWriter(FILE* p_fout)
+{
+    File = p_fout;
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheWriter::Write(const void* p_data,size_t size)
+{
+    if( size == 0 ) return(true);
+    return( fwrite(p_data,size,1,File) == 1 );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheWriter::WriteInt(int value)
+{
+    return( Write(&value,sizeof(value)) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheWriter::WriteBool(bool value)
+{
+    return( WriteInt(value ? 1 : 0) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheWriter::WriteDouble(double value)
+{
+    return( Write(&value,sizeof(value)) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheWriter::WriteString(const CSmallString& value)
+{
+    int len = value.GetLength();
+    if( WriteInt(len) == false ) return(false);
+    return( Write((const char*)value,len) );
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+/// binary cache reader - the cache is mapped into memory
+
+class CAmberCacheReader {
+public:
+    CAmberCacheReader(void);
+    ~CAmberCacheReader(void);
+
+    bool Open(const CSmallString& cache_name);
+    void Close(void);
+
+    bool Read(void* p_data,size_t size);
+    bool ReadInt(int& value);
+    bool ReadBool(bool& value);
+    bool ReadDouble(double& value);
+    bool ReadString(CSmallString& value);
+
+private:
+    const char* Data;
+    size_t      Size;
+    size_t      Position;
+    bool        Mapped;
+};
+
+//------------------------------------------------------------------------------
+
+CAmberCacheReader::CAmberCacheReader(void)
+{
+    Data = NULL;
+    Size = 0;
+    Position = 0;
+    Mapped = false;
+}
+
+//------------------------------------------------------------------------------
+
+CAmberCacheReader::~CAmberCacheReader(void)
+{
+    Close();
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheReader::Open(const CSmallString& cache_name)
+{
+    Close();
+
+#ifdef UNIX
+    int fd = open(cache_name,O_RDONLY);
+    if( fd < 0 ) return(false);
+
+    struct stat info;
+    if( (fstat(fd,&info) != 0) || (info.st_size <= 0) ) {
+        close(fd);
+        return(false);
+    }
+
+    void* p_addr = mmap(NULL,info.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    close(fd);
+
+    if( p_addr == MAP_FAILED ) return(false);
+
+    Data = (const char*)p_addr;
+    Size = info.st_size;
+    Mapped = true;
+#else
+    FILE* p_fin = fopen(cache_name,"rb");
+    if( p_fin == NULL ) return(false);
+
+    fseek(p_fin,0,SEEK_END);
+    long fsize = ftell(p_fin);
+    fseek(p_fin,0,SEEK_SET);
+
+    if( fsize <= 0 ) {
+        fclose(p_fin);
+        return(false);
+    }
+
+    char* p_data = new char[fsize];
+    if( fread(p_data,fsize,1,p_fin) != 1 ) {
+        delete[] p_data;
+        fclose(p_fin);
+        return(false);
+    }
+    fclose(p_fin);
+
+    Data = p_data;
+    Size = fsize;
+    Mapped = false;
+#endif
+
+    Position = 0;
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberCacheReader::Close(void)
+{
+    if( Data != NULL ) {
+#ifdef UNIX
+        if( Mapped ) munmap((void*)Data,Size);
+#endif
+        if( ! Mapped ) delete[] Data;
+    }
+    Data = NULL;
+    Size = 0;
+    Position = 0;
+    Mapped = false;
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheReader::Read(void* p_data,size_t size)
+{
+    if( size == 0 ) return(true);
+    if( (Data == NULL) || (Position + size > Size) ) return(false);
+    memcpy(p_data,Data+Position,size);
+    Position += size;
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheReader::ReadInt(int& value)
+{
+    return( Read(&value,sizeof(value)) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheReader::ReadBool(bool& value)
+{
+    int ivalue = 0;
+    if( ReadInt(ivalue) == false ) return(false);
+    value = ivalue != 0;
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheReader::ReadDouble(double& value)
+{
+    return( Read(&value,sizeof(value)) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberCacheReader::ReadString(CSmallString& value)
+{
+    int len = 0;
+    if( ReadInt(len) == false ) return(false);
+    if( (len < 0) || (Position + len > Size) ) return(false);
+    if( len == 0 ) {
+        value = NULL;
+        return(true);
+    }
+    std::vector<char> buffer(len+1);
+    memcpy(&buffer[0],Data+Position,len);
+    buffer[len] = '\0';
+    value = &buffer[0];
+    Position += len;
+    return(true);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberTopology::SaveCache(const CSmallString& cache_name,
+                               const CSmallString& source_name)
+{
+    if( FakeTopology ){
+        ES_ERROR("cannot save fake topology");
+        return(false);
+    }
+
+    if( LoadedParts != AMBER_LOAD_ALL ){
+        ES_ERROR("cannot save partially loaded topology");
+        return(false);
+    }
+
+    CAmberCacheFingerprint fingerprint;
+    if( fingerprint.Calculate(source_name) == false ) {
+        ES_ERROR("unable to calculate fingerprint of source topology");
+        return(false);
+    }
+
+    // the cache is written into a temporary file in the same directory,
+    // which atomically replaces the cache when it is complete, thus readers
+    // never see partially written cache
+    CSmallString tmp_name;
+    FILE* p_fout = OpenCacheTemporary(cache_name,tmp_name);
+    if( p_fout == NULL ) {
+        CSmallString error;
+        error << "unable to open temporary file for topology cache '" << cache_name << "' ("
+              << strerror(errno) << ")";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    CAmberCacheWriter writer(p_fout);
+
+    bool result = true;
+
+    // header
+    result &= writer.Write(AMBER_CACHE_MAGIC,8);
+    result &= writer.WriteInt(AMBER_CACHE_VERSION);
+    result &= writer.WriteInt(AMBER_CACHE_BOM);
+    result &= writer.Write(&fingerprint.Size,sizeof(fingerprint.Size));
+    result &= writer.Write(&fingerprint.Hash,sizeof(fingerprint.Hash));
+
+    // topology
+    result &= writer.WriteInt(Version);
+    result &= writer.WriteString(ITITL);
+    result &= writer.WriteInt(NHPARM);
+    result &= writer.WriteInt(NPARM);
+    result &= writer.WriteInt(NCOPY);
+    result &= writer.WriteBool(NCOPY_Read);
+
+    std::vector<CSmallString*> formats;
+    GetFormats(formats);
+    result &= writer.WriteInt(formats.size());
+    for(unsigned int i=0; i < formats.size(); i++) {
+        result &= writer.WriteString(*formats[i]);
+    }
+
+    // atoms
+    result &= writer.WriteInt(AtomList.NATOM);
+    result &= writer.WriteInt(AtomList.IFPERT);
+    result &= writer.WriteInt(AtomList.IFPOL);
+    result &= writer.WriteInt(AtomList.NUMEXTRA);
+    result &= writer.WriteBool(AtomList.AtomicNumberLoaded);
+    result &= writer.WriteString(AtomList.RadiusSet);
+    for(int i=0; (i < AtomList.NATOM) && result; i++) {
+        CAmberAtom* p_atom = &AtomList.Atoms[i];
+        result &= writer.WriteInt(p_atom->NUMEX);
+        result &= writer.Write(p_atom->ITREE,sizeof(p_atom->ITREE));
+        result &= writer.WriteInt(p_atom->JOIN);
+        result &= writer.WriteInt(p_atom->IROTAT);
+        result &= writer.WriteDouble(p_atom->AMASS);
+        result &= writer.WriteDouble(p_atom->RADIUS);
+        result &= writer.WriteDouble(p_atom->SCREEN);
+        result &= writer.Write(p_atom->IGRAPH,sizeof(p_atom->IGRAPH));
+        result &= writer.Write(p_atom->ISYMBL,sizeof(p_atom->ISYMBL));
+        result &= writer.WriteDouble(p_atom->CHRG);
+        result &= writer.WriteInt(p_atom->IAC);
+        result &= writer.WriteDouble(p_atom->ATPOL);
+        result &= writer.WriteInt(p_atom->IAPER);
+        result &= writer.Write(p_atom->IGRPER,sizeof(p_atom->IGRPER));
+        result &= writer.Write(p_atom->ISMPER,sizeof(p_atom->ISMPER));
+        result &= writer.WriteDouble(p_atom->CGPER);
+        result &= writer.WriteInt(p_atom->IACPER);
+        result &= writer.WriteDouble(p_atom->ATPOL1);
+        result &= writer.WriteDouble(p_atom->ALMPER);
+        result &= writer.WriteInt(p_atom->ATOMIC_NUMBER);
+    }
+
+    // residues
+    result &= writer.WriteInt(ResidueList.NRES);
+    result &= writer.WriteInt(ResidueList.NMXRS);
+    for(int i=0; (i < ResidueList.NRES) && result; i++) {
+        CAmberResidue* p_res = &ResidueList.Residues[i];
+        result &= writer.Write(p_res->LABRES,sizeof(p_res->LABRES));
+        result &= writer.Write(p_res->PERRES,sizeof(p_res->PERRES));
+        result &= writer.WriteInt(p_res->IPRES);
+        result &= writer.WriteInt(p_res->NumOfBondsWithHydrogen);
+    }
+
+    // bonds
+    result &= writer.WriteInt(BondList.NBONH);
+    result &= writer.WriteInt(BondList.MBONA);
+    result &= writer.WriteInt(BondList.NUMBND);
+    result &= writer.WriteInt(BondList.NBONA);
+    result &= writer.WriteInt(BondList.NBPER);
+    result &= writer.WriteInt(BondList.MBPER);
+    for(int i=0; (i < BondList.NUMBND) && result; i++) {
+        result &= writer.WriteDouble(BondList.BondTypes[i].GetRK());
+        result &= writer.WriteDouble(BondList.BondTypes[i].GetREQ());
+    }
+    for(int i=0; (i < BondList.MBONA + BondList.NBONH + BondList.NBPER) && result; i++) {
+        CAmberBond* p_bond;
+        if( i < BondList.MBONA ) {
+            p_bond = &BondList.BondsWithoutHydrogens[i];
+        } else if( i < BondList.MBONA + BondList.NBONH ) {
+            p_bond = &BondList.BondsWithHydrogens[i-BondList.MBONA];
+        } else {
+            p_bond = &BondList.PerturbedBonds[i-BondList.MBONA-BondList.NBONH];
+        }
+        result &= writer.WriteInt(p_bond->GetIB());
+        result &= writer.WriteInt(p_bond->GetJB());
+        result &= writer.WriteInt(p_bond->GetICB());
+        result &= writer.WriteInt(p_bond->GetPCB());
+    }
+
+    // angles
+    result &= writer.WriteInt(AngleList.NTHETH);
+    result &= writer.WriteInt(AngleList.MTHETA);
+    result &= writer.WriteInt(AngleList.NUMANG);
+    result &= writer.WriteInt(AngleList.NTHETA);
+    result &= writer.WriteInt(AngleList.NGPER);
+    result &= writer.WriteInt(AngleList.MGPER);
+    for(int i=0; (i < AngleList.NUMANG) && result; i++) {
+        result &= writer.WriteDouble(AngleList.AngleTypes[i].GetTK());
+        result &= writer.WriteDouble(AngleList.AngleTypes[i].GetTEQ());
+    }
+    for(int i=0; (i < AngleList.MTHETA + AngleList.NTHETH + AngleList.NGPER) && result; i++) {
+        CAmberAngle* p_angle;
+        if( i < AngleList.MTHETA ) {
+            p_angle = &AngleList.AngleWithoutHydrogens[i];
+        } else if( i < AngleList.MTHETA + AngleList.NTHETH ) {
+            p_angle = &AngleList.AngleWithHydrogens[i-AngleList.MTHETA];
+        } else {
+            p_angle = &AngleList.PerturbedAngles[i-AngleList.MTHETA-AngleList.NTHETH];
+        }
+        result &= writer.WriteInt(p_angle->GetIT());
+        result &= writer.WriteInt(p_angle->GetJT());
+        result &= writer.WriteInt(p_angle->GetKT());
+        result &= writer.WriteInt(p_angle->GetICT());
+        result &= writer.WriteInt(p_angle->GetPCT());
+    }
+
+    // dihedrals
+    result &= writer.WriteInt(DihedralList.NPHIH);
+    result &= writer.WriteInt(DihedralList.MPHIA);
+    result &= writer.WriteInt(DihedralList.NPTRA);
+    result &= writer.WriteInt(DihedralList.NPHIA);
+    result &= writer.WriteInt(DihedralList.NDPER);
+    result &= writer.WriteInt(DihedralList.MDPER);
+    result &= writer.WriteBool(DihedralList.SCEEFactorsLoaded);
+    result &= writer.WriteBool(DihedralList.SCNBFactorsLoaded);
+    for(int i=0; (i < DihedralList.NPTRA) && result; i++) {
+        CAmberDihedralType* p_type = &DihedralList.DihedralTypes[i];
+        result &= writer.WriteDouble(p_type->GetPK());
+        result &= writer.WriteDouble(p_type->GetPN());
+        result &= writer.WriteDouble(p_type->GetPHASE());
+        result &= writer.WriteDouble(p_type->GetSCEE());
+        result &= writer.WriteDouble(p_type->GetSCNB());
+    }
+    for(int i=0; (i < DihedralList.MPHIA + DihedralList.NPHIH + DihedralList.NDPER) && result; i++) {
+        CAmberDihedral* p_dih;
+        if( i < DihedralList.MPHIA ) {
+            p_dih = &DihedralList.DihedralWithoutHydrogens[i];
+        } else if( i < DihedralList.MPHIA + DihedralList.NPHIH ) {
+            p_dih = &DihedralList.DihedralWithHydrogens[i-DihedralList.MPHIA];
+        } else {
+            p_dih = &DihedralList.PerturbedDihedrals[i-DihedralList.MPHIA-DihedralList.NPHIH];
+        }
+        result &= writer.WriteInt(p_dih->GetIP());
+        result &= writer.WriteInt(p_dih->GetJP());
+        result &= writer.WriteInt(p_dih->GetKP());
+        result &= writer.WriteInt(p_dih->GetLP());
+        result &= writer.WriteInt(p_dih->GetICP());
+        result &= writer.WriteInt(p_dih->GetPCP());
+        result &= writer.WriteInt(p_dih->GetType());
+    }
+
+    // nonbonded list
+    CAmberNonBondedList* p_nb = &NonBondedList;
+    int ntypes2 = p_nb->NTYPES*p_nb->NTYPES;
+    int ntypes12 = p_nb->NTYPES*(p_nb->NTYPES+1)/2;
+    result &= writer.WriteInt(p_nb->NTYPES);
+    result &= writer.WriteInt(p_nb->NEXT);
+    result &= writer.WriteInt(p_nb->NATYP);
+    result &= writer.WriteInt(p_nb->NPHB);
+    if( ntypes2 > 0 )       result &= writer.Write(p_nb->ICO,ntypes2*sizeof(int));
+    if( ntypes12 > 0 )      result &= writer.Write(p_nb->CN1,ntypes12*sizeof(double));
+    if( ntypes12 > 0 )      result &= writer.Write(p_nb->CN2,ntypes12*sizeof(double));
+    if( p_nb->NEXT > 0 )    result &= writer.Write(p_nb->NATEX,p_nb->NEXT*sizeof(int));
+    if( p_nb->NPHB > 0 )    result &= writer.Write(p_nb->ASOL,p_nb->NPHB*sizeof(double));
+    if( p_nb->NPHB > 0 )    result &= writer.Write(p_nb->BSOL,p_nb->NPHB*sizeof(double));
+    if( p_nb->NPHB > 0 )    result &= writer.Write(p_nb->HBCUT,p_nb->NPHB*sizeof(double));
+    if( p_nb->NATYP > 0 )   result &= writer.Write(p_nb->SOLTY,p_nb->NATYP*sizeof(double));
+
+    // box
+    result &= writer.WriteInt(BoxInfo.IFBOX);
+    result &= writer.WriteInt(BoxInfo.IPTRES);
+    result &= writer.WriteInt(BoxInfo.NSP != NULL ? BoxInfo.NSPM : 0);
+    result &= writer.WriteInt(BoxInfo.NSPSOL);
+    if( (BoxInfo.NSP != NULL) && (BoxInfo.NSPM > 0) ) {
+        result &= writer.Write(BoxInfo.NSP,BoxInfo.NSPM*sizeof(int));
+    }
+    result &= writer.Write(BoxInfo.DIMM,sizeof(BoxInfo.DIMM));
+    result &= writer.Write(BoxInfo.ANGS,sizeof(BoxInfo.ANGS));
+    result &= writer.Write(BoxInfo.UCELL,sizeof(BoxInfo.UCELL));
+    result &= writer.Write(BoxInfo.RECIP,sizeof(BoxInfo.RECIP));
+    result &= writer.WriteDouble(BoxInfo.Volume);
+    result &= writer.WriteDouble(BoxInfo.Radius);
+    result &= writer.WriteInt(BoxInfo.NumOfSoluteAtoms);
+
+    // cap
+    result &= writer.WriteInt(CapInfo.IFCAP);
+
+    if( fflush(p_fout) != 0 ) result = false;
+    if( fclose(p_fout) != 0 ) result = false;
+
+    if( result == false ) {
+        CSmallString error;
+        error << "unable to write topology cache '" << cache_name << "'";
+        ES_ERROR(error);
+        remove(tmp_name);
+        return(false);
+    }
+
+#ifndef UNIX
+    // rename does not replace existing files on all platforms
+    remove(cache_name);
+#endif
+
+    if( rename(tmp_name,cache_name) != 0 ) {
+        CSmallString error;
+        error << "unable to rename temporary file to topology cache '" << cache_name << "' ("
+              << strerror(errno) << ")";
+        ES_ERROR(error);
+        remove(tmp_name);
+        return(false);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+FILE* CAmberTopology::OpenCacheTemporary(const CSmallString& cache_name,
+                                         CSmallString& tmp_name)
+{
+#ifdef UNIX
+    CSmallString templ;
+    templ << cache_name << ".XXXXXX";
+
+    std::vector<char> buffer(templ.GetLength()+1);
+    strcpy(&buffer[0],templ);
+
+    int fd = mkstemp(&buffer[0]);
+    if( fd < 0 ) return(NULL);
+    tmp_name = &buffer[0];
+
+    // mkstemp creates the file readable only by the owner
+    fchmod(fd,S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+    FILE* p_fout = fdopen(fd,"wb");
+    if( p_fout == NULL ) {
+        close(fd);
+        remove(tmp_name);
+    }
+    return(p_fout);
+#else
+    tmp_name = cache_name;
+    tmp_name << ".tmp";
+    return(fopen(tmp_name,"wb"));
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberTopology::LoadCache(const CSmallString& cache_name,
+                               const CSmallString& source_name)
+{
+    CAmberCacheReader reader;
+
+    if( reader.Open(cache_name) == false ) {
+        // missing cache is not an error, caller will use the source topology
+        return(false);
+    }
+
+    // header ----------------------------------------
+    char    magic[8];
+    int     version = 0;
+    int     bom = 0;
+    CAmberCacheFingerprint cache_fingerprint;
+
+    if( (reader.Read(magic,8) == false) || (memcmp(magic,AMBER_CACHE_MAGIC,8) != 0) ) {
+        return(false);
+    }
+    if( (reader.ReadInt(version) == false) || (version != AMBER_CACHE_VERSION) ) {
+        return(false);
+    }
+    if( (reader.ReadInt(bom) == false) || (bom != AMBER_CACHE_BOM) ) {
+        return(false);
+    }
+    if( reader.Read(&cache_fingerprint.Size,sizeof(cache_fingerprint.Size)) == false ) return(false);
+    if( reader.Read(&cache_fingerprint.Hash,sizeof(cache_fingerprint.Hash)) == false ) return(false);
+
+    CAmberCacheFingerprint source_fingerprint;
+    if( source_fingerprint.Calculate(source_name) == false ) {
+        ES_ERROR("unable to calculate fingerprint of source topology");
+        return(false);
+    }
+
+    if( ! (source_fingerprint == cache_fingerprint) ) {
+        // stale cache
+        return(false);
+    }
+
+    // payload ---------------------------------------
+    Clean();
+
+    if( LoadCachePayload(reader) == false ) {
+        CSmallString error;
+        error << "topology cache '" << cache_name << "' is corrupted";
+        ES_ERROR(error);
+        Clean();
+        return(false);
+    }
+
+    if( ResidueList.GetNumberOfResidues() > 0 ) {
+        ResidueList.ReinitAtomResiduePointers(&AtomList);
+    }
+
+    Name = source_name;
+    BuildNameIndexes();
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberTopology::LoadCachePayload(CAmberCacheReader& reader)
+{
+    int ivalue = 0;
+
+    // topology
+    if( reader.ReadInt(ivalue) == false ) return(false);
+    Version = (EAmberVersion)ivalue;
+    if( reader.ReadString(ITITL) == false ) return(false);
+    if( reader.ReadInt(NHPARM) == false ) return(false);
+    if( reader.ReadInt(NPARM) == false ) return(false);
+    if( reader.ReadInt(NCOPY) == false ) return(false);
+    if( reader.ReadBool(NCOPY_Read) == false ) return(false);
+
+    std::vector<CSmallString*> formats;
+    GetFormats(formats);
+    if( (reader.ReadInt(ivalue) == false) || (ivalue != (int)formats.size()) ) return(false);
+    for(unsigned int i=0; i < formats.size(); i++) {
+        if( reader.ReadString(*formats[i]) == false ) return(false);
+    }
+
+    // atoms
+    int natom,ifpert,ifpol,numextra;
+    if( reader.ReadInt(natom) == false ) return(false);
+    if( reader.ReadInt(ifpert) == false ) return(false);
+    if( reader.ReadInt(ifpol) == false ) return(false);
+    if( reader.ReadInt(numextra) == false ) return(false);
+    if( natom < 0 ) return(false);
+    AtomList.InitFields(natom,ifpert,ifpol,numextra);
+    if( reader.ReadBool(AtomList.AtomicNumberLoaded) == false ) return(false);
+    if( reader.ReadString(AtomList.RadiusSet) == false ) return(false);
+
+    bool result = true;
+
+    for(int i=0; (i < AtomList.NATOM) && result; i++) {
+        CAmberAtom* p_atom = &AtomList.Atoms[i];
+        result &= reader.ReadInt(p_atom->NUMEX);
+        result &= reader.Read(p_atom->ITREE,sizeof(p_atom->ITREE));
+        result &= reader.ReadInt(p_atom->JOIN);
+        result &= reader.ReadInt(p_atom->IROTAT);
+        result &= reader.ReadDouble(p_atom->AMASS);
+        result &= reader.ReadDouble(p_atom->RADIUS);
+        result &= reader.ReadDouble(p_atom->SCREEN);
+        result &= reader.Read(p_atom->IGRAPH,sizeof(p_atom->IGRAPH));
+        result &= reader.Read(p_atom->ISYMBL,sizeof(p_atom->ISYMBL));
+        result &= reader.ReadDouble(p_atom->CHRG);
+        result &= reader.ReadInt(p_atom->IAC);
+        result &= reader.ReadDouble(p_atom->ATPOL);
+        result &= reader.ReadInt(p_atom->IAPER);
+        result &= reader.Read(p_atom->IGRPER,sizeof(p_atom->IGRPER));
+        result &= reader.Read(p_atom->ISMPER,sizeof(p_atom->ISMPER));
+        result &= reader.ReadDouble(p_atom->CGPER);
+        result &= reader.ReadInt(p_atom->IACPER);
+        result &= reader.ReadDouble(p_atom->ATPOL1);
+        result &= reader.ReadDouble(p_atom->ALMPER);
+        result &= reader.ReadInt(p_atom->ATOMIC_NUMBER);
+    }
+    if( result == false ) return(false);
+
+    // residues
+    int nres,nmxrs;
+    if( reader.ReadInt(nres) == false ) return(false);
+    if( reader.ReadInt(nmxrs) == false ) return(false);
+    if( nres < 0 ) return(false);
+    ResidueList.InitFields(nres,nmxrs);
+    for(int i=0; (i < ResidueList.NRES) && result; i++) {
+        CAmberResidue* p_res = &ResidueList.Residues[i];
+        result &= reader.Read(p_res->LABRES,sizeof(p_res->LABRES));
+        result &= reader.Read(p_res->PERRES,sizeof(p_res->PERRES));
+        result &= reader.ReadInt(p_res->IPRES);
+        result &= reader.ReadInt(p_res->NumOfBondsWithHydrogen);
+        // IPRES is used to set atom residue pointers
+        if( (p_res->IPRES < 1) || (p_res->IPRES > AtomList.NATOM) ) return(false);
+    }
+    if( result == false ) return(false);
+
+    // bonds
+    int n1,n2,n3,n4,n5,n6;
+    if( reader.ReadInt(n1) == false ) return(false);
+    if( reader.ReadInt(n2) == false ) return(false);
+    if( reader.ReadInt(n3) == false ) return(false);
+    if( reader.ReadInt(n4) == false ) return(false);
+    if( reader.ReadInt(n5) == false ) return(false);
+    if( reader.ReadInt(n6) == false ) return(false);
+    if( (n1 < 0) || (n2 < 0) || (n3 < 0) || (n5 < 0) ) return(false);
+    BondList.InitFields(n1,n2,n3,n4,n5,n6);
+    for(int i=0; (i < BondList.NUMBND) && result; i++) {
+        double rk = 0.0, req = 0.0;
+        result &= reader.ReadDouble(rk);
+        result &= reader.ReadDouble(req);
+        BondList.BondTypes[i].SetRK(rk);
+        BondList.BondTypes[i].SetREQ(req);
+    }
+    for(int i=0; (i < BondList.MBONA + BondList.NBONH + BondList.NBPER) && result; i++) {
+        CAmberBond* p_bond;
+        if( i < BondList.MBONA ) {
+            p_bond = &BondList.BondsWithoutHydrogens[i];
+        } else if( i < BondList.MBONA + BondList.NBONH ) {
+            p_bond = &BondList.BondsWithHydrogens[i-BondList.MBONA];
+        } else {
+            p_bond = &BondList.PerturbedBonds[i-BondList.MBONA-BondList.NBONH];
+        }
+        int data[4];
+        result &= reader.Read(data,sizeof(data));
+        p_bond->SetIB(data[0]);
+        p_bond->SetJB(data[1]);
+        p_bond->SetICB(data[2]);
+        p_bond->SetPCB(data[3]);
+    }
+    if( result == false ) return(false);
+
+    // angles
+    if( reader.ReadInt(n1) == false ) return(false);
+    if( reader.ReadInt(n2) == false ) return(false);
+    if( reader.ReadInt(n3) == false ) return(false);
+    if( reader.ReadInt(n4) == false ) return(false);
+    if( reader.ReadInt(n5) == false ) return(false);
+    if( reader.ReadInt(n6) == false ) return(false);
+    if( (n1 < 0) || (n2 < 0) || (n3 < 0) || (n5 < 0) ) return(false);
+    AngleList.InitFields(n1,n2,n3,n4,n5,n6);
+    for(int i=0; (i < AngleList.NUMANG) && result; i++) {
+        double tk = 0.0, teq = 0.0;
+        result &= reader.ReadDouble(tk);
+        result &= reader.ReadDouble(teq);
+        AngleList.AngleTypes[i].SetTK(tk);
+        AngleList.AngleTypes[i].SetTEQ(teq);
+    }
+    for(int i=0; (i < AngleList.MTHETA + AngleList.NTHETH + AngleList.NGPER) && result; i++) {
+        CAmberAngle* p_angle;
+        if( i < AngleList.MTHETA ) {
+            p_angle = &AngleList.AngleWithoutHydrogens[i];
+        } else if( i < AngleList.MTHETA + AngleList.NTHETH ) {
+            p_angle = &AngleList.AngleWithHydrogens[i-AngleList.MTHETA];
+        } else {
+            p_angle = &AngleList.PerturbedAngles[i-AngleList.MTHETA-AngleList.NTHETH];
+        }
+        int data[5];
+        result &= reader.Read(data,sizeof(data));
+        p_angle->SetIT(data[0]);
+        p_angle->SetJT(data[1]);
+        p_angle->SetKT(data[2]);
+        p_angle->SetICT(data[3]);
+        p_angle->SetPCT(data[4]);
+    }
+    if( result == false ) return(false);
+
+    // dihedrals
+    if( reader.ReadInt(n1) == false ) return(false);
+    if( reader.ReadInt(n2) == false ) return(false);
+    if( reader.ReadInt(n3) == false ) return(false);
+    if( reader.ReadInt(n4) == false ) return(false);
+    if( reader.ReadInt(n5) == false ) return(false);
+    if( reader.ReadInt(n6) == false ) return(false);
+    if( (n1 < 0) || (n2 < 0) || (n3 < 0) || (n5 < 0) ) return(false);
+    DihedralList.InitFields(n1,n2,n3,n4,n5,n6);
+    if( reader.ReadBool(DihedralList.SCEEFactorsLoaded) == false ) return(false);
+    if( reader.ReadBool(DihedralList.SCNBFactorsLoaded) == false ) return(false);
+    for(int i=0; (i < DihedralList.NPTRA) && result; i++) {
+        double data[5];
+        result &= reader.Read(data,sizeof(data));
+        CAmberDihedralType* p_type = &DihedralList.DihedralTypes[i];
+        p_type->SetPK(data[0]);
+        p_type->SetPN(data[1]);
+        p_type->SetPHASE(data[2]);
+        p_type->SetSCEE(data[3]);
+        p_type->SetSCNB(data[4]);
+    }
+    for(int i=0; (i < DihedralList.MPHIA + DihedralList.NPHIH + DihedralList.NDPER) && result; i++) {
+        CAmberDihedral* p_dih;
+        if( i < DihedralList.MPHIA ) {
+            p_dih = &DihedralList.DihedralWithoutHydrogens[i];
+        } else if( i < DihedralList.MPHIA + DihedralList.NPHIH ) {
+            p_dih = &DihedralList.DihedralWithHydrogens[i-DihedralList.MPHIA];
+        } else {
+            p_dih = &DihedralList.PerturbedDihedrals[i-DihedralList.MPHIA-DihedralList.NPHIH];
+        }
+        int data[7];
+        result &= reader.Read(data,sizeof(data));
+        p_dih->SetIP(data[0]);
+        p_dih->SetJP(data[1]);
+        p_dih->SetKP(data[2]);
+        p_dih->SetLP(data[3]);
+        p_dih->SetICP(data[4]);
+        p_dih->SetPCP(data[5]);
+        p_dih->SetType(data[6]);
+    }
+    if( result == false ) return(false);
+
+    // nonbonded list
+    if( reader.ReadInt(n1) == false ) return(false);
+    if( reader.ReadInt(n2) == false ) return(false);
+    if( reader.ReadInt(n3) == false ) return(false);
+    if( reader.ReadInt(n4) == false ) return(false);
+    if( (n1 < 0) || (n2 < 0) || (n3 < 0) || (n4 < 0) ) return(false);
+    NonBondedList.InitFields(n1,n2,n3,n4);
+
+    CAmberNonBondedList* p_nb = &NonBondedList;
+    int ntypes2 = p_nb->NTYPES*p_nb->NTYPES;
+    int ntypes12 = p_nb->NTYPES*(p_nb->NTYPES+1)/2;
+    if( ntypes2 > 0 )       result &= reader.Read(p_nb->ICO,ntypes2*sizeof(int));
+    if( ntypes12 > 0 )      result &= reader.Read(p_nb->CN1,ntypes12*sizeof(double));
+    if( ntypes12 > 0 )      result &= reader.Read(p_nb->CN2,ntypes12*sizeof(double));
+    if( p_nb->NEXT > 0 )    result &= reader.Read(p_nb->NATEX,p_nb->NEXT*sizeof(int));
+    if( p_nb->NPHB > 0 )    result &= reader.Read(p_nb->ASOL,p_nb->NPHB*sizeof(double));
+    if( p_nb->NPHB > 0 )    result &= reader.Read(p_nb->BSOL,p_nb->NPHB*sizeof(double));
+    if( p_nb->NPHB > 0 )    result &= reader.Read(p_nb->HBCUT,p_nb->NPHB*sizeof(double));
+    if( p_nb->NATYP > 0 )   result &= reader.Read(p_nb->SOLTY,p_nb->NATYP*sizeof(double));
+    if( result == false ) return(false);
+
+    // box
+    if( reader.ReadInt(ivalue) == false ) return(false);
+    BoxInfo.InitFields(ivalue);
+    if( reader.ReadInt(BoxInfo.IPTRES) == false ) return(false);
+    if( reader.ReadInt(BoxInfo.NSPM) == false ) return(false);
+    if( reader.ReadInt(BoxInfo.NSPSOL) == false ) return(false);
+    if( BoxInfo.NSPM < 0 ) return(false);
+    if( BoxInfo.NSPM > 0 ) {
+        BoxInfo.NSP = new int[BoxInfo.NSPM];
+        if( reader.Read(BoxInfo.NSP,BoxInfo.NSPM*sizeof(int)) == false ) return(false);
+    }
+    result &= reader.Read(BoxInfo.DIMM,sizeof(BoxInfo.DIMM));
+    result &= reader.Read(BoxInfo.ANGS,sizeof(BoxInfo.ANGS));
+    result &= reader.Read(BoxInfo.UCELL,sizeof(BoxInfo.UCELL));
+    result &= reader.Read(BoxInfo.RECIP,sizeof(BoxInfo.RECIP));
+    result &= reader.ReadDouble(BoxInfo.Volume);
+    result &= reader.ReadDouble(BoxInfo.Radius);
+    result &= reader.ReadInt(BoxInfo.NumOfSoluteAtoms);
+    if( result == false ) return(false);
+
+    // cap
+    if( reader.ReadInt(ivalue) == false ) return(false);
+    CapInfo.InitFields(ivalue);
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberTopology::LoadWithCache(const CSmallString& file_name,
+                                   const CSmallString& cache_name)
+{
+    if( LoadCache(cache_name,file_name) == true ) return(true);
+
+    if( Load(file_name) == false ) return(false);
+
+    // failure to create the cache is not fatal
+    if( SaveCache(cache_name,file_name) == false ) {
+        CSmallString warning;
+        warning << "unable to create topology cache '" << cache_name << "'";
+        ES_WARNING(warning);
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::GetFormats(std::vector<CSmallString*>& formats)
+{
+    formats.clear();
+    formats.push_back(&fTITLE);
+    formats.push_back(&fPOINTERS);
+    formats.push_back(&fATOM_NAME);
+    formats.push_back(&fCHARGE);
+    formats.push_back(&fMASS);
+    formats.push_back(&fATOM_TYPE_INDEX);
+    formats.push_back(&fNUMBER_EXCLUDED_ATOMS);
+    formats.push_back(&fNONBONDED_PARM_INDEX);
+    formats.push_back(&fRESIDUE_LABEL);
+    formats.push_back(&fRESIDUE_POINTER);
+    formats.push_back(&fBOND_FORCE_CONSTANT);
+    formats.push_back(&fBOND_EQUIL_VALUE);
+    formats.push_back(&fANGLE_FORCE_CONSTANT);
+    formats.push_back(&fANGLE_EQUIL_VALUE);
+    formats.push_back(&fDIHEDRAL_FORCE_CONSTANT);
+    formats.push_back(&fDIHEDRAL_PERIODICITY);
+    formats.push_back(&fDIHEDRAL_PHASE);
+    formats.push_back(&fSOLTY);
+    formats.push_back(&fLENNARD_JONES_ACOEF);
+    formats.push_back(&fLENNARD_JONES_BCOEF);
+    formats.push_back(&fBONDS_INC_HYDROGEN);
+    formats.push_back(&fBONDS_WITHOUT_HYDROGEN);
+    formats.push_back(&fANGLES_INC_HYDROGEN);
+    formats.push_back(&fANGLES_WITHOUT_HYDROGEN);
+    formats.push_back(&fDIHEDRALS_INC_HYDROGEN);
+    formats.push_back(&fDIHEDRALS_WITHOUT_HYDROGEN);
+    formats.push_back(&fEXCLUDED_ATOMS_LIST);
+    formats.push_back(&fHBOND_ACOEF);
+    formats.push_back(&fHBOND_BCOEF);
+    formats.push_back(&fHBCUT);
+    formats.push_back(&fAMBER_ATOM_TYPE);
+    formats.push_back(&fTREE_CHAIN_CLASSIFICATION);
+    formats.push_back(&fJOIN_ARRAY);
+    formats.push_back(&fIROTAT);
+    formats.push_back(&fSOLVENT_POINTERS);
+    formats.push_back(&fATOMS_PER_MOLECULE);
+    formats.push_back(&fBOX_DIMENSIONS);
+    formats.push_back(&fRADIUS_SET);
+    formats.push_back(&fRADII);
+    formats.push_back(&fSCREEN);
+    formats.push_back(&fPERT_BOND_ATOMS);
+    formats.push_back(&fPERT_BOND_PARAMS);
+    formats.push_back(&fPERT_ANGLE_ATOMS);
+    formats.push_back(&fPERT_ANGLE_PARAMS);
+    formats.push_back(&fPERT_DIHEDRAL_ATOMS);
+    formats.push_back(&fPERT_DIHEDRAL_PARAMS);
+    formats.push_back(&fPERT_RESIDUE_NAME);
+    formats.push_back(&fPERT_ATOM_NAME);
+    formats.push_back(&fPERT_ATOM_SYMBOL);
+    formats.push_back(&fALMPER);
+    formats.push_back(&fIAPER);
+    formats.push_back(&fPERT_ATOM_TYPE_INDEX);
+    formats.push_back(&fPERT_CHARGE);
+    formats.push_back(&fSCEE_SCALE_FACTOR);
+    formats.push_back(&fSCNB_SCALE_FACTOR);
+    formats.push_back(&fATOMIC_NUMBER);
+    formats.push_back(&fIPOL);
+    formats.push_back(&fPOL);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,229 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberTopology.hpp>
+#include <ErrorSystem.hpp>
+#include <SmallString.hpp>
+#include <algorithm>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+// all queries work on the bond graph (see BuidListOfNeighbourAtoms),
+// which is built on demand
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+bool CAmberTopology::GetBondedPairs(int nbonds,std::vector<int>& ai,
+                                    std::vector<int>& aj,std::vector<int>& dist)
+{
+    ai.clear();
+    aj.clear();
+    dist.clear();
+
+    if( nbonds < 1 ) {
+        CSmallString error;
+        error << "number of bonds (" << nbonds << ") must be greater than zero";
+        ES_ERROR(error);
+        return(false);
+    }
+
+    int natoms = AtomList.GetNumberOfAtoms();
+    if( natoms <= 0 ) return(true);
+
+    if( NeighbourOffsets == NULL ) BuidListOfNeighbourAtoms();
+
+    // breadth-first search limited to nbonds from each atom
+    // mark contains the last source atom, which visited the atom
+    vector<int> mark(natoms,-1);
+    vector<int> curr;
+    vector<int> next;
+
+    for(int i=0; i < natoms; i++) {
+        mark[i] = i;
+        curr.clear();
+        curr.push_back(i);
+        for(int d=1; (d <= nbonds) && (curr.size() > 0); d++) {
+            next.clear();
+            for(unsigned int k=0; k < curr.size(); k++) {
+                int a = curr[k];
+                for(int l = NeighbourOffsets[a]; l < NeighbourOffsets[a+1]; l++) {
+                    int n = NeighbourList[l];
+                    if( mark[n] == i ) continue;
+                    mark[n] = i;
+                    next.push_back(n);
+                    if( n > i ) {
+                        ai.push_back(i);
+                        aj.push_back(n);
+                        dist.push_back(d);
+                    }
+                }
+            }
+            curr.swap(next);
+        }
+    }
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetBondedDistance(int ai,int aj,int maxdist)
+{
+    int natoms = AtomList.GetNumberOfAtoms();
+    if( (ai < 0) || (ai >= natoms) ) return(-1);
+    if( (aj < 0) || (aj >= natoms) ) return(-1);
+    if( ai == aj ) return(0);
+
+    // atoms from different molecules are not connected
+    CAmberAtom* p_at1 = AtomList.GetAtom(ai);
+    CAmberAtom* p_at2 = AtomList.GetAtom(aj);
+    if( (p_at1->GetMoleculeIndex() >= 0) && (p_at2->GetMoleculeIndex() >= 0) &&
+        (p_at1->GetMoleculeIndex() != p_at2->GetMoleculeIndex()) ) return(-1);
+
+    if( NeighbourOffsets == NULL ) BuidListOfNeighbourAtoms();
+
+    vector<int> mark(natoms,0);
+    vector<int> curr;
+    vector<int> next;
+
+    mark[ai] = 1;
+    curr.push_back(ai);
+    for(int d=1; ((maxdist < 0) || (d <= maxdist)) && (curr.size() > 0); d++) {
+        next.clear();
+        for(unsigned int k=0; k < curr.size(); k++) {
+            int a = curr[k];
+            for(int l = NeighbourOffsets[a]; l < NeighbourOffsets[a+1]; l++) {
+                int n = NeighbourList[l];
+                if( n == aj ) return(d);
+                if( mark[n] != 0 ) continue;
+                mark[n] = 1;
+                next.push_back(n);
+            }
+        }
+        curr.swap(next);
+    }
+
+    return(-1);
+}
+
+//------------------------------------------------------------------------------
+
+int CAmberTopology::GetRigidFragments(std::vector<int>& fragments,
+                                      std::vector<int>& rb_ai,std::vector<int>& rb_aj)
+{
+    fragments.clear();
+    rb_ai.clear();
+    rb_aj.clear();
+
+    int natoms = AtomList.GetNumberOfAtoms();
+    if( natoms <= 0 ) return(0);
+
+    if( NeighbourOffsets == NULL ) BuidListOfNeighbourAtoms();
+
+    // rotatable bonds are bridges (bonds not in rings) between non-terminal
+    // atoms, bridges are found by iterative Tarjan's algorithm
+    int         nedges = NeighbourOffsets[natoms];
+    vector<int> disc(natoms,-1);
+    vector<int> low(natoms,0);
+    vector<int> parent(natoms,-1);
+    vector<int> next_nb(natoms,0);
+    vector<int> stack;
+    vector<char> rotatable(nedges > 0 ? nedges : 1,0);
+    int         time = 0;
+
+    for(int s=0; s < natoms; s++) {
+        if( disc[s] >= 0 ) continue;
+        disc[s] = low[s] = time++;
+        next_nb[s] = NeighbourOffsets[s];
+        stack.push_back(s);
+
+        while( stack.size() > 0 ) {
+            int v = stack.back();
+            if( next_nb[v] < NeighbourOffsets[v+1] ) {
+                int w = NeighbourList[next_nb[v]++];
+                if( disc[w] < 0 ) {
+                    parent[w] = v;
+                    disc[w] = low[w] = time++;
+                    next_nb[w] = NeighbourOffsets[w];
+                    stack.push_back(w);
+                } else if( w != parent[v] ) {
+                    low[v] = min(low[v],disc[w]);
+                }
+            } else {
+                stack.pop_back();
+                int p = parent[v];
+                if( p < 0 ) continue;
+                low[p] = min(low[p],low[v]);
+                if( low[v] <= disc[p] ) continue;
+                // bridge p-v, terminal atoms do not define torsion
+                int deg_p = NeighbourOffsets[p+1] - NeighbourOffsets[p];
+                int deg_v = NeighbourOffsets[v+1] - NeighbourOffsets[v];
+                if( (deg_p < 2) || (deg_v < 2) ) continue;
+
+                int* p_e1 = lower_bound(NeighbourList + NeighbourOffsets[p],NeighbourList + NeighbourOffsets[p+1],v);
+                int* p_e2 = lower_bound(NeighbourList + NeighbourOffsets[v],NeighbourList + NeighbourOffsets[v+1],p);
+                rotatable[p_e1 - NeighbourList] = 1;
+                rotatable[p_e2 - NeighbourList] = 1;
+            }
+        }
+    }
+
+    // rotatable bonds
+    for(int i=0; i < natoms; i++) {
+        for(int l = NeighbourOffsets[i]; l < NeighbourOffsets[i+1]; l++) {
+            if( (rotatable[l] != 0) && (NeighbourList[l] > i) ) {
+                rb_ai.push_back(i);
+                rb_aj.push_back(NeighbourList[l]);
+            }
+        }
+    }
+
+    // fragments - connected components without rotatable bonds
+    fragments.resize(natoms,-1);
+    int nfrags = 0;
+    for(int s=0; s < natoms; s++) {
+        if( fragments[s] >= 0 ) continue;
+        fragments[s] = nfrags;
+        stack.clear();
+        stack.push_back(s);
+        while( stack.size() > 0 ) {
+            int v = stack.back();
+            stack.pop_back();
+            for(int l = NeighbourOffsets[v]; l < NeighbourOffsets[v+1]; l++) {
+                int w = NeighbourList[l];
+                if( (rotatable[l] != 0) || (fragments[w] >= 0) ) continue;
+                fragments[w] = nfrags;
+                stack.push_back(w);
+            }
+        }
+        nfrags++;
+    }
+
+    return(nfrags);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
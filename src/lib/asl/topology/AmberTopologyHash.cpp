@@ -0,0 +1,463 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberTopology.hpp>
+#include <ErrorSystem.hpp>
+#include <SmallString.hpp>
+#include <string.h>
+#include <stdio.h>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+// the hash is calculated from decoded values (not from the file content):
+//   integers are hashed as 32-bit values, reals as their IEEE 754 bit
+//   patterns (-0.0 is treated as 0.0), names as four characters
+// the mixing follows MurmurHash3 (x64, 128-bit variant) but operates on 64-bit
+// values instead of bytes, the result does not depend on the byte order
+// the content is split into independent blocks (atoms are hashed in chunks
+// of fixed size), which are hashed in parallel and combined in fixed order
+
+#define AMBER_HASH_CHUNK    4096
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+/// streaming 128-bit hash
+
+class CAmberHashStream {
+public:
+    CAmberHashStream(uint64_t seed);
+
+    void AddWord(uint64_t value);
+    void AddInt(int value);
+    void AddDouble(double value);
+    void AddName(const char* p_name);
+    void AddHash(const CAmberContentHash& hash);
+
+    void Finish(CAmberContentHash& hash);
+
+private:
+    uint64_t    H1;
+    uint64_t    H2;
+    uint64_t    K1;         // the first half of pending block
+    bool        Pending;
+    uint64_t    Length;     // number of added words
+
+    void MixBlock(uint64_t k1,uint64_t k2);
+    static uint64_t Rotl(uint64_t x,int r);
+    static uint64_t FMix(uint64_t k);
+};
+
+//------------------------------------------------------------------------------
+
+CAmberHashStream::CAmberHashStream(uint64_t seed)
+{
+    H1 = seed;
+    H2 = seed;
+    K1 = 0;
+    Pending = false;
+    Length = 0;
+}
+
+//------------------------------------------------------------------------------
+
+inline uint64_t CAmberHashStream::Rotl(uint64_t x,int r)
+{
+    return( (x << r) | (x >> (64 - r)) );
+}
+
+//------------------------------------------------------------------------------
+
+inline uint64_t CAmberHashStream::FMix(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return(k);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberHashStream::MixBlock(uint64_t k1,uint64_t k2)
+{
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    k1 *= c1;
+    k1 = Rotl(k1,31);
+    k1 *= c2;
+    H1 ^= k1;
+
+    H1 = Rotl(H1,27);
+    H1 += H2;
+    H1 = H1*5 + 0x52dce729;
+
+    k2 *= c2;
+    k2 = Rotl(k2,33);
+    k2 *= c1;
+    H2 ^= k2;
+
+    H2 = Rotl(H2,31);
+    H2 += H1;
+    H2 = H2*5 + 0x38495ab5;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberHashStream::AddWord(uint64_t value)
+{
+    Length++;
+    if( Pending == false ) {
+        K1 = value;
+        Pending = true;
+        return;
+    }
+    MixBlock(K1,value);
+    Pending = false;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberHashStream::AddInt(int value)
+{
+    AddWord((uint32_t)value);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberHashStream::AddDouble(double value)
+{
+    if( value == 0.0 ) value = 0.0;     // -0.0 -> 0.0
+    uint64_t bits;
+    memcpy(&bits,&value,sizeof(bits));
+    AddWord(bits);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberHashStream::AddName(const char* p_name)
+{
+    // names are at most four characters long and zero terminated
+    uint64_t value = 0;
+    for(int i=0; (i < 4) && (p_name[i] != '\0'); i++) {
+        value |= ((uint64_t)(unsigned char)p_name[i]) << (8*i);
+    }
+    AddWord(value);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberHashStream::AddHash(const CAmberContentHash& hash)
+{
+    AddWord(hash.H1);
+    AddWord(hash.H2);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberHashStream::Finish(CAmberContentHash& hash)
+{
+    if( Pending ) {
+        MixBlock(K1,0);
+        Pending = false;
+    }
+
+    H1 ^= Length;
+    H2 ^= Length;
+
+    H1 += H2;
+    H2 += H1;
+
+    H1 = FMix(H1);
+    H2 = FMix(H2);
+
+    H1 += H2;
+    H2 += H1;
+
+    hash.H1 = H1;
+    hash.H2 = H2;
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberContentHash::CAmberContentHash(void)
+{
+    H1 = 0;
+    H2 = 0;
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberContentHash::operator == (const CAmberContentHash& right) const
+{
+    return( (H1 == right.H1) && (H2 == right.H2) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberContentHash::operator != (const CAmberContentHash& right) const
+{
+    return( ! operator == (right) );
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberContentHash::operator < (const CAmberContentHash& right) const
+{
+    if( H1 != right.H1 ) return( H1 < right.H1 );
+    return( H2 < right.H2 );
+}
+
+//------------------------------------------------------------------------------
+
+const CSmallString CAmberContentHash::GetString(void) const
+{
+    char buffer[33];
+    sprintf(buffer,"%016llx%016llx",(unsigned long long)H1,(unsigned long long)H2);
+    return(buffer);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+const CAmberContentHash& CAmberTopology::GetContentHash(void)
+{
+    if( ContentHashValid == false ) {
+        CalculateContentHash();
+        ContentHashValid = true;
+    }
+    return(ContentHash);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::InvalidateContentHash(void)
+{
+    ContentHashValid = false;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::CalculateContentHash(void)
+{
+    // blocks: residues, bonds, angles, dihedrals, nonbonded, box, atom chunks
+    int nchunks = (AtomList.NATOM + AMBER_HASH_CHUNK - 1) / AMBER_HASH_CHUNK;
+    int nblocks = 6 + nchunks;
+
+    std::vector<CAmberContentHash> hashes(nblocks);
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic,1)
+#endif
+    for(int b=0; b < nblocks; b++) {
+        CAmberHashStream stream(b);
+
+        switch(b) {
+            // residues ------------------------------------
+            case 0:
+                stream.AddInt(ResidueList.NRES);
+                for(int i=0; i < ResidueList.NRES; i++) {
+                    CAmberResidue* p_res = &ResidueList.Residues[i];
+                    stream.AddName(p_res->LABRES);
+                    stream.AddName(p_res->PERRES);
+                    stream.AddInt(p_res->IPRES);
+                }
+                break;
+
+            // bonds ---------------------------------------
+            case 1:
+                stream.AddInt(BondList.NBONH);
+                stream.AddInt(BondList.MBONA);
+                stream.AddInt(BondList.NUMBND);
+                stream.AddInt(BondList.NBPER);
+                for(int i=0; i < BondList.NUMBND; i++) {
+                    stream.AddDouble(BondList.BondTypes[i].GetRK());
+                    stream.AddDouble(BondList.BondTypes[i].GetREQ());
+                }
+                for(int i=0; i < BondList.MBONA + BondList.NBONH + BondList.NBPER; i++) {
+                    CAmberBond* p_bond;
+                    if( i < BondList.MBONA ) {
+                        p_bond = &BondList.BondsWithoutHydrogens[i];
+                    } else if( i < BondList.MBONA + BondList.NBONH ) {
+                        p_bond = &BondList.BondsWithHydrogens[i-BondList.MBONA];
+                    } else {
+                        p_bond = &BondList.PerturbedBonds[i-BondList.MBONA-BondList.NBONH];
+                    }
+                    stream.AddInt(p_bond->GetIB());
+                    stream.AddInt(p_bond->GetJB());
+                    stream.AddInt(p_bond->GetICB());
+                    stream.AddInt(p_bond->GetPCB());
+                }
+                break;
+
+            // angles --------------------------------------
+            case 2:
+                stream.AddInt(AngleList.NTHETH);
+                stream.AddInt(AngleList.MTHETA);
+                stream.AddInt(AngleList.NUMANG);
+                stream.AddInt(AngleList.NGPER);
+                for(int i=0; i < AngleList.NUMANG; i++) {
+                    stream.AddDouble(AngleList.AngleTypes[i].GetTK());
+                    stream.AddDouble(AngleList.AngleTypes[i].GetTEQ());
+                }
+                for(int i=0; i < AngleList.MTHETA + AngleList.NTHETH + AngleList.NGPER; i++) {
+                    CAmberAngle* p_angle;
+                    if( i < AngleList.MTHETA ) {
+                        p_angle = &AngleList.AngleWithoutHydrogens[i];
+                    } else if( i < AngleList.MTHETA + AngleList.NTHETH ) {
+                        p_angle = &AngleList.AngleWithHydrogens[i-AngleList.MTHETA];
+                    } else {
+                        p_angle = &AngleList.PerturbedAngles[i-AngleList.MTHETA-AngleList.NTHETH];
+                    }
+                    stream.AddInt(p_angle->GetIT());
+                    stream.AddInt(p_angle->GetJT());
+                    stream.AddInt(p_angle->GetKT());
+                    stream.AddInt(p_angle->GetICT());
+                    stream.AddInt(p_angle->GetPCT());
+                }
+                break;
+
+            // dihedrals -----------------------------------
+            case 3:
+                stream.AddInt(DihedralList.NPHIH);
+                stream.AddInt(DihedralList.MPHIA);
+                stream.AddInt(DihedralList.NPTRA);
+                stream.AddInt(DihedralList.NDPER);
+                for(int i=0; i < DihedralList.NPTRA; i++) {
+                    CAmberDihedralType* p_type = &DihedralList.DihedralTypes[i];
+                    stream.AddDouble(p_type->GetPK());
+                    stream.AddDouble(p_type->GetPN());
+                    stream.AddDouble(p_type->GetPHASE());
+                    stream.AddDouble(p_type->GetSCEE());
+                    stream.AddDouble(p_type->GetSCNB());
+                }
+                for(int i=0; i < DihedralList.MPHIA + DihedralList.NPHIH + DihedralList.NDPER; i++) {
+                    CAmberDihedral* p_dih;
+                    if( i < DihedralList.MPHIA ) {
+                        p_dih = &DihedralList.DihedralWithoutHydrogens[i];
+                    } else if( i < DihedralList.MPHIA + DihedralList.NPHIH ) {
+                        p_dih = &DihedralList.DihedralWithHydrogens[i-DihedralList.MPHIA];
+                    } else {
+                        p_dih = &DihedralList.PerturbedDihedrals[i-DihedralList.MPHIA-DihedralList.NPHIH];
+                    }
+                    stream.AddInt(p_dih->GetIP());
+                    stream.AddInt(p_dih->GetJP());
+                    stream.AddInt(p_dih->GetKP());
+                    stream.AddInt(p_dih->GetLP());
+                    stream.AddInt(p_dih->GetICP());
+                    stream.AddInt(p_dih->GetPCP());
+                    stream.AddInt(p_dih->GetType());
+                }
+                break;
+
+            // nonbonded list ------------------------------
+            case 4: {
+                CAmberNonBondedList* p_nb = &NonBondedList;
+                int ntypes2 = p_nb->NTYPES*p_nb->NTYPES;
+                int ntypes12 = p_nb->NTYPES*(p_nb->NTYPES+1)/2;
+                stream.AddInt(p_nb->NTYPES);
+                stream.AddInt(p_nb->NEXT);
+                stream.AddInt(p_nb->NATYP);
+                stream.AddInt(p_nb->NPHB);
+                for(int i=0; i < ntypes2; i++) stream.AddInt(p_nb->ICO[i]);
+                for(int i=0; i < ntypes12; i++) stream.AddDouble(p_nb->CN1[i]);
+                for(int i=0; i < ntypes12; i++) stream.AddDouble(p_nb->CN2[i]);
+                for(int i=0; i < p_nb->NEXT; i++) stream.AddInt(p_nb->NATEX[i]);
+                for(int i=0; i < p_nb->NPHB; i++) stream.AddDouble(p_nb->ASOL[i]);
+                for(int i=0; i < p_nb->NPHB; i++) stream.AddDouble(p_nb->BSOL[i]);
+                for(int i=0; i < p_nb->NPHB; i++) stream.AddDouble(p_nb->HBCUT[i]);
+                for(int i=0; i < p_nb->NATYP; i++) stream.AddDouble(p_nb->SOLTY[i]);
+                }
+                break;
+
+            // box -----------------------------------------
+            case 5:
+                stream.AddInt(BoxInfo.IFBOX);
+                stream.AddInt(BoxInfo.IPTRES);
+                stream.AddInt(BoxInfo.NSPSOL);
+                if( BoxInfo.NSP != NULL ) {
+                    stream.AddInt(BoxInfo.NSPM);
+                    for(int i=0; i < BoxInfo.NSPM; i++) stream.AddInt(BoxInfo.NSP[i]);
+                } else {
+                    stream.AddInt(0);
+                }
+                stream.AddInt(CapInfo.IFCAP);
+                break;
+
+            // chunk of atoms ------------------------------
+            default: {
+                int first = (b - 6)*AMBER_HASH_CHUNK;
+                int last = first + AMBER_HASH_CHUNK;
+                if( last > AtomList.NATOM ) last = AtomList.NATOM;
+                for(int i=first; i < last; i++) {
+                    CAmberAtom* p_atom = &AtomList.Atoms[i];
+                    stream.AddName(p_atom->IGRAPH);
+                    stream.AddName(p_atom->ISYMBL);
+                    stream.AddName(p_atom->ITREE);
+                    stream.AddDouble(p_atom->CHRG);
+                    stream.AddDouble(p_atom->AMASS);
+                    stream.AddInt(p_atom->IAC);
+                    stream.AddInt(p_atom->NUMEX);
+                    stream.AddInt(p_atom->JOIN);
+                    stream.AddInt(p_atom->IROTAT);
+                    stream.AddDouble(p_atom->RADIUS);
+                    stream.AddDouble(p_atom->SCREEN);
+                    stream.AddInt(p_atom->ATOMIC_NUMBER);
+                    stream.AddDouble(p_atom->ATPOL);
+                    stream.AddInt(p_atom->IAPER);
+                    stream.AddName(p_atom->IGRPER);
+                    stream.AddName(p_atom->ISMPER);
+                    stream.AddDouble(p_atom->CGPER);
+                    stream.AddInt(p_atom->IACPER);
+                    stream.AddDouble(p_atom->ATPOL1);
+                }
+                }
+                break;
+        }
+
+        stream.Finish(hashes[b]);
+    }
+
+    // combine blocks in fixed order
+    CAmberHashStream stream(0x41534c544f504f4cULL);
+    stream.AddInt(FakeTopology ? 1 : 0);
+    stream.AddInt(LoadedParts);
+    stream.AddInt(AtomList.NATOM);
+    stream.AddInt(AtomList.IFPERT);
+    stream.AddInt(AtomList.IFPOL);
+    stream.AddInt(AtomList.NUMEXTRA);
+    for(int b=0; b < nblocks; b++) {
+        stream.AddHash(hashes[b]);
+    }
+    stream.Finish(ContentHash);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
@@ -0,0 +1,197 @@
+// =============================================================================
+// ASL - Amber Support Library
+// -----------------------------------------------------------------------------
+//    Copyright (C) 2003,2004,2008 Petr Kulhanek (kulhanek@chemi.muni.cz)
+//
+//     This program is free software; you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation; either version 2 of the License, or
+//     (at your option) any later version.
+//
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+//
+//     You should have received a copy of the GNU General Public License along
+//     with this program; if not, write to the Free Software Foundation, Inc.,
+//     51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+// =============================================================================
+
+#include <AmberTopology.hpp>
+#include <algorithm>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+using namespace std;
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+CAmberNameIndex::CAmberNameIndex(void)
+{
+    Built = false;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNameIndex::Build(const char** p_names,int nitems)
+{
+    Free();
+
+    // sort items by keys, sort is stable thus items of a key remain ordered
+    vector< pair<uint32_t,int> > pairs(nitems);
+    for(int i=0; i < nitems; i++) {
+        pairs[i].first = MakeKey(p_names[i]);
+        pairs[i].second = i;
+    }
+    sort(pairs.begin(),pairs.end());
+
+    Items.resize(nitems);
+    for(int i=0; i < nitems; i++) {
+        if( (i == 0) || (pairs[i].first != pairs[i-1].first) ) {
+            Keys.push_back(pairs[i].first);
+            Offsets.push_back(i);
+        }
+        Items[i] = pairs[i].second;
+    }
+    Offsets.push_back(nitems);
+
+    Built = true;
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberNameIndex::Free(void)
+{
+    Keys.clear();
+    Offsets.clear();
+    Items.clear();
+    Built = false;
+}
+
+//------------------------------------------------------------------------------
+
+bool CAmberNameIndex::IsBuilt(void) const
+{
+    return(Built);
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberNameIndex::Find(const char* p_name,int len,int& count) const
+{
+    count = 0;
+    if( Keys.empty() ) return(NULL);
+
+    if( len < 0 ) len = 0;
+    if( len > 4 ) len = 4;
+
+    // names with the common prefix form the range of keys [lo,hi]
+    uint32_t lo = MakeKey(p_name,len);
+    uint32_t hi = lo;
+    if( len < 4 ) hi |= 0xFFFFFFFFu >> (8*len);
+
+    int first = lower_bound(Keys.begin(),Keys.end(),lo) - Keys.begin();
+    int last = upper_bound(Keys.begin() + first,Keys.end(),hi) - Keys.begin();
+
+    count = Offsets[last] - Offsets[first];
+    if( count == 0 ) return(NULL);
+    return(&Items[Offsets[first]]);
+}
+
+//------------------------------------------------------------------------------
+
+uint32_t CAmberNameIndex::MakeKey(const char* p_name,int len)
+{
+    // characters after the string terminator are zero as for strncmp
+    uint32_t key = 0;
+    bool     end = false;
+    for(int i=0; i < 4; i++) {
+        uint32_t c = 0;
+        if( (i < len) && (end == false) ) {
+            c = (unsigned char)p_name[i];
+            if( c == 0 ) end = true;
+        }
+        key = (key << 8) | c;
+    }
+    return(key);
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
+
+void CAmberTopology::BuildNameIndexes(void)
+{
+    FreeNameIndexes();
+
+    int natoms = AtomList.GetNumberOfAtoms();
+    vector<const char*> names(natoms);
+    vector<const char*> types(natoms);
+    for(int i=0; i < natoms; i++) {
+        CAmberAtom* p_atom = AtomList.GetAtom(i);
+        names[i] = p_atom->GetName();
+        types[i] = p_atom->GetType();
+    }
+    AtomNameIndex.Build(natoms > 0 ? &names[0] : NULL,natoms);
+    AtomTypeIndex.Build(natoms > 0 ? &types[0] : NULL,natoms);
+
+    int nres = ResidueList.GetNumberOfResidues();
+    vector<const char*> rnames(nres);
+    for(int i=0; i < nres; i++) {
+        rnames[i] = ResidueList.GetResidue(i)->GetName();
+    }
+    ResidueNameIndex.Build(nres > 0 ? &rnames[0] : NULL,nres);
+}
+
+//------------------------------------------------------------------------------
+
+void CAmberTopology::FreeNameIndexes(void)
+{
+    AtomNameIndex.Free();
+    AtomTypeIndex.Free();
+    ResidueNameIndex.Free();
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberTopology::FindAtomsByName(const char* p_name,int len,int& count)
+{
+#ifdef _OPENMP
+    #pragma omp critical(AmberTopologyNameIndexes)
+#endif
+    if( AtomNameIndex.IsBuilt() == false ) BuildNameIndexes();
+
+    return(AtomNameIndex.Find(p_name,len,count));
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberTopology::FindAtomsByType(const char* p_name,int len,int& count)
+{
+#ifdef _OPENMP
+    #pragma omp critical(AmberTopologyNameIndexes)
+#endif
+    if( AtomTypeIndex.IsBuilt() == false ) BuildNameIndexes();
+
+    return(AtomTypeIndex.Find(p_name,len,count));
+}
+
+//------------------------------------------------------------------------------
+
+const int* CAmberTopology::FindResiduesByName(const char* p_name,int len,int& count)
+{
+#ifdef _OPENMP
+    #pragma omp critical(AmberTopologyNameIndexes)
+#endif
+    if( ResidueNameIndex.IsBuilt() == false ) BuildNameIndexes();
+
+    return(ResidueNameIndex.Find(p_name,len,count));
+}
+
+//==============================================================================
+//------------------------------------------------------------------------------
+//==============================================================================
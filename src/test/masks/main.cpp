@@ -0,0 +1,262 @@
+// =============================================================================
+// concurrent mask test
+// -----------------------------------------------------------------------------
+// masks are set and compiled masks are evaluated by several threads on one
+// shared topology, each thread uses coordinates with one of two boxes, the
+// selections must be the same as from the serial run and the box of the
+// topology must not be changed
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <AmberTopology.hpp>
+#include <AmberRestart.hpp>
+#include <AmberMaskAtoms.hpp>
+#include <AmberMaskResidues.hpp>
+#include <AmberCompiledMask.hpp>
+#include <ErrorSystem.hpp>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+
+static const char* AtomMasks[] = {
+    ":WAT",
+    "@O",
+    "@H=",
+    "@%HW",
+    ":1-20&!@H1",
+    ":1<@3.5",
+    "(:WAT&@O)&(:1<@5.0)",
+    ":5>@12.0",
+    "cbox<@6.0",
+    "cbox>:8.0",
+    NULL
+};
+
+static const char* ResidueMasks[] = {
+    ":WAT",
+    ":1-20",
+    ":1<:3.5",
+    ":7>:12.0",
+    "cbox<:6.0",
+    NULL
+};
+
+static const int    NumOfSide   = 6;        // molecules along box edge
+static const double Spacing     = 3.1;      // distance between molecules
+static const int    NumOfPasses = 50;
+
+//------------------------------------------------------------------------------
+
+// water box, the topology is filled directly thus name indexes are not built
+// in advance
+
+static void BuildTopology(CAmberTopology& top)
+{
+    int nres = NumOfSide*NumOfSide*NumOfSide;
+
+    top.ResidueList.InitFields(nres,3);
+    for(int i=0; i < nres; i++) {
+        CAmberResidue* p_res = top.ResidueList.GetResidue(i);
+        p_res->SetName("WAT ");
+        p_res->SetFirstAtomIndex(3*i);
+    }
+
+    top.AtomList.InitFields(3*nres,0,0,0);
+    for(int i=0; i < nres; i++) {
+        top.AtomList.GetAtom(3*i+0)->SetName("O   ");
+        top.AtomList.GetAtom(3*i+0)->SetType("OW  ");
+        top.AtomList.GetAtom(3*i+1)->SetName("H1  ");
+        top.AtomList.GetAtom(3*i+1)->SetType("HW  ");
+        top.AtomList.GetAtom(3*i+2)->SetName("H2  ");
+        top.AtomList.GetAtom(3*i+2)->SetType("HW  ");
+    }
+    top.ResidueList.ReinitAtomResiduePointers(&top.AtomList);
+
+    double edge = NumOfSide*Spacing;
+    top.BoxInfo.InitFields(AMBER_BOX_STANDARD);
+    top.BoxInfo.SetBoxBeta(90.0);
+    top.BoxInfo.SetBoxDimmensions(CPoint(edge,edge,edge));
+    top.BoxInfo.UpdateBoxMatrices();
+}
+
+//------------------------------------------------------------------------------
+
+static bool BuildCoordinates(CAmberTopology& top,CAmberRestart& crd,double scale)
+{
+    crd.AssignTopology(&top);
+    if( crd.Create() == false ) return(false);
+
+    int k = 0;
+    for(int x=0; x < NumOfSide; x++) {
+        for(int y=0; y < NumOfSide; y++) {
+            for(int z=0; z < NumOfSide; z++) {
+                CPoint pos(x*Spacing+0.5,y*Spacing+0.5,z*Spacing+0.5);
+                crd.SetPosition(k++,pos);
+                crd.SetPosition(k++,pos + CPoint(0.96,0.0,0.0));
+                crd.SetPosition(k++,pos + CPoint(-0.24,0.93,0.0));
+            }
+        }
+    }
+
+    double edge = NumOfSide*Spacing*scale;
+    crd.SetBox(CPoint(edge,edge,edge));
+    crd.SetAngles(CPoint(90.0,90.0,90.0));
+
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+static bool SelectAtoms(CAmberTopology* p_top,CAmberRestart* p_crd,
+                        const char* p_mask,vector<char>& selected)
+{
+    CAmberMaskAtoms mask;
+    mask.AssignTopology(p_top);
+    mask.AssignCoordinates(p_crd);
+    mask.SetPeriodicDistances(true);
+    if( mask.SetMask(p_mask) == false ) return(false);
+
+    selected.resize(mask.GetNumberOfTopologyAtoms());
+    for(unsigned int i=0; i < selected.size(); i++) {
+        selected[i] = mask.IsAtomSelected(i);
+    }
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+static bool SelectResidues(CAmberTopology* p_top,CAmberRestart* p_crd,
+                           const char* p_mask,vector<char>& selected)
+{
+    CAmberMaskResidues mask;
+    mask.AssignTopology(p_top);
+    mask.AssignCoordinates(p_crd);
+    mask.SetPeriodicDistances(true);
+    if( mask.SetMask(p_mask) == false ) return(false);
+
+    selected.resize(mask.GetNumberOfTopologyResidues());
+    for(unsigned int i=0; i < selected.size(); i++) {
+        selected[i] = mask.IsResidueSelected(i);
+    }
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+static bool SelectCompiled(CAmberTopology* p_top,CAmberRestart* p_crd,
+                           const char* p_mask,vector<char>* p_selected)
+{
+    CAmberCompiledMask mask;
+    mask.AssignTopology(p_top);
+    mask.SetPeriodicDistances(true);
+    if( mask.SetMask(p_mask) == false ) return(false);
+
+    // the same compiled mask for both snapshots
+    for(int s=0; s < 2; s++) {
+        if( mask.Evaluate(&p_crd[s]) == false ) return(false);
+        p_selected[s].resize(mask.GetNumberOfTopologyAtoms());
+        for(unsigned int i=0; i < p_selected[s].size(); i++) {
+            p_selected[s][i] = mask.IsAtomSelected(i);
+        }
+    }
+    return(true);
+}
+
+//------------------------------------------------------------------------------
+
+int main(void)
+{
+    CAmberTopology  top;
+    CAmberRestart   crd[2];
+
+    BuildTopology(top);
+    CPoint box = top.BoxInfo.GetBoxDimmensions();
+
+    if( (BuildCoordinates(top,crd[0],1.0) == false) ||
+        (BuildCoordinates(top,crd[1],1.25) == false) ) {
+        fprintf(stderr,"unable to create coordinates\n");
+        return(1);
+    }
+
+    int natmasks = 0;
+    while( AtomMasks[natmasks] != NULL ) natmasks++;
+    int nresmasks = 0;
+    while( ResidueMasks[nresmasks] != NULL ) nresmasks++;
+    int nmasks = natmasks + nresmasks;
+
+    // serial reference
+    vector< vector<char> > reference(2*nmasks);
+    for(int i=0; i < 2*nmasks; i++) {
+        int m = i / 2;
+        bool result;
+        if( m < natmasks ) {
+            result = SelectAtoms(&top,&crd[i % 2],AtomMasks[m],reference[i]);
+        } else {
+            result = SelectResidues(&top,&crd[i % 2],ResidueMasks[m-natmasks],reference[i]);
+        }
+        if( result == false ) {
+            fprintf(stderr,"unable to set mask %d\n",m);
+            ErrorSystem.PrintErrors();
+            return(1);
+        }
+    }
+
+    // the name indexes are built by the first selection, start over
+    // to build them concurrently
+    top.FreeNameIndexes();
+
+    int nfailed = 0;
+    int ntasks  = 2*nmasks*NumOfPasses;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(+:nfailed)
+#endif
+    for(int t=0; t < ntasks; t++) {
+        int i = t % (2*nmasks);
+        int m = i / 2;
+        vector<char> selected;
+        bool result;
+        if( m < natmasks ) {
+            result = SelectAtoms(&top,&crd[i % 2],AtomMasks[m],selected);
+        } else {
+            result = SelectResidues(&top,&crd[i % 2],ResidueMasks[m-natmasks],selected);
+        }
+        if( (result == false) || (selected != reference[i]) ) nfailed++;
+    }
+
+    if( nfailed > 0 ) {
+        fprintf(stderr,"%d of %d concurrent selections differ from serial ones\n",nfailed,ntasks);
+        return(1);
+    }
+
+    int ncompiled = natmasks*NumOfPasses;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(+:nfailed)
+#endif
+    for(int t=0; t < ncompiled; t++) {
+        int m = t % natmasks;
+        vector<char> selected[2];
+        if( SelectCompiled(&top,crd,AtomMasks[m],selected) == false ) {
+            nfailed++;
+            continue;
+        }
+        if( (selected[0] != reference[2*m]) || (selected[1] != reference[2*m+1]) ) nfailed++;
+    }
+
+    if( nfailed > 0 ) {
+        fprintf(stderr,"%d of %d concurrent compiled masks differ from serial selections\n",nfailed,ncompiled);
+        return(1);
+    }
+
+    if( top.BoxInfo.GetBoxDimmensions() != box ) {
+        fprintf(stderr,"box of topology was changed by masks\n");
+        return(1);
+    }
+
+    printf("%d concurrent selections and %d compiled masks passed\n",ntasks,ncompiled);
+
+    return(0);
+}